@@ -17,10 +17,15 @@
 #ifndef __ACTOR_HPP__
 #define __ACTOR_HPP__
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "actor/buslog.hpp"
 #include "actor/msg.hpp"
@@ -37,6 +42,31 @@ using ActorReference = std::shared_ptr<ActorBase>;
 // should be at least greater than 1
 constexpr uint32_t MAX_ACTOR_RECORD_SIZE = 3;
 
+// messages an actor handles in one run on the shared threads before it is queued behind the other ready actors,
+// it can be overridden by the env LITEBUS_ACTOR_MSG_QUANTUM (0 means unbounded) or ActorBase::SetMsgQuantum.
+constexpr uint32_t DEFAULT_ACTOR_MSG_QUANTUM = 1024;
+
+// LOCKED_LIST: mutex protected std::list mailbox, LOCK_FREE: intrusive lock-free MPSC mailbox for hot actors
+enum class MailboxType { LOCKED_LIST, LOCK_FREE };
+
+// scheduling statistics of one shared actor thread
+struct ActorWorkerStats {
+    uint32_t worker;
+    uint64_t queueDepth;    // ready actors waiting in the run queue of the worker
+    uint64_t steals;        // ready actors the worker took from the other workers
+    uint64_t runs;          // actors run by the worker
+    bool dedicated;         // the worker runs an actor spawned with its own thread
+};
+
+// run statistics of one actor, the run time only counts the time spent in handling messages
+struct ActorRunStats {
+    std::string name;
+    uint64_t runs;         // mailbox batches handled
+    uint64_t msgs;         // messages handled
+    uint64_t runTimeUs;    // time spent in handling the messages
+    uint64_t yields;       // runs cut by the message quantum
+};
+
 class ActorBase {
 public:
     inline const AID &GetAID() const
@@ -70,6 +100,25 @@ public:
     int Send(const AID &to, std::string &&name, std::string &&msg, bool remoteLink = false,
              bool isExactNotRemote = false);
 
+    // select the mailbox implementation, it takes effect only when called before the actor is spawned.
+    inline void SetMailboxType(MailboxType type)
+    {
+        mailboxType = type;
+    }
+
+    inline MailboxType GetMailboxType() const
+    {
+        return mailboxType;
+    }
+
+    // bound the messages handled in one run on the shared threads, 0 means unbounded.
+    inline void SetMsgQuantum(uint32_t quantum)
+    {
+        msgQuantum.store(static_cast<int64_t>(quantum));
+    }
+
+    ActorRunStats GetRunStats() const;
+
     // get output buffer size for flow control
     uint64_t GetOutBufSize(const AID &to) const;
 
@@ -139,6 +188,16 @@ protected:
         return;
     }
 
+    // register the message handle taking the body as a slice, a large body received by the ring receive mode of
+    // TCPMgr is not copied
+    template <typename T>
+    void Receive(const std::string &msgName, void (T::*method)(const litebus::AID &, std::string &&, MsgSlice &&))
+    {
+        ActorFunction func = std::bind(&SliceBehaviorBase<T>, static_cast<T *>(this), method, std::placeholders::_1);
+        Receive(msgName, std::move(func));
+        return;
+    }
+
     // register the message handle, for kmsg-udp message
     template <typename T>
     void ReceiveUdp(const std::string &msgName, void (T::*method)(const litebus::AID &, std::string &&, std::string &&))
@@ -176,7 +235,19 @@ private:
                          msg->name);
             return;
         }
-        (t->*method)(msg->from, std::move(msg->name), std::move(msg->body));
+        (t->*method)(msg->from, std::move(msg->name), std::move(msg->Body()));
+    }
+
+    template <typename T>
+    static void SliceBehaviorBase(T *t, void (T::*method)(const litebus::AID &, std::string &&, MsgSlice &&),
+                                  std::unique_ptr<MessageBase> &msg)
+    {
+        if (msg->type != MessageBase::Type::KMSG) {
+            BUSLOG_ERROR("Drop non-tcp message, from:{},to:{},name:{}", std::string(msg->from), std::string(msg->to),
+                         msg->name);
+            return;
+        }
+        (t->*method)(msg->from, std::move(msg->name), msg->TakeBodySlice());
     }
 
     // regist the message handle. It will be discarded.
@@ -189,7 +260,7 @@ private:
                          msg->name);
             return;
         }
-        (t->*method)(msg->from, std::move(msg->name), std::move(msg->body));
+        (t->*method)(msg->from, std::move(msg->name), std::move(msg->Body()));
     }
 
     // regist the udp message handle. Use this closure function to drop non-udp messages
@@ -205,7 +276,12 @@ private:
         (t->*method)(msg->from, std::move(msg->name), std::move(msg->body));
     }
 
-    void Run();
+    // return true if the run is cut by the message quantum and the actor has to be scheduled again
+    bool Run(uint32_t defaultQuantum);
+    bool RunLockFree(uint32_t quantum);
+    void AddRunStats(const std::chrono::steady_clock::time_point &begin, uint32_t msgs, bool yield);
+    // return false if the actor quits
+    bool HandleMsg(std::unique_ptr<MessageBase> &msg);
     void Quit();
     int EnqueMessage(std::unique_ptr<MessageBase> msg);
 
@@ -215,8 +291,19 @@ private:
     std::unique_ptr<ActorPolicy> actorThread;
 
     AID id;
-
-    std::map<std::string, ActorFunction> actionFunctions;
+    MailboxType mailboxType = MailboxType::LOCKED_LIST;
+    // the shared thread which ran the actor last time
+    std::atomic<int> lastWorker{ -1 };
+    // negative means the default quantum of the shared threads
+    std::atomic<int64_t> msgQuantum{ -1 };
+
+    std::atomic<uint64_t> runCount{ 0 };
+    std::atomic<uint64_t> handledMsgCount{ 0 };
+    std::atomic<uint64_t> runTimeUs{ 0 };
+    std::atomic<uint64_t> yieldCount{ 0 };
+
+    // message handlers sorted by the interned id of the message name, see MsgNameTable
+    std::vector<std::pair<uint32_t, ActorFunction>> actionFunctions;
     std::mutex waiterLock;
 
     std::string msgRecords[MAX_ACTOR_RECORD_SIZE];
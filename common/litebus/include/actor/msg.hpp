@@ -17,11 +17,67 @@
 #ifndef LITEBUS_MESSAGE_HPP
 #define LITEBUS_MESSAGE_HPP
 
+#include <memory>
+#include <new>
+
 #include "actor/aid.hpp"
 #include "ssl/sensitive_value.hpp"
 
 namespace litebus {
 class ActorBase;
+class MpscMailbox;
+
+// allocation statistics of the message pool
+struct MsgAllocStats {
+    uint64_t msgAllocs;     // messages allocated, the count of the running threads is flushed every 64 messages
+    uint64_t heapAllocs;    // blocks the pool took from the heap
+    uint64_t heapFrees;     // blocks the pool gave back to the heap
+};
+
+// A read-only view of a received message body, it keeps the receive buffer it points into alive. Protobuf
+// messages parse it in place with ParseFromArray(slice.Data(), slice.Size()).
+class MsgSlice {
+public:
+    MsgSlice() = default;
+
+    MsgSlice(std::shared_ptr<const void> sliceOwner, const char *sliceData, size_t sliceSize)
+        : owner(std::move(sliceOwner)), data(sliceData), size(sliceSize)
+    {
+    }
+
+    inline const char *Data() const
+    {
+        return data;
+    }
+
+    inline size_t Size() const
+    {
+        return size;
+    }
+
+    inline bool Empty() const
+    {
+        return owner == nullptr;
+    }
+
+    inline std::string ToString() const
+    {
+        return std::string(data, size);
+    }
+
+    inline void Reset()
+    {
+        owner.reset();
+        data = nullptr;
+        size = 0;
+    }
+
+private:
+    std::shared_ptr<const void> owner;
+    const char *data = nullptr;
+    size_t size = 0;
+};
+
 class MessageBase {
 public:
     enum class Type : char {
@@ -77,11 +133,40 @@ public:
         return from;
     }
 
+    // a body received as a slice is copied out on the first call
     inline std::string &Body()
     {
+        if (!bodySlice.Empty()) {
+            body.assign(bodySlice.Data(), bodySlice.Size());
+            bodySlice.Reset();
+        }
         return body;
     }
 
+    inline bool HasBodySlice() const
+    {
+        return !bodySlice.Empty();
+    }
+
+    inline void SetBodySlice(MsgSlice &&slice)
+    {
+        body.clear();
+        bodySlice = std::move(slice);
+    }
+
+    // moves the body out without a copy, a string body is handed over as a slice owning it
+    inline MsgSlice TakeBodySlice()
+    {
+        if (bodySlice.Empty()) {
+            auto owner = std::make_shared<std::string>(std::move(body));
+            body.clear();
+            return MsgSlice(owner, owner->data(), owner->size());
+        }
+        MsgSlice slice = std::move(bodySlice);
+        bodySlice.Reset();
+        return slice;
+    }
+
     inline void SetFrom(const AID &aFrom)
     {
         from = aFrom;
@@ -111,6 +196,12 @@ public:
     {
     }
 
+    // messages and their subclasses are allocated from the per-thread message pool, see MsgPool
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t size, const std::nothrow_t &) noexcept;
+    static void operator delete(void *ptr) noexcept;
+    static void operator delete(void *ptr, const std::nothrow_t &) noexcept;
+
     friend class ActorBase;
     friend class TCPMgr;
     AID from;
@@ -121,6 +212,13 @@ public:
 
     std::string timestamp;
     std::string signature{ "0" };    // to(url@name), name, body
+    // the body left in the receive buffer of the link, see the ring receive mode of TCPMgr
+    MsgSlice bodySlice;
+
+private:
+    friend class MpscMailbox;
+    // intrusive link of the lock-free mailbox, it avoids a list node allocation per message.
+    MessageBase *mailboxNext = nullptr;
 };
 
 }    // namespace litebus
@@ -28,8 +28,41 @@ using MessageHandler = std::function<void(ActorBase *)>;
 
 void Async(const AID &aid, std::unique_ptr<MessageHandler> handler);
 
+// send a prepared KASYNC message
+void Async(const AID &aid, std::unique_ptr<MessageBase> msg);
+
 namespace internal {
 
+// async message keeping the closure inline, the message and the closure take one allocation from the message pool
+template <typename F>
+class MessageClosure : public MessageBase {
+public:
+    explicit MessageClosure(F &&f) : MessageBase("Async", Type::KASYNC), closure(std::move(f))
+    {
+    }
+
+    ~MessageClosure() override
+    {
+    }
+
+    void Run(ActorBase *actor) override
+    {
+        closure(actor);
+    }
+
+private:
+    F closure;
+};
+
+template <typename F>
+void AsyncClosure(const AID &aid, F &&f)
+{
+    using Closure = typename std::decay<F>::type;
+    std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageClosure<Closure>(std::forward<F>(f)));
+    BUS_OOM_EXIT(msg);
+    Async(aid, std::move(msg));
+}
+
 template <typename R>
 struct AsyncHelper;
 
@@ -39,10 +72,7 @@ struct AsyncHelper<void> {
     template <typename F>
     void operator()(const AID &aid, F &&f)
     {
-        std::unique_ptr<std::function<void(ActorBase *)>> handler(
-            new (std::nothrow) std::function<void(ActorBase *)>([=](ActorBase *) { f(); }));
-        BUS_OOM_EXIT(handler);
-        Async(aid, std::move(handler));
+        internal::AsyncClosure(aid, [=](ActorBase *) { f(); });
     }
 };
 
@@ -55,10 +85,7 @@ struct AsyncHelper<Future<R>> {
         BUS_OOM_EXIT(promise);
         Future<R> future = promise->GetFuture();
 
-        std::unique_ptr<std::function<void(ActorBase *)>> handler(
-            new (std::nothrow) std::function<void(ActorBase *)>([=](ActorBase *) { promise->Associate(f()); }));
-        BUS_OOM_EXIT(handler);
-        Async(aid, std::move(handler));
+        internal::AsyncClosure(aid, [=](ActorBase *) { promise->Associate(f()); });
         return future;
     }
 };
@@ -72,10 +99,7 @@ struct AsyncHelper {
         BUS_OOM_EXIT(promise);
         Future<R> future = promise->GetFuture();
 
-        std::unique_ptr<std::function<void(ActorBase *)>> handler(
-            new (std::nothrow) std::function<void(ActorBase *)>([=](ActorBase *) { promise->SetValue(f()); }));
-        BUS_OOM_EXIT(handler);
-        Async(aid, std::move(handler));
+        internal::AsyncClosure(aid, [=](ActorBase *) { promise->SetValue(f()); });
         return future;
     }
 };
@@ -86,43 +110,34 @@ struct AsyncHelper {
 template <typename T>
 void Async(const AID &aid, void (T::*method)())
 {
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([method](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            (t->*method)();
-        }));
-    BUS_OOM_EXIT(handler);
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [method](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        (t->*method)();
+    });
 }
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg)
 {
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([method, arg](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            (t->*method)(arg);
-        }));
-    BUS_OOM_EXIT(handler);
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [method, arg](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        (t->*method)(arg);
+    });
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple)
 {
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([method, tuple](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            Apply(t, method, tuple);
-        }));
-    BUS_OOM_EXIT(handler);
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [method, tuple](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        Apply(t, method, tuple);
+    });
 }
 
 template <typename T, typename... Args0, typename... Args1>
@@ -140,16 +155,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)())
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->Associate((t->*method)());
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->Associate((t->*method)());
+    });
     return future;
 }
 
@@ -160,16 +171,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Arg0), Arg1 &&arg)
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method, arg](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->Associate((t->*method)(arg));
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method, arg](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->Associate((t->*method)(arg));
+    });
     return future;
 }
 
@@ -180,16 +187,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Args0...), std::tuple<Arg
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method, tuple](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->Associate(Apply(t, method, tuple));
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method, tuple](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->Associate(Apply(t, method, tuple));
+    });
     return future;
 }
 
@@ -209,16 +212,12 @@ Future<R> Async(const AID &aid, R (T::*method)())
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->SetValue((t->*method)());
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->SetValue((t->*method)());
+    });
     return future;
 }
 
@@ -231,16 +230,12 @@ Future<R> Async(const AID &aid, R (T::*method)(Arg0), Arg1 &&arg)
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method, arg](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->SetValue((t->*method)(arg));
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method, arg](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->SetValue((t->*method)(arg));
+    });
     return future;
 }
 
@@ -253,16 +248,12 @@ Future<R> Async(const AID &aid, R (T::*method)(Args0...), std::tuple<Args1...> &
     BUS_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::unique_ptr<std::function<void(ActorBase *)>> handler(
-        new (std::nothrow) std::function<void(ActorBase *)>([promise, method, tuple](ActorBase *actor) {
-            BUS_ASSERT(actor != nullptr);
-            T *t = dynamic_cast<T *>(actor);
-            BUS_ASSERT(t != nullptr);
-            promise->SetValue(Apply(t, method, tuple));
-        }));
-    BUS_OOM_EXIT(handler);
-
-    Async(aid, std::move(handler));
+    internal::AsyncClosure(aid, [promise, method, tuple](ActorBase *actor) {
+        BUS_ASSERT(actor != nullptr);
+        T *t = dynamic_cast<T *>(actor);
+        BUS_ASSERT(t != nullptr);
+        promise->SetValue(Apply(t, method, tuple));
+    });
     return future;
 }
 
@@ -122,7 +122,7 @@ public:
         F &&function = std::forward<F>(f);
 
         return std::function<void(Arg)>([=](Arg arg) {
-            std::function<void()> handler([=]() { function(arg); });
+            auto handler = [=]() { function(arg); };
             Async(optionAid.Get(), handler);
         });
     }
@@ -138,7 +138,7 @@ public:
         F &&function = std::forward<F>(f);
 
         return std::function<void(Arg)>([=](Arg arg) {
-            std::function<void()> handler([=]() { function(arg); });
+            auto handler = [=]() { function(arg); };
             Async(optionAid.Get(), handler);
         });
     }
@@ -155,7 +155,7 @@ public:
 
         return std::function<void(Args...)>([=](Args... args) {
             auto tuple = std::make_tuple(std::forward<Args>(args)...);
-            std::function<void()> handler([=]() { Apply(function, tuple); });
+            auto handler = [=]() { Apply(function, tuple); };
             Async(optionAid.Get(), handler);
         });
     }
@@ -172,7 +172,7 @@ public:
 
         return std::function<void(Args...)>([=](Args... args) {
             auto tuple = std::make_tuple(std::forward<Args>(args)...);
-            std::function<void()> handler([=]() { Apply(function, tuple); });
+            auto handler = [=]() { Apply(function, tuple); };
             Async(optionAid.Get(), handler);
         });
     }
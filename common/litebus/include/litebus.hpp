@@ -17,6 +17,8 @@
 #ifndef LITEBUS_HPP
 #define LITEBUS_HPP
 
+#include <vector>
+
 #include "actor/actor.hpp"
 
 // brief provide an asynchronous programming framework as Actor model
@@ -68,5 +70,14 @@ int GetHttpKmsgFlag();
 // brief set flag of http message format
 void SetHttpKmsgFlag(int flag);
 
+// get run queue depth and steal count of the shared actor threads
+std::vector<ActorWorkerStats> GetActorWorkerStats();
+
+// get message count and run time of the spawned actors
+std::vector<ActorRunStats> GetActorRunStats();
+
+// get allocation statistics of the message pool
+MsgAllocStats GetMsgAllocStats();
+
 }    // namespace litebus
 #endif
@@ -16,10 +16,13 @@
 
 #include "actor/actor.hpp"
 
+#include <algorithm>
+
 #include "actor/actormgr.hpp"
 #include "actor/actorpolicyinterface.hpp"
 #include "actor/buslog.hpp"
 #include "actor/iomgr.hpp"
+#include "actor/msgnametable.hpp"
 #include "utils/os_utils.hpp"
 #include "utils/time_util.hpp"
 
@@ -73,8 +76,11 @@ void ActorBase::Terminate()
 
 void ActorBase::HandlekMsg(std::unique_ptr<MessageBase> &msg)
 {
-    auto it = actionFunctions.find(msg->Name());
-    if (it != actionFunctions.end()) {
+    uint32_t nameId = MsgNameTable::GetInstance().Find(msg->Name());
+    auto it = std::lower_bound(
+        actionFunctions.begin(), actionFunctions.end(), nameId,
+        [](const std::pair<uint32_t, ActorFunction> &handler, uint32_t key) { return handler.first < key; });
+    if (it != actionFunctions.end() && it->first == nameId) {
         ActorFunction &func = it->second;
         func(msg);
     } else {
@@ -95,55 +101,135 @@ void ActorBase::Quit()
     waiterLock.unlock();
 }
 
-void ActorBase::Run()
+bool ActorBase::HandleMsg(std::unique_ptr<MessageBase> &msg)
 {
+    BUSLOG_DEBUG("dequeue message, actor={},msg={}", id.Name(), msg->Name());
+    AddMsgRecord(msg->Name());
+    switch (msg->GetType()) {
+        case MessageBase::Type::KMSG:
+        case MessageBase::Type::KUDP: {
+            if (Filter(msg)) {
+                break;
+            }
+            this->HandlekMsg(msg);
+            break;
+        }
+        case MessageBase::Type::KHTTP: {
+            this->HandleHttp(std::move(msg));
+            break;
+        }
+        case MessageBase::Type::KASYNC: {
+            msg->Run(this);
+            break;
+        }
+        case MessageBase::Type::KLOCAL: {
+            this->HandleLocalMsg(std::move(msg));
+            break;
+        }
+        case MessageBase::Type::KTERMINATE: {
+            this->Quit();
+            return false;
+        }
+        case MessageBase::Type::KEXIT: {
+            this->Exited(msg->From());
+            break;
+        }
+    }
+    return true;
+}
+
+bool ActorBase::Run(uint32_t defaultQuantum)
+{
+    uint32_t quantum = 0;
+    if (actorThread->IsShared()) {
+        int64_t actorQuantum = msgQuantum.load();
+        quantum = actorQuantum < 0 ? defaultQuantum : static_cast<uint32_t>(actorQuantum);
+    }
+    if (actorThread->IsLockFree()) {
+        return RunLockFree(quantum);
+    }
+    uint32_t handled = 0;
     for (;;) {
         auto msgs = actorThread->GetMsgs();
         if (msgs == nullptr) {
-            return;
+            return false;
         }
-        for (auto it = msgs->begin(); it != msgs->end(); ++it) {
-            std::unique_ptr<MessageBase> &msg = *it;
+        auto begin = std::chrono::steady_clock::now();
+        uint32_t count = 0;
+        while (!msgs->empty()) {
+            std::unique_ptr<MessageBase> msg = std::move(msgs->front());
+            msgs->pop_front();
             if (msg == nullptr) {
                 continue;
             }
-            BUSLOG_DEBUG("dequeue message, actor={},msg={}", id.Name(), msg->Name());
-            AddMsgRecord(msg->Name());
-            switch (msg->GetType()) {
-                case MessageBase::Type::KMSG:
-                case MessageBase::Type::KUDP: {
-                    if (Filter(msg)) {
-                        continue;
-                    }
-                    this->HandlekMsg(msg);
-                    break;
-                }
-                case MessageBase::Type::KHTTP: {
-                    this->HandleHttp(std::move(msg));
-                    break;
-                }
-                case MessageBase::Type::KASYNC: {
-                    msg->Run(this);
-                    break;
-                }
-                case MessageBase::Type::KLOCAL: {
-                    this->HandleLocalMsg(std::move(msg));
-                    break;
-                }
-                case MessageBase::Type::KTERMINATE: {
-                    this->Quit();
-                    return;
-                }
-                case MessageBase::Type::KEXIT: {
-                    this->Exited(msg->From());
-                    break;
-                }
+            ++count;
+            if (!HandleMsg(msg)) {
+                AddRunStats(begin, count, false);
+                return false;
+            }
+            // the rest of the messages stay in the deque mailbox and are handled first in the next run
+            if (quantum != 0 && handled + count >= quantum) {
+                AddRunStats(begin, count, true);
+                return true;
+            }
+        }
+        AddRunStats(begin, count, false);
+        handled += count;
+    }
+}
+
+bool ActorBase::RunLockFree(uint32_t quantum)
+{
+    uint32_t handled = 0;
+    for (;;) {
+        MessageBase *msgs = actorThread->leftoverMsgs;
+        actorThread->leftoverMsgs = nullptr;
+        if (msgs == nullptr) {
+            msgs = actorThread->DrainMsgs();
+        }
+        if (msgs == nullptr) {
+            return false;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        uint32_t count = 0;
+        while (msgs != nullptr) {
+            std::unique_ptr<MessageBase> msg(msgs);
+            msgs = MpscMailbox::Next(msgs);
+            ++count;
+            if (!HandleMsg(msg)) {
+                MpscMailbox::Release(msgs);
+                AddRunStats(begin, count, false);
+                return false;
+            }
+            if (quantum != 0 && handled + count >= quantum) {
+                actorThread->leftoverMsgs = msgs;
+                AddRunStats(begin, count, true);
+                return true;
             }
         }
-        msgs->clear();
+        AddRunStats(begin, count, false);
+        handled += count;
+    }
+}
+
+void ActorBase::AddRunStats(const std::chrono::steady_clock::time_point &begin, uint32_t msgs, bool yield)
+{
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    (void)runCount.fetch_add(1, std::memory_order_relaxed);
+    (void)handledMsgCount.fetch_add(msgs, std::memory_order_relaxed);
+    (void)runTimeUs.fetch_add(static_cast<uint64_t>(cost.count()), std::memory_order_relaxed);
+    if (yield) {
+        (void)yieldCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
+ActorRunStats ActorBase::GetRunStats() const
+{
+    return ActorRunStats{ id.Name(), runCount.load(std::memory_order_relaxed),
+                          handledMsgCount.load(std::memory_order_relaxed), runTimeUs.load(std::memory_order_relaxed),
+                          yieldCount.load(std::memory_order_relaxed) };
+}
+
 int ActorBase::Send(const AID &to, std::unique_ptr<MessageBase> msg)
 {
     msg->SetFrom(id);
@@ -160,12 +246,16 @@ int ActorBase::Send(const AID &to, std::string &&name, std::string &&strMsg, boo
 // register the message handle
 void ActorBase::Receive(const std::string &msgName, ActorFunction &&func)
 {
-    if (actionFunctions.find(msgName) != actionFunctions.end()) {
+    uint32_t nameId = MsgNameTable::GetInstance().Intern(msgName);
+    auto it = std::lower_bound(
+        actionFunctions.begin(), actionFunctions.end(), nameId,
+        [](const std::pair<uint32_t, ActorFunction> &handler, uint32_t key) { return handler.first < key; });
+    if (it != actionFunctions.end() && it->first == nameId) {
         BUSLOG_ERROR("ACTOR function's name conflicts, a={},f={}", id.Name(), msgName);
         BUS_EXIT("function's name conflicts");
         return;
     }
-    (void)actionFunctions.emplace(msgName, std::move(func));
+    (void)actionFunctions.emplace(it, nameId, std::move(func));
     return;
 }
 
@@ -36,7 +36,6 @@ std::shared_ptr<IOMgr> &ActorMgr::GetIOMgrRef(const std::string &protocol)
 }
 ActorMgr::ActorMgr() : actors(), procotols(), urls()
 {
-    actors.clear();
     procotols.clear();
     urls.clear();
 }
@@ -75,20 +74,13 @@ void ActorMgr::AddIOMgr(const std::string &protocol, const std::shared_ptr<IOMgr
 void ActorMgr::RemoveActor(const std::string &name)
 {
     BUSLOG_DEBUG("ACTOR was terminated with aid={}", name);
-    actorsMutex.lock();
-    (void)actors.erase(name);
-    actorsMutex.unlock();
+    actors.Erase(name);
 }
 
 void ActorMgr::TerminateAll()
 {
     // copy all the actors
-    std::list<ActorReference> actorsWaiting;
-    actorsMutex.lock();
-    for (auto actorIt = actors.begin(); actorIt != actors.end(); ++actorIt) {
-        actorsWaiting.push_back(actorIt->second);
-    }
-    actorsMutex.unlock();
+    std::list<ActorReference> actorsWaiting = actors.GetAll();
 
     // send terminal msg to all actors.
     for (auto actorIt = actorsWaiting.begin(); actorIt != actorsWaiting.end(); ++actorIt) {
@@ -125,20 +117,19 @@ void ActorMgr::Finalize()
     BUSLOG_INFO("litebus IOMGRS finish exiting.");
 }
 
-ActorReference ActorMgr::GetActor(const AID &id)
+std::vector<ActorRunStats> ActorMgr::GetActorRunStats()
 {
-    ActorReference result;
-    actorsMutex.lock();
-    auto actorIt = actors.find(id.Name());
-    if (actorIt != actors.end()) {
-        result = actorIt->second;
-    } else {
-        result = nullptr;
+    std::vector<ActorRunStats> result;
+    for (const auto &actor : actors.GetAll()) {
+        result.push_back(actor->GetRunStats());
     }
-    // find the
-    actorsMutex.unlock();
     return result;
 }
+
+ActorReference ActorMgr::GetActor(const AID &id)
+{
+    return actors.Find(id.Name());
+}
 int ActorMgr::Send(const AID &to, std::unique_ptr<MessageBase> msg, bool remoteLink, bool isExactNotRemote)
 {
     // The destination is local
@@ -174,29 +165,26 @@ int ActorMgr::Send(const AID &to, std::unique_ptr<MessageBase> msg, bool remoteL
 
 AID ActorMgr::Spawn(ActorReference &actor, bool shareThread, bool start)
 {
-    actorsMutex.lock();
-    if (actors.find(actor->GetAID().Name()) != actors.end()) {
-        actorsMutex.unlock();
-        BUSLOG_ERROR("The actor's name conflicts,name:{}", actor->GetAID().Name());
-        BUS_EXIT("Actor name conflicts.");
-    }
-
     BUSLOG_DEBUG("ACTOR {} was spawned", actor->GetAID().Name());
     std::unique_ptr<ActorPolicy> threadPolicy;
 
     if (shareThread) {
-        threadPolicy.reset(new (std::nothrow) ShardedThread(actor));
-        BUS_OOM_EXIT(threadPolicy);
-        actor->Spawn(actor, std::move(threadPolicy));
+        threadPolicy.reset(new (std::nothrow) ShardedThread(actor, actor->GetMailboxType()));
     } else {
-        threadPolicy.reset(new (std::nothrow) SingleThread());
-        BUS_OOM_EXIT(threadPolicy);
-        actor->Spawn(actor, std::move(threadPolicy));
-        ActorMgr::GetActorMgrRef()->SetActorReady(actor);
+        threadPolicy.reset(new (std::nothrow) SingleThread(actor->GetMailboxType()));
     }
+    BUS_OOM_EXIT(threadPolicy);
+    actor->Spawn(actor, std::move(threadPolicy));
 
-    (void)this->actors.emplace(actor->GetAID().Name(), actor);
-    actorsMutex.unlock();
+    // the name is checked and taken in one step under the shard lock, the actor is published with its policy set and
+    // gets a thread only after it owns the name
+    if (!actors.Insert(actor)) {
+        BUSLOG_ERROR("The actor's name conflicts,name:{}", actor->GetAID().Name());
+        BUS_EXIT("Actor name conflicts.");
+    }
+    if (!shareThread) {
+        ActorMgr::GetActorMgrRef()->SetActorReady(actor);
+    }
 
     // long time
     actor->Init();
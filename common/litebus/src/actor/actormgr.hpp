@@ -18,6 +18,7 @@
 #define DEF_ACTOR_MGR_H
 
 #include <set>
+#include "actor/actortable.hpp"
 #include "actor/actorthread.hpp"
 
 namespace litebus {
@@ -73,6 +74,11 @@ public:
     {
         threadPool.EnqueReadyActor(actor);
     }
+    inline std::vector<ActorWorkerStats> GetWorkerStats()
+    {
+        return threadPool.GetWorkerStats();
+    }
+    std::vector<ActorRunStats> GetActorRunStats();
     void SetActorStatus(const AID &pid, bool start);
 
 private:
@@ -85,8 +91,7 @@ private:
         }
     }
     // Map of all local spawned and running processes.
-    std::map<std::string, ActorReference> actors;
-    std::mutex actorsMutex;
+    ActorTable actors;
 
     ActorThread threadPool;
 
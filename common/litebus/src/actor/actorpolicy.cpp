@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "actor/actor.hpp"
 #include "actor/actormgr.hpp"
 
@@ -28,7 +30,7 @@ void ActorPolicy::SetRunningStatus(bool startRun)
     Notify();
 }
 
-SingleThread::SingleThread()
+SingleThread::SingleThread(MailboxType type) : ActorPolicy(type)
 {
 }
 SingleThread::~SingleThread()
@@ -45,6 +47,15 @@ void SingleThread::Terminate(const ActorBase *actor)
 
 int SingleThread::EnqueMessage(std::unique_ptr<MessageBase> &msg)
 {
+    if (IsLockFree()) {
+        // Only the push which makes the mailbox non-empty may find the thread waiting, so only it takes the lock.
+        if (lockFreeMailbox.Push(msg) && start) {
+            std::lock_guard<std::mutex> lock(mailboxLock);
+            conditionVar.notify_one();
+        }
+        return std::max(lockFreeMailbox.Pending(), 1);
+    }
+
     int result;
     {
         std::lock_guard<std::mutex> lock(mailboxLock);
@@ -61,7 +72,7 @@ int SingleThread::EnqueMessage(std::unique_ptr<MessageBase> &msg)
 }
 void SingleThread::Notify()
 {
-    if (start && msgCount > 0) {
+    if (start && HasPendingMsgs()) {
         conditionVar.notify_one();
     }
 }
@@ -79,7 +90,19 @@ std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs()
     return result;
 }
 
-ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor) : ready(false), terminated(false), actor(aActor)
+MessageBase *SingleThread::DrainMsgs()
+{
+    MessageBase *result = lockFreeMailbox.Drain();
+    if (result != nullptr) {
+        return result;
+    }
+    std::unique_lock<std::mutex> lock(mailboxLock);
+    conditionVar.wait(lock, [this] { return (!this->lockFreeMailbox.Empty()); });
+    return lockFreeMailbox.Drain();
+}
+
+ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor, MailboxType type)
+    : ActorPolicy(type), ready(false), terminated(false), actor(aActor)
 {
 }
 ShardedThread::~ShardedThread()
@@ -101,6 +124,17 @@ void ShardedThread::Terminate(const ActorBase *aActor)
 
 int ShardedThread::EnqueMessage(std::unique_ptr<MessageBase> &msg)
 {
+    if (IsLockFree()) {
+        (void)lockFreeMailbox.Push(msg);
+        // A ready actor is queued or running and drains the message later, only an idle actor needs the lock to be
+        // scheduled. The push is ordered before the load of ready, see DrainMsgs.
+        if (!ready.load()) {
+            std::lock_guard<std::mutex> lock(mailboxLock);
+            Notify();
+        }
+        return std::max(lockFreeMailbox.Pending(), 1);
+    }
+
     int result;
     mailboxLock.lock();
     enqueMailbox->push_back(std::move(msg));
@@ -116,7 +150,7 @@ int ShardedThread::EnqueMessage(std::unique_ptr<MessageBase> &msg)
 
 void ShardedThread::Notify()
 {
-    if (start && ready == false && terminated == false && msgCount > 0) {
+    if (start && ready == false && terminated == false && HasPendingMsgs()) {
         ActorMgr::GetActorMgrRef()->SetActorReady(actor);
         ready = true;
     }
@@ -127,7 +161,10 @@ std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs()
     std::list<std::unique_ptr<MessageBase>> *result;
     mailboxLock.lock();
 
-    if (enqueMailbox->empty()) {
+    if (!dequeMailbox->empty()) {
+        // the messages left by the last run which reached the message quantum
+        result = dequeMailbox;
+    } else if (enqueMailbox->empty()) {
         ready = false;
         result = nullptr;
     } else {
@@ -141,4 +178,22 @@ std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs()
     return result;
 }
 
+MessageBase *ShardedThread::DrainMsgs()
+{
+    MessageBase *result = lockFreeMailbox.Drain();
+    if (result != nullptr) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mailboxLock);
+    // Clear ready before the last check: a producer either pushed before it and the message is drained here, or it
+    // sees ready cleared and schedules the actor again in Notify.
+    ready = false;
+    result = lockFreeMailbox.Drain();
+    if (result != nullptr) {
+        ready = true;
+    }
+    return result;
+}
+
 };    // end of namespace litebus
@@ -16,36 +16,45 @@
 
 #ifndef ACTOR_POLICY_H
 #define ACTOR_POLICY_H
+#include <atomic>
+
 #include "actor/actorpolicyinterface.hpp"
 
 namespace litebus {
 
 class ShardedThread : public ActorPolicy {
 public:
-    ShardedThread(const std::shared_ptr<ActorBase> &actor);
+    ShardedThread(const std::shared_ptr<ActorBase> &actor, MailboxType type = MailboxType::LOCKED_LIST);
     ~ShardedThread() override;
 
 protected:
     void Terminate(const ActorBase *actor) override;
     int EnqueMessage(std::unique_ptr<MessageBase> &msg) override;
     std::list<std::unique_ptr<MessageBase>> *GetMsgs() override;
+    MessageBase *DrainMsgs() override;
     void Notify() override;
+    bool IsShared() const override
+    {
+        return true;
+    }
 
 private:
-    bool ready;
+    // read without mailboxLock by the producers of a lock-free mailbox
+    std::atomic<bool> ready;
     bool terminated;
     std::shared_ptr<ActorBase> actor;
 };
 
 class SingleThread : public ActorPolicy {
 public:
-    SingleThread();
+    SingleThread(MailboxType type = MailboxType::LOCKED_LIST);
     ~SingleThread() override;
 
 protected:
     void Terminate(const ActorBase *actor) override;
     int EnqueMessage(std::unique_ptr<MessageBase> &msg) override;
     std::list<std::unique_ptr<MessageBase>> *GetMsgs() override;
+    MessageBase *DrainMsgs() override;
     void Notify() override;
 
 private:
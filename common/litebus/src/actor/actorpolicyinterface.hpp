@@ -17,17 +17,21 @@
 #ifndef DEF_ACTOR_POLICY_INTERFACE_H
 #define DEF_ACTOR_POLICY_INTERFACE_H
 
+#include "actor/mailbox.hpp"
+
 namespace litebus {
 
 class ActorPolicy {
 public:
-    ActorPolicy() : mailbox1(), mailbox2()
+    ActorPolicy(MailboxType type = MailboxType::LOCKED_LIST) : mailboxType(type), mailbox1(), mailbox2()
     {
         enqueMailbox = &mailbox1;
         dequeMailbox = &mailbox2;
     };
     virtual ~ActorPolicy()
     {
+        MpscMailbox::Release(leftoverMsgs);
+        leftoverMsgs = nullptr;
         if (enqueMailbox != nullptr) {
             enqueMailbox = nullptr;
         }
@@ -44,12 +48,29 @@ public:
         msgCount = 0;
     }
 
+    inline bool IsLockFree() const
+    {
+        return mailboxType == MailboxType::LOCK_FREE;
+    }
+
 protected:
     void SetRunningStatus(bool startRun);
     virtual void Terminate(const ActorBase *actor) = 0;
     virtual int EnqueMessage(std::unique_ptr<MessageBase> &msg) = 0;
     virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
+    // lock-free counterpart of GetMsgs, return the oldest message of the drained chain
+    virtual MessageBase *DrainMsgs() = 0;
     virtual void Notify() = 0;
+    // whether the actor runs on the shared threads and has to give them up after the message quantum
+    virtual bool IsShared() const
+    {
+        return false;
+    }
+
+    inline bool HasPendingMsgs() const
+    {
+        return IsLockFree() ? !lockFreeMailbox.Empty() : msgCount > 0;
+    }
 
     std::list<std::unique_ptr<MessageBase>> *enqueMailbox;
     std::list<std::unique_ptr<MessageBase>> *dequeMailbox;
@@ -58,6 +79,11 @@ protected:
     bool start = false;
     std::mutex mailboxLock;
 
+    const MailboxType mailboxType;
+    MpscMailbox lockFreeMailbox;
+    // drained from lockFreeMailbox but not handled in the last run, only touched by the running actor
+    MessageBase *leftoverMsgs = nullptr;
+
 private:
     friend class ActorBase;
 
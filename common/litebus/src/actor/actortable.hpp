@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEF_ACTOR_TABLE_H
+#define DEF_ACTOR_TABLE_H
+
+#include <array>
+#include <functional>
+#include <list>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "actor/actor.hpp"
+
+namespace litebus {
+
+constexpr size_t ACTOR_TABLE_SHARDS = 64;
+
+// Name to actor table of ActorMgr. Every local Send looks the target up here, so the table is split into shards
+// with their own reader-writer lock: lookups of different actors do not contend and lookups of the same actor only
+// share a read lock. The name is hashed once, the hash selects the shard and is the key inside it.
+class ActorTable {
+public:
+    // return false if an actor with the same name exists
+    bool Insert(const ActorReference &actor)
+    {
+        const std::string &name = actor->GetAID().Name();
+        size_t hash = std::hash<std::string>()(name);
+        Shard &shard = GetShard(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (FindLocked(shard, hash, name) != shard.actors.end()) {
+            return false;
+        }
+        (void)shard.actors.emplace(hash, actor);
+        return true;
+    }
+
+    ActorReference Find(const std::string &name)
+    {
+        size_t hash = std::hash<std::string>()(name);
+        Shard &shard = GetShard(hash);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = FindLocked(shard, hash, name);
+        return it == shard.actors.end() ? nullptr : it->second;
+    }
+
+    void Erase(const std::string &name)
+    {
+        size_t hash = std::hash<std::string>()(name);
+        Shard &shard = GetShard(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = FindLocked(shard, hash, name);
+        if (it != shard.actors.end()) {
+            (void)shard.actors.erase(it);
+        }
+    }
+
+    std::list<ActorReference> GetAll()
+    {
+        std::list<ActorReference> result;
+        for (auto &shard : shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto &actor : shard.actors) {
+                result.push_back(actor.second);
+            }
+        }
+        return result;
+    }
+
+private:
+    using ActorMap = std::unordered_multimap<size_t, ActorReference>;
+
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        ActorMap actors;
+    };
+
+    inline Shard &GetShard(size_t hash)
+    {
+        return shards[hash % ACTOR_TABLE_SHARDS];
+    }
+
+    static ActorMap::iterator FindLocked(Shard &shard, size_t hash, const std::string &name)
+    {
+        auto range = shard.actors.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->GetAID().Name() == name) {
+                return it;
+            }
+        }
+        return shard.actors.end();
+    }
+
+    std::array<Shard, ACTOR_TABLE_SHARDS> shards;
+};
+
+};    // end of namespace litebus
+#endif
@@ -19,10 +19,29 @@
 
 namespace litebus {
 constexpr int MAXTHREADNAMELEN = 12;
-ActorThread::ActorThread() : readyActors(), workers()
+
+namespace {
+// the pool and the index of the worker running on the current thread
+thread_local ActorThread *g_currentPool = nullptr;
+thread_local int g_currentWorker = -1;
+}    // namespace
+
+ActorThread::ActorThread()
+    : runQueues(),
+      workerCount(0),
+      nextQueue(0),
+      readyCount(0),
+      idleWorkers(0),
+      actorAffinity(false),
+      msgQuantum(DEFAULT_ACTOR_MSG_QUANTUM),
+      workers()
 {
-    readyActors.clear();
     workers.clear();
+    for (int i = 0; i < MAX_ACTOR_WORKERS; ++i) {
+        std::unique_ptr<WorkerQueue> queue(new (std::nothrow) WorkerQueue());
+        BUS_OOM_EXIT(queue);
+        runQueues.push_back(std::move(queue));
+    }
 
     char *envThreadName = getenv("LITEBUS_THREAD_NAME");
     if (envThreadName != nullptr) {
@@ -33,6 +52,20 @@ ActorThread::ActorThread() : readyActors(), workers()
     } else {
         threadName = "HARES_LB_ACT";
     }
+
+    char *envAffinity = getenv("LITEBUS_ACTOR_AFFINITY");
+    if (envAffinity != nullptr && std::string(envAffinity) == "true") {
+        actorAffinity = true;
+    }
+
+    char *envQuantum = getenv("LITEBUS_ACTOR_MSG_QUANTUM");
+    if (envQuantum != nullptr) {
+        try {
+            msgQuantum = static_cast<uint32_t>(std::stoul(envQuantum));
+        } catch (const std::exception &) {
+            BUSLOG_WARN("invalid LITEBUS_ACTOR_MSG_QUANTUM:{}, use default:{}", envQuantum, msgQuantum);
+        }
+    }
 }
 
 ActorThread::~ActorThread()
@@ -41,9 +74,15 @@ ActorThread::~ActorThread()
 void ActorThread::AddThread(int threadCount)
 {
     for (int i = 0; i < threadCount; ++i) {
-        std::unique_ptr<std::thread> worker(new (std::nothrow) std::thread(&ActorThread::Run, this));
+        int index = workerCount.load();
+        if (index >= MAX_ACTOR_WORKERS) {
+            BUSLOG_WARN("actor worker count reaches the limit:{}", MAX_ACTOR_WORKERS);
+            break;
+        }
+        std::unique_ptr<std::thread> worker(new (std::nothrow) std::thread(&ActorThread::Run, this, index));
         BUS_OOM_EXIT(worker);
         workers.push_back(std::move(worker));
+        workerCount.fetch_add(1);
     }
 }
 void ActorThread::Finalize()
@@ -66,27 +105,123 @@ void ActorThread::Finalize()
         }
     }
     workers.clear();
+    workerCount.store(0);
     BUSLOG_INFO("Actor's threads finish exiting.");
 }
 
-void ActorThread::DequeReadyActor(std::shared_ptr<ActorBase> &actor)
+bool ActorThread::PopLocal(int index, std::shared_ptr<ActorBase> &actor)
 {
-    std::unique_lock<std::mutex> lock(readyActorMutex);
-    conditionVar.wait(lock, [this] { return (this->readyActors.size() > 0); });
-    actor = readyActors.front();
-    readyActors.pop_front();
+    WorkerQueue &queue = *runQueues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.actors.empty()) {
+        return false;
+    }
+    actor = std::move(queue.actors.front());
+    queue.actors.pop_front();
+    return true;
+}
+
+bool ActorThread::Steal(int index, std::shared_ptr<ActorBase> &actor)
+{
+    int count = workerCount.load();
+    for (int i = 1; i < count; ++i) {
+        WorkerQueue &victim = *runQueues[(index + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.actors.empty()) {
+            continue;
+        }
+        actor = std::move(victim.actors.front());
+        victim.actors.pop_front();
+        (void)runQueues[index]->steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ActorThread::DequeReadyActor(int index, std::shared_ptr<ActorBase> &actor)
+{
+    for (;;) {
+        if (PopLocal(index, actor) || Steal(index, actor)) {
+            (void)readyCount.fetch_sub(1);
+            return;
+        }
+        // Publish idle before checking readyCount, EnqueReadyActor does it the other way round, so either the
+        // enqueued actor is seen here or the enqueuer sees the idle worker and wakes it up.
+        std::unique_lock<std::mutex> lock(idleMutex);
+        (void)idleWorkers.fetch_add(1);
+        conditionVar.wait(lock, [this] { return (this->readyCount.load() > 0); });
+        (void)idleWorkers.fetch_sub(1);
+    }
+}
+
+bool ActorThread::IsDedicated(int index) const
+{
+    return runQueues[index]->dedicated.load(std::memory_order_relaxed);
+}
+
+int ActorThread::SelectQueue(const std::shared_ptr<ActorBase> &actor)
+{
+    int count = workerCount.load();
+    if (count <= 0) {
+        return 0;
+    }
+    // A worker running a dedicated actor does not come back to its queue, the actors queued there would only be run by
+    // thieves, so it is neither kept local nor chosen.
+    if (actorAffinity && actor != nullptr) {
+        int last = actor->lastWorker.load(std::memory_order_relaxed);
+        if (last >= 0 && last < count && !IsDedicated(last)) {
+            return last;
+        }
+    }
+    // An actor made ready by a worker usually consumes what the worker just produced, keep it local.
+    if (g_currentPool == this && g_currentWorker >= 0 && g_currentWorker < count && !IsDedicated(g_currentWorker)) {
+        return g_currentWorker;
+    }
+    int index = 0;
+    for (int i = 0; i < count; ++i) {
+        index = static_cast<int>(nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(count));
+        if (!IsDedicated(index)) {
+            break;
+        }
+    }
+    return index;
 }
 
 void ActorThread::EnqueReadyActor(const std::shared_ptr<ActorBase> &actor)
 {
+    WorkerQueue &queue = *runQueues[SelectQueue(actor)];
     {
-        std::lock_guard<std::mutex> lock(readyActorMutex);
-        readyActors.push_back(actor);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.actors.push_back(actor);
+    }
+    (void)readyCount.fetch_add(1);
+    if (idleWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        conditionVar.notify_one();
+    }
+}
+
+std::vector<ActorWorkerStats> ActorThread::GetWorkerStats()
+{
+    std::vector<ActorWorkerStats> result;
+    int count = workerCount.load();
+    for (int i = 0; i < count; ++i) {
+        WorkerQueue &queue = *runQueues[i];
+        ActorWorkerStats stats;
+        stats.worker = static_cast<uint32_t>(i);
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            stats.queueDepth = queue.actors.size();
+        }
+        stats.steals = queue.steals.load(std::memory_order_relaxed);
+        stats.runs = queue.runs.load(std::memory_order_relaxed);
+        stats.dedicated = queue.dedicated.load(std::memory_order_relaxed);
+        result.push_back(stats);
     }
-    conditionVar.notify_one();
+    return result;
 }
 
-void ActorThread::Run()
+void ActorThread::Run(int index)
 {
 #if __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12
     static std::atomic<int> actorCount(1);
@@ -97,14 +232,26 @@ void ActorThread::Run()
         BUSLOG_INFO("set pthread name success, threadID:{}", pthread_self());
     }
 #endif
+    g_currentPool = this;
+    g_currentWorker = index;
 
     bool terminate = false;
     do {
         std::shared_ptr<ActorBase> actor;
-        DequeReadyActor(actor);
+        DequeReadyActor(index, actor);
         if (actor != nullptr) {
+            actor->lastWorker.store(index, std::memory_order_relaxed);
+            (void)runQueues[index]->runs.fetch_add(1, std::memory_order_relaxed);
+            // an actor spawned with its own thread keeps the worker until it exits
+            bool dedicated = !actor->actorThread->IsShared();
+            runQueues[index]->dedicated.store(dedicated, std::memory_order_relaxed);
             try {
-                actor->Run();
+                bool yield = actor->Run(msgQuantum);
+                runQueues[index]->dedicated.store(false, std::memory_order_relaxed);
+                if (yield) {
+                    // the actor used up its message quantum, queue it behind the other ready actors
+                    EnqueReadyActor(actor);
+                }
             } catch (const std::exception &e) {
                 BUSLOG_ERROR("Will Exit:{},{}", actor->GetAID().Name(), e.what());
                 actor->PrintMsgRecord();
@@ -115,6 +262,8 @@ void ActorThread::Run()
             BUSLOG_DEBUG("Actor this Threads have finished exiting.");
         }
     } while (!terminate);
+    g_currentPool = nullptr;
+    g_currentWorker = -1;
 }
 
 };    // end of namespace litebus
@@ -17,14 +17,19 @@
 #ifndef ACTOR_THREAD_H
 #define ACTOR_THREAD_H
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <thread>
+#include <vector>
 
 #include "actor/actor.hpp"
 
 namespace litebus {
 
+constexpr int MAX_ACTOR_WORKERS = 128;
+
 class ActorThread {
 public:
     ActorThread();
@@ -32,14 +37,37 @@ public:
     void Finalize();
     void AddThread(int threadCount);
     void EnqueReadyActor(const std::shared_ptr<ActorBase> &actor);
+    std::vector<ActorWorkerStats> GetWorkerStats();
 
 private:
-    void Run();
-    void DequeReadyActor(std::shared_ptr<ActorBase> &actor);
+    // run queue of one worker. the owner and the thieves both take from the front, in the order the actors got ready.
+    struct alignas(64) WorkerQueue {
+        std::deque<std::shared_ptr<ActorBase>> actors;
+        std::mutex mutex;
+        std::atomic<uint64_t> steals{ 0 };
+        std::atomic<uint64_t> runs{ 0 };
+        // the worker runs an actor spawned with its own thread and does not pop its queue until the actor exits
+        std::atomic<bool> dedicated{ false };
+    };
+
+    void Run(int index);
+    void DequeReadyActor(int index, std::shared_ptr<ActorBase> &actor);
+    bool PopLocal(int index, std::shared_ptr<ActorBase> &actor);
+    bool Steal(int index, std::shared_ptr<ActorBase> &actor);
+    int SelectQueue(const std::shared_ptr<ActorBase> &actor);
+    bool IsDedicated(int index) const;
 
-    std::list<std::shared_ptr<ActorBase>> readyActors;
-    std::mutex readyActorMutex;
+    std::vector<std::unique_ptr<WorkerQueue>> runQueues;
+    std::atomic<int> workerCount;
+    std::atomic<uint32_t> nextQueue;
+    // enqueued but not yet dequeued actors, it may be negative for a moment.
+    std::atomic<int64_t> readyCount;
+    std::atomic<int> idleWorkers;
+    std::mutex idleMutex;
     std::condition_variable conditionVar;
+    // keep an actor on the worker which ran it last time
+    bool actorAffinity;
+    uint32_t msgQuantum;
 
     std::list<std::unique_ptr<std::thread>> workers;
     std::string threadName;
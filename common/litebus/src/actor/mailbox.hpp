@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEF_ACTOR_MAILBOX_H
+#define DEF_ACTOR_MAILBOX_H
+
+#include <atomic>
+#include <memory>
+
+#include "actor/msg.hpp"
+
+namespace litebus {
+
+// Intrusive lock-free multi-producer/single-consumer mailbox.
+// Producers push onto an atomic stack with one CAS and no allocation, the consumer detaches the whole stack with
+// one exchange (the lock-free counterpart of ActorPolicy::SwapMailbox) and gets the messages back in FIFO order.
+class MpscMailbox {
+public:
+    MpscMailbox() : head(nullptr), pending(0)
+    {
+    }
+
+    ~MpscMailbox()
+    {
+        Release(head.exchange(nullptr));
+    }
+
+    MpscMailbox(const MpscMailbox &) = delete;
+    MpscMailbox &operator=(const MpscMailbox &) = delete;
+
+    // push a message, return true when the mailbox was empty before this push.
+    inline bool Push(std::unique_ptr<MessageBase> &msg)
+    {
+        MessageBase *node = msg.release();
+        MessageBase *old = head.load(std::memory_order_relaxed);
+        do {
+            node->mailboxNext = old;
+        } while (!head.compare_exchange_weak(old, node, std::memory_order_seq_cst, std::memory_order_relaxed));
+        (void)pending.fetch_add(1, std::memory_order_relaxed);
+        return old == nullptr;
+    }
+
+    // detach all the messages, return the oldest one. the others are linked by Next().
+    inline MessageBase *Drain()
+    {
+        MessageBase *node = head.exchange(nullptr, std::memory_order_seq_cst);
+        pending.store(0, std::memory_order_relaxed);
+        MessageBase *fifo = nullptr;
+        while (node != nullptr) {
+            MessageBase *next = node->mailboxNext;
+            node->mailboxNext = fifo;
+            fifo = node;
+            node = next;
+        }
+        return fifo;
+    }
+
+    inline bool Empty() const
+    {
+        return head.load(std::memory_order_seq_cst) == nullptr;
+    }
+
+    // approximate count of messages pushed since the last drain, only used as a statistic.
+    inline int Pending() const
+    {
+        return pending.load(std::memory_order_relaxed);
+    }
+
+    static inline MessageBase *Next(const MessageBase *msg)
+    {
+        return msg->mailboxNext;
+    }
+
+    // free a drained message chain which will not be handled.
+    static inline void Release(MessageBase *msgs)
+    {
+        while (msgs != nullptr) {
+            MessageBase *next = msgs->mailboxNext;
+            delete msgs;
+            msgs = next;
+        }
+    }
+
+private:
+    std::atomic<MessageBase *> head;
+    std::atomic<int> pending;
+};
+
+};    // end of namespace litebus
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "actor/msgnametable.hpp"
+
+#include <functional>
+
+#include "actor/buslog.hpp"
+
+namespace litebus {
+
+namespace {
+constexpr size_t INIT_MSG_NAME_TABLE_CAPACITY = 1024;
+}    // namespace
+
+MsgNameTable &MsgNameTable::GetInstance()
+{
+    static MsgNameTable instance;
+    return instance;
+}
+
+MsgNameTable::Table::Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<const Entry *>[capacity])
+{
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+MsgNameTable::MsgNameTable() : current(nullptr)
+{
+    std::unique_ptr<Table> table(new (std::nothrow) Table(INIT_MSG_NAME_TABLE_CAPACITY));
+    BUS_OOM_EXIT(table);
+    current.store(table.get());
+    tables.push_back(std::move(table));
+}
+
+void MsgNameTable::Insert(const Table &table, const Entry *entry)
+{
+    size_t index = entry->hash & table.mask;
+    while (table.slots[index].load(std::memory_order_relaxed) != nullptr) {
+        index = (index + 1) & table.mask;
+    }
+    table.slots[index].store(entry, std::memory_order_release);
+}
+
+uint32_t MsgNameTable::Find(const std::string &name) const
+{
+    const Table *table = current.load(std::memory_order_acquire);
+    size_t hash = std::hash<std::string>()(name);
+    for (size_t index = hash & table->mask;; index = (index + 1) & table->mask) {
+        const Entry *entry = table->slots[index].load(std::memory_order_acquire);
+        if (entry == nullptr) {
+            return INVALID_MSG_NAME_ID;
+        }
+        if (entry->hash == hash && entry->name == name) {
+            return entry->id;
+        }
+    }
+}
+
+uint32_t MsgNameTable::Intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t id = Find(name);
+    if (id != INVALID_MSG_NAME_ID) {
+        return id;
+    }
+
+    std::unique_ptr<Entry> entry(new (std::nothrow)
+                                     Entry{ std::hash<std::string>()(name), name, static_cast<uint32_t>(entries.size()) });
+    BUS_OOM_EXIT(entry);
+    const Table *table = current.load(std::memory_order_relaxed);
+    // keep the load factor under 1/2 so that the probe sequences stay short
+    if ((entries.size() + 1) * 2 > table->mask + 1) {
+        std::unique_ptr<Table> grown(new (std::nothrow) Table((table->mask + 1) * 2));
+        BUS_OOM_EXIT(grown);
+        for (const auto &old : entries) {
+            Insert(*grown, old.get());
+        }
+        table = grown.get();
+        tables.push_back(std::move(grown));
+        current.store(table, std::memory_order_release);
+    }
+    Insert(*table, entry.get());
+    id = entry->id;
+    entries.push_back(std::move(entry));
+    return id;
+}
+
+};    // end of namespace litebus
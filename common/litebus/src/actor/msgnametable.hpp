@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEF_ACTOR_MSG_NAME_TABLE_H
+#define DEF_ACTOR_MSG_NAME_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace litebus {
+
+constexpr uint32_t INVALID_MSG_NAME_ID = UINT32_MAX;
+
+// Process wide table which interns the message names registered by ActorBase::Receive into dense integer ids.
+// Names are never removed. Lookups are lock-free: the hash table is only appended to under the mutex, and a grown
+// table is published with one atomic store while the old one is kept alive for the readers still probing it.
+class MsgNameTable {
+public:
+    static MsgNameTable &GetInstance();
+
+    MsgNameTable();
+    ~MsgNameTable() = default;
+
+    MsgNameTable(const MsgNameTable &) = delete;
+    MsgNameTable &operator=(const MsgNameTable &) = delete;
+
+    // return the id of the name, assign a new one for an unknown name.
+    uint32_t Intern(const std::string &name);
+
+    // return the id of the name or INVALID_MSG_NAME_ID if the name is not interned.
+    uint32_t Find(const std::string &name) const;
+
+private:
+    struct Entry {
+        size_t hash;
+        std::string name;
+        uint32_t id;
+    };
+
+    struct Table {
+        explicit Table(size_t capacity);
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry *>[]> slots;
+    };
+
+    static void Insert(const Table &table, const Entry *entry);
+
+    std::atomic<const Table *> current;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::vector<std::unique_ptr<Table>> tables;
+};
+
+};    // end of namespace litebus
+#endif
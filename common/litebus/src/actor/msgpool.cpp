@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "actor/msgpool.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace litebus {
+
+namespace {
+// every block starts with a header keeping its size class, so that operator delete does not need the size
+constexpr size_t BLOCK_HEADER_SIZE = alignof(std::max_align_t);
+constexpr size_t LARGE_SIZE_CLASS = MsgPool::SIZE_CLASS_NUM;
+
+std::atomic<uint64_t> g_msgAllocs(0);
+std::atomic<uint64_t> g_heapAllocs(0);
+std::atomic<uint64_t> g_heapFrees(0);
+
+struct ThreadCache {
+    MsgPool::FreeBlock *lists[MsgPool::SIZE_CLASS_NUM] = {};
+    uint32_t counts[MsgPool::SIZE_CLASS_NUM] = {};
+    uint64_t allocs = 0;
+    ~ThreadCache();
+};
+
+thread_local ThreadCache t_cache;
+// messages may be freed by the destructors of other thread_local objects after the cache is gone
+thread_local bool t_cacheDestroyed = false;
+
+// flush the thread local message count every so many allocations to keep the shared counter off the fast path
+constexpr uint64_t ALLOC_COUNT_FLUSH = 64;
+
+ThreadCache::~ThreadCache()
+{
+    t_cacheDestroyed = true;
+    (void)g_msgAllocs.fetch_add(allocs, std::memory_order_relaxed);
+    for (size_t sizeClass = 0; sizeClass < MsgPool::SIZE_CLASS_NUM; ++sizeClass) {
+        MsgPool::FreeBlock *block = lists[sizeClass];
+        while (block != nullptr) {
+            MsgPool::FreeBlock *next = block->next;
+            MsgPool::HeapFree(block);
+            block = next;
+        }
+        lists[sizeClass] = nullptr;
+    }
+}
+
+inline size_t BlockSize(size_t sizeClass)
+{
+    return BLOCK_HEADER_SIZE + (sizeClass + 1) * MsgPool::SIZE_CLASS_STEP;
+}
+
+inline void *ToUser(void *block, size_t sizeClass)
+{
+    *static_cast<size_t *>(block) = sizeClass;
+    return static_cast<char *>(block) + BLOCK_HEADER_SIZE;
+}
+}    // namespace
+
+MsgPool &MsgPool::GetInstance()
+{
+    static MsgPool *instance = new MsgPool();    // never destroyed, messages may be freed during exit
+    return *instance;
+}
+
+MsgPool::MsgPool() : enabled(true)
+{
+    char *env = getenv("LITEBUS_MSG_POOL");
+    if (env != nullptr && std::string(env) == "false") {
+        enabled = false;
+    }
+}
+
+void *MsgPool::HeapAllocate(size_t blockSize)
+{
+    (void)g_heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(blockSize, std::nothrow);
+}
+
+void MsgPool::HeapFree(void *block)
+{
+    (void)g_heapFrees.fetch_add(1, std::memory_order_relaxed);
+    ::operator delete(block);
+}
+
+void *MsgPool::Allocate(size_t size)
+{
+    if (!t_cacheDestroyed && ++t_cache.allocs == ALLOC_COUNT_FLUSH) {
+        (void)g_msgAllocs.fetch_add(ALLOC_COUNT_FLUSH, std::memory_order_relaxed);
+        t_cache.allocs = 0;
+    }
+    size_t sizeClass = size == 0 ? 0 : (size - 1) / SIZE_CLASS_STEP;
+    if (!enabled || sizeClass >= SIZE_CLASS_NUM) {
+        void *block = HeapAllocate(BLOCK_HEADER_SIZE + size);
+        return block == nullptr ? nullptr : ToUser(block, LARGE_SIZE_CLASS);
+    }
+    if (t_cacheDestroyed) {
+        void *block = HeapAllocate(BlockSize(sizeClass));
+        return block == nullptr ? nullptr : ToUser(block, sizeClass);
+    }
+
+    FreeBlock *block = t_cache.lists[sizeClass];
+    if (block == nullptr) {
+        block = GetBatch(sizeClass);
+        t_cache.counts[sizeClass] = block == nullptr ? 0 : BATCH_SIZE;
+    }
+    if (block == nullptr) {
+        void *newBlock = HeapAllocate(BlockSize(sizeClass));
+        return newBlock == nullptr ? nullptr : ToUser(newBlock, sizeClass);
+    }
+    t_cache.lists[sizeClass] = block->next;
+    --t_cache.counts[sizeClass];
+    return ToUser(block, sizeClass);
+}
+
+void MsgPool::Free(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    void *raw = static_cast<char *>(ptr) - BLOCK_HEADER_SIZE;
+    size_t sizeClass = *static_cast<size_t *>(raw);
+    if (sizeClass >= SIZE_CLASS_NUM || t_cacheDestroyed) {
+        HeapFree(raw);
+        return;
+    }
+
+    FreeBlock *block = static_cast<FreeBlock *>(raw);
+    block->next = t_cache.lists[sizeClass];
+    t_cache.lists[sizeClass] = block;
+    if (++t_cache.counts[sizeClass] < BATCH_SIZE * 2) {
+        return;
+    }
+
+    // keep one batch for the coming allocations and hand the other one over
+    FreeBlock *batch = t_cache.lists[sizeClass];
+    FreeBlock *last = batch;
+    for (uint32_t i = 1; i < BATCH_SIZE; ++i) {
+        last = last->next;
+    }
+    t_cache.lists[sizeClass] = last->next;
+    t_cache.counts[sizeClass] = BATCH_SIZE;
+    last->next = nullptr;
+    if (!PutBatch(sizeClass, batch)) {
+        while (batch != nullptr) {
+            FreeBlock *next = batch->next;
+            HeapFree(batch);
+            batch = next;
+        }
+    }
+}
+
+bool MsgPool::PutBatch(size_t sizeClass, FreeBlock *batch)
+{
+    Depot &depot = depots[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    if (depot.batches.size() >= MAX_DEPOT_BATCHES) {
+        return false;
+    }
+    depot.batches.push_back(batch);
+    return true;
+}
+
+MsgPool::FreeBlock *MsgPool::GetBatch(size_t sizeClass)
+{
+    Depot &depot = depots[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    if (depot.batches.empty()) {
+        return nullptr;
+    }
+    FreeBlock *batch = depot.batches.back();
+    depot.batches.pop_back();
+    return batch;
+}
+
+MsgAllocStats MsgPool::GetStats() const
+{
+    return MsgAllocStats{ g_msgAllocs.load(std::memory_order_relaxed), g_heapAllocs.load(std::memory_order_relaxed),
+                          g_heapFrees.load(std::memory_order_relaxed) };
+}
+
+void *MessageBase::operator new(std::size_t size)
+{
+    void *ptr = MsgPool::GetInstance().Allocate(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *MessageBase::operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return MsgPool::GetInstance().Allocate(size);
+}
+
+void MessageBase::operator delete(void *ptr) noexcept
+{
+    MsgPool::GetInstance().Free(ptr);
+}
+
+void MessageBase::operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    MsgPool::GetInstance().Free(ptr);
+}
+
+};    // end of namespace litebus
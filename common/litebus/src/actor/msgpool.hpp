@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEF_ACTOR_MSG_POOL_H
+#define DEF_ACTOR_MSG_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "actor/msg.hpp"
+
+namespace litebus {
+
+// Slab allocator behind MessageBase::operator new.
+// Messages are carved from fixed size classes and recycled through a free list per thread, so the common
+// allocate/free pair never reaches malloc. A message is usually freed on the actor thread and allocated on the
+// sender thread, so a thread returns whole batches of free blocks to a global depot once its list grows long,
+// and takes a batch back from the depot when its list runs empty.
+class MsgPool {
+public:
+    static constexpr size_t SIZE_CLASS_STEP = 64;
+    static constexpr size_t SIZE_CLASS_NUM = 16;    // up to 1KB, the larger messages go to the heap directly
+    static constexpr uint32_t BATCH_SIZE = 64;
+    static constexpr size_t MAX_DEPOT_BATCHES = 256;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    static MsgPool &GetInstance();
+
+    void *Allocate(size_t size);
+    void Free(void *ptr);
+    MsgAllocStats GetStats() const;
+
+    // give a batch of free blocks to the depot, return false if the depot is full
+    bool PutBatch(size_t sizeClass, FreeBlock *batch);
+    FreeBlock *GetBatch(size_t sizeClass);
+
+    static void *HeapAllocate(size_t blockSize);
+    static void HeapFree(void *block);
+
+private:
+    MsgPool();
+    ~MsgPool() = default;
+
+    struct alignas(64) Depot {
+        std::mutex mutex;
+        std::vector<FreeBlock *> batches;
+    };
+
+    bool enabled;
+    Depot depots[SIZE_CLASS_NUM];
+};
+
+};    // end of namespace litebus
+#endif
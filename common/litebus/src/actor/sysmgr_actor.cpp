@@ -46,7 +46,7 @@ void MetricsMessage::PrintMetrics()
         stringTypeMetrics.pop();
     }
 
-    BUSLOG_DEBUG("[format:fd-err-sum-size|to-okmsg-failmsg][value:{}]", out.str());
+    BUSLOG_DEBUG("[format:fd-err-sum-size-bytesPerSyscall|to-okmsg-failmsg][value:{}]", out.str());
 }
 
 void SysMgrActor::SendMetricsDurationCallback()
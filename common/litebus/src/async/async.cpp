@@ -46,4 +46,9 @@ void Async(const AID &aid, std::unique_ptr<std::function<void(ActorBase *)>> han
     (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
 }
 
+void Async(const AID &aid, std::unique_ptr<MessageBase> msg)
+{
+    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+}
+
 }    // namespace litebus
@@ -33,12 +33,44 @@
 
 namespace litebus {
 
+namespace {
+
+// user data of an io_uring request: op in the top 2 bits, token in the next 30, fd in the low 32
+enum UringOp : uint64_t { URING_OP_POLL = 0, URING_OP_RECV = 1, URING_OP_CTRL = 2 };
+constexpr uint32_t URING_TOKEN_MASK = 0x3FFFFFFF;
+constexpr int URING_OP_SHIFT = 62;
+constexpr int URING_TOKEN_SHIFT = 32;
+constexpr uint32_t URING_POLL_EVENTS = static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLOUT) |
+                                       static_cast<uint32_t>(EPOLLERR) | static_cast<uint32_t>(EPOLLHUP) |
+                                       static_cast<uint32_t>(EPOLLRDHUP) | static_cast<uint32_t>(EPOLLPRI);
+constexpr size_t STASH_COMPACT_SIZE = 64 * 1024;
+
+uint64_t UringUserData(UringOp op, uint32_t token, int fd)
+{
+    return (static_cast<uint64_t>(op) << URING_OP_SHIFT) |
+           (static_cast<uint64_t>(token & URING_TOKEN_MASK) << URING_TOKEN_SHIFT) | static_cast<uint32_t>(fd);
+}
+
+bool UringRequested()
+{
+    char *env = getenv("LITEBUS_EVLOOP_IO_URING");
+    return env != nullptr && std::string(env) == "true";
+}
+
+}    // namespace
+
 int EventLoopRun(EvLoop *evloop, int timeout)
 {
     int nevent = 0;
     struct epoll_event *events = nullptr;
 
+    evloop->loopThreadId = pthread_self();
     (void)sem_post(&evloop->semId);
+    if (evloop->uring != nullptr) {
+        int ret = evloop->UringLoopRun();
+        evloop->loopThreadId = 0;
+        return ret;
+    }
 
     size_t size = sizeof(struct epoll_event) * EPOLL_EVENTS_SIZE;
     events = (struct epoll_event *)malloc(size);
@@ -61,6 +93,7 @@ int EventLoopRun(EvLoop *evloop, int timeout)
             if (errno != EINTR) {
                 BUSLOG_ERROR("epoll_wait failed, epoll_fd:{},errno:{}", evloop->efd, errno);
                 free(events);
+                evloop->loopThreadId = 0;
                 return BUS_ERROR;
             } else {
                 continue;
@@ -79,6 +112,7 @@ int EventLoopRun(EvLoop *evloop, int timeout)
         }
     }
     evloop->stopLoop = 0;
+    evloop->loopThreadId = 0;
     BUSLOG_INFO("event epoll loop run end");
     free(events);
     return BUS_OK;
@@ -130,6 +164,11 @@ void EvLoop::CleanUp()
         (void)close(efd);
         efd = -1;
     }
+
+    if (uring != nullptr) {
+        delete uring;
+        uring = nullptr;
+    }
 }
 
 int EvLoop::AddFuncToEvLoop(std::function<void()> &&func)
@@ -246,11 +285,21 @@ int EvLoop::EventLoopCreate(void)
     int retval;
 
     stopLoop = 0;
-    efd = epoll_create(EPOLL_SIZE);
-    if (efd == -1) {
-        BUSLOG_ERROR("epoll_create fail, errno:{}", errno);
-        CleanUp();
-        return BUS_ERROR;
+    if (UringRequested()) {
+        uring = new (std::nothrow) UringPoller();
+        if (uring != nullptr && !uring->Init()) {
+            BUSLOG_WARN("io_uring unavailable, fall back to epoll");
+            delete uring;
+            uring = nullptr;
+        }
+    }
+    if (uring == nullptr) {
+        efd = epoll_create(EPOLL_SIZE);
+        if (efd == -1) {
+            BUSLOG_ERROR("epoll_create fail, errno:{}", errno);
+            CleanUp();
+            return BUS_ERROR;
+        }
     }
 
     // create eventfd
@@ -276,6 +325,10 @@ int EvLoop::EventLoopCreate(void)
 
 int EvLoop::AddFdEvent(int fd, uint32_t tEvents, EventHandler handler, void *data)
 {
+    if (uring != nullptr) {
+        return UringAddFdEvent(fd, tEvents, handler, data);
+    }
+
     struct epoll_event ev;
     EventData *evdata = nullptr;
     int ret;
@@ -284,7 +337,7 @@ int EvLoop::AddFdEvent(int fd, uint32_t tEvents, EventHandler handler, void *dat
     // memset_s will always executes successfully.
     (void)memset_s(&ev, sizeof(ev), 0, sizeof(ev));
 
-    ev.events = tEvents;
+    ev.events = tEvents & ~EVLOOP_RECV_MULTISHOT;
 
     evdata = new (std::nothrow) EventData();
     if (evdata == nullptr) {
@@ -321,6 +374,10 @@ int EvLoop::AddFdEvent(int fd, uint32_t tEvents, EventHandler handler, void *dat
 
 int EvLoop::DelFdEvent(int fd)
 {
+    if (uring != nullptr) {
+        return UringDelFdEvent(fd);
+    }
+
     EventData *tev = nullptr;
     struct epoll_event ev;
     int ret;
@@ -354,6 +411,10 @@ int EvLoop::DelFdEvent(int fd)
 
 int EvLoop::ModifyFdEvent(int fd, uint32_t tEvents)
 {
+    if (uring != nullptr) {
+        return UringModifyFdEvent(fd, tEvents);
+    }
+
     struct epoll_event ev;
     EventData *tev = nullptr;
     int ret;
@@ -368,7 +429,7 @@ int EvLoop::ModifyFdEvent(int fd, uint32_t tEvents)
     // memset_s will always executes successfully.
     (void)memset_s(&ev, sizeof(ev), 0, sizeof(ev));
 
-    ev.events = tEvents;
+    ev.events = tEvents & ~EVLOOP_RECV_MULTISHOT;
     ev.data.ptr = tev;
 
     BUSLOG_DEBUG("epoll modify, fd:{},events:{}", fd, tEvents);
@@ -488,6 +549,19 @@ void EvLoop::StopEventLoop()
 
 void EvLoop::EventLoopDestroy()
 {
+    if (uring != nullptr) {
+        if (queueEventfd > 0) {
+            (void)DelFdEvent(queueEventfd);
+            (void)close(queueEventfd);
+            queueEventfd = -1;
+        }
+        UringReleaseDetached();
+        EventFreeDelEvents();
+        delete uring;
+        uring = nullptr;
+        return;
+    }
+
     /* free deleted event handlers */
     EventFreeDelEvents();
     if (efd > 0) {
@@ -502,4 +576,389 @@ void EvLoop::EventLoopDestroy()
     }
 }
 
+void EvRecvStash::Consume(size_t len)
+{
+    offset += len;
+    if (offset == data.size()) {
+        data.clear();
+        offset = 0;
+    } else if (offset >= STASH_COMPACT_SIZE && offset * 2 >= data.size()) {
+        (void)data.erase(0, offset);
+        offset = 0;
+    }
+}
+
+bool EvLoop::InLoopThread() const
+{
+    // before the loop runs and after it stops, the caller owns the ring
+    pthread_t owner = loopThreadId.load();
+    return owner == 0 || pthread_equal(owner, pthread_self());
+}
+
+EventData *EvLoop::FindLiveEvent(int fd, uint32_t token)
+{
+    std::lock_guard<std::mutex> lock(eventsLock);
+    EventData *tev = FindEvent(fd);
+    if (tev == nullptr || tev->token != token) {
+        return nullptr;
+    }
+    return tev;
+}
+
+EvRecvStash *EvLoop::FindRecvStash(int fd)
+{
+    if (uring == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(eventsLock);
+    EventData *tev = FindEvent(fd);
+    return tev == nullptr ? nullptr : tev->stash.get();
+}
+
+ssize_t EvLoop::Recv(int fd, void *buf, size_t len, int flags)
+{
+    EvRecvStash *stash = FindRecvStash(fd);
+    if (stash == nullptr) {
+        return recv(fd, buf, len, flags);
+    }
+    if (stash->Size() == 0) {
+        if (stash->err != 0) {
+            errno = stash->err;
+            return -1;
+        }
+        if (stash->eof) {
+            return 0;
+        }
+        errno = EAGAIN;
+        return -1;
+    }
+
+    size_t copyLen = len < stash->Size() ? len : stash->Size();
+    (void)memcpy_s(buf, len, stash->data.data() + stash->offset, copyLen);
+    if ((static_cast<unsigned int>(flags) & static_cast<unsigned int>(MSG_PEEK)) == 0) {
+        stash->Consume(copyLen);
+    }
+    return static_cast<ssize_t>(copyLen);
+}
+
+ssize_t EvLoop::Recvmsg(int fd, struct msghdr *msg, int flags)
+{
+    EvRecvStash *stash = FindRecvStash(fd);
+    if (stash == nullptr) {
+        return recvmsg(fd, msg, flags);
+    }
+    if (stash->Size() == 0) {
+        return Recv(fd, nullptr, 0, flags);
+    }
+
+    size_t copied = 0;
+    for (size_t i = 0; i < msg->msg_iovlen && stash->Size() > 0; ++i) {
+        size_t iovLen = msg->msg_iov[i].iov_len;
+        size_t copyLen = iovLen < stash->Size() ? iovLen : stash->Size();
+        if (copyLen == 0) {
+            continue;
+        }
+        (void)memcpy_s(msg->msg_iov[i].iov_base, iovLen, stash->data.data() + stash->offset, copyLen);
+        stash->Consume(copyLen);
+        copied += copyLen;
+    }
+    return static_cast<ssize_t>(copied);
+}
+
+int EvLoop::UringLoopRun()
+{
+    std::vector<UringCompletion> completions(EPOLL_EVENTS_SIZE);
+
+    while (!stopLoop) {
+        /* free deleted event handlers */
+        EventFreeDelEvents();
+
+        // the re-arms of the last round go out with the wait, a stash left unread polls without blocking
+        if (uring->Submit(uringRedispatch.empty()) < 0) {
+            BUSLOG_ERROR("io_uring enter failed, errno:{}", errno);
+            return BUS_ERROR;
+        }
+        int count = 0;
+        do {
+            count = uring->Reap(completions.data(), EPOLL_EVENTS_SIZE);
+            HandleUringEvents(completions.data(), count);
+        } while (count == EPOLL_EVENTS_SIZE && !stopLoop);
+
+        if (stopLoop) {
+            /* free deleted event handlers */
+            EventFreeDelEvents();
+        }
+    }
+    stopLoop = 0;
+    BUSLOG_INFO("event io_uring loop run end");
+    return BUS_OK;
+}
+
+int EvLoop::UringAddFdEvent(int fd, uint32_t tEvents, EventHandler handler, void *data)
+{
+    if (fd < 0) {
+        BUSLOG_ERROR("io_uring add fail, fd:{}", fd);
+        return BUS_ERROR;
+    }
+    EventData *evdata = new (std::nothrow) EventData();
+    if (evdata == nullptr) {
+        BUSLOG_ERROR("malloc eventData fail, fd:{}", fd);
+        return BUS_ERROR;
+    }
+    evdata->data = data;
+    evdata->handler = handler;
+    evdata->fd = fd;
+    evdata->events = tEvents & ~EVLOOP_RECV_MULTISHOT;
+    evdata->recvMode = (tEvents & EVLOOP_RECV_MULTISHOT) != 0;
+    evdata->token = ++nextToken & URING_TOKEN_MASK;
+
+    eventsLock.lock();
+    if (FindEvent(fd) != nullptr) {
+        eventsLock.unlock();
+        delete evdata;
+        BUSLOG_ERROR("io_uring add already exists, fd:{}", fd);
+        return BUS_ERROR;
+    }
+    (void)events.emplace(fd, evdata);
+    eventsLock.unlock();
+
+    if (InLoopThread()) {
+        UringArm(evdata);
+    } else {
+        uint32_t token = evdata->token;
+        (void)AddFuncToEvLoop([this, fd, token]() {
+            EventData *tev = FindLiveEvent(fd, token);
+            if (tev != nullptr) {
+                UringArm(tev);
+            }
+        });
+    }
+    return BUS_OK;
+}
+
+int EvLoop::UringModifyFdEvent(int fd, uint32_t tEvents)
+{
+    eventsLock.lock();
+    EventData *tev = FindEvent(fd);
+    uint32_t token = tev == nullptr ? 0 : tev->token;
+    eventsLock.unlock();
+    if (tev == nullptr) {
+        BUSLOG_ERROR("event lookup fail, fd:{},events:{}", fd, tEvents);
+        return BUS_ERROR;
+    }
+
+    tEvents &= ~EVLOOP_RECV_MULTISHOT;
+    if (InLoopThread()) {
+        UringRearmPoll(tev, tEvents);
+    } else {
+        (void)AddFuncToEvLoop([this, fd, token, tEvents]() {
+            EventData *liveEvent = FindLiveEvent(fd, token);
+            if (liveEvent != nullptr) {
+                UringRearmPoll(liveEvent, tEvents);
+            }
+        });
+    }
+    return BUS_OK;
+}
+
+int EvLoop::UringDelFdEvent(int fd)
+{
+    eventsLock.lock();
+    EventData *tev = FindEvent(fd);
+    if (tev == nullptr) {
+        eventsLock.unlock();
+        BUSLOG_DEBUG("event search fail, fd:{}", fd);
+        return BUS_ERROR;
+    }
+    (void)events.erase(fd);
+    detachedEvents.push_back(tev);
+    eventsLock.unlock();
+
+    if (InLoopThread()) {
+        UringReleaseDetached();
+    } else {
+        (void)AddFuncToEvLoop([this]() { UringReleaseDetached(); });
+    }
+    return BUS_OK;
+}
+
+void EvLoop::UringReleaseDetached()
+{
+    std::vector<EventData *> detached;
+    eventsLock.lock();
+    detached.swap(detachedEvents);
+    eventsLock.unlock();
+
+    for (auto tev : detached) {
+        if (tev->pollArmed) {
+            (void)uring->PollRemove(UringUserData(URING_OP_POLL, tev->pollToken, tev->fd),
+                                    UringUserData(URING_OP_CTRL, 0, tev->fd));
+            tev->pollArmed = false;
+        }
+        if (tev->recvArmed) {
+            (void)uring->Cancel(UringUserData(URING_OP_RECV, tev->token, tev->fd),
+                                UringUserData(URING_OP_CTRL, 0, tev->fd));
+            tev->recvArmed = false;
+        }
+        // freed before the next wait, like the epoll loop
+        eventsLock.lock();
+        AddDeletedEvents(tev);
+        eventsLock.unlock();
+    }
+}
+
+void EvLoop::UringArm(EventData *tev)
+{
+    if (tev->recvMode && tev->stash == nullptr && uring->EnableRecvBuffers()) {
+        tev->stash.reset(new (std::nothrow) EvRecvStash());
+    }
+    EvRecvStash *stash = tev->stash.get();
+    if (stash != nullptr && !tev->recvArmed && !stash->eof && stash->err == 0 &&
+        stash->Size() < EVLOOP_RECV_STASH_HIGH_WATER) {
+        tev->recvArmed = uring->RecvMultishot(tev->fd, UringUserData(URING_OP_RECV, tev->token, tev->fd));
+        if (!tev->recvArmed) {
+            BUSLOG_ERROR("io_uring arm recv fail, fd:{}", tev->fd);
+        }
+    }
+
+    // the multishot receive reports the input, its end and its errors, the poll only waits for the output then
+    uint32_t pollEvents = tev->events & URING_POLL_EVENTS;
+    if (stash != nullptr) {
+        pollEvents &= ~(static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLHUP) |
+                        static_cast<uint32_t>(EPOLLRDHUP));
+        if ((pollEvents & static_cast<uint32_t>(EPOLLOUT)) == 0) {
+            pollEvents = 0;
+        }
+    }
+    if (!tev->pollArmed && pollEvents != 0) {
+        tev->pollToken = ++nextToken & URING_TOKEN_MASK;
+        tev->pollArmed = uring->PollAdd(tev->fd, pollEvents, UringUserData(URING_OP_POLL, tev->pollToken, tev->fd));
+        if (!tev->pollArmed) {
+            BUSLOG_ERROR("io_uring arm poll fail, fd:{},events:{}", tev->fd, pollEvents);
+        }
+    }
+}
+
+void EvLoop::UringRearmPoll(EventData *tev, uint32_t tEvents)
+{
+    if (tev->events == tEvents) {
+        return;
+    }
+    tev->events = tEvents;
+    if (tev->pollArmed) {
+        (void)uring->PollRemove(UringUserData(URING_OP_POLL, tev->pollToken, tev->fd),
+                                UringUserData(URING_OP_CTRL, 0, tev->fd));
+        tev->pollArmed = false;
+    }
+    UringArm(tev);
+}
+
+void EvLoop::UringMarkReady(EventData *tev, uint32_t tEvents)
+{
+    tev->readyEvents |= tEvents;
+    if (!tev->ready) {
+        tev->ready = true;
+        uringReady.push_back(tev);
+    }
+}
+
+void EvLoop::UringOnRecv(EventData *tev, const UringCompletion &completion, const char *buf)
+{
+    EvRecvStash *stash = tev->stash.get();
+    if ((completion.flags & IORING_CQE_F_MORE) == 0) {
+        tev->recvArmed = false;
+        tev->recvPaused = false;
+    }
+    if (completion.res > 0 && buf != nullptr) {
+        (void)stash->data.append(buf, static_cast<size_t>(completion.res));
+        UringMarkReady(tev, static_cast<uint32_t>(EPOLLIN));
+        // a handler slower than the peer stops taking from the socket, UringArm resumes once it reads the stash down
+        if (tev->recvArmed && !tev->recvPaused && stash->Size() >= EVLOOP_RECV_STASH_HIGH_WATER) {
+            tev->recvPaused = uring->Cancel(UringUserData(URING_OP_RECV, tev->token, tev->fd),
+                                            UringUserData(URING_OP_CTRL, 0, tev->fd));
+        }
+    } else if (completion.res == 0) {
+        stash->eof = true;
+        UringMarkReady(tev, static_cast<uint32_t>(EPOLLIN) | (tev->events & static_cast<uint32_t>(EPOLLRDHUP)));
+    } else if (completion.res == -ENOBUFS || completion.res == -ECANCELED) {
+        // the buffers are back in the ring after this round, the receive is armed again
+        UringMarkReady(tev, 0);
+    } else if (completion.res < 0) {
+        stash->err = -completion.res;
+        UringMarkReady(tev, static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLERR));
+    }
+}
+
+void EvLoop::HandleUringEvents(const UringCompletion *completions, int count)
+{
+    for (const auto &item : uringRedispatch) {
+        EventData *tev = FindLiveEvent(item.first, item.second);
+        if (tev != nullptr) {
+            UringMarkReady(tev, static_cast<uint32_t>(EPOLLIN));
+        }
+    }
+    uringRedispatch.clear();
+
+    for (int i = 0; i < count; i++) {
+        const UringCompletion &completion = completions[i];
+        uint64_t op = completion.userData >> URING_OP_SHIFT;
+        if (op == URING_OP_CTRL) {
+            continue;
+        }
+        int fd = static_cast<int>(static_cast<uint32_t>(completion.userData));
+        uint32_t token = static_cast<uint32_t>(completion.userData >> URING_TOKEN_SHIFT) & URING_TOKEN_MASK;
+        uint16_t bufferId = 0;
+        const char *buf = uring->GetRecvBuffer(completion.flags, bufferId);
+
+        eventsLock.lock();
+        EventData *tev = FindEvent(fd);
+        eventsLock.unlock();
+        if (op == URING_OP_POLL) {
+            if (tev != nullptr && tev->pollArmed && tev->pollToken == token) {
+                tev->pollArmed = false;
+                if (completion.res > 0) {
+                    UringMarkReady(tev, static_cast<uint32_t>(completion.res));
+                } else if (completion.res < 0 && completion.res != -ECANCELED) {
+                    BUSLOG_ERROR("io_uring poll fail, fd:{},res:{}", fd, completion.res);
+                    UringMarkReady(tev, static_cast<uint32_t>(EPOLLERR) | static_cast<uint32_t>(EPOLLHUP));
+                } else {
+                    UringMarkReady(tev, 0);
+                }
+            }
+        } else if (tev != nullptr && tev->token == token && tev->stash != nullptr) {
+            UringOnRecv(tev, completion, buf);
+        }
+        if (buf != nullptr) {
+            uring->RecycleRecvBuffer(bufferId);
+        }
+    }
+
+    // handlers never mark events ready, the list is stable while they run
+    for (auto tev : uringReady) {
+        tev->ready = false;
+        uint32_t tEvents = tev->readyEvents;
+        tev->readyEvents = 0;
+        if (FindDeletedEvent(tev) || FindLiveEvent(tev->fd, tev->token) != tev) {
+            continue;
+        }
+        EvRecvStash *stash = tev->stash.get();
+        size_t unread = stash == nullptr ? 0 : stash->Size();
+        if (unread > 0) {
+            tEvents |= static_cast<uint32_t>(EPOLLIN);
+        }
+        if (tEvents != 0) {
+            tev->handler(tev->fd, tEvents, tev->data);
+        }
+        if (FindDeletedEvent(tev) || FindLiveEvent(tev->fd, tev->token) != tev) {
+            continue;
+        }
+        // the handler reads a bounded count of messages, come back for the rest like a level triggered epoll
+        if (stash != nullptr && stash->Size() > 0 && stash->Size() < unread) {
+            uringRedispatch.emplace_back(tev->fd, tev->token);
+        }
+        UringArm(tev);
+    }
+    uringReady.clear();
+}
+
 }    // namespace litebus
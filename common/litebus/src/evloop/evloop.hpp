@@ -18,13 +18,20 @@
 #define __LITEBUS_EVLOOP_H__
 
 #include <sys/epoll.h>
+#include <sys/socket.h>
+#include <atomic>
 #include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 #include <sys/eventfd.h>
 #include <semaphore.h>
+#include "evloop/uring_poller.hpp"
 #include "timer/duration.hpp"
 
 namespace litebus {
@@ -39,12 +46,50 @@ constexpr auto EPOLL_SIZE = 4096;
  */
 constexpr auto EPOLL_EVENTS_SIZE = 64;
 
+/*
+ * AddFdEvent flag of a stream socket, the io_uring loop receives into the loop and the handler reads by EvLoop::Recv
+ */
+constexpr uint32_t EVLOOP_RECV_MULTISHOT = 1U << 27;
+
+/*
+ * unread bytes of a stash above which the multishot receive is cancelled, the socket buffer and the peer's window hold
+ * the rest until the handler reads the stash below it and the receive is armed again
+ */
+constexpr size_t EVLOOP_RECV_STASH_HIGH_WATER = 4 * 1024 * 1024;
+
 using EventHandler = void (*)(int fd, uint32_t events, void *data);
 
+// bytes the multishot receive took from the socket, not read by the handler yet
+struct EvRecvStash {
+    std::string data;
+    size_t offset = 0;
+    int err = 0;
+    bool eof = false;
+
+    size_t Size() const
+    {
+        return data.size() - offset;
+    }
+    void Consume(size_t len);
+};
+
 struct EventData {
     EventHandler handler;
     void *data;
     int fd;
+
+    // the fields below are used by the io_uring loop only, and only on its thread
+    uint32_t events = 0;
+    uint32_t token = 0;
+    uint32_t pollToken = 0;
+    uint32_t readyEvents = 0;
+    bool recvMode = false;
+    bool pollArmed = false;
+    bool recvArmed = false;
+    // the armed receive is cancelled for a full stash, its last completion is pending
+    bool recvPaused = false;
+    bool ready = false;
+    std::unique_ptr<EvRecvStash> stash;
 };
 
 class EvLoop {
@@ -62,6 +107,14 @@ public:
     int DelFdEvent(int fd);
     void Finish();
 
+    // recv/recvmsg of the handlers, they read what the io_uring loop received for the fd first
+    ssize_t Recv(int fd, void *buf, size_t len, int flags);
+    ssize_t Recvmsg(int fd, struct msghdr *msg, int flags);
+    bool IsUring() const
+    {
+        return uring != nullptr;
+    }
+
     ~EvLoop();
 
     int EventLoopCreate();
@@ -80,6 +133,20 @@ public:
     void AddEvent(EventData *eventData);
     void CleanUp();
 
+    bool InLoopThread() const;
+    int UringLoopRun();
+    int UringAddFdEvent(int fd, uint32_t events, EventHandler handler, void *data);
+    int UringModifyFdEvent(int fd, uint32_t events);
+    int UringDelFdEvent(int fd);
+    void UringArm(EventData *tev);
+    void UringRearmPoll(EventData *tev, uint32_t events);
+    void UringReleaseDetached();
+    void UringMarkReady(EventData *tev, uint32_t events);
+    void UringOnRecv(EventData *tev, const UringCompletion &completion, const char *buf);
+    void HandleUringEvents(const UringCompletion *completions, int count);
+    EventData *FindLiveEvent(int fd, uint32_t token);
+    EvRecvStash *FindRecvStash(int fd);
+
     int efd = -1;
     int stopLoop = 0;
     std::mutex loopMutex;
@@ -96,6 +163,16 @@ public:
     // Just to be safe, let's use a list to preserve deleted events rather than a map. Because the caller may
     // delete events on the same fd twice in once epoll_wait
     std::map<int, std::list<EventData *>> deletedEvents;
+
+    // io_uring backend, null when the loop runs on epoll
+    UringPoller *uring = nullptr;
+    std::atomic<pthread_t> loopThreadId{ 0 };
+    std::atomic<uint32_t> nextToken{ 0 };
+    // removed by other threads, their requests are cancelled on the loop thread
+    std::vector<EventData *> detachedEvents;
+    std::vector<EventData *> uringReady;
+    // fd and token of the stashes the handler stopped reading before the end
+    std::vector<std::pair<int, uint32_t>> uringRedispatch;
 };
 
 }    // namespace litebus
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <securec.h>
+
+#include "actor/buslog.hpp"
+#include "evloop/uring_poller.hpp"
+
+namespace litebus {
+
+#ifdef LITEBUS_IO_URING
+
+namespace {
+
+constexpr uint16_t URING_RECV_BUF_GROUP = 0;
+
+int UringSetup(unsigned entries, struct io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int UringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int UringRegister(int fd, unsigned opcode, void *arg, unsigned nrArgs)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+}    // namespace
+
+UringPoller::~UringPoller()
+{
+    Destroy();
+}
+
+bool UringPoller::IsSupported()
+{
+    static const bool supported = []() {
+        UringPoller poller;
+        return poller.Init();
+    }();
+    return supported;
+}
+
+bool UringPoller::Init()
+{
+    struct io_uring_params params;
+    (void)memset_s(&params, sizeof(params), 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = URING_CQ_ENTRIES;
+
+    ringFd = UringSetup(URING_SQ_ENTRIES, &params);
+    if (ringFd < 0) {
+        BUSLOG_INFO("io_uring setup fail, errno:{}", errno);
+        ringFd = -1;
+        return false;
+    }
+    // the loop relies on the kernel keeping the completions of a full cq ring
+    if ((params.features & IORING_FEAT_NODROP) == 0) {
+        BUSLOG_INFO("io_uring lacks nodrop, features:{}", params.features);
+        Destroy();
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+        cqRingSize = sqRingSize;
+    }
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        BUSLOG_ERROR("io_uring mmap sq ring fail, errno:{}", errno);
+        Destroy();
+        return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cqRing = sqRing;
+    } else {
+        cqRing =
+            mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            BUSLOG_ERROR("io_uring mmap cq ring fail, errno:{}", errno);
+            Destroy();
+            return false;
+        }
+    }
+    sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqesAddr =
+        mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqesAddr == MAP_FAILED) {
+        BUSLOG_ERROR("io_uring mmap sqes fail, errno:{}", errno);
+        Destroy();
+        return false;
+    }
+    sqes = static_cast<struct io_uring_sqe *>(sqesAddr);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sqEntries = params.sq_entries;
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+}
+
+bool UringPoller::EnableRecvBuffers()
+{
+    if (bufRing != nullptr) {
+        return true;
+    }
+    if (recvBuffersTried) {
+        return false;
+    }
+    recvBuffersTried = true;
+
+    bufRingSize = URING_RECV_BUF_COUNT * sizeof(struct io_uring_buf);
+    void *ring = mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        BUSLOG_ERROR("io_uring mmap buffer ring fail, errno:{}", errno);
+        return false;
+    }
+
+    struct io_uring_buf_reg reg;
+    (void)memset_s(&reg, sizeof(reg), 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = URING_RECV_BUF_COUNT;
+    reg.bgid = URING_RECV_BUF_GROUP;
+    if (UringRegister(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+        BUSLOG_INFO("io_uring register buffer ring fail, errno:{}", errno);
+        (void)munmap(ring, bufRingSize);
+        return false;
+    }
+    bufRing = static_cast<struct io_uring_buf_ring *>(ring);
+    recvBuffers.resize(static_cast<size_t>(URING_RECV_BUF_COUNT) * URING_RECV_BUF_SIZE);
+    for (uint16_t i = 0; i < URING_RECV_BUF_COUNT; ++i) {
+        RecycleRecvBuffer(i);
+    }
+    return true;
+}
+
+struct io_uring_sqe *UringPoller::GetSqe()
+{
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+        // the sq ring is full, hand the queued requests to the kernel first
+        (void)Submit(false);
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            return nullptr;
+        }
+    }
+    unsigned index = tail & *sqMask;
+    struct io_uring_sqe *sqe = &sqes[index];
+    (void)memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++toSubmit;
+    return sqe;
+}
+
+bool UringPoller::PollAdd(int fd, uint32_t pollEvents, uint64_t userData)
+{
+    struct io_uring_sqe *sqe = GetSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = pollEvents;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool UringPoller::PollRemove(uint64_t target, uint64_t userData)
+{
+    struct io_uring_sqe *sqe = GetSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool UringPoller::RecvMultishot(int fd, uint64_t userData)
+{
+    struct io_uring_sqe *sqe = GetSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_RECV_BUF_GROUP;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool UringPoller::Cancel(uint64_t target, uint64_t userData)
+{
+    struct io_uring_sqe *sqe = GetSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = userData;
+    return true;
+}
+
+int UringPoller::Submit(bool wait)
+{
+    if (toSubmit == 0 && !wait) {
+        return 0;
+    }
+    unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+    int ret = UringEnter(ringFd, toSubmit, wait ? 1 : 0, flags);
+    if (ret < 0) {
+        // EINTR and a busy cq ring are retried by the next call, the requests stay queued
+        return errno == EINTR || errno == EBUSY || errno == EAGAIN ? 0 : -1;
+    }
+    toSubmit -= (static_cast<unsigned>(ret) < toSubmit) ? static_cast<unsigned>(ret) : toSubmit;
+    return ret;
+}
+
+int UringPoller::Reap(UringCompletion *completions, int max)
+{
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    int count = 0;
+    while (head != tail && count < max) {
+        const struct io_uring_cqe *cqe = &cqes[head & *cqMask];
+        completions[count].userData = cqe->user_data;
+        completions[count].res = cqe->res;
+        completions[count].flags = cqe->flags;
+        ++count;
+        ++head;
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+const char *UringPoller::GetRecvBuffer(uint32_t cqeFlags, uint16_t &bufferId) const
+{
+    if ((cqeFlags & IORING_CQE_F_BUFFER) == 0 || bufRing == nullptr) {
+        return nullptr;
+    }
+    bufferId = static_cast<uint16_t>(cqeFlags >> IORING_CQE_BUFFER_SHIFT);
+    if (bufferId >= URING_RECV_BUF_COUNT) {
+        return nullptr;
+    }
+    return recvBuffers.data() + static_cast<size_t>(bufferId) * URING_RECV_BUF_SIZE;
+}
+
+void UringPoller::RecycleRecvBuffer(uint16_t bufferId)
+{
+    // the tail overlays the resv field of the first entry, only addr, len and bid are written. The entries are
+    // indexed by hand, the empty struct in front of the bufs flex array takes a byte in c++
+    unsigned short tail = bufRing->tail;
+    struct io_uring_buf *buf =
+        reinterpret_cast<struct io_uring_buf *>(bufRing) + (tail & (URING_RECV_BUF_COUNT - 1));
+    buf->addr = reinterpret_cast<uint64_t>(recvBuffers.data() + static_cast<size_t>(bufferId) * URING_RECV_BUF_SIZE);
+    buf->len = URING_RECV_BUF_SIZE;
+    buf->bid = bufferId;
+    __atomic_store_n(&bufRing->tail, static_cast<unsigned short>(tail + 1), __ATOMIC_RELEASE);
+}
+
+void UringPoller::Destroy()
+{
+    if (bufRing != nullptr) {
+        (void)munmap(bufRing, bufRingSize);
+        bufRing = nullptr;
+    }
+    if (sqes != nullptr) {
+        (void)munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRing != nullptr && cqRing != sqRing) {
+        (void)munmap(cqRing, cqRingSize);
+    }
+    cqRing = nullptr;
+    if (sqRing != nullptr) {
+        (void)munmap(sqRing, sqRingSize);
+        sqRing = nullptr;
+    }
+    if (ringFd != -1) {
+        (void)close(ringFd);
+        ringFd = -1;
+    }
+}
+
+#else
+
+UringPoller::~UringPoller()
+{
+}
+
+bool UringPoller::IsSupported()
+{
+    return false;
+}
+
+bool UringPoller::Init()
+{
+    BUSLOG_INFO("io_uring is not built in");
+    return false;
+}
+
+bool UringPoller::EnableRecvBuffers()
+{
+    return false;
+}
+
+bool UringPoller::PollAdd(int, uint32_t, uint64_t)
+{
+    return false;
+}
+
+bool UringPoller::PollRemove(uint64_t, uint64_t)
+{
+    return false;
+}
+
+bool UringPoller::RecvMultishot(int, uint64_t)
+{
+    return false;
+}
+
+bool UringPoller::Cancel(uint64_t, uint64_t)
+{
+    return false;
+}
+
+int UringPoller::Submit(bool)
+{
+    return -1;
+}
+
+int UringPoller::Reap(UringCompletion *, int)
+{
+    return 0;
+}
+
+const char *UringPoller::GetRecvBuffer(uint32_t, uint16_t &) const
+{
+    return nullptr;
+}
+
+void UringPoller::RecycleRecvBuffer(uint16_t)
+{
+}
+
+void UringPoller::Destroy()
+{
+}
+
+#endif
+
+}    // namespace litebus
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LITEBUS_URING_POLLER_H__
+#define __LITEBUS_URING_POLLER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_CQE_F_MORE)
+#define LITEBUS_IO_URING
+#endif
+#endif
+#endif
+
+#ifndef LITEBUS_IO_URING
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+#endif
+
+namespace litebus {
+
+/*
+ * submission and completion queue size of a loop
+ */
+constexpr unsigned int URING_SQ_ENTRIES = 256;
+constexpr unsigned int URING_CQ_ENTRIES = 1024;
+
+/*
+ * provided buffers of the multishot receives, registered once per loop
+ */
+constexpr unsigned int URING_RECV_BUF_COUNT = 64;
+constexpr unsigned int URING_RECV_BUF_SIZE = 32 * 1024;
+
+struct UringCompletion {
+    uint64_t userData;
+    int32_t res;
+    uint32_t flags;
+};
+
+// A thin io_uring wrapper over the raw syscalls, it is driven by the loop thread only.
+class UringPoller {
+public:
+    UringPoller() = default;
+    UringPoller(const UringPoller &) = delete;
+    UringPoller &operator=(const UringPoller &) = delete;
+    ~UringPoller();
+
+    // false when the kernel or the seccomp policy refuses io_uring
+    bool Init();
+    // registers the provided buffer ring on first use, false if the kernel lacks it
+    bool EnableRecvBuffers();
+
+    bool PollAdd(int fd, uint32_t pollEvents, uint64_t userData);
+    bool PollRemove(uint64_t target, uint64_t userData);
+    bool RecvMultishot(int fd, uint64_t userData);
+    bool Cancel(uint64_t target, uint64_t userData);
+
+    // submits the queued requests, blocks for one completion at least when wait is true
+    int Submit(bool wait);
+    // copies out the ready completions, returns the count
+    int Reap(UringCompletion *completions, int max);
+
+    const char *GetRecvBuffer(uint32_t cqeFlags, uint16_t &bufferId) const;
+    void RecycleRecvBuffer(uint16_t bufferId);
+
+    static bool IsSupported();
+
+private:
+    struct io_uring_sqe *GetSqe();
+    void Destroy();
+
+    int ringFd = -1;
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    struct io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqEntries = 0;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    struct io_uring_cqe *cqes = nullptr;
+    unsigned toSubmit = 0;
+
+    struct io_uring_buf_ring *bufRing = nullptr;
+    size_t bufRingSize = 0;
+    std::vector<char> recvBuffers;
+    bool recvBuffersTried = false;
+};
+
+}    // namespace litebus
+
+#endif
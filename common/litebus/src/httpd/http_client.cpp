@@ -83,10 +83,7 @@ void CloseConnection(int conSeq)
         conn->recvMsgBase = nullptr;
     }
 
-    if (conn->sendTotalLen != 0 && conn->sendMsgBase != nullptr) {
-        delete conn->sendMsgBase;
-        conn->sendMsgBase = nullptr;
-    }
+    (void)conn->ReleaseSendBatch();
 
     MessageBase *tmpmsg = nullptr;
     while (!conn->sendQueue.empty()) {
@@ -143,55 +143,55 @@ std::string EncodeHttpMsg(MessageBase *msg)
     return postLine + userAgentLine + fromLine + connectLine + hostLine + authorizationLine + commonEndLine;
 }
 
-// write message to the buffer
-void EvbufMgr::PrepareSendMsg(Connection *conn, MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg)
+static void AddSendIov(Connection *conn, const void *base, size_t len)
 {
-    unsigned int i = 0;
+    // empty parts take no iovec
+    if (len == 0) {
+        return;
+    }
+    struct iovec iov;
+    iov.iov_base = const_cast<void *>(base);
+    iov.iov_len = len;
+    conn->sendIov.push_back(iov);
+}
+
+// frame one message behind the ones already in the batch
+bool EvbufMgr::AddSendFrame(Connection *conn, MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg)
+{
+    if (conn->sendFrames.size() <= conn->sendFrameCount) {
+        conn->sendFrames.emplace_back();
+    }
+    SendFrame &frame = conn->sendFrames[conn->sendFrameCount];
     if (msg->type == MessageBase::Type::KMSG) {
         if (!isHttpKmsg) {
-            conn->sendTo = msg->to;
-            conn->sendFrom = msg->from.Name() + "@" + advertiseUrl;
-            if (msg->name.size() > MAX_KMSG_NAME_LEN || conn->sendTo.size() > MAX_KMSG_TO_LEN
-                || conn->sendFrom.size() > MAX_KMSG_FROM_LEN || msg->body.size() > MAX_KMSG_BODY_LEN
+            frame.to = msg->to;
+            frame.from = msg->from.Name() + "@" + advertiseUrl;
+            if (msg->name.size() > MAX_KMSG_NAME_LEN || frame.to.size() > MAX_KMSG_TO_LEN
+                || frame.from.size() > MAX_KMSG_FROM_LEN || msg->body.size() > MAX_KMSG_BODY_LEN
                 || msg->signature.size() > MAX_KMSG_SIGNATURE_LEN) {
                 BUSLOG_ERROR("Drop invalid send tcp data.");
-                return;
+                return false;
             }
-            conn->sendHeader.nameLen = htonl(static_cast<uint32_t>(msg->name.size()));
-            conn->sendHeader.toLen = htonl(static_cast<uint32_t>(conn->sendTo.size()));
-            conn->sendHeader.fromLen = htonl(static_cast<uint32_t>(conn->sendFrom.size()));
-            conn->sendHeader.signatureLen = htonl(static_cast<uint32_t>(msg->signature.size()));
-            conn->sendHeader.bodyLen = htonl(static_cast<uint32_t>(msg->body.size()));
-
-            conn->sendIov[i].iov_base = &conn->sendHeader;
-            conn->sendIov[i++].iov_len = sizeof(conn->sendHeader);
-
-            conn->sendIov[i].iov_base = const_cast<char *>(msg->name.data());
-            conn->sendIov[i++].iov_len = msg->name.size();
-
-            conn->sendIov[i].iov_base = const_cast<char *>(conn->sendTo.data());
-            conn->sendIov[i++].iov_len = conn->sendTo.size();
-
-            conn->sendIov[i].iov_base = const_cast<char *>(conn->sendFrom.data());
-            conn->sendIov[i++].iov_len = conn->sendFrom.size();
-
-            conn->sendIov[i].iov_base = const_cast<char *>(msg->signature.data());
-            conn->sendIov[i++].iov_len = msg->signature.size();
-
-            conn->sendIov[i].iov_base = const_cast<char *>(msg->body.data());
-            conn->sendIov[i++].iov_len = msg->body.size();
-
-            conn->sendMsg.msg_iov = conn->sendIov;
-            conn->sendMsg.msg_iovlen = i;
-            conn->sendTotalLen = sizeof(conn->sendHeader) + msg->name.size() + conn->sendTo.size()
-                                 + conn->sendFrom.size() + msg->signature.size() + msg->body.size();
-            conn->sendMsgBase = msg;
+            frame.header.nameLen = htonl(static_cast<uint32_t>(msg->name.size()));
+            frame.header.toLen = htonl(static_cast<uint32_t>(frame.to.size()));
+            frame.header.fromLen = htonl(static_cast<uint32_t>(frame.from.size()));
+            frame.header.signatureLen = htonl(static_cast<uint32_t>(msg->signature.size()));
+            frame.header.bodyLen = htonl(static_cast<uint32_t>(msg->body.size()));
+
+            AddSendIov(conn, &frame.header, sizeof(frame.header));
+            AddSendIov(conn, msg->name.data(), msg->name.size());
+            AddSendIov(conn, frame.to.data(), frame.to.size());
+            AddSendIov(conn, frame.from.data(), frame.from.size());
+            AddSendIov(conn, msg->signature.data(), msg->signature.size());
+            AddSendIov(conn, msg->body.data(), msg->body.size());
+
+            frame.len = sizeof(frame.header) + msg->name.size() + frame.to.size() + frame.from.size()
+                        + msg->signature.size() + msg->body.size();
+            frame.msg = msg;
 
             // update metrics
             conn->sendMetrics->UpdateMax(msg->signature.size() + msg->body.size());
             conn->sendMetrics->UpdateName(msg->name);
-
-            return;
         } else {
             if (g_advertiseAddr.empty()) {
                 SetAdvertiseAddr(advertiseUrl);
@@ -201,17 +201,39 @@ void EvbufMgr::PrepareSendMsg(Connection *conn, MessageBase *msg, const std::str
         }
     }
 
-    conn->sendIov[i].iov_base = const_cast<char *>(msg->body.data());
-    conn->sendIov[i++].iov_len = msg->body.size();
+    if (frame.msg == nullptr) {
+        AddSendIov(conn, msg->body.data(), msg->body.size());
+        frame.len = msg->body.size();
+        frame.msg = msg;
 
-    conn->sendMsg.msg_iov = conn->sendIov;
-    conn->sendMsg.msg_iovlen = i;
-    conn->sendTotalLen = msg->body.size();
-    conn->sendMsgBase = msg;
+        // update metrics
+        conn->sendMetrics->UpdateMax(msg->body.size());
+        conn->sendMetrics->UpdateName(msg->name);
+    }
+    conn->sendFrameCount++;
+    conn->sendBatchLen += frame.len;
+    return true;
+}
 
-    // update metrics
-    conn->sendMetrics->UpdateMax(msg->body.size());
-    conn->sendMetrics->UpdateName(msg->name);
+// pack the queued messages into one batch, bounded by the iovecs of a sendmsg and SENDMSG_BATCH_BYTES
+void EvbufMgr::PrepareSendBatch(Connection *conn, const std::string &advertiseUrl, bool isHttpKmsg)
+{
+    (void)conn->ReleaseSendBatch();
+    while (!conn->sendQueue.empty()) {
+        MessageBase *msg = conn->sendQueue.front();
+        size_t iovLen = (msg->type == MessageBase::Type::KMSG && !isHttpKmsg) ? SENDMSG_IOVLEN : 1;
+        if (conn->sendFrameCount > 0 && (conn->sendIov.size() + iovLen > SENDMSG_BATCH_IOVLEN
+                                         || conn->sendBatchLen + msg->body.size() > SENDMSG_BATCH_BYTES)) {
+            break;
+        }
+        conn->sendQueue.pop();
+        if (!AddSendFrame(conn, msg, advertiseUrl, isHttpKmsg)) {
+            delete msg;
+        }
+    }
+    conn->sendTotalLen = conn->sendBatchLen;
+    conn->sendMsg.msg_iov = conn->sendIov.data();
+    conn->sendMsg.msg_iovlen = conn->sendIov.size();
 }
 
 }    // namespace litebus
@@ -25,10 +25,13 @@ namespace litebus {
 
 class EvbufMgr {
 public:
-    static void PrepareSendMsg(Connection *conn, MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg);
+    static void PrepareSendBatch(Connection *conn, const std::string &advertiseUrl, bool isHttpKmsg);
     static void PrepareRecvMsg(Connection *conn);
 
     static void HeaderNtoH(MsgHeader *header);
+
+private:
+    static bool AddSendFrame(Connection *conn, MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg);
 };
 
 };    // namespace litebus
@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <atomic>
+#include <cstring>
+#include <functional>
 #include <mutex>
 #include <queue>
 #include <string>
@@ -48,8 +51,8 @@
 #endif
 
 namespace litebus {
-LinkMgr *LinkMgr::linkMgr = nullptr;
-std::mutex LinkMgr::linkMutex;
+std::atomic<LinkMgr *> LinkMgr::linkMgrs[MAX_LINK_SHARDS] = {};
+std::atomic<size_t> LinkMgr::linkMgrCount(0);
 
 void LinkMgr::SetLinkPattern(bool linkPattern)
 {
@@ -90,10 +93,8 @@ void LinkMgr::CloseConnection(Connection *conn)
         }
     }
 
-    if (conn->sendTotalLen != 0 && conn->sendMsgBase != nullptr) {
-        delete conn->sendMsgBase;
-        freeMsgNum++;
-    }
+    freeMsgNum += conn->sendFrameCount;
+    (void)conn->ReleaseSendBatch();
     freeMsgNum += conn->sendQueue.size();
     MessageBase *tmpmsg = nullptr;
     while (!conn->sendQueue.empty()) {
@@ -432,11 +433,67 @@ LinkMgr::~LinkMgr()
 
 LinkMgr *LinkMgr::GetLinkMgr()
 {
-    return LinkMgr::linkMgr;
+    if (linkMgrCount.load() == 0) {
+        return nullptr;
+    }
+    return linkMgrs[0].load();
+}
+
+LinkMgr *LinkMgr::GetLinkMgr(const std::string &to)
+{
+    size_t count = linkMgrCount.load();
+    if (count == 0) {
+        return nullptr;
+    }
+    return linkMgrs[GetShardIndex(to, count)].load();
 }
+
+LinkMgr *LinkMgr::GetLinkMgrShard(size_t index)
+{
+    if (index >= linkMgrCount.load()) {
+        return nullptr;
+    }
+    return linkMgrs[index].load();
+}
+
+size_t LinkMgr::GetLinkMgrCount()
+{
+    return linkMgrCount.load();
+}
+
 void LinkMgr::SetLinkMgr(LinkMgr *linkmgr)
 {
-    LinkMgr::linkMgr = linkmgr;
+    SetLinkMgrs(std::vector<LinkMgr *>{ linkmgr });
+}
+
+void LinkMgr::SetLinkMgrs(const std::vector<LinkMgr *> &linkmgrs)
+{
+    size_t count = std::min(linkmgrs.size(), MAX_LINK_SHARDS);
+    for (size_t i = 0; i < count; ++i) {
+        linkMgrs[i].store(linkmgrs[i]);
+    }
+    linkMgrCount.store(count);
+}
+
+size_t LinkMgr::GetShardIndex(const std::string &to, size_t shardCount)
+{
+    if (shardCount <= 1) {
+        return 0;
+    }
+    return std::hash<std::string>()(to) % shardCount;
+}
+
+int LinkMgr::GetTotalRemoteLinkCount()
+{
+    int total = 0;
+    size_t count = linkMgrCount.load();
+    for (size_t i = 0; i < count; ++i) {
+        LinkMgr *linkmgr = linkMgrs[i].load();
+        if (linkmgr != nullptr) {
+            total += linkmgr->GetRemoteLinkCount();
+        }
+    }
+    return total;
 }
 
 void ConnectionUtil::SetSocketOperate(Connection *conn)
@@ -544,28 +601,32 @@ int ConnectionUtil::RecvKMsg(Connection *conn, IOMgr::MsgHandler msgHandler)
         return 0;
     }
 
-    if (!conn->recvMsgBase->from.OK() || !conn->recvMsgBase->to.OK()) {
-        BUSLOG_ERROR("from/to is invalid, from:{},to:{}", std::string(conn->recvMsgBase->from),
-                     std::string(conn->recvMsgBase->to));
-        conn->connState = ConnectionState::DISCONNECTING;
+    std::unique_ptr<MessageBase> msg(conn->recvMsgBase);
+    conn->recvMsgBase = nullptr;
+    if (!DeliverKMsg(conn, std::move(msg), msgHandler)) {
         return -1;
     }
+    return 1;
+}
+
+bool ConnectionUtil::DeliverKMsg(Connection *conn, std::unique_ptr<MessageBase> msg, IOMgr::MsgHandler msgHandler)
+{
+    if (!msg->from.OK() || !msg->to.OK()) {
+        BUSLOG_ERROR("from/to is invalid, from:{},to:{}", std::string(msg->from), std::string(msg->to));
+        conn->connState = ConnectionState::DISCONNECTING;
+        return false;
+    }
 
     if (conn->to.empty()) {
         // remote link
-        std::string fromUrl = conn->recvMsgBase->from;
+        std::string fromUrl = msg->from;
         size_t index = fromUrl.find("@");
         if (index != std::string::npos) {
             conn->to = fromUrl.substr(index + 1);
             BUSLOG_INFO("new conn, fd:{},to:{}", conn->fd, conn->to);
-            std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
-            LinkMgr::GetLinkMgr()->SetLinkPriority(conn->to, false, ConnectionPriority::PRI_LOW);
-            conn->connState = ConnectionState::CONNECTED;
-            LinkMgr::GetLinkMgr()->AddLink(conn);
+            MoveToPeerLinkMgr(conn);
         }
     }
-    std::unique_ptr<MessageBase> msg(conn->recvMsgBase);
-    conn->recvMsgBase = nullptr;
 
     // call msg handler if set
     if (msgHandler != nullptr) {
@@ -573,13 +634,150 @@ int ConnectionUtil::RecvKMsg(Connection *conn, IOMgr::MsgHandler msgHandler)
     } else {
         BUSLOG_INFO("mshandler was not found");
     }
+    return true;
+}
 
-    return 1;
+// the bytes the frame at the read position needs, the header alone until it is complete
+size_t ConnectionUtil::PendingFrameLen(Connection *conn)
+{
+    RecvBuffer *buffer = conn->recvBuffer.get();
+    if (buffer->writePos - buffer->readPos < sizeof(MsgHeader)) {
+        return sizeof(MsgHeader);
+    }
+    MsgHeader header;
+    (void)memcpy_s(&header, sizeof(MsgHeader), buffer->data.get() + buffer->readPos, sizeof(MsgHeader));
+    EvbufMgr::HeaderNtoH(&header);
+    // an invalid header is dropped by the parse
+    if (header.nameLen > MAX_KMSG_NAME_LEN || header.toLen > MAX_KMSG_TO_LEN || header.fromLen > MAX_KMSG_FROM_LEN ||
+        header.bodyLen > MAX_KMSG_BODY_LEN || header.signatureLen > MAX_KMSG_SIGNATURE_LEN) {
+        return sizeof(MsgHeader);
+    }
+    return sizeof(MsgHeader) + static_cast<size_t>(header.nameLen) + header.toLen + header.fromLen +
+           header.signatureLen + header.bodyLen;
+}
+
+// reads once into the free space after the buffered bytes, the partial frame moves to the front or to a new buffer
+// when it does not fit, a buffer pinned by slices is never written over
+bool ConnectionUtil::FillRecvBuffer(Connection *conn)
+{
+    if (conn->recvBuffer == nullptr ||
+        (conn->recvBuffer->readPos == conn->recvBuffer->writePos && conn->recvBuffer->capacity > RECV_RING_BUFFER_SIZE)) {
+        conn->recvBuffer = std::make_shared<RecvBuffer>(RECV_RING_BUFFER_SIZE);
+    }
+    RecvBuffer *buffer = conn->recvBuffer.get();
+    size_t buffered = buffer->writePos - buffer->readPos;
+    bool pinned = conn->recvBuffer.use_count() > 1;
+    if (buffered == 0 && !pinned) {
+        buffer->readPos = 0;
+        buffer->writePos = 0;
+    }
+
+    size_t frameLen = PendingFrameLen(conn);
+    if (buffer->readPos + frameLen > buffer->capacity) {
+        if (!pinned && frameLen <= buffer->capacity) {
+            (void)memmove(buffer->data.get(), buffer->data.get() + buffer->readPos, buffered);
+        } else {
+            auto newBuffer = std::make_shared<RecvBuffer>(std::max(frameLen, RECV_RING_BUFFER_SIZE));
+            if (buffered > 0) {
+                (void)memcpy_s(newBuffer->data.get(), newBuffer->capacity, buffer->data.get() + buffer->readPos,
+                               buffered);
+            }
+            conn->recvBuffer = newBuffer;
+            buffer = newBuffer.get();
+        }
+        buffer->readPos = 0;
+        buffer->writePos = buffered;
+    }
+
+    uint32_t recvLen = 0;
+    size_t space = std::min(buffer->capacity - buffer->writePos, static_cast<size_t>(UINT32_MAX));
+    int retval = conn->socketOperate->Recv(conn, buffer->data.get() + buffer->writePos,
+                                           static_cast<uint32_t>(space), recvLen);
+    buffer->writePos += recvLen;
+    if (retval < 0) {
+        conn->connState = ConnectionState::DISCONNECTING;
+        return false;
+    }
+    return true;
+}
+
+// cuts one complete frame off the buffer, the name and the addresses are copied and a large body stays in place
+MessageBase *ConnectionUtil::ParseRingFrame(Connection *conn)
+{
+    RecvBuffer *buffer = conn->recvBuffer.get();
+    size_t buffered = buffer->writePos - buffer->readPos;
+    if (buffered < sizeof(MsgHeader)) {
+        return nullptr;
+    }
+    const char *cur = buffer->data.get() + buffer->readPos;
+    MsgHeader header;
+    (void)memcpy_s(&header, sizeof(MsgHeader), cur, sizeof(MsgHeader));
+    if (strncmp(header.magic, BUS_MAGICID.c_str(), BUS_MAGICID.size()) != 0) {
+        BUSLOG_ERROR("check magicid fail, BUS_MAGICID:{},fd:{}", BUS_MAGICID, conn->fd);
+        conn->connState = ConnectionState::DISCONNECTING;
+        return nullptr;
+    }
+    EvbufMgr::HeaderNtoH(&header);
+    size_t nameLen = static_cast<size_t>(header.nameLen);
+    size_t toLen = static_cast<size_t>(header.toLen);
+    size_t fromLen = static_cast<size_t>(header.fromLen);
+    size_t signatureLen = static_cast<size_t>(header.signatureLen);
+    size_t bodyLen = static_cast<size_t>(header.bodyLen);
+    if (nameLen > MAX_KMSG_NAME_LEN || toLen > MAX_KMSG_TO_LEN || fromLen > MAX_KMSG_FROM_LEN ||
+        bodyLen > MAX_KMSG_BODY_LEN || signatureLen > MAX_KMSG_SIGNATURE_LEN) {
+        BUSLOG_ERROR("Drop invalid tcp data.");
+        conn->connState = ConnectionState::DISCONNECTING;
+        return nullptr;
+    }
+    size_t frameLen = sizeof(MsgHeader) + nameLen + toLen + fromLen + signatureLen + bodyLen;
+    if (buffered < frameLen) {
+        return nullptr;
+    }
+
+    MessageBase *msg = new (std::nothrow) MessageBase();
+    BUS_OOM_EXIT(msg);
+    cur += sizeof(MsgHeader);
+    msg->name.assign(cur, nameLen);
+    cur += nameLen;
+    msg->SetTo(AID(std::string(cur, toLen)));
+    cur += toLen;
+    msg->SetFrom(AID(std::string(cur, fromLen)));
+    cur += fromLen;
+    msg->signature.assign(cur, signatureLen);
+    cur += signatureLen;
+    if (bodyLen >= RECV_SLICE_MIN_LEN) {
+        msg->SetBodySlice(MsgSlice(conn->recvBuffer, cur, bodyLen));
+    } else {
+        msg->body.assign(cur, bodyLen);
+    }
+    buffer->readPos += frameLen;
+
+    BUSLOG_DEBUG("recvmsg, name:{},from:{},to:{}", msg->name, std::string(msg->from), std::string(msg->to));
+    return msg;
+}
+
+// the ring receive mode, one read takes all the frames the socket has and each complete one is delivered
+int ConnectionUtil::RecvKMsgRing(Connection *conn, IOMgr::MsgHandler msgHandler)
+{
+    bool ok = FillRecvBuffer(conn);
+    int count = 0;
+    MessageBase *msg = nullptr;
+    while (conn->connState != ConnectionState::DISCONNECTING && (msg = ParseRingFrame(conn)) != nullptr) {
+        if (!DeliverKMsg(conn, std::unique_ptr<MessageBase>(msg), msgHandler)) {
+            return -1;
+        }
+        ++count;
+    }
+    if (!ok || conn->connState == ConnectionState::DISCONNECTING) {
+        return -1;
+    }
+    return count;
 }
 
 void ConnectionUtil::CheckRecvMsgType(Connection *conn)
 {
-    std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+    std::unique_lock<std::mutex> lock;
+    LinkMgr *linkMgr = LockLinkMgr(conn, lock);
     if (conn->recvMsgType != ParseType::UNKNOWN) {
         return;
     }
@@ -605,7 +803,7 @@ void ConnectionUtil::CheckRecvMsgType(Connection *conn)
     } else {
         conn->recvMsgType = ("HTTP" == magicID) ? ParseType::KHTTP_RSP : ParseType::KHTTP_REQ;
         if (conn->isRemote) {
-            LinkMgr::GetLinkMgr()->AddHttpRemoteLink(conn);
+            linkMgr->AddHttpRemoteLink(conn);
         }
 #endif
     }
@@ -668,12 +866,15 @@ void ConnectionUtil::SocketEventHandler(int fd, uint32_t events, void *context)
 
 int ConnectionUtil::AddSockEventHandler(Connection *conn)
 {
+    uint32_t events = static_cast<unsigned int>(EPOLLIN) | static_cast<unsigned int>(EPOLLHUP) |
+                      static_cast<unsigned int>(EPOLLRDHUP) | static_cast<unsigned int>(EPOLLERR);
+    // plain tcp reads through the loop, an io_uring loop then receives without a syscall per message
+    if (conn->type == ConnectionType::TYPE_TCP) {
+        events |= EVLOOP_RECV_MULTISHOT;
+    }
     /* add to epoll */
-    return conn->recvEvloop->AddFdEvent(conn->fd,
-                                        static_cast<unsigned int>(EPOLLIN) | static_cast<unsigned int>(EPOLLHUP) |
-                                            static_cast<unsigned int>(EPOLLRDHUP) |
-                                            static_cast<unsigned int>(EPOLLERR),
-                                        ConnectionUtil::SocketEventHandler, static_cast<void *>(conn));
+    return conn->recvEvloop->AddFdEvent(conn->fd, events, ConnectionUtil::SocketEventHandler,
+                                        static_cast<void *>(conn));
 }
 
 bool ConnectionUtil::ConnEstablishedDelAdd(Connection *conn, int fd, uint32_t events, int *soError, uint32_t error)
@@ -765,8 +966,56 @@ void ConnectionUtil::NewConnEventHandler(int fd, uint32_t events, void *context)
 
 void ConnectionUtil::CloseConnection(Connection *conn)
 {
-    std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
-    LinkMgr::GetLinkMgr()->CloseConnection(conn);
+    std::unique_lock<std::mutex> lock;
+    LinkMgr *linkMgr = LockLinkMgr(conn, lock);
+    linkMgr->CloseConnection(conn);
+}
+
+LinkMgr *ConnectionUtil::GetLinkMgr(const Connection *conn)
+{
+    LinkMgr *linkMgr = conn->linkMgr.load();
+    if (linkMgr != nullptr) {
+        return linkMgr;
+    }
+    return LinkMgr::GetLinkMgr();
+}
+
+LinkMgr *ConnectionUtil::LockLinkMgr(const Connection *conn, std::unique_lock<std::mutex> &lock)
+{
+    while (true) {
+        LinkMgr *linkMgr = GetLinkMgr(conn);
+        lock = std::unique_lock<std::mutex>(linkMgr->linkMutex);
+        if (GetLinkMgr(conn) == linkMgr) {
+            return linkMgr;
+        }
+        lock.unlock();
+    }
+}
+
+// an accepted connection waits in the first shard until its first message names the peer, then moves to the shard of
+// the peer with the send loop of that shard. It runs on the recv loop of the connection, the only loop handling its fd,
+// and holds the locks of both shards, so a thread locking the connection through LockLinkMgr sees it in one of them.
+void ConnectionUtil::MoveToPeerLinkMgr(Connection *conn)
+{
+    LinkMgr *acceptMgr = GetLinkMgr(conn);
+    LinkMgr *peerMgr = LinkMgr::GetLinkMgr(conn->to);
+    if (peerMgr == nullptr || peerMgr == acceptMgr) {
+        std::lock_guard<std::mutex> lock(acceptMgr->linkMutex);
+        acceptMgr->SetLinkPriority(conn->to, false, ConnectionPriority::PRI_LOW);
+        conn->connState = ConnectionState::CONNECTED;
+        acceptMgr->AddLink(conn);
+        return;
+    }
+    std::scoped_lock lock(acceptMgr->linkMutex, peerMgr->linkMutex);
+    acceptMgr->DelRemoteLink(conn);
+    conn->linkMgr.store(peerMgr);
+    if (peerMgr->sendEvloop != nullptr) {
+        conn->sendEvloop = peerMgr->sendEvloop;
+    }
+    peerMgr->AddRemoteLink(conn);
+    peerMgr->SetLinkPriority(conn->to, false, ConnectionPriority::PRI_LOW);
+    conn->connState = ConnectionState::CONNECTED;
+    peerMgr->AddLink(conn);
 }
 
 Connection::Connection()
@@ -782,7 +1031,6 @@ Connection::Connection()
       priority(ConnectionPriority::PRI_HIGH)
 {
     InitMsgHeader(recvHeader);
-    InitMsgHeader(sendHeader);
     recvMsg.msg_control = nullptr;
     recvMsg.msg_controllen = 0;
     recvMsg.msg_flags = 0;
@@ -797,20 +1045,63 @@ Connection::Connection()
     sendMsg.msg_flags = 0;
     sendMsg.msg_name = nullptr;
     sendMsg.msg_namelen = 0;
-    sendMsg.msg_iov = sendIov;
-    sendMsg.msg_iovlen = SENDMSG_IOVLEN;
+    sendMsg.msg_iov = nullptr;
+    sendMsg.msg_iovlen = 0;
 }
+
+uint64_t Connection::ReleaseSendBatch()
+{
+    uint64_t bodySize = 0;
+    for (size_t i = 0; i < sendFrameCount; ++i) {
+        SendFrame &frame = sendFrames[i];
+        if (frame.msg != nullptr) {
+            bodySize += frame.msg->body.size();
+            delete frame.msg;
+            frame.msg = nullptr;
+        }
+    }
+    sendFrameCount = 0;
+    sendBatchLen = 0;
+    sendTotalLen = 0;
+    sendIov.clear();
+    sendMsg.msg_iov = nullptr;
+    sendMsg.msg_iovlen = 0;
+    return bodySize;
+}
+
+void Connection::RequeueSendBatch()
+{
+    uint32_t written = sendBatchLen - sendTotalLen;
+    uint32_t offset = 0;
+    std::queue<MessageBase *> pending;
+    for (size_t i = 0; i < sendFrameCount; ++i) {
+        SendFrame &frame = sendFrames[i];
+        // a frame cut in the middle can't be resumed on another socket
+        if (offset >= written && frame.msg != nullptr) {
+            pending.push(frame.msg);
+            frame.msg = nullptr;
+        }
+        offset += frame.len;
+    }
+    (void)ReleaseSendBatch();
+    while (!sendQueue.empty()) {
+        pending.push(sendQueue.front());
+        sendQueue.pop();
+    }
+    sendQueue.swap(pending);
+}
+
 Connection::~Connection()
 {
     if (recvEvloop != nullptr) {
         recvEvloop = nullptr;
     }
+    if (linkMgr != nullptr) {
+        linkMgr = nullptr;
+    }
     if (socketOperate != nullptr) {
         socketOperate = nullptr;
     }
-    if (sendMsgBase != nullptr) {
-        sendMsgBase = nullptr;
-    }
     if (sendMetrics != nullptr) {
         sendMetrics = nullptr;
     }
@@ -21,10 +21,16 @@
 #include "openssl/ssl.h"
 #endif
 
+#include <atomic>
+#include <climits>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <sys/socket.h>
 
@@ -40,17 +46,33 @@ namespace http {
 class HttpParser;
 }
 
+class LinkMgr;
+
 using LinkerCallBack = void (*)(const std::string &from, const std::string &to);
 
 using ConnectionCallBack = void (*)(void *conn);
 
 constexpr int SENDMSG_IOVLEN = 6;
+// iovecs and bytes packed into one sendmsg, a single message may exceed the bytes
+#ifdef IOV_MAX
+constexpr size_t SENDMSG_BATCH_IOVLEN = IOV_MAX;
+#else
+constexpr size_t SENDMSG_BATCH_IOVLEN = 1024;
+#endif
+constexpr uint32_t SENDMSG_BATCH_BYTES = 256 * 1024;
 constexpr int RECVMSG_IOVLEN = 5;
+// the receive buffer of the ring mode, a larger frame gets a buffer of its own size
+constexpr size_t RECV_RING_BUFFER_SIZE = 256 * 1024;
+// smaller bodies are copied out of the receive buffer, the larger ones are handed over as slices of it
+constexpr size_t RECV_SLICE_MIN_LEN = 4 * 1024;
 
 constexpr unsigned int BUSMAGIC_LEN = 4;
 constexpr int SENDMSG_QUEUELEN = 1024;
 constexpr int SENDMSG_DROPED = -1;
 
+// at most one link table per tcp send loop
+constexpr size_t MAX_LINK_SHARDS = 16;
+
 constexpr size_t MAX_KMSG_FROM_LEN = 1024;
 constexpr size_t MAX_KMSG_TO_LEN = 1024;
 constexpr size_t MAX_KMSG_NAME_LEN = 1024;
@@ -89,7 +111,14 @@ inline void InitMsgHeader(MsgHeader &msghdr)
 
 struct SendMetrics {
     SendMetrics()
-        : sendSum(0), sendMaxSize(0), errCode(0), lastSucMsgName(""), lastFailMsgName(""), lastSendMsgName("")
+        : sendSum(0),
+          sendMaxSize(0),
+          errCode(0),
+          sendBytes(0),
+          sendCalls(0),
+          lastSucMsgName(""),
+          lastFailMsgName(""),
+          lastSendMsgName("")
     {
     }
 
@@ -106,6 +135,20 @@ struct SendMetrics {
         lastSendMsgName = name;
     }
 
+    void UpdateSyscall(int bytes)
+    {
+        sendBytes += static_cast<uint64_t>(bytes);
+        sendCalls++;
+    }
+
+    int BytesPerSyscall() const
+    {
+        if (sendCalls == 0) {
+            return 0;
+        }
+        return static_cast<int>(sendBytes / sendCalls);
+    }
+
     void UpdateError(bool fail, int err = 0)
     {
         if (fail) {
@@ -121,6 +164,8 @@ struct SendMetrics {
         sendSum = 0;
         sendMaxSize = 0;
         errCode = 0;
+        sendBytes = 0;
+        sendCalls = 0;
         lastSucMsgName = "";
         lastFailMsgName = "";
         lastSendMsgName = "";
@@ -129,11 +174,40 @@ struct SendMetrics {
     int sendSum;
     int sendMaxSize;
     int errCode;
+    // bytes and successful sendmsg calls, their ratio shows how well the sends are batched
+    uint64_t sendBytes;
+    uint64_t sendCalls;
     std::string lastSucMsgName;
     std::string lastFailMsgName;
     std::string lastSendMsgName;
 };
 
+// a queued message framed into the batch in flight, the iovecs point into it
+struct SendFrame {
+    SendFrame()
+    {
+        InitMsgHeader(header);
+    }
+
+    MsgHeader header;
+    std::string to;
+    std::string from;
+    uint32_t len = 0;
+    MessageBase *msg = nullptr;
+};
+
+// the bytes read ahead of the frames parsed so far, the body slices of the delivered messages share it
+struct RecvBuffer {
+    explicit RecvBuffer(size_t size) : data(new char[size]), capacity(size)
+    {
+    }
+
+    std::unique_ptr<char[]> data;
+    size_t capacity;
+    size_t readPos = 0;
+    size_t writePos = 0;
+};
+
 class Connection {
 public:
     Connection();
@@ -145,6 +219,11 @@ public:
         return !(that != nullptr && that->to == to && that->isRemote == isRemote);
     }
 
+    // frees the messages of the batch in flight, returns their body bytes
+    uint64_t ReleaseSendBatch();
+    // puts the messages not written yet back to the front of the queue, the written ones are freed
+    void RequeueSendBatch();
+
     int fd;
     bool isRemote;
     bool isExited;
@@ -167,22 +246,27 @@ public:
     struct iovec recvIov[RECVMSG_IOVLEN];
     uint32_t recvTotalLen = 0;
     MessageBase *recvMsgBase;
+    // the ring receive mode reads many frames at once into it instead of the fields of recvMsgBase
+    std::shared_ptr<RecvBuffer> recvBuffer;
 
-    std::string sendTo;
-    std::string sendFrom;
-
-    MsgHeader sendHeader;
+    // frames of the batch in flight, a deque keeps them in place while the batch grows
+    std::deque<SendFrame> sendFrames;
+    size_t sendFrameCount = 0;
     struct msghdr sendMsg;
-    struct iovec sendIov[SENDMSG_IOVLEN];
+    std::vector<struct iovec> sendIov;
+    // bytes of the batch in flight, and the bytes left to write
+    uint32_t sendBatchLen = 0;
     uint32_t sendTotalLen = 0;
 
     SendMetrics *sendMetrics = nullptr;
 
-    MessageBase *sendMsgBase = nullptr;
     ParseType recvMsgType;
 
     EvLoop *recvEvloop = nullptr;
     EvLoop *sendEvloop = nullptr;
+    // link table holding the connection, its mutex guards the connection. It changes once, when an accepted
+    // connection moves to the shard of its peer, so lock it through ConnectionUtil::LockLinkMgr.
+    std::atomic<LinkMgr *> linkMgr{ nullptr };
 
     ConnectionCallBack eventCallBack = nullptr;
     ConnectionCallBack succCallBack = nullptr;
@@ -270,13 +354,25 @@ public:
     // each to_url has two fds at most, and each fd has multiple linkinfos
     std::map<int, std::set<LinkerInfo *>> linkers;
 
+    // the first shard, it also holds the accepted connections until their peer is known
     static LinkMgr *GetLinkMgr();
+    // the shard owning the links to the peer url
+    static LinkMgr *GetLinkMgr(const std::string &to);
+    static LinkMgr *GetLinkMgrShard(size_t index);
+    static size_t GetLinkMgrCount();
     static void SetLinkMgr(LinkMgr *linkmgr);
+    static void SetLinkMgrs(const std::vector<LinkMgr *> &linkmgrs);
+    static size_t GetShardIndex(const std::string &to, size_t shardCount);
+    static int GetTotalRemoteLinkCount();
+
+    // the send loop of the shard, an accepted connection takes it when it moves here
+    EvLoop *sendEvloop = nullptr;
 
 private:
     bool doubleLink;
-    static LinkMgr *linkMgr;
-    static std::mutex linkMutex;
+    std::mutex linkMutex;
+    static std::atomic<LinkMgr *> linkMgrs[MAX_LINK_SHARDS];
+    static std::atomic<size_t> linkMgrCount;
     friend class ConnectionUtil;
     friend class IOMgr;
     friend class TCPMgr;
@@ -285,9 +381,15 @@ private:
 class ConnectionUtil {    // recv msg
 public:
     static void CloseConnection(Connection *conn);
+    static LinkMgr *GetLinkMgr(const Connection *conn);
+    // locks the link table holding the connection, the table is loaded again under its lock and the lock is taken
+    // again if the connection moved meanwhile
+    static LinkMgr *LockLinkMgr(const Connection *conn, std::unique_lock<std::mutex> &lock);
+    static void MoveToPeerLinkMgr(Connection *conn);
 
     static void CheckRecvMsgType(Connection *conn);
     static int RecvKMsg(Connection *conn, IOMgr::MsgHandler msgHandler);
+    static int RecvKMsgRing(Connection *conn, IOMgr::MsgHandler msgHandler);
     static bool Parse(int, Connection *conn);
     static bool ParseHeader(Connection *conn, uint32_t &recvLen, int &retval);
     static void SetSocketOperate(Connection *conn);
@@ -301,6 +403,10 @@ public:
 
 private:
     static void CleanUp(int fd, Connection *conn);
+    static bool DeliverKMsg(Connection *conn, std::unique_ptr<MessageBase> msg, IOMgr::MsgHandler msgHandler);
+    static size_t PendingFrameLen(Connection *conn);
+    static bool FillRecvBuffer(Connection *conn);
+    static MessageBase *ParseRingFrame(Connection *conn);
 };    // namespace connectionUtil
 
 };    // namespace litebus
@@ -20,6 +20,7 @@
 #include "actor/sysmgr_actor.hpp"
 #include "actor/actormgr.hpp"
 #include "actor/iomgr.hpp"
+#include "actor/msgpool.hpp"
 
 #ifdef HTTP_ENABLED
 #include "httpd/http_iomgr.hpp"
@@ -376,4 +377,19 @@ int GetHttpKmsgFlag()
     return g_httpKmsgEnable;
 }
 
+std::vector<ActorWorkerStats> GetActorWorkerStats()
+{
+    return litebus::ActorMgr::GetActorMgrRef()->GetWorkerStats();
+}
+
+std::vector<ActorRunStats> GetActorRunStats()
+{
+    return litebus::ActorMgr::GetActorMgrRef()->GetActorRunStats();
+}
+
+MsgAllocStats GetMsgAllocStats()
+{
+    return MsgPool::GetInstance().GetStats();
+}
+
 }    // namespace litebus
@@ -179,6 +179,9 @@ int SSLSocketOperate::Sendmsg(Connection *connection, struct msghdr *sendMsg, ui
     while (sendLen) {
         retval = SSL_write(ssl, sendMsg->msg_iov[0].iov_base, sendMsg->msg_iov[0].iov_len);
         if (retval > 0) {
+            if (connection->sendMetrics != nullptr) {
+                connection->sendMetrics->UpdateSyscall(retval);
+            }
             sendLen -= static_cast<unsigned int>(retval);
 
             if (sendLen == 0) {
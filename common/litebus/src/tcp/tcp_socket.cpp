@@ -43,6 +43,23 @@ namespace litebus {
 
 constexpr int EAGAIN_RETRY = 2;
 
+// an io_uring loop may hold what it received for the fd already, the epoll loop reads the socket
+static ssize_t SocketRecv(const Connection *connection, void *buf, size_t len, int flags)
+{
+    if (connection->recvEvloop != nullptr) {
+        return connection->recvEvloop->Recv(connection->fd, buf, len, flags);
+    }
+    return recv(connection->fd, buf, len, flags);
+}
+
+static ssize_t SocketRecvmsg(const Connection *connection, struct msghdr *msg, int flags)
+{
+    if (connection->recvEvloop != nullptr) {
+        return connection->recvEvloop->Recvmsg(connection->fd, msg, flags);
+    }
+    return recvmsg(connection->fd, msg, flags);
+}
+
 int TCPSocketOperate::Pending(Connection *)
 {
     return 0;
@@ -54,7 +71,7 @@ int TCPSocketOperate::RecvPeek(Connection *connection, char *recvBuf, uint32_t r
         return -1;
     }
 
-    return recv(connection->fd, recvBuf, recvLen, MSG_PEEK);
+    return SocketRecv(connection, recvBuf, recvLen, MSG_PEEK);
 }
 
 int TCPSocketOperate::Recv(Connection *connection, char *recvBuf, uint32_t totRecvLen, uint32_t &recvLen)
@@ -69,7 +86,7 @@ int TCPSocketOperate::Recv(Connection *connection, char *recvBuf, uint32_t totRe
 
     recvLen = 0;
     while (recvLen != totRecvLen) {
-        retval = recv(fd, curRecvBuf, totRecvLen - recvLen, 0);
+        retval = SocketRecv(connection, curRecvBuf, totRecvLen - recvLen, 0);
         if (retval > 0) {
             recvLen += static_cast<unsigned int>(retval);
             if (recvLen == totRecvLen) {
@@ -116,7 +133,7 @@ int TCPSocketOperate::Recvmsg(Connection *connection, struct msghdr *recvMsg, ui
     }
 
     while (totalRecvLen) {
-        retval = recvmsg(fd, recvMsg, 0);
+        retval = SocketRecvmsg(connection, recvMsg, 0);
         if (retval <= 0) {
             int recvRet = TraceRecvmsgErr(retval, fd, recvLen, recvLen - totalRecvLen);
             if (recvRet == -1) {
@@ -177,11 +194,15 @@ int TCPSocketOperate::Sendmsg(Connection *connection, struct msghdr *sendMsg, ui
             continue;
         }
 
+        if (connection->sendMetrics != nullptr) {
+            connection->sendMetrics->UpdateSyscall(retval);
+        }
         sendLen -= static_cast<uint32_t>(retval);
         if (sendLen == 0) {
             sendMsg->msg_iovlen = 0;
             break;
         }
+        // partial write, skip the iovecs written and cut the first one left
         tmpBytes = 0;
         for (i = 0; i < sendMsg->msg_iovlen; i++) {
             if (sendMsg->msg_iov[i].iov_len + tmpBytes >= static_cast<size_t>(retval)) {
@@ -60,6 +60,7 @@ constexpr auto MAX_RECYCLE_LINK_COUNT = 10;
 constexpr auto MAX_REMOTE_LINK_COUNT_DEFAULT = 20000;
 constexpr auto MAX_REMOTE_LINK_COUNT_MIN = 10000;
 constexpr auto MAX_REMOTE_LINK_COUNT_MAX = 50000;
+constexpr auto SEND_LOOP_COUNT_DEFAULT = 1;
 #ifdef HTTP_ENABLED
 RecvCallBack TCPMgr::httpReqCb = nullptr;
 RecvCallBack TCPMgr::httpRspCb = nullptr;
@@ -67,9 +68,58 @@ CheckConCallBack TCPMgr::httpConCheckCb = nullptr;
 #endif
 std::string TCPMgr::advertiseUrl = "";
 bool TCPMgr::isHttpKmsg = false;
-uint64_t TCPMgr::outTcpBufSize = 0;
+std::atomic<uint64_t> TCPMgr::outTcpBufSize(0);
 IOMgr::MsgHandler TCPMgr::tcpMsgHandler;
 int TCPMgr::maxRemoteLinkCount = MAX_REMOTE_LINK_COUNT_DEFAULT;
+int TCPMgr::sendLoopCount = SEND_LOOP_COUNT_DEFAULT;
+bool TCPMgr::recvRing = false;
+
+namespace {
+// copy of the send metrics of one link, the link may be closed once its shard is unlocked
+struct LinkMetrics {
+    void CopyFrom(const Connection *conn)
+    {
+        found = true;
+        isRemote = conn->isRemote;
+        fd = conn->fd;
+        errCode = conn->errCode;
+        sendSum = conn->sendMetrics->sendSum;
+        sendMaxSize = conn->sendMetrics->sendMaxSize;
+        bytesPerSyscall = conn->sendMetrics->BytesPerSyscall();
+        to = conn->to;
+        lastSucMsgName = conn->sendMetrics->lastSucMsgName;
+        lastFailMsgName = conn->sendMetrics->lastFailMsgName;
+    }
+
+    bool Different(const LinkMetrics &that) const
+    {
+        return !(that.found && that.to == to && that.isRemote == isRemote);
+    }
+
+    void Push(IntTypeMetrics &intMetrics, StringTypeMetrics &stringMetrics) const
+    {
+        intMetrics.push(fd);
+        intMetrics.push(errCode);
+        intMetrics.push(sendSum);
+        intMetrics.push(sendMaxSize);
+        intMetrics.push(bytesPerSyscall);
+        stringMetrics.push(to);
+        stringMetrics.push(lastSucMsgName);
+        stringMetrics.push(lastFailMsgName);
+    }
+
+    bool found = false;
+    bool isRemote = false;
+    int fd = -1;
+    int errCode = 0;
+    int sendSum = 0;
+    int sendMaxSize = 0;
+    int bytesPerSyscall = 0;
+    std::string to;
+    std::string lastSucMsgName;
+    std::string lastFailMsgName;
+};
+}    // namespace
 
 namespace tcpUtil {
 int DoConnect(const std::string &to, Connection *conn, ConnectionCallBack eventCallBack,
@@ -165,7 +215,7 @@ void OnAccept(int server, uint32_t events, void *arg)
         return;
     }
 
-    if (LinkMgr::GetLinkMgr()->GetRemoteLinkCount() >= TCPMgr::maxRemoteLinkCount) {
+    if (LinkMgr::GetTotalRemoteLinkCount() >= TCPMgr::maxRemoteLinkCount) {
         BUSLOG_ERROR("remote link overrun, serverfd:{},events:{},acceptFd:{}", server, events, acceptFd);
         (void)close(acceptFd);
         acceptFd = -1;
@@ -190,7 +240,8 @@ void OnAccept(int server, uint32_t events, void *arg)
         delete conn;
         return;
     }
-    LinkMgr::GetLinkMgr()->AddRemoteLink(conn);
+    std::unique_lock<std::mutex> lock;
+    ConnectionUtil::LockLinkMgr(conn, lock)->AddRemoteLink(conn);
 }
 
 void ConnectionSend(Connection *conn)
@@ -198,21 +249,23 @@ void ConnectionSend(Connection *conn)
     conn->noCommTime = 0;
     while (!conn->sendQueue.empty() || conn->sendTotalLen != 0) {
         if (conn->sendTotalLen == 0) {
-            EvbufMgr::PrepareSendMsg(conn, conn->sendQueue.front(), TCPMgr::GetAdvertiseUrl(), TCPMgr::IsHttpKmsg());
-            conn->sendQueue.pop();
+            // a burst of queued messages goes out in one sendmsg
+            EvbufMgr::PrepareSendBatch(conn, TCPMgr::GetAdvertiseUrl(), TCPMgr::IsHttpKmsg());
+            if (conn->sendTotalLen == 0) {
+                continue;
+            }
         }
 
         int sendLen = conn->socketOperate->Sendmsg(conn, &conn->sendMsg, conn->sendTotalLen);
         if (sendLen > 0) {
             if (conn->sendTotalLen == 0) {
-                BUSLOG_DEBUG("send succ, to:{}", conn->to);
+                BUSLOG_DEBUG("send succ, to:{},msgs:{}", conn->to, conn->sendFrameCount);
                 // update metrics
                 conn->sendMetrics->UpdateError(false);
 
-                TCPMgr::SetTCPOutSize(TCPMgr::GetTCPOutSize() - conn->sendMsgBase->body.size());
-                conn->outBufferSize -= conn->sendMsgBase->body.size();
-                delete conn->sendMsgBase;
-                conn->sendMsgBase = nullptr;
+                uint64_t bodySize = conn->ReleaseSendBatch();
+                TCPMgr::SubTCPOutSize(bodySize);
+                conn->outBufferSize -= bodySize;
             }
         } else if (sendLen == 0) {
             // EAGAIN
@@ -281,13 +334,59 @@ void TCPMgr::InitRemoteLinkMaxSetting()
     maxRemoteLinkCount = count;
 }
 
+void TCPMgr::InitSendLoopSetting()
+{
+    char *sendLoopEnv = getenv("LITEBUS_TCP_SEND_LOOPS");
+    int count = SEND_LOOP_COUNT_DEFAULT;
+    if (sendLoopEnv != nullptr) {
+        try {
+            count = std::stoi(sendLoopEnv);
+        } catch (const std::exception &e) {
+            BUSLOG_ERROR("stoi fail:{}, error:{} ", sendLoopEnv, e.what());
+            count = SEND_LOOP_COUNT_DEFAULT;
+        }
+        if (count < 1 || count > static_cast<int>(MAX_LINK_SHARDS)) {
+            count = SEND_LOOP_COUNT_DEFAULT;
+        }
+    }
+    BUSLOG_INFO("tcp send loops set:{}", count);
+    sendLoopCount = count;
+}
+
+void TCPMgr::InitRecvRingSetting()
+{
+    char *recvRingEnv = getenv("LITEBUS_TCP_RECV_RING");
+    recvRing = recvRingEnv != nullptr && strlen(recvRingEnv) <= MAX_ENV_BOOLEAN_LENGTH &&
+               (std::string(recvRingEnv) == "true" || std::string(recvRingEnv) == "1");
+    BUSLOG_INFO("tcp recv ring set:{}", recvRing);
+}
+
+EvLoop *TCPMgr::GetSendEvloop(const std::string &to) const
+{
+    if (sendEvloops.size() <= 1) {
+        return sendEvloop;
+    }
+    return sendEvloops[LinkMgr::GetShardIndex(to, sendEvloops.size())];
+}
+
 bool TCPMgr::Init()
 {
-    LinkMgr::SetLinkMgr(new (std::nothrow) LinkMgr());
-    if (LinkMgr::GetLinkMgr() == nullptr) {
-        BUSLOG_ERROR("new LinkMgr failed");
-        return false;
+    InitSendLoopSetting();
+    InitRecvRingSetting();
+    // one link table per send loop, a peer url maps to the same index of both
+    std::vector<LinkMgr *> linkMgrs;
+    for (int i = 0; i < sendLoopCount; ++i) {
+        LinkMgr *linkMgr = new (std::nothrow) LinkMgr();
+        if (linkMgr == nullptr) {
+            BUSLOG_ERROR("new LinkMgr failed");
+            for (auto created : linkMgrs) {
+                delete created;
+            }
+            return false;
+        }
+        linkMgrs.push_back(linkMgr);
     }
+    LinkMgr::SetLinkMgrs(linkMgrs);
     recvEvloop = new (std::nothrow) EvLoop();
     if (recvEvloop == nullptr) {
         BUSLOG_ERROR("new recv evLoop failed");
@@ -302,22 +401,27 @@ bool TCPMgr::Init()
         return false;
     }
 
-    sendEvloop = new (std::nothrow) EvLoop();
-    if (sendEvloop == nullptr) {
-        BUSLOG_ERROR("new send evLoop failed");
-        delete recvEvloop;
-        recvEvloop = nullptr;
-        return false;
-    }
-    ok = sendEvloop->Init(TCP_SEND_EVLOOP_THREADNAME);
-    if (!ok) {
-        BUSLOG_ERROR("send evLoop init failed");
-        delete recvEvloop;
-        recvEvloop = nullptr;
-        delete sendEvloop;
-        sendEvloop = nullptr;
-        return false;
+    for (int i = 0; i < sendLoopCount; ++i) {
+        EvLoop *loop = new (std::nothrow) EvLoop();
+        std::string threadName = TCP_SEND_EVLOOP_THREADNAME;
+        if (i > 0) {
+            threadName += std::to_string(i);
+        }
+        if (loop == nullptr || !loop->Init(threadName)) {
+            BUSLOG_ERROR("send evLoop init failed, index:{}", i);
+            delete recvEvloop;
+            recvEvloop = nullptr;
+            delete loop;
+            for (auto created : sendEvloops) {
+                delete created;
+            }
+            sendEvloops.clear();
+            return false;
+        }
+        sendEvloops.push_back(loop);
+        linkMgrs[static_cast<size_t>(i)]->sendEvloop = loop;
     }
+    sendEvloop = sendEvloops.front();
 
     if (litebus::GetHttpKmsgFlag() < 0) {
         char *httpKmsgEnv = getenv("LITEBUS_HTTPKMSG_ENABLED");
@@ -329,7 +433,9 @@ bool TCPMgr::Init()
         isHttpKmsg = (litebus::GetHttpKmsgFlag() == 0) ? false : true;
     }
 
-    LinkMgr::GetLinkMgr()->SetLinkPattern(isHttpKmsg);
+    for (auto linkMgr : linkMgrs) {
+        linkMgr->SetLinkPattern(isHttpKmsg);
+    }
     BUSLOG_INFO("init succ, LITEBUS_HTTPKMSG_ENABLED:{}", isHttpKmsg);
 
     InitRemoteLinkMaxSetting();
@@ -397,12 +503,14 @@ void TCPMgr::EventCallBack(void *context)
     Connection *conn = static_cast<Connection *>(context);
 
     if (conn->connState == ConnectionState::CONNECTED) {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        std::unique_lock<std::mutex> lock;
+        (void)ConnectionUtil::LockLinkMgr(conn, lock);
         tcpUtil::ConnectionSend(conn);
     } else if (conn->connState == ConnectionState::DISCONNECTING) {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        std::unique_lock<std::mutex> lock;
+        LinkMgr *linkMgr = ConnectionUtil::LockLinkMgr(conn, lock);
         outTcpBufSize -= conn->outBufferSize;
-        LinkMgr::GetLinkMgr()->CloseConnection(conn);
+        linkMgr->CloseConnection(conn);
     }
 }
 
@@ -410,7 +518,8 @@ void TCPMgr::WriteCallBack(void *context)
 {
     Connection *conn = static_cast<Connection *>(context);
     if (conn->connState == ConnectionState::CONNECTED) {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        std::unique_lock<std::mutex> lock;
+        (void)ConnectionUtil::LockLinkMgr(conn, lock);
         tcpUtil::ConnectionSend(conn);
     }
 }
@@ -422,7 +531,8 @@ int TCPMgr::RecvMsg(Connection *conn)
     switch (conn->recvMsgType) {
         case ParseType::KMSG:
             if (!isHttpKmsg) {
-                return ConnectionUtil::RecvKMsg(conn, tcpMsgHandler);
+                return recvRing ? ConnectionUtil::RecvKMsgRing(conn, tcpMsgHandler)
+                                : ConnectionUtil::RecvKMsg(conn, tcpMsgHandler);
             } else {
                 conn->connState = ConnectionState::DISCONNECTING;
                 return -1;
@@ -519,9 +629,10 @@ int TCPMgr::TcpConnect(Connection *conn, const struct sockaddr *sa, socklen_t sa
 
 void TCPMgr::Send(MessageBase *msg, const TCPMgr *tcpmgr, bool remoteLink, bool isExactNotRemote)
 {
-    std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+    LinkMgr *linkMgr = LinkMgr::GetLinkMgr(msg->to.Url());
+    std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
     // search connection by the target address
-    Connection *conn = LinkMgr::GetLinkMgr()->FindLink(msg->to.Url(), remoteLink, isExactNotRemote);
+    Connection *conn = linkMgr->FindLink(msg->to.Url(), remoteLink, isExactNotRemote);
     if (conn == nullptr) {
         BUSLOG_DEBUG("send,not found link and to connect, from:{},to:{},remoteLink:{}", advertiseUrl, msg->to.Url(),
                      remoteLink);
@@ -535,22 +646,18 @@ void TCPMgr::Send(MessageBase *msg, const TCPMgr *tcpmgr, bool remoteLink, bool
         if (conn == nullptr) {
             return;
         }
-        LinkMgr::GetLinkMgr()->AddLink(conn);
+        linkMgr->AddLink(conn);
     }
 
     if (!conn->isRemote && !isExactNotRemote && conn->priority == ConnectionPriority::PRI_LOW) {
-        Connection *remoteConn = LinkMgr::GetLinkMgr()->ExactFindLink(msg->to.Url(), true);
+        Connection *remoteConn = linkMgr->ExactFindLink(msg->to.Url(), true);
         if (remoteConn != nullptr && remoteConn->connState == ConnectionState::CONNECTED) {
             conn = remoteConn;
         }
     }
 
     BUSLOG_DEBUG("send msg,fd:{},name:{},from:{},to:{}", "", conn->fd, msg->name, advertiseUrl, msg->to.Url());
-    if (conn->sendTotalLen == 0) {
-        EvbufMgr::PrepareSendMsg(conn, msg, advertiseUrl, isHttpKmsg);
-    } else {
-        conn->sendQueue.emplace(msg);
-    }
+    conn->sendQueue.emplace(msg);
     if (conn->connState == ConnectionState::CONNECTED) {
         tcpUtil::ConnectionSend(conn);
     }
@@ -564,7 +671,7 @@ void TCPMgr::SendByRecvLoop(MessageBase *msg, const TCPMgr *tcpmgr, bool remoteL
 
 Connection *TCPMgr::FindSendMsgConn(MessageBase *msg, bool remoteLink, bool exactNotRemote)
 {
-    Connection *conn = LinkMgr::GetLinkMgr()->FindLink(msg->to.Url(), remoteLink, exactNotRemote);
+    Connection *conn = LinkMgr::GetLinkMgr(msg->to.Url())->FindLink(msg->to.Url(), remoteLink, exactNotRemote);
     if (conn == nullptr) {
         BUSLOG_DEBUG("send,not found link and to connect, from:{},to:{},remoteLink:{}", advertiseUrl, msg->to.Url(),
                      remoteLink);
@@ -584,11 +691,14 @@ Connection *TCPMgr::FindSendMsgConn(MessageBase *msg, bool remoteLink, bool exac
 
 int TCPMgr::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote)
 {
+    // a forwarded message may still keep its body in a receive buffer
+    (void)msg->Body();
     BUSLOG_DEBUG("send msg,remoteLink:{},isExactNotRemote:{},name:{},from:{},to:{}", remoteLink, isExactNotRemote,
                  msg->name, advertiseUrl, msg->to.Url());
 
-    return sendEvloop->AddFuncToEvLoop([msg, this, remoteLink, isExactNotRemote] {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+    return GetSendEvloop(msg->to.Url())->AddFuncToEvLoop([msg, this, remoteLink, isExactNotRemote] {
+        LinkMgr *linkMgr = LinkMgr::GetLinkMgr(msg->to.Url());
+        std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
         // search connection by the target address
         bool exactNotRemote = isHttpKmsg || isExactNotRemote;
         Connection *conn = this->FindSendMsgConn(msg, remoteLink, exactNotRemote);
@@ -609,7 +719,7 @@ int TCPMgr::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote)
         }
 
         if (!conn->isRemote && !exactNotRemote && conn->priority == ConnectionPriority::PRI_LOW) {
-            Connection *remoteConn = LinkMgr::GetLinkMgr()->ExactFindLink(msg->to.Url(), true);
+            Connection *remoteConn = linkMgr->ExactFindLink(msg->to.Url(), true);
             if (remoteConn != nullptr && remoteConn->connState == ConnectionState::CONNECTED) {
                 conn = remoteConn;
             }
@@ -617,11 +727,7 @@ int TCPMgr::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote)
 
         BUSLOG_DEBUG("send msg,fd:{},name:{},from:{},to:{}", conn->fd, msg->name, advertiseUrl, msg->to.Url());
         outTcpBufSize += msg->body.size();
-        if (conn->sendTotalLen == 0) {
-            EvbufMgr::PrepareSendMsg(conn, msg, advertiseUrl, isHttpKmsg);
-        } else {
-            conn->sendQueue.emplace(msg);
-        }
+        conn->sendQueue.emplace(msg);
         if (conn->connState == ConnectionState::CONNECTED) {
             tcpUtil::ConnectionSend(conn);
         }
@@ -630,34 +736,37 @@ int TCPMgr::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote)
 
 void TCPMgr::CollectMetrics()
 {
-    (void)sendEvloop->AddFuncToEvLoop([this] {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
-        Connection *maxConn = LinkMgr::GetLinkMgr()->FindMaxLink();
-        Connection *fastConn = LinkMgr::GetLinkMgr()->FindFastLink();
+    (void)sendEvloop->AddFuncToEvLoop([] {
+        LinkMetrics maxLink;
+        LinkMetrics fastLink;
+        for (size_t i = 0; i < LinkMgr::GetLinkMgrCount(); ++i) {
+            LinkMgr *linkMgr = LinkMgr::GetLinkMgrShard(i);
+            if (linkMgr == nullptr) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
+            Connection *maxConn = linkMgr->FindMaxLink();
+            if (maxConn != nullptr && maxConn->sendMetrics->sendSum > maxLink.sendSum) {
+                maxLink.CopyFrom(maxConn);
+            }
+            Connection *fastConn = linkMgr->FindFastLink();
+            if (fastConn != nullptr && fastConn->sendMetrics->sendMaxSize > fastLink.sendMaxSize) {
+                fastLink.CopyFrom(fastConn);
+            }
+            linkMgr->RefreshMetrics();
+        }
 
         if (tcpMsgHandler != nullptr) {
             IntTypeMetrics intMetrics;
             StringTypeMetrics stringMetrics;
             bool needSendMetrics = false;
 
-            if (maxConn != nullptr) {
-                intMetrics.push(maxConn->fd);
-                intMetrics.push(maxConn->errCode);
-                intMetrics.push(maxConn->sendMetrics->sendSum);
-                intMetrics.push(maxConn->sendMetrics->sendMaxSize);
-                stringMetrics.push(maxConn->to);
-                stringMetrics.push(maxConn->sendMetrics->lastSucMsgName);
-                stringMetrics.push(maxConn->sendMetrics->lastFailMsgName);
+            if (maxLink.found) {
+                maxLink.Push(intMetrics, stringMetrics);
                 needSendMetrics = true;
             }
-            if (fastConn != nullptr && fastConn->Different(maxConn)) {
-                intMetrics.push(fastConn->fd);
-                intMetrics.push(fastConn->errCode);
-                intMetrics.push(fastConn->sendMetrics->sendSum);
-                intMetrics.push(fastConn->sendMetrics->sendMaxSize);
-                stringMetrics.push(fastConn->to);
-                stringMetrics.push(fastConn->sendMetrics->lastSucMsgName);
-                stringMetrics.push(fastConn->sendMetrics->lastFailMsgName);
+            if (fastLink.found && fastLink.Different(maxLink)) {
+                fastLink.Push(intMetrics, stringMetrics);
                 needSendMetrics = true;
             }
             if (needSendMetrics) {
@@ -672,8 +781,6 @@ void TCPMgr::CollectMetrics()
                 tcpMsgHandler(std::move(localMsg));
             }
         }
-
-        LinkMgr::GetLinkMgr()->RefreshMetrics();
     });
 }
 
@@ -688,9 +795,10 @@ void TCPMgr::Link(const AID &sAid, const AID &dAid)
 
     (void)recvEvloop->AddFuncToEvLoop([sAid, dAid, this] {
         std::string to = dAid.Url();
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        LinkMgr *linkMgr = LinkMgr::GetLinkMgr(to);
+        std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
         // search connection by the target address
-        Connection *conn = LinkMgr::GetLinkMgr()->FindLink(to, false, isHttpKmsg);
+        Connection *conn = linkMgr->FindLink(to, false, isHttpKmsg);
         if (conn == nullptr) {
             BUSLOG_INFO("not found link, sAid:{}, dAid:{}", std::string(sAid), std::string(dAid));
             conn = new (std::nothrow) Connection();
@@ -704,7 +812,8 @@ void TCPMgr::Link(const AID &sAid, const AID &dAid)
             conn->to = to;
 
             conn->recvEvloop = this->recvEvloop;
-            conn->sendEvloop = this->sendEvloop;
+            conn->sendEvloop = this->GetSendEvloop(to);
+            conn->linkMgr = linkMgr;
             ConnectionUtil::SetSocketOperate(conn);
 
             int ret = tcpUtil::DoConnect(to, conn, TCPMgr::EventCallBack, TCPMgr::WriteCallBack, TCPMgr::ReadCallBack);
@@ -718,10 +827,10 @@ void TCPMgr::Link(const AID &sAid, const AID &dAid)
                 delete conn;
                 return;
             }
-            LinkMgr::GetLinkMgr()->AddLink(conn);
+            linkMgr->AddLink(conn);
         }
 
-        LinkMgr::GetLinkMgr()->AddLinker(conn->fd, sAid, dAid, SendExitMsg);
+        linkMgr->AddLinker(conn->fd, sAid, dAid, SendExitMsg);
 
         BUSLOG_INFO("link, fd:{},sAid:{},dAid:{},remote:{}", conn->fd, std::string(sAid), std::string(dAid),
                     conn->isRemote);
@@ -732,17 +841,18 @@ void TCPMgr::UnLink(const AID &dAid)
 {
     (void)recvEvloop->AddFuncToEvLoop([dAid] {
         std::string to = dAid.Url();
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        LinkMgr *linkMgr = LinkMgr::GetLinkMgr(to);
+        std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
         if (isHttpKmsg) {
             // When application has set 'LITEBUS_HTTPKMSG_ENABLED',it means sending-link is in links map
             // while accepting-link is differently in remoteLinks map. So we only need to delete link in exact links.
-            LinkMgr::GetLinkMgr()->ExactDeleteLink(to, false);
+            linkMgr->ExactDeleteLink(to, false);
         } else {
             // When application hasn't set 'LITEBUS_HTTPKMSG_ENABLED',it means sending-link and accepting-link is
             // shared
             // So we need to delete link in both links map and remote-links map.
-            LinkMgr::GetLinkMgr()->ExactDeleteLink(to, false);
-            LinkMgr::GetLinkMgr()->ExactDeleteLink(to, true);
+            linkMgr->ExactDeleteLink(to, false);
+            linkMgr->ExactDeleteLink(to, true);
         }
     });
 }
@@ -751,13 +861,13 @@ void TCPMgr::DoReConnectConn(Connection *conn, const std::string &to, const AID
                              int &oldFd) const
 {
     if (!isHttpKmsg && !conn->isRemote) {
-        Connection *remoteConn = LinkMgr::GetLinkMgr()->ExactFindLink(to, true);
+        Connection *remoteConn = LinkMgr::GetLinkMgr(to)->ExactFindLink(to, true);
         // We will close remote link in rare cases where sending-link and accepting link coexists
         // simultaneously.
         if (remoteConn != nullptr) {
             BUSLOG_INFO("reconnect, close remote connect,fd:{},sAid:{},dAid:{},remote:{},connState:{}", remoteConn->fd,
                         std::string(sAid), std::string(dAid), remoteConn->isRemote, remoteConn->connState);
-            LinkMgr::GetLinkMgr()->CloseConnection(remoteConn);
+            LinkMgr::GetLinkMgr(to)->CloseConnection(remoteConn);
         }
     }
 
@@ -775,17 +885,16 @@ void TCPMgr::DoReConnectConn(Connection *conn, const std::string &to, const AID
     conn->recvTotalLen = 0;
     conn->recvMsgType = UNKNOWN;
     conn->connState = INIT;
-    if (conn->sendTotalLen != 0 && conn->sendMsgBase != nullptr) {
-        delete conn->sendMsgBase;
-    }
-    conn->sendMsgBase = nullptr;
-    conn->sendTotalLen = 0;
+    // the new socket starts from the first message not written yet
+    conn->RequeueSendBatch();
 
     if (conn->recvTotalLen != 0 && conn->recvMsgBase != nullptr) {
         delete conn->recvMsgBase;
     }
     conn->recvMsgBase = nullptr;
     conn->recvTotalLen = 0;
+    // the delivered slices keep the old buffer, the partial frame is dropped with the old socket
+    conn->recvBuffer.reset();
 
     conn->recvState = State::MSG_HEADER;
 }
@@ -815,6 +924,8 @@ Connection *TCPMgr::CreateRemoteConn(int acceptFd) const
     conn->isRemote = true;
     conn->recvEvloop = this->recvEvloop;
     conn->sendEvloop = this->sendEvloop;
+    // the peer is unknown until the first message, stay in the first shard till then
+    conn->linkMgr = LinkMgr::GetLinkMgr();
 
     conn->eventCallBack = TCPMgr::EventCallBack;
     conn->writeCallBack = TCPMgr::WriteCallBack;
@@ -832,7 +943,8 @@ Connection *TCPMgr::CreateDefaultConn(std::string to) const
     conn->from = advertiseUrl;
     conn->to = to;
     conn->recvEvloop = this->recvEvloop;
-    conn->sendEvloop = this->sendEvloop;
+    conn->sendEvloop = this->GetSendEvloop(to);
+    conn->linkMgr = LinkMgr::GetLinkMgr(to);
     ConnectionUtil::SetSocketOperate(conn);
     return conn;
 }
@@ -849,7 +961,8 @@ Connection *TCPMgr::CreateSendMsgConn(MessageBase *msg) const
     conn->from = advertiseUrl;
     conn->to = msg->to.Url();
     conn->recvEvloop = this->recvEvloop;
-    conn->sendEvloop = this->sendEvloop;
+    conn->sendEvloop = this->GetSendEvloop(conn->to);
+    conn->linkMgr = LinkMgr::GetLinkMgr(conn->to);
     ConnectionUtil::SetSocketOperate(conn);
 
     int ret =
@@ -870,10 +983,11 @@ Connection *TCPMgr::CreateSendMsgConn(MessageBase *msg) const
 
 void TCPMgr::Reconnect(const AID &sAid, const AID &dAid)
 {
-    (void)sendEvloop->AddFuncToEvLoop([sAid, dAid, this] {
+    (void)GetSendEvloop(dAid.Url())->AddFuncToEvLoop([sAid, dAid, this] {
         std::string to = dAid.Url();
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
-        Connection *conn = LinkMgr::GetLinkMgr()->FindLink(to, false, isHttpKmsg);
+        LinkMgr *linkMgr = LinkMgr::GetLinkMgr(to);
+        std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
+        Connection *conn = linkMgr->FindLink(to, false, isHttpKmsg);
         if (conn != nullptr) {
             conn->connState = ConnectionState::CLOSE;
         }
@@ -881,8 +995,9 @@ void TCPMgr::Reconnect(const AID &sAid, const AID &dAid)
         (void)recvEvloop->AddFuncToEvLoop([sAid, dAid, this] {
             std::string to = dAid.Url();
             int oldFd = -1;
-            std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
-            Connection *conn = LinkMgr::GetLinkMgr()->FindLink(to, false, isHttpKmsg);
+            LinkMgr *linkMgr = LinkMgr::GetLinkMgr(to);
+            std::lock_guard<std::mutex> lock(linkMgr->linkMutex);
+            Connection *conn = linkMgr->FindLink(to, false, isHttpKmsg);
             if (conn != nullptr) {
                 // connection already exist
                 DoReConnectConn(conn, to, sAid, dAid, oldFd);
@@ -903,17 +1018,17 @@ void TCPMgr::Reconnect(const AID &sAid, const AID &dAid)
                     conn->fd = oldFd;
                 }
                 BUSLOG_ERROR("connect fail and reconnect fail, sAid:{},dAid:{}", std::string(sAid), std::string(dAid));
-                LinkMgr::GetLinkMgr()->CloseConnection(conn);
+                linkMgr->CloseConnection(conn);
                 return;
             }
             if (oldFd != -1) {
-                if (LinkMgr::GetLinkMgr()->SwapLinkerSocket(oldFd, conn->fd)) {
+                if (linkMgr->SwapLinkerSocket(oldFd, conn->fd)) {
                 }
                 // else not found
             } else {
-                LinkMgr::GetLinkMgr()->AddLink(conn);
+                linkMgr->AddLink(conn);
             }
-            LinkMgr::GetLinkMgr()->AddLinker(conn->fd, sAid, dAid, SendExitMsg);
+            linkMgr->AddLinker(conn->fd, sAid, dAid, SendExitMsg);
             BUSLOG_INFO("reconnect,fd:{},sAid:{},dAid:{}", conn->fd, std::string(sAid), std::string(dAid));
         });
     });
@@ -921,12 +1036,17 @@ void TCPMgr::Reconnect(const AID &sAid, const AID &dAid)
 
 void TCPMgr::FinishDestruct()
 {
-    if (sendEvloop != nullptr) {
+    if (sendEvloops.empty() && sendEvloop != nullptr) {
+        sendEvloops.push_back(sendEvloop);
+    }
+    for (auto &loop : sendEvloops) {
         BUSLOG_INFO("delete send event loop");
-        sendEvloop->Finish();
-        delete sendEvloop;
-        sendEvloop = nullptr;
+        loop->Finish();
+        delete loop;
+        loop = nullptr;
     }
+    sendEvloops.clear();
+    sendEvloop = nullptr;
 
     if (recvEvloop != nullptr) {
         BUSLOG_INFO("delete recv event loop");
@@ -964,6 +1084,11 @@ void TCPMgr::SetTCPOutSize(uint64_t size)
     outTcpBufSize = size;
 }
 
+void TCPMgr::SubTCPOutSize(uint64_t size)
+{
+    outTcpBufSize -= size;
+}
+
 uint64_t TCPMgr::GetInBufSize()
 {
     return 1;
@@ -991,7 +1116,8 @@ void TCPMgr::RegisterRecvHttpCallBack(RecvCallBack reqCb, RecvCallBack rspCb, Ch
 int TCPMgr::Send(MessageBase *msg, Connection *connection, int conSeq)
 {
     return recvEvloop->AddFuncToEvLoop([msg, connection, conSeq]() mutable {
-        std::lock_guard<std::mutex> lock(LinkMgr::linkMutex);
+        // http connections are accepted ones, they never leave the first shard
+        std::lock_guard<std::mutex> lock(LinkMgr::GetLinkMgr()->linkMutex);
         if (httpConCheckCb(conSeq)) {
             connection->sendQueue.emplace(msg);
             tcpUtil::ConnectionSend(connection);
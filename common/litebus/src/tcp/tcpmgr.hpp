@@ -17,7 +17,9 @@
 #ifndef __LITEBUS_TCPMGR_H__
 #define __LITEBUS_TCPMGR_H__
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include "actor/iomgr.hpp"
 #include "evloop/evloop.hpp"
@@ -67,6 +69,7 @@ public:
     void CollectMetrics() override;
     static uint64_t GetTCPOutSize();
     static void SetTCPOutSize(uint64_t size);
+    static void SubTCPOutSize(uint64_t size);
     uint64_t GetInBufSize() override;
     int AddRuleUdp(std::string, int) override
     {
@@ -96,6 +99,10 @@ public:
     static std::string GetAdvertiseUrl();
     static bool IsHttpKmsg();
     static void InitRemoteLinkMaxSetting();
+    static void InitSendLoopSetting();
+    static void InitRecvRingSetting();
+    // send loop of the shard owning the peer url
+    EvLoop *GetSendEvloop(const std::string &to) const;
 
 #ifdef HTTP_ENABLED
     int Send(MessageBase *msg, Connection *connection, int conSeq);
@@ -107,7 +114,7 @@ private:
     std::string url_;
 
     int serverFd = -1;
-    static uint64_t outTcpBufSize;
+    static std::atomic<uint64_t> outTcpBufSize;
     static IOMgr::MsgHandler tcpMsgHandler;
 #ifdef HTTP_ENABLED
     static RecvCallBack httpReqCb;
@@ -117,8 +124,13 @@ private:
     static std::string advertiseUrl;
     static bool isHttpKmsg;
     EvLoop *recvEvloop = nullptr;
+    // the first send loop
     EvLoop *sendEvloop = nullptr;
+    std::vector<EvLoop *> sendEvloops;
     static int maxRemoteLinkCount;
+    static int sendLoopCount;
+    // LITEBUS_TCP_RECV_RING, the kmsg links read the frames in bulk and keep the large bodies in place
+    static bool recvRing;
     friend void tcpUtil::OnAccept(int server, uint32_t events, void *arg);
 };
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer/timer_wheel.hpp"
+
+namespace litebus {
+
+constexpr Duration WHEEL_ROOT_MASK = WHEEL_ROOT_SIZE - 1;
+constexpr Duration WHEEL_LEVEL_MASK = WHEEL_LEVEL_SIZE - 1;
+
+TimerWheel::TimerWheel(Duration now) : current(now)
+{
+}
+
+void TimerWheel::Add(TimerNode *node)
+{
+    // an overdue node runs on the next tick, a far one is parked in the top level and cascaded down again
+    Duration expire = node->expire < current ? current : node->expire;
+    Duration delta = expire - current;
+    if (delta > WHEEL_MAX_DELTA) {
+        delta = WHEEL_MAX_DELTA;
+        expire = current + WHEEL_MAX_DELTA;
+    }
+
+    uint32_t level = 0;
+    while (level + 1 < WHEEL_LEVELS && delta >= (1ULL << Shift(level + 1))) {
+        ++level;
+    }
+    node->level = level;
+    node->slot = static_cast<uint32_t>(level == 0 ? (expire & WHEEL_ROOT_MASK)
+                                                  : ((expire >> Shift(level)) & WHEEL_LEVEL_MASK));
+    Link(GetSlot(node->level, node->slot), node);
+}
+
+void TimerWheel::Remove(TimerNode *node)
+{
+    if (!node->linked) {
+        return;
+    }
+    Slot &slot = GetSlot(node->level, node->slot);
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        slot.head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        slot.tail = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+    node->linked = false;
+    --levelSize[node->level];
+    --size;
+}
+
+void TimerWheel::Link(Slot &slot, TimerNode *node)
+{
+    node->next = nullptr;
+    node->prev = slot.tail;
+    if (slot.tail != nullptr) {
+        slot.tail->next = node;
+    } else {
+        slot.head = node;
+    }
+    slot.tail = node;
+    node->linked = true;
+    ++levelSize[node->level];
+    ++size;
+}
+
+TimerNode *TimerWheel::Detach(Slot &slot)
+{
+    TimerNode *node = slot.head;
+    if (node != nullptr) {
+        Remove(node);
+    }
+    return node;
+}
+
+void TimerWheel::Cascade(uint32_t level, uint32_t index)
+{
+    Slot &slot = GetSlot(level, index);
+    TimerNode *node = nullptr;
+    while ((node = Detach(slot)) != nullptr) {
+        Add(node);
+    }
+}
+
+void TimerWheel::Advance(Duration now, std::vector<TimerNode *> &expired)
+{
+    while (current <= now) {
+        if (size == 0) {
+            current = now + 1;
+            break;
+        }
+        uint32_t index = static_cast<uint32_t>(current & WHEEL_ROOT_MASK);
+        if (index == 0) {
+            // the root level wraps, pull the next slot of each upper level whose lower one wrapped too
+            for (uint32_t level = 1; level < WHEEL_LEVELS; ++level) {
+                uint32_t upper = static_cast<uint32_t>((current >> Shift(level)) & WHEEL_LEVEL_MASK);
+                Cascade(level, upper);
+                if (upper != 0) {
+                    break;
+                }
+            }
+        } else if (levelSize[0] == 0) {
+            // nothing in the root level, skip to its wrap where the next cascade happens
+            Duration wrap = (current | WHEEL_ROOT_MASK) + 1;
+            if (wrap > now) {
+                current = now + 1;
+                break;
+            }
+            current = wrap;
+            continue;
+        }
+
+        TimerNode *node = nullptr;
+        while ((node = Detach(root[index])) != nullptr) {
+            expired.push_back(node);
+        }
+        ++current;
+    }
+}
+
+Duration TimerWheel::NextWakeup() const
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    Duration wakeup = 0;
+    if (levelSize[0] > 0) {
+        for (Duration i = 0; i < WHEEL_ROOT_SIZE; ++i) {
+            if (root[(current + i) & WHEEL_ROOT_MASK].head != nullptr) {
+                wakeup = current + i;
+                break;
+            }
+        }
+    }
+
+    // an upper level node moves down when its slot is cascaded, wake up then
+    for (uint32_t level = 1; level < WHEEL_LEVELS; ++level) {
+        if (levelSize[level] == 0) {
+            continue;
+        }
+        unsigned int shift = Shift(level);
+        Duration base = current >> shift;
+        bool atWrap = (current & ((1ULL << shift) - 1)) == 0;
+        for (Duration i = atWrap ? 0 : 1; i <= WHEEL_LEVEL_SIZE; ++i) {
+            if (GetSlot(level, static_cast<uint32_t>((base + i) & WHEEL_LEVEL_MASK)).head != nullptr) {
+                Duration cascade = (base + i) << shift;
+                if (cascade < current) {
+                    cascade = current;
+                }
+                if (wakeup == 0 || cascade < wakeup) {
+                    wakeup = cascade;
+                }
+                break;
+            }
+        }
+    }
+    return wakeup;
+}
+
+void TimerWheel::Clear(std::vector<TimerNode *> &nodes)
+{
+    for (uint32_t level = 0; level < WHEEL_LEVELS; ++level) {
+        Duration slots = level == 0 ? WHEEL_ROOT_SIZE : WHEEL_LEVEL_SIZE;
+        for (Duration i = 0; i < slots; ++i) {
+            TimerNode *node = nullptr;
+            while ((node = Detach(GetSlot(level, static_cast<uint32_t>(i)))) != nullptr) {
+                nodes.push_back(node);
+            }
+        }
+    }
+}
+
+}    // namespace litebus
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LITEBUS_TIMER_WHEEL_H__
+#define __LITEBUS_TIMER_WHEEL_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "timer/timer.hpp"
+
+namespace litebus {
+
+/*
+ * the first level holds 256 slots of 1ms, each upper level holds 64 slots of the whole lower level,
+ * so the five levels span 2^32 ms
+ */
+constexpr unsigned int WHEEL_ROOT_BITS = 8;
+constexpr unsigned int WHEEL_LEVEL_BITS = 6;
+constexpr unsigned int WHEEL_LEVELS = 5;
+constexpr Duration WHEEL_ROOT_SIZE = 1ULL << WHEEL_ROOT_BITS;
+constexpr Duration WHEEL_LEVEL_SIZE = 1ULL << WHEEL_LEVEL_BITS;
+constexpr Duration WHEEL_MAX_DELTA = (1ULL << (WHEEL_ROOT_BITS + WHEEL_LEVEL_BITS * (WHEEL_LEVELS - 1))) - 1;
+
+struct TimerNode {
+    TimerNode(const Timer &t, Duration expireTime) : timer(t), expire(expireTime)
+    {
+    }
+
+    Timer timer;
+    Duration expire;
+    // set by the canceller, the wheel drops the node instead of linking it
+    std::atomic_bool canceled{ false };
+
+    // the wheel links, touched by the timer thread only
+    TimerNode *prev = nullptr;
+    TimerNode *next = nullptr;
+    uint32_t level = 0;
+    uint32_t slot = 0;
+    bool linked = false;
+};
+
+// A hashed hierarchical timing wheel in ms ticks, add and remove are O(1). It does not own the nodes and is
+// driven by the timer thread only.
+class TimerWheel {
+public:
+    explicit TimerWheel(Duration now);
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+    ~TimerWheel() = default;
+
+    void Add(TimerNode *node);
+    void Remove(TimerNode *node);
+
+    // moves the nodes expiring at or before now to expired in expiry order
+    void Advance(Duration now, std::vector<TimerNode *> &expired);
+
+    // the next time the wheel has work, a cascade or an expiry; 0 when empty
+    Duration NextWakeup() const;
+
+    // unlinks all the nodes for the finalize
+    void Clear(std::vector<TimerNode *> &nodes);
+
+    size_t Size() const
+    {
+        return size;
+    }
+
+private:
+    struct Slot {
+        TimerNode *head = nullptr;
+        TimerNode *tail = nullptr;
+    };
+
+    Slot &GetSlot(uint32_t level, uint32_t slot)
+    {
+        return level == 0 ? root[slot] : levels[level - 1][slot];
+    }
+
+    const Slot &GetSlot(uint32_t level, uint32_t slot) const
+    {
+        return level == 0 ? root[slot] : levels[level - 1][slot];
+    }
+
+    void Link(Slot &slot, TimerNode *node);
+    TimerNode *Detach(Slot &slot);
+    void Cascade(uint32_t level, uint32_t index);
+
+    static unsigned int Shift(uint32_t level)
+    {
+        return level == 0 ? 0 : WHEEL_ROOT_BITS + WHEEL_LEVEL_BITS * (level - 1);
+    }
+
+    // the next tick to run, every tick before it is done
+    Duration current;
+    size_t size = 0;
+    size_t levelSize[WHEEL_LEVELS] = { 0 };
+    Slot root[WHEEL_ROOT_SIZE];
+    Slot levels[WHEEL_LEVELS - 1][WHEEL_LEVEL_SIZE];
+};
+
+}    // namespace litebus
+
+#endif
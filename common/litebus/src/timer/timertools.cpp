@@ -16,41 +16,51 @@
 
 #include "timer/timertools.hpp"
 #include <csignal>
+#include <unordered_map>
+#include <unordered_set>
 #include <unistd.h>
 #include <sys/timerfd.h>
 #include "actor/buslog.hpp"
 #include "evloop/evloop.hpp"
+#include "timer/timer_wheel.hpp"
 
 namespace litebus {
-using TimerPoolType = std::map<Duration, std::list<Timer>>;
-static std::unique_ptr<TimerPoolType> g_timerPool = nullptr;
+constexpr unsigned int TIMER_SHARD_BITS = 4;
+constexpr uint32_t TIMER_SHARDS = 1U << TIMER_SHARD_BITS;
+// a full insertion or cancel buffer wakes the timer thread up before the next tick
+constexpr size_t TIMER_BUFFER_BATCH = 4096;
+
+// The timers are spread over the shards by the adding thread and found again by the low bits of the id, so the adds
+// and the cancels of the threads do not contend on one lock. The buffers are drained by the timer thread.
+struct alignas(64) TimerShard {
+    SpinLock lock;
+    std::atomic<uint64_t> nextId{ 1 };
+    std::unordered_map<uint64_t, TimerNode *> pending;
+    std::vector<TimerNode *> added;
+    std::vector<TimerNode *> canceled;
+};
+
+static std::unique_ptr<TimerWheel> g_timerWheel = nullptr;
+static TimerShard g_timerShards[TIMER_SHARDS];
+static std::atomic<uint32_t> g_nextShard(0);
 static std::unique_ptr<EvLoop> g_timerEvLoop = nullptr;
-static Duration g_ticks(0);
+static std::atomic<Duration> g_ticks(0);
+static std::atomic_bool g_drainPending(false);
 static int g_runTimerFD(-1);
 static int g_watchTimerFD(-1);
 static SpinLock g_timersLock{};
 std::atomic_bool TimerTools::initStatus(false);
-constexpr Duration SCAN_TIMERPOOL_DELAY = 30;
 constexpr Duration WATCH_INTERVAL = 20;
 constexpr unsigned int TIMER_LOG_INTERVAL = 6;
 const static std::string TIMER_EVLOOP_THREADNAME = "HARES_LB_TMer";
 
 namespace timer {
 void ScanTimerPool(int fd, uint32_t events, void *data);
-Duration NextTick(const std::map<Duration, std::list<Timer>> &timerPool)
-{
-    if (!timerPool.empty()) {
-        Duration first = timerPool.begin()->first;
-        return first;
-    }
-    return 0;
-}
 
-void ExecTimers(const std::list<Timer> &timers)
+uint32_t LocalShard()
 {
-    for (const auto &timer : timers) {
-        timer();
-    }
+    static thread_local uint32_t shard = g_nextShard.fetch_add(1) % TIMER_SHARDS;
+    return shard;
 }
 
 void CreateTimerToLoop(const Duration &delay, const Duration &)
@@ -87,33 +97,127 @@ void CreateTimerToLoop(const Duration &delay, const Duration &)
     }
 }
 
-void ScheduleTick(const std::map<Duration, std::list<Timer>> &timerPool)
+// arms the run timer for nextTick unless a 'tick' is scheduled for an earlier time, g_timersLock is held
+void ScheduleTick(Duration nextTick)
+{
+    Duration ticks = g_ticks.load();
+    if (nextTick == 0 || (ticks != 0 && ticks <= nextTick)) {
+        return;
+    }
+    Duration nowTime = TimeWatch::Now();
+    Duration delay = nextTick > nowTime ? nextTick - nowTime : 1;
+    g_ticks.store(nextTick);
+    CreateTimerToLoop(delay, nextTick);
+}
+
+// called by the adders, the timer thread picks the node up from the shard buffer when the tick fires
+void ScheduleTickForAdd(Duration expire)
+{
+    Duration ticks = g_ticks.load();
+    if (ticks != 0 && ticks <= expire) {
+        return;
+    }
+    g_timersLock.Lock();
+    ScheduleTick(expire);
+    g_timersLock.Unlock();
+}
+
+void RunTimers();
+
+void RequestDrain()
 {
-    Duration nextTick = NextTick(timerPool);
-    if (nextTick != 0) {
-        // 'tick' scheduled for an earlier time, not schedule current 'tick'
-        if ((g_ticks == 0) || (nextTick < g_ticks)) {
-            Duration nowTime = TimeWatch::Now();
-            Duration delay = 0;
-
-            if (nextTick > nowTime) {
-                delay = nextTick - nowTime;
-                g_ticks = nextTick;
-                CreateTimerToLoop(delay, nextTick);
-            } else {
-                delay = SCAN_TIMERPOOL_DELAY;
-                g_ticks = delay + nowTime;
-                CreateTimerToLoop(delay, nextTick);
-                BUSLOG_DEBUG("run timer immediately (nextTick, now time)=({}, {})", nextTick, nowTime);
+    if (!g_drainPending.exchange(true)) {
+        (void)g_timerEvLoop->AddFuncToEvLoop([]() { RunTimers(); });
+    }
+}
+
+// moves the buffered adds into the wheel and unlinks the canceled nodes
+void DrainShards()
+{
+    static std::vector<TimerNode *> added;
+    static std::vector<TimerNode *> canceled;
+    for (auto &shard : g_timerShards) {
+        shard.lock.Lock();
+        added.insert(added.end(), shard.added.begin(), shard.added.end());
+        shard.added.clear();
+        canceled.insert(canceled.end(), shard.canceled.begin(), shard.canceled.end());
+        shard.canceled.clear();
+        shard.lock.Unlock();
+    }
+
+    // a node canceled in the buffer is never linked, it is freed with the cancel list of this or a later drain
+    for (auto node : added) {
+        if (!node->canceled.load()) {
+            g_timerWheel->Add(node);
+        }
+    }
+    for (auto node : canceled) {
+        g_timerWheel->Remove(node);
+        delete node;
+    }
+    added.clear();
+    canceled.clear();
+}
+
+// the expired nodes are claimed from the pending tables once per shard, a node lost to a concurrent cancel is left
+// to the cancel list
+void ClaimExpired(std::vector<TimerNode *> &expired)
+{
+    static std::vector<size_t> byShard[TIMER_SHARDS];
+    for (size_t i = 0; i < expired.size(); ++i) {
+        byShard[expired[i]->timer.GetTimerID() & (TIMER_SHARDS - 1)].push_back(i);
+    }
+    for (uint32_t i = 0; i < TIMER_SHARDS; ++i) {
+        if (byShard[i].empty()) {
+            continue;
+        }
+        TimerShard &shard = g_timerShards[i];
+        shard.lock.Lock();
+        for (auto index : byShard[i]) {
+            if (shard.pending.erase(expired[index]->timer.GetTimerID()) == 0) {
+                expired[index] = nullptr;
             }
         }
+        shard.lock.Unlock();
+        byShard[i].clear();
     }
 }
 
+void ExecTimers(const std::vector<TimerNode *> &timers)
+{
+    for (auto node : timers) {
+        if (node != nullptr) {
+            node->timer();
+            delete node;
+        }
+    }
+}
+
+// drains the buffers, expires the wheel up to now and re-arms the run timer, on the timer thread only
+void RunTimers()
+{
+    std::vector<TimerNode *> expired;
+
+    g_drainPending.store(false);
+    // the adders after this point arm the run timer by themselves, the earlier ones are in the buffers
+    g_timersLock.Lock();
+    g_ticks.store(0);
+    g_timersLock.Unlock();
+
+    DrainShards();
+    g_timerWheel->Advance(TimeWatch::Now(), expired);
+    ClaimExpired(expired);
+
+    g_timersLock.Lock();
+    ScheduleTick(g_timerWheel->NextWakeup());
+    g_timersLock.Unlock();
+
+    ExecTimers(expired);
+}
+
 // select timeout timers
 void ScanTimerPool(int fd, uint32_t events, void *)
 {
-    std::list<Timer> outTimer;
     uint64_t count;
 
     if ((g_runTimerFD != fd) || !(events & static_cast<unsigned int>(EPOLLIN))) {
@@ -124,29 +228,11 @@ void ScanTimerPool(int fd, uint32_t events, void *)
     if (read(fd, &count, sizeof(uint64_t)) < 0) {
         return;
     }
-    g_timersLock.Lock();
-    Duration now = TimeWatch::Now();
-    auto it = g_timerPool->begin();
-    while (it != g_timerPool->end()) {
-        if (it->first > now) {
-            break;
-        }
-        outTimer.splice(outTimer.end(), (*g_timerPool)[it->first]);
-        ++it;
-    }
-    // delete timed out timer
-    (void)g_timerPool->erase(g_timerPool->begin(), g_timerPool->upper_bound(now));
-    g_ticks = 0;
-    ScheduleTick(*g_timerPool);
-    g_timersLock.Unlock();
-
-    ExecTimers(outTimer);
-    outTimer.clear();
+    RunTimers();
 }
 
 void CheckPassedTimer(int fd, uint32_t events, void *)
 {
-    std::list<Timer> passTimer;
     static unsigned long watchTimes = 0;
     uint64_t count;
 
@@ -158,42 +244,12 @@ void CheckPassedTimer(int fd, uint32_t events, void *)
     if (read(fd, &count, sizeof(uint64_t)) < 0) {
         return;
     }
-    g_timersLock.Lock();
-    Duration now = TimeWatch::Now();
     ++watchTimes;
-
-    for (auto it = g_timerPool->begin(); it != g_timerPool->end(); ++it) {
-        if (it->first > now) {
-            break;
-        }
-        passTimer.splice(passTimer.end(), (*g_timerPool)[it->first]);
-    }
-    // delete passed timer
-    if (passTimer.size() > 0) {
-        BUSLOG_DEBUG("fire pass timer (pass size, now, g_ticks)=({}, {}, {})", passTimer.size(), now, g_ticks);
-    }
-    (void)g_timerPool->erase(g_timerPool->begin(), g_timerPool->upper_bound(now));
-    if (g_ticks <= now) {
-        g_ticks = 0;
-    }
-
-    if (g_timerPool->size() > 0) {
-        if ((watchTimes % TIMER_LOG_INTERVAL == 0) && (passTimer.size() > 0)
-            && (now - g_timerPool->begin()->first > SECTOMILLI)) {
-            BUSLOG_DEBUG(
-                "timer info (pool size, pass size, now, g_ticks, poolTick, watchTimes)=({}, {}, {}, {}, {} ,{})",
-                g_timerPool->size(), passTimer.size(), now, g_ticks, g_timerPool->begin()->first, watchTimes);
-        }
+    if (watchTimes % TIMER_LOG_INTERVAL == 0) {
+        BUSLOG_DEBUG("timer info (wheel size, now, g_ticks, nextWakeup, watchTimes)=({}, {}, {}, {}, {})",
+                     g_timerWheel->Size(), TimeWatch::Now(), g_ticks.load(), g_timerWheel->NextWakeup(), watchTimes);
     }
-
-    BUSLOG_DEBUG("timer info (pool size, pass size, now, g_ticks, poolTick, watchTimes)=({}, {}, {}, {}, {}, {})",
-                 g_timerPool->size(), passTimer.size(), now, g_ticks, g_timerPool->begin()->first, watchTimes);
-
-    ScheduleTick(*g_timerPool);
-    g_timersLock.Unlock();
-
-    ExecTimers(passTimer);
-    passTimer.clear();
+    RunTimers();
 }
 
 bool StartWatchTimer()
@@ -236,12 +292,14 @@ bool TimerTools::Initialize()
     bool ret = true;
     g_timersLock.Lock();
 
-    g_timerPool.reset(new (std::nothrow) TimerPoolType());
-    if (g_timerPool == nullptr) {
-        BUSLOG_ERROR("timer pool new failed.");
+    g_timerWheel.reset(new (std::nothrow) TimerWheel(TimeWatch::Now()));
+    if (g_timerWheel == nullptr) {
+        BUSLOG_ERROR("timer wheel new failed.");
         g_timersLock.Unlock();
         return false;
     }
+    g_ticks.store(0);
+    g_drainPending.store(false);
 
     g_timerEvLoop.reset(new (std::nothrow) EvLoop());
     if (g_timerEvLoop == nullptr) {
@@ -272,13 +330,14 @@ void TimerTools::Finalize()
     initStatus.store(false);
 
     BUSLOG_INFO("Timer Finalize.");
-    g_timersLock.Lock();
+    // the timer thread takes g_timersLock, stop it first
     if (g_timerEvLoop != nullptr) {
         (void)g_timerEvLoop->DelFdEvent(g_watchTimerFD);
         (void)g_timerEvLoop->DelFdEvent(g_runTimerFD);
         g_timerEvLoop->Finish();
         g_timerEvLoop = nullptr;
     }
+    g_timersLock.Lock();
     if (g_runTimerFD >= 0) {
         (void)close(g_runTimerFD);
         BUSLOG_INFO("run timer close ID={}", g_runTimerFD);
@@ -289,6 +348,26 @@ void TimerTools::Finalize()
         BUSLOG_INFO("watch timer close ID={}", g_watchTimerFD);
         g_watchTimerFD = -1;
     }
+
+    // a canceled node may still sit in the wheel or in an insertion buffer
+    std::vector<TimerNode *> nodes;
+    if (g_timerWheel != nullptr) {
+        g_timerWheel->Clear(nodes);
+    }
+    for (auto &shard : g_timerShards) {
+        shard.lock.Lock();
+        nodes.insert(nodes.end(), shard.added.begin(), shard.added.end());
+        nodes.insert(nodes.end(), shard.canceled.begin(), shard.canceled.end());
+        shard.added.clear();
+        shard.canceled.clear();
+        shard.pending.clear();
+        shard.lock.Unlock();
+    }
+    std::unordered_set<TimerNode *> uniqueNodes(nodes.begin(), nodes.end());
+    for (auto node : uniqueNodes) {
+        delete node;
+    }
+    g_ticks.store(0);
     g_timersLock.Unlock();
 }
 
@@ -301,24 +380,23 @@ Timer TimerTools::AddTimer(const Duration &duration, const AID &aid, const std::
         thunk();
         return Timer();
     }
-    static std::atomic<uint64_t> id(1);
+    uint32_t index = timer::LocalShard();
+    TimerShard &shard = g_timerShards[index];
     TimeWatch timeWatch = TimeWatch::In(duration);
-    Timer timer(id.fetch_add(1), timeWatch, aid, thunk);
-
-    // Add the timer to timerpoll and Schedule it
-    g_timersLock.Lock();
-
-    if (g_timerPool->size() == 0 || timer.GetTimeWatch().Time() < g_timerPool->begin()->first) {
-        (*g_timerPool)[timer.GetTimeWatch().Time()].push_back(timer);
-        timer::ScheduleTick(*g_timerPool);
-    } else {
-        if (!(g_timerPool->size() >= 1)) {
-            BUSLOG_ERROR("g_timerPool size invalid size={}", g_timerPool->size());
-        }
-        (*g_timerPool)[timer.GetTimeWatch().Time()].push_back(timer);
+    Timer timer((shard.nextId.fetch_add(1) << TIMER_SHARD_BITS) | index, timeWatch, aid, thunk);
+    TimerNode *node = new TimerNode(timer, timeWatch.Time());
+
+    // Buffer the timer in the shard of this thread and Schedule it
+    shard.lock.Lock();
+    (void)shard.pending.emplace(timer.GetTimerID(), node);
+    shard.added.push_back(node);
+    bool full = shard.added.size() >= TIMER_BUFFER_BATCH;
+    shard.lock.Unlock();
+
+    timer::ScheduleTickForAdd(node->expire);
+    if (full) {
+        timer::RequestDrain();
     }
-    g_timersLock.Unlock();
-
     return timer;
 }
 
@@ -328,18 +406,27 @@ bool TimerTools::Cancel(const Timer &timer)
         return false;
     }
 
-    bool canceled = false;
-    g_timersLock.Lock();
-    Duration duration = timer.GetTimeWatch().Time();
-    if (g_timerPool->count(duration) > 0) {
-        canceled = true;
-        (*g_timerPool)[duration].remove(timer);
-        if ((*g_timerPool)[duration].empty()) {
-            (void)(g_timerPool->erase(duration));
-        }
+    uint64_t id = timer.GetTimerID();
+    if (id == 0) {
+        return false;
     }
-    g_timersLock.Unlock();
-
-    return canceled;
+    TimerShard &shard = g_timerShards[id & (TIMER_SHARDS - 1)];
+    shard.lock.Lock();
+    auto iter = shard.pending.find(id);
+    if (iter == shard.pending.end()) {
+        shard.lock.Unlock();
+        return false;
+    }
+    TimerNode *node = iter->second;
+    (void)shard.pending.erase(iter);
+    node->canceled.store(true);
+    shard.canceled.push_back(node);
+    bool full = shard.canceled.size() >= TIMER_BUFFER_BATCH;
+    shard.lock.Unlock();
+
+    if (full) {
+        timer::RequestDrain();
+    }
+    return true;
 }
 }    // namespace litebus
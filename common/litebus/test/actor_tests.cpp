@@ -26,6 +26,8 @@
 #define protected public
 #include "actor/actorapp.hpp"
 #include "actor/actormgr.hpp"
+#include "actor/mailbox.hpp"
+#include "actor/msgnametable.hpp"
 #include "async/async.hpp"
 #include "litebus.h"
 #include "litebus.hpp"
@@ -366,6 +368,115 @@ public:
     }
 };
 
+class CountActor : public litebus::ActorBase {
+public:
+    CountActor(const std::string &name, int producers, int msgNum)
+        : ActorBase(name), lastSeq(producers, -1), expected(producers * msgNum)
+    {
+    }
+
+    void Count(const AID &from, std::string &&name, std::string &&body)
+    {
+        auto pos = body.find(':');
+        int producer = std::stoi(body.substr(0, pos));
+        int seq = std::stoi(body.substr(pos + 1));
+        if (seq != lastSeq[producer] + 1) {
+            outOfOrder = true;
+        }
+        lastSeq[producer] = seq;
+        if (++received == expected) {
+            done.SetValue(!outOfOrder);
+        }
+    }
+
+    void Init()
+    {
+        Receive("Count", &CountActor::Count);
+    }
+
+    std::vector<int> lastSeq;
+    int expected;
+    int received = 0;
+    bool outOfOrder = false;
+    litebus::Promise<bool> done;
+};
+
+void SendToCountActor(const AID &to, int producers, int msgNum)
+{
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([to, p, msgNum]() {
+            for (int i = 0; i < msgNum; ++i) {
+                std::unique_ptr<MessageBase> msg(
+                    new MessageBase(AID("producer", to.Url()), to, "Count", std::to_string(p) + ":" + std::to_string(i)));
+                (void)ActorMgr::GetActorMgrRef()->Send(to, std::move(msg));
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+class ReadyActor : public litebus::ActorBase {
+public:
+    explicit ReadyActor(const std::string &name) : ActorBase(name)
+    {
+    }
+
+    void Ready()
+    {
+        ran.SetValue(true);
+    }
+
+    litebus::Promise<bool> ran;
+};
+
+class BusyActor : public litebus::ActorBase {
+public:
+    BusyActor(const std::string &name, const std::vector<std::shared_ptr<ReadyActor>> &targets)
+        : ActorBase(name), targets(targets)
+    {
+    }
+
+    // make the targets ready on this worker, then keep it busy until the other workers have stolen them.
+    bool KickAndWait()
+    {
+        for (auto &target : targets) {
+            litebus::Async(target->GetAID(), &ReadyActor::Ready);
+        }
+        bool allRan = true;
+        for (auto &target : targets) {
+            allRan = allRan && target->ran.GetFuture().WaitFor(5000).IsOK();
+        }
+        return allRan;
+    }
+
+    // run on a dedicated worker, the targets it makes ready are queued on the other workers and run in turn.
+    bool KickFromDedicated()
+    {
+        for (auto &target : targets) {
+            litebus::Async(target->GetAID(), &ReadyActor::Ready);
+        }
+        int dedicatedWorkers = 0;
+        for (auto &stats : litebus::GetActorWorkerStats()) {
+            if (stats.dedicated) {
+                ++dedicatedWorkers;
+                if (stats.queueDepth > 0) {
+                    return false;
+                }
+            }
+        }
+        bool allRan = dedicatedWorkers > 0;
+        for (auto &target : targets) {
+            allRan = allRan && target->ran.GetFuture().WaitFor(5000).IsOK();
+        }
+        return allRan;
+    }
+
+    std::vector<std::shared_ptr<ReadyActor>> targets;
+};
+
 std::string serUrl = "tcp://127.0.0.1:4100";
 std::string serName = "server_";
 
@@ -646,6 +757,243 @@ TEST_F(ActorTest, ActorTwoModelsThread)
     litebus::Await(app1->GetAID());
 }
 
+TEST_F(ActorTest, LockFreeMailboxSharedThread)
+{
+    const int producers = 4;
+    const int msgNum = 5000;
+    auto actor = std::make_shared<CountActor>("LockFreeShared", producers, msgNum);
+    actor->SetMailboxType(MailboxType::LOCK_FREE);
+    auto aid = litebus::Spawn(actor, true);
+    SendToCountActor(aid, producers, msgNum);
+    auto done = actor->done.GetFuture();
+    ASSERT_TRUE(done.WaitFor(10000).IsOK());
+    EXPECT_TRUE(done.Get());
+    EXPECT_EQ(actor->received, producers * msgNum);
+    litebus::Terminate(aid);
+    litebus::Await(aid);
+}
+
+TEST_F(ActorTest, LockFreeMailboxSingleThread)
+{
+    const int producers = 4;
+    const int msgNum = 5000;
+    auto actor = std::make_shared<CountActor>("LockFreeSingle", producers, msgNum);
+    actor->SetMailboxType(MailboxType::LOCK_FREE);
+    auto aid = litebus::Spawn(actor, false);
+    SendToCountActor(aid, producers, msgNum);
+    auto done = actor->done.GetFuture();
+    ASSERT_TRUE(done.WaitFor(10000).IsOK());
+    EXPECT_TRUE(done.Get());
+    EXPECT_EQ(actor->received, producers * msgNum);
+    litebus::Terminate(aid);
+    litebus::Await(aid);
+}
+
+TEST_F(ActorTest, LockFreeMailboxDrainOrder)
+{
+    MpscMailbox mailbox;
+    EXPECT_TRUE(mailbox.Empty());
+    for (int i = 0; i < 3; ++i) {
+        std::unique_ptr<MessageBase> msg(new MessageBase(std::to_string(i)));
+        EXPECT_EQ(mailbox.Push(msg), i == 0);
+    }
+    EXPECT_EQ(mailbox.Pending(), 3);
+    MessageBase *head = mailbox.Drain();
+    MessageBase *msgs = head;
+    EXPECT_TRUE(mailbox.Empty());
+    EXPECT_EQ(mailbox.Pending(), 0);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(msgs != nullptr);
+        EXPECT_EQ(msgs->Name(), std::to_string(i));
+        msgs = MpscMailbox::Next(msgs);
+    }
+    EXPECT_TRUE(msgs == nullptr);
+    MpscMailbox::Release(head);
+}
+
+TEST_F(ActorTest, WorkStealingRunsReadyActorsOfBusyWorker)
+{
+    std::vector<std::shared_ptr<ReadyActor>> targets;
+    for (int i = 0; i < 3; ++i) {
+        targets.push_back(std::make_shared<ReadyActor>("StealTarget" + std::to_string(i)));
+        litebus::Spawn(targets.back());
+    }
+    auto busy = std::make_shared<BusyActor>("StealBusy", targets);
+    litebus::Spawn(busy);
+
+    uint64_t stealsBefore = 0;
+    for (auto &stats : litebus::GetActorWorkerStats()) {
+        stealsBefore += stats.steals;
+    }
+    auto result = litebus::Async(busy->GetAID(), &BusyActor::KickAndWait);
+    ASSERT_TRUE(result.WaitFor(10000).IsOK());
+    EXPECT_TRUE(result.Get());
+
+    auto allStats = litebus::GetActorWorkerStats();
+    EXPECT_FALSE(allStats.empty());
+    uint64_t stealsAfter = 0;
+    uint64_t runs = 0;
+    for (auto &stats : allStats) {
+        stealsAfter += stats.steals;
+        runs += stats.runs;
+    }
+    EXPECT_GE(stealsAfter, stealsBefore + targets.size());
+    EXPECT_GT(runs, 0u);
+
+    litebus::Terminate(busy->GetAID());
+    litebus::Await(busy->GetAID());
+    for (auto &target : targets) {
+        litebus::Terminate(target->GetAID());
+        litebus::Await(target->GetAID());
+    }
+}
+
+TEST_F(ActorTest, DedicatedActorDoesNotQueueReadyActorsOnItsWorker)
+{
+    std::vector<std::shared_ptr<ReadyActor>> targets;
+    for (int i = 0; i < 3; ++i) {
+        targets.push_back(std::make_shared<ReadyActor>("DedicatedTarget" + std::to_string(i)));
+        litebus::Spawn(targets.back());
+    }
+    auto dedicated = std::make_shared<BusyActor>("DedicatedKicker", targets);
+    litebus::Spawn(dedicated, false);
+
+    auto result = litebus::Async(dedicated->GetAID(), &BusyActor::KickFromDedicated);
+    ASSERT_TRUE(result.WaitFor(10000).IsOK());
+    EXPECT_TRUE(result.Get());
+
+    litebus::Terminate(dedicated->GetAID());
+    litebus::Await(dedicated->GetAID());
+    for (auto &target : targets) {
+        litebus::Terminate(target->GetAID());
+        litebus::Await(target->GetAID());
+    }
+}
+
+void CheckMsgQuantum(const std::string &name, MailboxType type)
+{
+    const int msgNum = 100;
+    const uint32_t quantum = 10;
+    auto actor = std::make_shared<CountActor>(name, 1, msgNum);
+    actor->SetMailboxType(type);
+    actor->SetMsgQuantum(quantum);
+    // queue all the messages before the actor starts so that one run would drain them without the quantum
+    auto aid = litebus::Spawn(actor, true, false);
+    SendToCountActor(aid, 1, msgNum);
+    litebus::SetActorStatus(aid, true);
+    auto done = actor->done.GetFuture();
+    ASSERT_TRUE(done.WaitFor(10000).IsOK());
+    EXPECT_TRUE(done.Get());
+
+    auto stats = actor->GetRunStats();
+    EXPECT_EQ(stats.name, name);
+    EXPECT_EQ(stats.msgs, static_cast<uint64_t>(msgNum));
+    EXPECT_GE(stats.yields, msgNum / quantum - 1);
+    EXPECT_GE(stats.runs, stats.yields);
+
+    bool found = false;
+    for (auto &actorStats : litebus::GetActorRunStats()) {
+        found = found || actorStats.name == name;
+    }
+    EXPECT_TRUE(found);
+    litebus::Terminate(aid);
+    litebus::Await(aid);
+}
+
+TEST_F(ActorTest, MsgQuantumYieldsSharedThread)
+{
+    CheckMsgQuantum("QuantumList", MailboxType::LOCKED_LIST);
+    CheckMsgQuantum("QuantumLockFree", MailboxType::LOCK_FREE);
+}
+
+TEST_F(ActorTest, MsgNameTableInternAndGrow)
+{
+    MsgNameTable table;
+    const int nameNum = 5000;
+    EXPECT_EQ(table.Find("name_0"), INVALID_MSG_NAME_ID);
+    EXPECT_EQ(table.Intern("name_0"), 0u);
+    std::atomic<bool> stop(false);
+    std::atomic<bool> lost(false);
+    // lookups run without the lock while the table grows under them
+    std::thread reader([&table, &stop, &lost]() {
+        while (!stop.load()) {
+            if (table.Find("name_0") != 0) {
+                lost = true;
+            }
+        }
+    });
+    for (int i = 1; i < nameNum; ++i) {
+        EXPECT_EQ(table.Intern("name_" + std::to_string(i)), static_cast<uint32_t>(i));
+    }
+    stop = true;
+    reader.join();
+    EXPECT_FALSE(lost.load());
+    for (int i = 0; i < nameNum; ++i) {
+        EXPECT_EQ(table.Find("name_" + std::to_string(i)), static_cast<uint32_t>(i));
+        EXPECT_EQ(table.Intern("name_" + std::to_string(i)), static_cast<uint32_t>(i));
+    }
+    EXPECT_EQ(table.Find("unknown"), INVALID_MSG_NAME_ID);
+}
+
+TEST_F(ActorTest, ActorLookupAfterSpawnAndTerminate)
+{
+    std::vector<std::shared_ptr<ReadyActor>> actors;
+    for (int i = 0; i < 200; ++i) {
+        actors.push_back(std::make_shared<ReadyActor>("LookupActor" + std::to_string(i)));
+        litebus::Spawn(actors.back());
+    }
+    for (auto &actor : actors) {
+        EXPECT_EQ(ActorMgr::GetActorMgrRef()->GetActor(actor->GetAID()), actor);
+    }
+    for (auto &actor : actors) {
+        litebus::Terminate(actor->GetAID());
+        litebus::Await(actor->GetAID());
+        EXPECT_TRUE(ActorMgr::GetActorMgrRef()->GetActor(actor->GetAID()) == nullptr);
+    }
+}
+
+TEST_F(ActorTest, MsgPoolRecyclesMessages)
+{
+    std::vector<std::unique_ptr<MessageBase>> warm;
+    for (int i = 0; i < 100; ++i) {
+        warm.emplace_back(new MessageBase("warm"));
+    }
+    warm.clear();
+
+    const uint64_t msgNum = 10000;
+    auto before = litebus::GetMsgAllocStats();
+    for (uint64_t i = 0; i < msgNum; ++i) {
+        std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageBase("pooled"));
+        ASSERT_TRUE(msg != nullptr);
+    }
+    auto after = litebus::GetMsgAllocStats();
+    // the other litebus threads may allocate at the same time, the loop itself reuses the warm blocks
+    EXPECT_LT(after.heapAllocs - before.heapAllocs, msgNum / 10);
+}
+
+TEST_F(ActorTest, MsgPoolRecyclesAsyncMessagesAcrossThreads)
+{
+    auto actor = std::make_shared<ReadyActor>("PoolAsyncActor");
+    auto aid = litebus::Spawn(actor);
+    const int rounds = 100;
+    const int batch = 100;
+    auto before = litebus::GetMsgAllocStats();
+    for (int round = 0; round < rounds; ++round) {
+        std::vector<Future<bool>> results;
+        for (int i = 0; i < batch; ++i) {
+            results.push_back(litebus::Async(aid, []() { return true; }));
+        }
+        for (auto &result : results) {
+            ASSERT_TRUE(result.Get());
+        }
+    }
+    auto after = litebus::GetMsgAllocStats();
+    // the messages freed on the actor thread come back to this thread through the depot
+    EXPECT_LT(after.heapAllocs - before.heapAllocs, static_cast<uint64_t>(rounds * batch / 4));
+    litebus::Terminate(aid);
+    litebus::Await(aid);
+}
+
 TEST_F(ActorTest, TestLink)
 {
     auto app2 = std::make_shared<Worker2>("Worker2");
@@ -0,0 +1,178 @@
+#include <time.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+
+#include "actor/actor.hpp"
+#include "actor/actormgr.hpp"
+#include "actor/buslog.hpp"
+#include "async/async.hpp"
+#include "async/flag_parser_impl.hpp"
+
+#include "litebus.hpp"
+
+using namespace litebus;
+using namespace std;
+
+static inline uint64_t get_time_us(void)
+{
+    uint64_t retval = 0;
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    retval = ts.tv_sec * 1000000;    // USECS_IN_SEC *NSECS_IN_USEC;
+    retval += ts.tv_nsec / 1000;
+    return retval;
+}
+
+class MyFlagParser : public litebus::flag::FlagParser {
+public:
+    MyFlagParser()
+    {
+        AddFlag(&MyFlagParser::url, "url", "Set local url", std::string("tcp://127.0.0.1:8090"));
+        AddFlag(&MyFlagParser::producerNum, "producerNum", "Set producer thread num", 8);
+        AddFlag(&MyFlagParser::sendCount, "sendCount", "Set sendCount for each producer", 200000);
+        AddFlag(&MyFlagParser::sharedThread, "sharedThread", "Spawn the sink actor on the shared threads", true);
+        AddFlag(&MyFlagParser::zExample, "zExample",
+                "for example:\n"
+                " ./mailbox_performance --producerNum=16 --sendCount=100000 --sharedThread=false\n"
+                " run LITEBUS_MSG_POOL=false ./mailbox_performance to compare with the heap allocated messages\n ");
+    }
+
+    std::string url;
+    long producerNum;
+    long sendCount;
+    bool sharedThread;
+    std::string zExample;
+};
+
+class SinkActor : public litebus::ActorBase {
+public:
+    SinkActor(const std::string &name, long expected) : ActorBase(name), expected(expected)
+    {
+    }
+
+    void Sink(const litebus::AID &, std::string &&, std::string &&)
+    {
+        if (++recvNum == expected) {
+            done.SetValue(get_time_us());
+        }
+    }
+
+    void SinkAsync(long)
+    {
+        if (++recvNum == expected) {
+            done.SetValue(get_time_us());
+        }
+    }
+
+    virtual void Init() override
+    {
+        Receive("sink", &SinkActor::Sink);
+    }
+
+    litebus::Promise<uint64_t> done;
+
+private:
+    long expected;
+    long recvNum = 0;
+};
+
+// N producer threads flood one actor, which is the pattern of the proxy's hot actors.
+uint64_t RunCase(const MyFlagParser &flags, MailboxType type, const std::string &name)
+{
+    auto sink = std::make_shared<SinkActor>(name, flags.producerNum * flags.sendCount);
+    sink->SetMailboxType(type);
+    AID to = litebus::Spawn(sink, flags.sharedThread);
+
+    std::atomic<bool> go(false);
+    std::vector<std::thread> producers;
+    for (long i = 0; i < flags.producerNum; ++i) {
+        producers.emplace_back([&flags, &go, to]() {
+            AID from("producer", to.Url());
+            while (!go.load()) {
+            }
+            for (long j = 0; j < flags.sendCount; ++j) {
+                std::unique_ptr<MessageBase> msg(new MessageBase(from, to, "sink", std::string()));
+                (void)ActorMgr::GetActorMgrRef()->Send(to, std::move(msg));
+            }
+        });
+    }
+
+    uint64_t startTime = get_time_us();
+    go.store(true);
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    uint64_t endTime = sink->done.GetFuture().Get();
+
+    litebus::Terminate(to);
+    litebus::Await(to);
+    return endTime - startTime;
+}
+
+// same flood through litebus::Async, it reports the heap blocks the message pool took per message
+uint64_t RunAsyncCase(const MyFlagParser &flags, const std::string &name, double &heapAllocsPerMsg)
+{
+    auto sink = std::make_shared<SinkActor>(name, flags.producerNum * flags.sendCount);
+    AID to = litebus::Spawn(sink, flags.sharedThread);
+
+    std::atomic<bool> go(false);
+    std::vector<std::thread> producers;
+    for (long i = 0; i < flags.producerNum; ++i) {
+        producers.emplace_back([&flags, &go, to]() {
+            while (!go.load()) {
+            }
+            for (long j = 0; j < flags.sendCount; ++j) {
+                litebus::Async(to, &SinkActor::SinkAsync, j);
+            }
+        });
+    }
+
+    MsgAllocStats before = litebus::GetMsgAllocStats();
+    uint64_t startTime = get_time_us();
+    go.store(true);
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    uint64_t endTime = sink->done.GetFuture().Get();
+    MsgAllocStats after = litebus::GetMsgAllocStats();
+    heapAllocsPerMsg = static_cast<double>(after.heapAllocs - before.heapAllocs) /
+                       static_cast<double>(flags.producerNum * flags.sendCount);
+
+    litebus::Terminate(to);
+    litebus::Await(to);
+    return endTime - startTime;
+}
+
+int main(int argc, char **argv)
+{
+    signal(SIGPIPE, SIG_IGN);
+    MyFlagParser flags;
+    flags.ParseFlags(argc, argv);
+
+    if (flags.help) {
+        std::cout << flags.Usage() << std::endl;
+        return 0;
+    }
+
+    litebus::Initialize(flags.url);
+    long total = flags.producerNum * flags.sendCount;
+    uint64_t listCost = RunCase(flags, MailboxType::LOCKED_LIST, "sink_list");
+    uint64_t lockFreeCost = RunCase(flags, MailboxType::LOCK_FREE, "sink_lockfree");
+    double heapAllocsPerMsg = 0;
+    uint64_t asyncCost = RunAsyncCase(flags, "sink_async", heapAllocsPerMsg);
+
+    std::cout << "producers: " << flags.producerNum << ", messages: " << total
+              << ", sharedThread: " << flags.sharedThread << std::endl;
+    std::cout << "list+mutex mailbox, cost(us): " << listCost << ", tps: " << total * 1000000 / (listCost + 1)
+              << std::endl;
+    std::cout << "lock-free mailbox,  cost(us): " << lockFreeCost << ", tps: " << total * 1000000 / (lockFreeCost + 1)
+              << std::endl;
+    std::cout << "async message,      cost(us): " << asyncCost << ", tps: " << total * 1000000 / (asyncCost + 1)
+              << ", pool heap allocations per message: " << heapAllocsPerMsg << std::endl;
+
+    litebus::Finalize();
+    return 0;
+}
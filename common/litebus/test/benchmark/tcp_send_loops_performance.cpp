@@ -0,0 +1,270 @@
+#include <time.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "actor/actor.hpp"
+#include "actor/actormgr.hpp"
+#include "actor/buslog.hpp"
+#include "async/async.hpp"
+#include "async/flag_parser_impl.hpp"
+
+#include "litebus.hpp"
+
+using namespace litebus;
+using namespace std;
+
+static inline uint64_t get_time_us(void)
+{
+    uint64_t retval = 0;
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    retval = ts.tv_sec * 1000000;    // USECS_IN_SEC *NSECS_IN_USEC;
+    retval += ts.tv_nsec / 1000;
+    return retval;
+}
+
+class MyFlagParser : public litebus::flag::FlagParser {
+public:
+    MyFlagParser()
+    {
+        AddFlag(&MyFlagParser::type, "type", "empty to run all the cases, sink or source for the child processes",
+                std::string());
+        AddFlag(&MyFlagParser::url, "url", "Set local url of a sink or source", std::string());
+        AddFlag(&MyFlagParser::ip, "ip", "Set ip of all the processes", std::string("127.0.0.1"));
+        AddFlag(&MyFlagParser::basePort, "basePort", "Set port of the first sink", 9310);
+        AddFlag(&MyFlagParser::peers, "peers", "Set sink process num, each one is fed by one producer thread", 8);
+        AddFlag(&MyFlagParser::sendCount, "sendCount", "Set sendCount for each sink", 20000);
+        AddFlag(&MyFlagParser::msgSize, "msgSize", "Set msgSize", 1024);
+        AddFlag(&MyFlagParser::loops, "loops", "Set the LITEBUS_TCP_SEND_LOOPS of each case", std::string("1,2,4,8"));
+        AddFlag(&MyFlagParser::sliceBody, "sliceBody", "The sinks take the body as a slice", false);
+        AddFlag(&MyFlagParser::zExample, "zExample",
+                "for example:\n"
+                " ./tcp_send_loops_performance --peers=16 --sendCount=50000 --loops=1,4,16\n"
+                " LITEBUS_TCP_RECV_RING=true ./tcp_send_loops_performance --msgSize=65536 --sliceBody=true\n ");
+    }
+
+    std::string type;
+    std::string url;
+    std::string ip;
+    long basePort;
+    long peers;
+    long sendCount;
+    long msgSize;
+    std::string loops;
+    bool sliceBody;
+    std::string zExample;
+};
+
+// counts the pings, a flush returns the count of the round to the source
+class SinkActor : public litebus::ActorBase {
+public:
+    SinkActor(const std::string &name, bool sliceBody) : ActorBase(name), sliceBody(sliceBody)
+    {
+    }
+
+    void Ping(const litebus::AID &, std::string &&, std::string &&)
+    {
+        ++recvNum;
+    }
+
+    void PingSlice(const litebus::AID &, std::string &&, litebus::MsgSlice &&)
+    {
+        ++recvNum;
+    }
+
+    void Flush(const litebus::AID &from, std::string &&, std::string &&)
+    {
+        Send(from, "flushed", std::to_string(recvNum));
+        recvNum = 0;
+    }
+
+    virtual void Init() override
+    {
+        if (sliceBody) {
+            Receive("ping", &SinkActor::PingSlice);
+        } else {
+            Receive("ping", &SinkActor::Ping);
+        }
+        Receive("flush", &SinkActor::Flush);
+    }
+
+private:
+    bool sliceBody;
+    long recvNum = 0;
+};
+
+class SourceActor : public litebus::ActorBase {
+public:
+    SourceActor(const std::string &name, long peers) : ActorBase(name), peers(peers)
+    {
+    }
+
+    void Flushed(const litebus::AID &, std::string &&, std::string &&body)
+    {
+        recvNum += std::stol(body);
+        if (++flushedNum == peers) {
+            flushedNum = 0;
+            rounds[round++].SetValue(recvNum);
+            recvNum = 0;
+        }
+    }
+
+    virtual void Init() override
+    {
+        Receive("flushed", &SourceActor::Flushed);
+    }
+
+    // the warm up round and the measured round
+    litebus::Promise<long> rounds[2];
+
+private:
+    long peers;
+    int round = 0;
+    long flushedNum = 0;
+    long recvNum = 0;
+};
+
+std::string SinkUrl(const MyFlagParser &flags, long index)
+{
+    return "tcp://" + flags.ip + ":" + std::to_string(flags.basePort + index);
+}
+
+void SendToSinks(const MyFlagParser &flags, const AID &from, const std::string &name, long count)
+{
+    std::vector<std::thread> producers;
+    for (long i = 0; i < flags.peers; ++i) {
+        AID to("sink", SinkUrl(flags, i));
+        producers.emplace_back([&flags, from, to, name, count]() {
+            for (long j = 0; j < count; ++j) {
+                std::unique_ptr<MessageBase> msg(new MessageBase(from, to, name, std::string(flags.msgSize, 'A')));
+                (void)ActorMgr::GetActorMgrRef()->Send(to, std::move(msg));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+}
+
+int RunSink(const MyFlagParser &flags)
+{
+    litebus::Initialize(flags.url);
+    AID sink = litebus::Spawn(std::make_shared<SinkActor>("sink", flags.sliceBody));
+    litebus::Await(sink);
+    litebus::Finalize();
+    return 0;
+}
+
+// N producer threads feed N remote sinks, the send loops of the process carry the traffic.
+int RunSource(const MyFlagParser &flags)
+{
+    litebus::Initialize(flags.url);
+    auto source = std::make_shared<SourceActor>("source", flags.peers);
+    AID from = litebus::Spawn(source);
+
+    // establish the links first, the messages beyond the queue of a connecting link are dropped
+    SendToSinks(flags, from, "flush", 1);
+    (void)source->rounds[0].GetFuture().Get();
+
+    uint64_t startTime = get_time_us();
+    SendToSinks(flags, from, "ping", flags.sendCount);
+    SendToSinks(flags, from, "flush", 1);
+    long recvNum = source->rounds[1].GetFuture().Get();
+    uint64_t cost = get_time_us() - startTime;
+
+    const char *loops = getenv("LITEBUS_TCP_SEND_LOOPS");
+    const char *recvRing = getenv("LITEBUS_TCP_RECV_RING");
+    long total = flags.peers * flags.sendCount;
+    std::cout << "send loops: " << (loops == nullptr ? "1" : loops)
+              << ", recv ring: " << (recvRing == nullptr ? "false" : recvRing) << ", peers: " << flags.peers
+              << ", messages: " << total << ", received: " << recvNum << ", cost(us): " << cost
+              << ", tps: " << total * 1000000 / (cost + 1) << ", MB/s: " << total * flags.msgSize / (cost + 1)
+              << std::endl;
+
+    litebus::Terminate(from);
+    litebus::Await(from);
+    litebus::Finalize();
+    return 0;
+}
+
+pid_t StartChild(const std::string &self, const std::vector<std::string> &args, const std::string &loops)
+{
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    if (!loops.empty()) {
+        (void)setenv("LITEBUS_TCP_SEND_LOOPS", loops.c_str(), 1);
+    }
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(self.c_str()));
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    (void)execv(self.c_str(), argv.data());
+    std::cout << "execv failed, errno: " << errno << std::endl;
+    _exit(1);
+}
+
+int RunAll(const MyFlagParser &flags, const std::string &self)
+{
+    std::vector<std::string> common = { "--ip=" + flags.ip, "--basePort=" + std::to_string(flags.basePort),
+                                        "--peers=" + std::to_string(flags.peers),
+                                        "--sendCount=" + std::to_string(flags.sendCount),
+                                        "--msgSize=" + std::to_string(flags.msgSize),
+                                        std::string("--sliceBody=") + (flags.sliceBody ? "true" : "false") };
+    std::vector<pid_t> sinks;
+    for (long i = 0; i < flags.peers; ++i) {
+        std::vector<std::string> args = common;
+        args.push_back("--type=sink");
+        args.push_back("--url=" + SinkUrl(flags, i));
+        sinks.push_back(StartChild(self, args, ""));
+    }
+    sleep(1);
+
+    long index = flags.peers;
+    std::stringstream loops(flags.loops);
+    std::string loopCount;
+    while (std::getline(loops, loopCount, ',')) {
+        std::vector<std::string> args = common;
+        args.push_back("--type=source");
+        args.push_back("--url=" + SinkUrl(flags, index++));
+        pid_t source = StartChild(self, args, loopCount);
+        int status = 0;
+        (void)waitpid(source, &status, 0);
+    }
+
+    for (auto sink : sinks) {
+        (void)kill(sink, SIGKILL);
+        int status = 0;
+        (void)waitpid(sink, &status, 0);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    signal(SIGPIPE, SIG_IGN);
+    MyFlagParser flags;
+    flags.ParseFlags(argc, argv);
+
+    if (flags.help) {
+        std::cout << flags.Usage() << std::endl;
+        return 0;
+    }
+
+    if (flags.type == "sink") {
+        return RunSink(flags);
+    }
+    if (flags.type == "source") {
+        return RunSource(flags);
+    }
+    return RunAll(flags, argv[0]);
+}
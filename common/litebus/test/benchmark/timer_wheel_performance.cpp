@@ -0,0 +1,167 @@
+#include <time.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+
+#include "actor/buslog.hpp"
+#include "async/flag_parser_impl.hpp"
+#include "timer/timertools.hpp"
+
+#include "litebus.hpp"
+
+using namespace litebus;
+using namespace std;
+
+static inline uint64_t get_time_us(void)
+{
+    uint64_t retval = 0;
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    retval = ts.tv_sec * 1000000;    // USECS_IN_SEC *NSECS_IN_USEC;
+    retval += ts.tv_nsec / 1000;
+    return retval;
+}
+
+class MyFlagParser : public litebus::flag::FlagParser {
+public:
+    MyFlagParser()
+    {
+        AddFlag(&MyFlagParser::url, "url", "Set local url", std::string("tcp://127.0.0.1:8091"));
+        AddFlag(&MyFlagParser::threadNum, "threadNum", "Set the thread num adding the timers", 4);
+        AddFlag(&MyFlagParser::timerCount, "timerCount", "Set the timers added and canceled by each thread", 1000000);
+        AddFlag(&MyFlagParser::fireCount, "fireCount", "Set the timers fired for each thread", 100000);
+        AddFlag(&MyFlagParser::maxDelay, "maxDelay", "Set the max delay(ms) of the fired timers", 1000);
+        AddFlag(&MyFlagParser::zExample, "zExample",
+                "for example:\n"
+                " ./timer_wheel_performance --threadNum=8 --timerCount=2000000 --fireCount=200000\n ");
+    }
+
+    std::string url;
+    long threadNum;
+    long timerCount;
+    long fireCount;
+    long maxDelay;
+    std::string zExample;
+};
+
+template <typename F>
+uint64_t RunThreads(const MyFlagParser &flags, F &&func)
+{
+    std::vector<std::thread> threads;
+    uint64_t startTime = get_time_us();
+    for (long i = 0; i < flags.threadNum; ++i) {
+        threads.emplace_back(func);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return get_time_us() - startTime;
+}
+
+// the request timeouts pattern: a timer is armed for each request and canceled by the response
+uint64_t RunAddCancel(const MyFlagParser &flags, long &canceled)
+{
+    std::atomic<long> canceledNum(0);
+    uint64_t cost = RunThreads(flags, [&flags, &canceledNum]() {
+        long num = 0;
+        for (long j = 0; j < flags.timerCount; ++j) {
+            Timer timer = TimerTools::AddTimer(30000 + j % 1000, AID(), []() {});
+            if (TimerTools::Cancel(timer)) {
+                ++num;
+            }
+        }
+        canceledNum += num;
+    });
+    canceled = canceledNum.load();
+    return cost;
+}
+
+// adds all the timers first and cancels them in the adding order, the cancels find them in the wheel
+uint64_t RunAddThenCancel(const MyFlagParser &flags, long &canceled)
+{
+    std::atomic<long> canceledNum(0);
+    uint64_t cost = RunThreads(flags, [&flags, &canceledNum]() {
+        std::vector<Timer> timers;
+        timers.reserve(flags.timerCount);
+        for (long j = 0; j < flags.timerCount; ++j) {
+            timers.push_back(TimerTools::AddTimer(30000 + j % 100000, AID(), []() {}));
+        }
+        long num = 0;
+        for (const auto &timer : timers) {
+            if (TimerTools::Cancel(timer)) {
+                ++num;
+            }
+        }
+        canceledNum += num;
+    });
+    canceled = canceledNum.load();
+    return cost;
+}
+
+// every timer fires, the lateness is how long past its expiry it ran
+uint64_t RunFire(const MyFlagParser &flags, uint64_t &maxLateness, uint64_t &avgLateness)
+{
+    long total = flags.threadNum * flags.fireCount;
+    std::atomic<long> firedNum(0);
+    std::atomic<uint64_t> lateness(0);
+    std::atomic<uint64_t> maxLate(0);
+    uint64_t cost = RunThreads(flags, [&flags, &firedNum, &lateness, &maxLate]() {
+        for (long j = 0; j < flags.fireCount; ++j) {
+            Duration delay = 1 + j % flags.maxDelay;
+            uint64_t expire = get_time_us() + delay * 1000;
+            (void)TimerTools::AddTimer(delay, AID(), [expire, &firedNum, &lateness, &maxLate]() {
+                uint64_t now = get_time_us();
+                uint64_t late = now > expire ? now - expire : 0;
+                lateness += late;
+                uint64_t prev = maxLate.load();
+                while (late > prev && !maxLate.compare_exchange_weak(prev, late)) {
+                }
+                ++firedNum;
+            });
+        }
+    });
+    uint64_t startTime = get_time_us() - cost;
+    while (firedNum.load() < total) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    maxLateness = maxLate.load();
+    avgLateness = lateness.load() / total;
+    return get_time_us() - startTime;
+}
+
+int main(int argc, char **argv)
+{
+    signal(SIGPIPE, SIG_IGN);
+    MyFlagParser flags;
+    flags.ParseFlags(argc, argv);
+
+    if (flags.help) {
+        std::cout << flags.Usage() << std::endl;
+        return 0;
+    }
+
+    litebus::Initialize(flags.url);
+    long total = flags.threadNum * flags.timerCount;
+    long canceled = 0;
+    uint64_t addCancelCost = RunAddCancel(flags, canceled);
+    std::cout << "threads: " << flags.threadNum << ", timers: " << total << std::endl;
+    std::cout << "add+cancel,        cost(us): " << addCancelCost
+              << ", ops/s: " << 2 * total * 1000000 / (addCancelCost + 1) << ", canceled: " << canceled << std::endl;
+
+    uint64_t addThenCancelCost = RunAddThenCancel(flags, canceled);
+    std::cout << "add all+cancel all, cost(us): " << addThenCancelCost
+              << ", ops/s: " << 2 * total * 1000000 / (addThenCancelCost + 1) << ", canceled: " << canceled
+              << std::endl;
+
+    uint64_t maxLateness = 0;
+    uint64_t avgLateness = 0;
+    uint64_t fireCost = RunFire(flags, maxLateness, avgLateness);
+    std::cout << "fire " << flags.threadNum * flags.fireCount << " timers in " << flags.maxDelay
+              << "ms, cost(us): " << fireCost << ", avg lateness(us): " << avgLateness
+              << ", max lateness(us): " << maxLateness << std::endl;
+
+    litebus::Finalize();
+    return 0;
+}
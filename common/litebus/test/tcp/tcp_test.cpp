@@ -8,6 +8,7 @@
 #include <signal.h>
 
 #include <sys/resource.h>
+#include <sys/socket.h>
 
 #include <sys/types.h>
 #include <dirent.h>
@@ -21,6 +22,7 @@
 #include "async/async.hpp"
 #include "securec.h"
 #include "tcp/tcpmgr.hpp"
+#include "tcp/tcp_socket.hpp"
 #include "evloop/evloop.hpp"
 
 using namespace std;
@@ -277,6 +279,76 @@ TEST_F(TCPTest, StartServer2)
     ASSERT_TRUE(ret);
 }
 
+TEST_F(TCPTest, SendLoopsShardByPeerUrl)
+{
+    setenv("LITEBUS_TCP_SEND_LOOPS", "4", true);
+    std::unique_ptr<TCPMgr> io(new TCPMgr());
+    bool ret = io->Init();
+    unsetenv("LITEBUS_TCP_SEND_LOOPS");
+    ASSERT_TRUE(ret);
+    ASSERT_EQ(io->sendEvloops.size(), 4u);
+    ASSERT_EQ(LinkMgr::GetLinkMgrCount(), 4u);
+
+    // a peer gets the send loop and the link table of the same index
+    for (int port = 3000; port < 3032; ++port) {
+        std::string peer = m_localIP + ":" + std::to_string(port);
+        size_t index = LinkMgr::GetShardIndex(peer, 4);
+        ASSERT_LT(index, 4u);
+        EXPECT_EQ(io->GetSendEvloop(peer), io->sendEvloops[index]);
+        EXPECT_EQ(LinkMgr::GetLinkMgr(peer), LinkMgr::GetLinkMgrShard(index));
+        EXPECT_EQ(LinkMgr::GetLinkMgrShard(index)->sendEvloop, io->sendEvloops[index]);
+    }
+
+    // an accepted connection moves to the link table and the send loop of its peer
+    std::string movedPeer;
+    for (int port = 3000; movedPeer.empty(); ++port) {
+        std::string peer = m_localIP + ":" + std::to_string(port);
+        if (LinkMgr::GetShardIndex(peer, 4) != 0) {
+            movedPeer = peer;
+        }
+    }
+    LinkMgr *acceptMgr = LinkMgr::GetLinkMgr();
+    LinkMgr *peerMgr = LinkMgr::GetLinkMgr(movedPeer);
+    Connection accepted;
+    accepted.fd = 1000;
+    accepted.isRemote = true;
+    accepted.linkMgr = acceptMgr;
+    accepted.sendEvloop = io->sendEvloop;
+    acceptMgr->AddRemoteLink(&accepted);
+    accepted.to = movedPeer;
+    ConnectionUtil::MoveToPeerLinkMgr(&accepted);
+    EXPECT_EQ(ConnectionUtil::GetLinkMgr(&accepted), peerMgr);
+    EXPECT_EQ(accepted.sendEvloop, peerMgr->sendEvloop);
+    EXPECT_EQ(accepted.connState, ConnectionState::CONNECTED);
+    EXPECT_EQ(acceptMgr->allRemoteLinks.count(accepted.fd), 0u);
+    EXPECT_EQ(peerMgr->allRemoteLinks.count(accepted.fd), 1u);
+    EXPECT_EQ(peerMgr->ExactFindLink(movedPeer, true), &accepted);
+    std::unique_lock<std::mutex> lock;
+    EXPECT_EQ(ConnectionUtil::LockLinkMgr(&accepted, lock), peerMgr);
+    lock.unlock();
+    peerMgr->remoteLinks.erase(movedPeer);
+    peerMgr->allRemoteLinks.erase(accepted.fd);
+    accepted.fd = -1;
+
+    io->RegisterMsgHandle(msgHandle);
+    string url = "tcp://" + m_localIP + ":2226";
+    ret = io->StartIOServer(url, url);
+    ASSERT_TRUE(ret);
+
+    recvNum = 0;
+    string peers[] = { url, "tcp://" + m_localIP + ":2223" };
+    for (int i = 0; i < 100; ++i) {
+        for (const auto &peer : peers) {
+            std::unique_ptr<MessageBase> message(
+                new MessageBase(AID("testserver", url), AID("testserver", peer), "testname", string(100, 'A')));
+            io->Send(std::move(message));
+        }
+    }
+    ret = CheckRecvNum(200, 5);
+    io->Finish();
+    ASSERT_TRUE(ret);
+}
+
 // server -> client -> server -> client
 TEST_F(TCPTest, send1Msg)
 {
@@ -1384,6 +1456,170 @@ TEST_F(TCPTest, EvLoopInit)
     evLoop = nullptr;
 }
 
+struct UringRecvContext {
+    EvLoop *evLoop = nullptr;
+    std::mutex mutex;
+    std::string received;
+    std::atomic<int> outEvents{ 0 };
+    std::atomic<bool> eof{ false };
+};
+
+void UringRecvHandler(int fd, uint32_t events, void *data)
+{
+    UringRecvContext *context = static_cast<UringRecvContext *>(data);
+    if (events & static_cast<uint32_t>(EPOLLOUT)) {
+        ++context->outEvents;
+        (void)context->evLoop->ModifyFdEvent(fd, static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLRDHUP));
+    }
+    char buf[1000];
+    ssize_t len = 0;
+    while ((len = context->evLoop->Recv(fd, buf, sizeof(buf), 0)) > 0) {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        context->received.append(buf, len);
+    }
+    if (len == 0) {
+        context->eof = true;
+    }
+}
+
+// the io_uring loop receives into the loop with a multishot recv, the handler reads it back by EvLoop::Recv
+TEST_F(TCPTest, EvLoopIoUringRecvMultishot)
+{
+    if (!UringPoller::IsSupported()) {
+        BUSLOG_INFO("io_uring is not supported, skip");
+        return;
+    }
+    (void)setenv("LITEBUS_EVLOOP_IO_URING", "true", 1);
+    EvLoop *evLoop = new EvLoop();
+    ASSERT_TRUE(evLoop->Init("testUringLoop"));
+    (void)unsetenv("LITEBUS_EVLOOP_IO_URING");
+    ASSERT_TRUE(evLoop->IsUring());
+
+    int fds[2] = { -1, -1 };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    UringRecvContext context;
+    context.evLoop = evLoop;
+    ASSERT_EQ(evLoop->AddFdEvent(fds[0],
+                                 static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLRDHUP) |
+                                     EVLOOP_RECV_MULTISHOT,
+                                 UringRecvHandler, &context),
+              BUS_OK);
+    ASSERT_NE(evLoop->AddFdEvent(fds[0], static_cast<uint32_t>(EPOLLIN), UringRecvHandler, &context), BUS_OK);
+
+    // more than the provided buffers hold, the receive is armed again after the buffers run out
+    std::string expected;
+    for (int i = 0; i < 4096; ++i) {
+        expected += std::string(1000, 'a' + i % 26);
+    }
+    std::thread writer([&expected, &fds]() {
+        size_t offset = 0;
+        while (offset < expected.size()) {
+            ssize_t len = write(fds[1], expected.data() + offset, expected.size() - offset);
+            if (len > 0) {
+                offset += static_cast<size_t>(len);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+    writer.join();
+
+    // output interest set by another thread goes to the loop as a function
+    ASSERT_EQ(evLoop->ModifyFdEvent(fds[0], static_cast<uint32_t>(EPOLLIN) | static_cast<uint32_t>(EPOLLOUT) |
+                                                static_cast<uint32_t>(EPOLLRDHUP)),
+              BUS_OK);
+    (void)close(fds[1]);
+    for (int i = 0; i < 500 && !context.eof; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(context.eof);
+    ASSERT_GE(context.outEvents.load(), 1);
+    {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        ASSERT_EQ(context.received.size(), expected.size());
+        ASSERT_TRUE(context.received == expected);
+    }
+
+    ASSERT_EQ(evLoop->DelFdEvent(fds[0]), BUS_OK);
+    ASSERT_NE(evLoop->DelFdEvent(fds[0]), BUS_OK);
+    (void)close(fds[0]);
+    delete evLoop;
+}
+
+struct UringSlowRecvContext {
+    EvLoop *evLoop = nullptr;
+    std::string received;
+    size_t maxStash = 0;
+    std::atomic<bool> eof{ false };
+};
+
+// reads a bounded count of chunks a call like TCPMgr, slower than the peer writes
+void UringSlowRecvHandler(int fd, uint32_t, void *data)
+{
+    constexpr int maxChunks = 16;
+    UringSlowRecvContext *context = static_cast<UringSlowRecvContext *>(data);
+    EvRecvStash *stash = context->evLoop->FindRecvStash(fd);
+    if (stash != nullptr && stash->Size() > context->maxStash) {
+        context->maxStash = stash->Size();
+    }
+    char buf[1000];
+    ssize_t len = 0;
+    for (int i = 0; i < maxChunks && (len = context->evLoop->Recv(fd, buf, sizeof(buf), 0)) > 0; ++i) {
+        context->received.append(buf, len);
+    }
+    if (len == 0) {
+        context->eof = true;
+    }
+}
+
+// the receive stops above the high water mark of the stash and goes on once the handler reads it down
+TEST_F(TCPTest, EvLoopIoUringRecvStashHighWater)
+{
+    if (!UringPoller::IsSupported()) {
+        BUSLOG_INFO("io_uring is not supported, skip");
+        return;
+    }
+    (void)setenv("LITEBUS_EVLOOP_IO_URING", "true", 1);
+    EvLoop *evLoop = new EvLoop();
+    ASSERT_TRUE(evLoop->Init("testUringLoop"));
+    (void)unsetenv("LITEBUS_EVLOOP_IO_URING");
+    ASSERT_TRUE(evLoop->IsUring());
+
+    int fds[2] = { -1, -1 };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    UringSlowRecvContext context;
+    context.evLoop = evLoop;
+    ASSERT_EQ(evLoop->AddFdEvent(fds[0], static_cast<uint32_t>(EPOLLIN) | EVLOOP_RECV_MULTISHOT,
+                                 UringSlowRecvHandler, &context),
+              BUS_OK);
+
+    std::string expected;
+    for (size_t i = 0; expected.size() < EVLOOP_RECV_STASH_HIGH_WATER * 3; ++i) {
+        expected += std::string(1000, 'a' + i % 26);
+    }
+    size_t offset = 0;
+    while (offset < expected.size()) {
+        ssize_t len = write(fds[1], expected.data() + offset, expected.size() - offset);
+        if (len > 0) {
+            offset += static_cast<size_t>(len);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    (void)close(fds[1]);
+    for (int i = 0; i < 1000 && !context.eof; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(context.eof);
+    ASSERT_TRUE(context.received == expected);
+    // the completions in flight when the receive is cancelled carry at most the provided buffers
+    ASSERT_LE(context.maxStash, EVLOOP_RECV_STASH_HIGH_WATER + URING_RECV_BUF_COUNT * URING_RECV_BUF_SIZE);
+
+    ASSERT_EQ(evLoop->DelFdEvent(fds[0]), BUS_OK);
+    (void)close(fds[0]);
+    delete evLoop;
+}
+
 int getFileCount(const char *strDir)
 {
     int num = 0;
@@ -1493,6 +1729,167 @@ TEST_F(TCPTest, EventCallBack)
     c1 = nullptr;
 }
 
+// queued messages leave in a few vectored sendmsg calls, a partial write resumes in the middle of the batch
+TEST_F(TCPTest, BatchSendCoalescesQueuedMsgs)
+{
+    int fds[2] = { -1, -1 };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    int sndBuf = 16 * 1024;
+    (void)setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf));
+
+    Connection *conn = new Connection();
+    conn->fd = fds[0];
+    conn->to = "tcp://127.0.0.1:2225";
+    conn->connState = ConnectionState::CONNECTED;
+    conn->socketOperate = new TCPSocketOperate();
+    conn->sendMetrics = new SendMetrics();
+    conn->recvEvloop = new EvLoop();
+
+    const int msgNum = 200;
+    AID from("batchFrom", "tcp://127.0.0.1:2223");
+    AID to("batchTo", conn->to);
+    for (int i = 0; i < msgNum; ++i) {
+        MessageBase *msg = new MessageBase(from, to, "batch" + std::to_string(i), std::string(1000, 'a' + i % 26));
+        TCPMgr::outTcpBufSize += msg->body.size();
+        conn->outBufferSize += msg->body.size();
+        conn->sendQueue.emplace(msg);
+    }
+
+    std::string stream;
+    char buf[4096];
+    for (int round = 0; round < 1000 && (!conn->sendQueue.empty() || conn->sendTotalLen != 0); ++round) {
+        tcpUtil::ConnectionSend(conn);
+        ASSERT_EQ(conn->connState, ConnectionState::CONNECTED);
+        ssize_t len = 0;
+        while ((len = read(fds[1], buf, sizeof(buf))) > 0) {
+            stream.append(buf, len);
+        }
+    }
+    ssize_t len = 0;
+    while ((len = read(fds[1], buf, sizeof(buf))) > 0) {
+        stream.append(buf, len);
+    }
+    ASSERT_TRUE(conn->sendQueue.empty());
+    ASSERT_EQ(conn->sendTotalLen, 0u);
+    ASSERT_EQ(conn->outBufferSize, 0u);
+    ASSERT_LT(conn->sendMetrics->sendCalls, static_cast<uint64_t>(msgNum));
+    ASSERT_EQ(conn->sendMetrics->sendBytes, stream.size());
+    ASSERT_GT(conn->sendMetrics->BytesPerSyscall(), 1000);
+
+    // the frames arrive whole and in order
+    size_t offset = 0;
+    for (int i = 0; i < msgNum; ++i) {
+        ASSERT_GE(stream.size() - offset, sizeof(MsgHeader));
+        MsgHeader header;
+        (void)memcpy_s(&header, sizeof(header), stream.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        std::string name = stream.substr(offset, ntohl(header.nameLen));
+        offset += ntohl(header.nameLen) + ntohl(header.toLen) + ntohl(header.fromLen) + ntohl(header.signatureLen);
+        std::string body = stream.substr(offset, ntohl(header.bodyLen));
+        offset += ntohl(header.bodyLen);
+        ASSERT_EQ(name, "batch" + std::to_string(i));
+        ASSERT_EQ(body, std::string(1000, 'a' + i % 26));
+    }
+    ASSERT_EQ(offset, stream.size());
+
+    close(fds[0]);
+    close(fds[1]);
+    delete conn->socketOperate;
+    delete conn->sendMetrics;
+    delete conn->recvEvloop;
+    delete conn;
+}
+
+static std::vector<std::unique_ptr<MessageBase>> g_ringRecvMsgs;
+
+static void CollectRingRecvMsg(std::unique_ptr<MessageBase> &&msg)
+{
+    g_ringRecvMsgs.push_back(std::move(msg));
+}
+
+TEST_F(TCPTest, RecvRingParsesFramesInPlace)
+{
+    int fds[2] = { -1, -1 };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+
+    Connection *sender = new Connection();
+    sender->fd = fds[0];
+    sender->to = "tcp://127.0.0.1:2227";
+    sender->connState = ConnectionState::CONNECTED;
+    sender->socketOperate = new TCPSocketOperate();
+    sender->sendMetrics = new SendMetrics();
+    sender->recvEvloop = new EvLoop();
+    Connection *receiver = new Connection();
+    receiver->fd = fds[1];
+    receiver->to = "tcp://127.0.0.1:2226";
+    receiver->connState = ConnectionState::CONNECTED;
+    receiver->recvMsgType = ParseType::KMSG;
+    receiver->socketOperate = new TCPSocketOperate();
+
+    // small bodies are copied, the others stay in the receive buffer, one is larger than the buffer
+    std::vector<size_t> bodySizes = { 10, 5000, 100, RECV_RING_BUFFER_SIZE * 3, 0, 20000, 4096, 4095 };
+    AID from("ringFrom", "tcp://127.0.0.1:2226");
+    AID to("ringTo", sender->to);
+    for (size_t i = 0; i < bodySizes.size(); ++i) {
+        MessageBase *msg = new MessageBase(from, to, "ring" + std::to_string(i), std::string(bodySizes[i], 'a' + i));
+        TCPMgr::outTcpBufSize += msg->body.size();
+        sender->outBufferSize += msg->body.size();
+        sender->sendQueue.emplace(msg);
+    }
+
+    g_ringRecvMsgs.clear();
+    for (int round = 0; round < 1000 && g_ringRecvMsgs.size() < bodySizes.size(); ++round) {
+        tcpUtil::ConnectionSend(sender);
+        ASSERT_GE(ConnectionUtil::RecvKMsgRing(receiver, CollectRingRecvMsg), 0);
+    }
+    ASSERT_EQ(g_ringRecvMsgs.size(), bodySizes.size());
+    for (size_t i = 0; i < bodySizes.size(); ++i) {
+        MessageBase *msg = g_ringRecvMsgs[i].get();
+        EXPECT_EQ(msg->Name(), "ring" + std::to_string(i));
+        EXPECT_EQ(msg->From().Name(), "ringFrom");
+        EXPECT_EQ(msg->To().Name(), "ringTo");
+        EXPECT_EQ(msg->HasBodySlice(), bodySizes[i] >= RECV_SLICE_MIN_LEN);
+        MsgSlice slice = msg->TakeBodySlice();
+        ASSERT_EQ(slice.Size(), bodySizes[i]);
+        EXPECT_EQ(slice.ToString(), std::string(bodySizes[i], 'a' + i));
+    }
+
+    // the slices keep their buffer after the connection moves on
+    MessageBase *msg = new MessageBase(from, to, "ringLast", std::string(30000, 'z'));
+    TCPMgr::outTcpBufSize += msg->body.size();
+    sender->outBufferSize += msg->body.size();
+    sender->sendQueue.emplace(msg);
+    tcpUtil::ConnectionSend(sender);
+    ASSERT_EQ(ConnectionUtil::RecvKMsgRing(receiver, CollectRingRecvMsg), 1);
+    ASSERT_TRUE(g_ringRecvMsgs.back()->HasBodySlice());
+    MsgSlice kept = g_ringRecvMsgs.back()->TakeBodySlice();
+    receiver->recvBuffer.reset();
+    // the next message goes to a new buffer, it may reuse the memory of the old one if the slice did not own it
+    msg = new MessageBase(from, to, "ringOverwrite", std::string(30000, 'y'));
+    TCPMgr::outTcpBufSize += msg->body.size();
+    sender->outBufferSize += msg->body.size();
+    sender->sendQueue.emplace(msg);
+    tcpUtil::ConnectionSend(sender);
+    ASSERT_EQ(ConnectionUtil::RecvKMsgRing(receiver, CollectRingRecvMsg), 1);
+    EXPECT_EQ(g_ringRecvMsgs.back()->Body(), std::string(30000, 'y'));
+    ASSERT_EQ(kept.Size(), 30000u);
+    EXPECT_EQ(kept.ToString(), std::string(30000, 'z'));
+
+    // a closed peer disconnects the link
+    close(fds[0]);
+    EXPECT_EQ(ConnectionUtil::RecvKMsgRing(receiver, CollectRingRecvMsg), -1);
+    EXPECT_EQ(receiver->connState, ConnectionState::DISCONNECTING);
+    g_ringRecvMsgs.clear();
+
+    close(fds[1]);
+    delete sender->socketOperate;
+    delete sender->sendMetrics;
+    delete sender->recvEvloop;
+    delete sender;
+    delete receiver->socketOperate;
+    delete receiver;
+}
+
 // test tcpmgr.cpp 493
 TEST_F(TCPTest, OnAccept)
 {
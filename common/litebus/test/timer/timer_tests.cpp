@@ -26,6 +26,7 @@
 #include "async/asyncafter.hpp"
 #include "litebus.hpp"
 #include "timer/duration.hpp"
+#include "timer/timer_wheel.hpp"
 #include "timer/timertools.hpp"
 
 using namespace std;
@@ -340,4 +341,77 @@ TEST_F(TimerTest, CancelTimer)
 
     EXPECT_EQ(true, p_actorreceive->GetDuration() == 100);
 }
+
+TEST_F(TimerTest, TimerWheelExpireInOrder)
+{
+    Duration start = 1000;
+    TimerWheel wheel(start);
+    std::vector<Duration> delays = { 0, 1, 255, 256, 257, 5000, 16383, 16384, 20000, 1200000 };
+    std::vector<std::unique_ptr<TimerNode>> nodes;
+    for (auto it = delays.rbegin(); it != delays.rend(); ++it) {
+        nodes.emplace_back(new TimerNode(Timer(), start + *it));
+        wheel.Add(nodes.back().get());
+    }
+    TimerNode removed(Timer(), start + 300);
+    wheel.Add(&removed);
+    wheel.Remove(&removed);
+    EXPECT_EQ(wheel.Size(), delays.size());
+
+    // step to each wakeup, every node expires exactly at its tick
+    std::vector<Duration> fired;
+    Duration now = start;
+    while (wheel.Size() > 0) {
+        Duration wakeup = wheel.NextWakeup();
+        ASSERT_TRUE(wakeup >= now);
+        now = wakeup;
+        std::vector<TimerNode *> expired;
+        wheel.Advance(now, expired);
+        for (auto node : expired) {
+            EXPECT_EQ(node->expire, now);
+            fired.push_back(node->expire - start);
+        }
+    }
+    EXPECT_EQ(fired, delays);
+    EXPECT_EQ(wheel.NextWakeup(), 0u);
+
+    // a late advance expires all the overdue nodes at once
+    for (auto &node : nodes) {
+        wheel.Add(node.get());
+    }
+    std::vector<TimerNode *> expired;
+    wheel.Advance(now + 2000000, expired);
+    EXPECT_EQ(expired.size(), delays.size());
+    EXPECT_EQ(wheel.Size(), 0u);
+}
+
+TEST_F(TimerTest, CancelFromThreads)
+{
+    std::atomic<int> fired(0);
+    std::vector<std::thread> threads;
+    std::atomic<int> canceled(0);
+    const int perThread = 5000;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&fired, &canceled]() {
+            for (int j = 0; j < perThread; ++j) {
+                Timer timer = TimerTools::AddTimer(50 + j % 100, AID(), [&fired]() { ++fired; });
+                if (j % 2 == 0 && TimerTools::Cancel(timer)) {
+                    ++canceled;
+                    EXPECT_FALSE(TimerTools::Cancel(timer));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(canceled.load(), 4 * perThread / 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(fired.load(), 4 * perThread / 2);
+
+    Timer timer = TimerTools::AddTimer(10, AID(), [&fired]() { ++fired; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(fired.load(), 4 * perThread / 2 + 1);
+    EXPECT_FALSE(TimerTools::Cancel(timer));
+    EXPECT_FALSE(TimerTools::Cancel(Timer()));
+}
 }    // namespace litebus
@@ -23,6 +23,7 @@
 #include <unordered_map>
 
 #include "meta_storage_accessor/lease_actor.h"
+#include "meta_storage_accessor/write_coalescer_actor.h"
 #include "meta_store_client/meta_store_client.h"
 #include "status/status.h"
 #include "time_trigger.h"
@@ -122,6 +123,8 @@ public:
 private:
     std::shared_ptr<MetaStoreClient> metaClient_;
     std::shared_ptr<LeaseActor> leaseActor_;
+    // nullptr if the writes are not coalesced
+    std::shared_ptr<WriteCoalescerActor> writeCoalescerActor_;
 };
 }  // namespace functionsystem
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_META_STORAGE_ACCESSOR_WRITE_COALESCER_ACTOR_H
+#define COMMON_META_STORAGE_ACCESSOR_WRITE_COALESCER_ACTOR_H
+
+#include <deque>
+
+#include "actor/actor.hpp"
+#include "async/asyncafter.hpp"
+#include "meta_store_client/meta_store_client.h"
+#include "status/status.h"
+
+namespace functionsystem {
+
+// Commits the independent puts and deletes in one txn. The writes are committed in their order: a batch closes before
+// a key already in it, and one txn is committed at a time, the writes arriving meanwhile make up the next one.
+class WriteCoalescerActor : public litebus::ActorBase {
+public:
+    WriteCoalescerActor(const std::string &name, const std::shared_ptr<MetaStoreClient> &metaStoreClient,
+                        uint32_t windowMs, uint32_t maxBatchSize);
+
+    ~WriteCoalescerActor() override = default;
+
+    litebus::Future<Status> Put(const std::string &key, const std::string &value);
+
+    litebus::Future<Status> Delete(const std::string &key, bool isPrefix);
+
+protected:
+    void Finalize() override;
+
+private:
+    struct PendingWrite {
+        meta_store::TxnOperationType type;
+        std::string key;
+        std::string value;
+        bool isPrefix{ false };
+        // a prefix delete or a key routed to another kv client than the txn is committed by itself
+        bool alone{ false };
+        litebus::Promise<Status> promise;
+    };
+
+    using Batch = std::vector<PendingWrite>;
+
+    litebus::Future<Status> Enqueue(PendingWrite &&write);
+
+    static void Fail(PendingWrite &write, const std::string &message);
+
+    void OnWindow();
+
+    void Flush();
+
+    void OnCommitted(const litebus::Future<std::shared_ptr<TxnResponse>> &response,
+                     const std::shared_ptr<Batch> &batch);
+
+    // the txn is rejected as a whole, the writes are committed by themselves in their order
+    void CommitOneByOne(const std::shared_ptr<Batch> &batch);
+
+    litebus::Future<Status> CommitOne(const PendingWrite &write);
+
+    void OnCommittedOneByOne();
+
+    std::shared_ptr<MetaStoreClient> metaClient_;
+
+    uint32_t windowMs_;
+
+    uint32_t maxBatchSize_;
+
+    std::deque<PendingWrite> pending_;
+
+    // a txn or the writes of a rejected one are in flight
+    bool committing_{ false };
+
+    // the writes of the txn in flight, the ones committed one by one are resolved by the meta store client
+    std::shared_ptr<Batch> committingTxn_;
+
+    bool windowStarted_{ false };
+
+    litebus::Timer windowTimer_;
+};
+
+}  // namespace functionsystem
+
+#endif  // COMMON_META_STORAGE_ACCESSOR_WRITE_COALESCER_ACTOR_H
@@ -17,10 +17,25 @@
 #ifndef COMMON_META_STORE_CLIENT_KEY_VALUE_ETCD_KV_CLIENT_STRATEGY_H
 #define COMMON_META_STORE_CLIENT_KEY_VALUE_ETCD_KV_CLIENT_STRATEGY_H
 
+#include <set>
+
 #include "meta_store_client/key_value/kv_client_strategy.h"
 #include "rpc/client/grpc_client.h"
 
 namespace functionsystem::meta_store {
+// the keys of a paged snapshot delivered to the observer. a snapshot read again after a failed page deletes the keys
+// delivered before that it does not have anymore
+struct SnapshotKeys {
+    std::set<std::string> delivered;
+    std::set<std::string> stale;
+
+    void OnPage(const std::vector<WatchEvent> &events);
+    // the snapshot is read again from the first page
+    void Restart();
+    // the delete events of the stale keys at the revision of the snapshot
+    std::vector<WatchEvent> TakeDeleted(int64_t revision);
+};
+
 class EtcdKvClientStrategy : public KvClientStrategy {
 public:
     EtcdKvClientStrategy(const std::string &name, const std::string &address,
@@ -84,6 +99,14 @@ private:
                   const etcdserverpb::DeleteRangeRequest &request,
                   const std::shared_ptr<etcdserverpb::DeleteRangeResponse> &response, int retryTimes);
 
+    litebus::Future<std::shared_ptr<Watcher>> GetPageAndWatch(const std::string &key, const WatchOption &option,
+                                                              const ObserverFunction &observer,
+                                                              const SyncerFunction &syncer,
+                                                              const std::shared_ptr<WatchRecord> &reconnectRecord,
+                                                              const std::string &pageKey, int64_t revision,
+                                                              int restartTimes,
+                                                              const std::shared_ptr<SnapshotKeys> &keys);
+
     void OnWatch();
 
     litebus::Future<std::shared_ptr<Watcher>> RetryWatch(const std::string &key, const WatchOption &option,
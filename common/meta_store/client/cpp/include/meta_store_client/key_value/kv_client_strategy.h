@@ -24,6 +24,27 @@
 
 namespace functionsystem::meta_store {
 using ObserverFunction = std::function<bool(const std::vector<WatchEvent> &, bool)>;
+
+// an observer told whether more pages of the snapshot of a get and watch follow a synced page, it gets the last page
+// even if that is empty
+struct PagedObserver {
+    std::function<bool(const std::vector<WatchEvent> &, bool synced, bool more)> function;
+
+    bool operator()(const std::vector<WatchEvent> &events, bool synced) const
+    {
+        return function(events, synced, false);
+    }
+};
+
+// deliver a page of the snapshot of a get and watch as synced events
+inline void NotifySnapshotPage(const ObserverFunction &observer, const std::vector<WatchEvent> &events, bool more)
+{
+    if (const auto *paged = observer.target<PagedObserver>(); paged != nullptr) {
+        (void)paged->function(events, true, more);
+    } else if (!events.empty()) {
+        (void)observer(events, true);
+    }
+}
 struct WatchRecord {
     std::string uuid;
 
@@ -86,7 +107,7 @@ public:
 protected:
     virtual void CancelWatch(int64_t watchId);
 
-    Status OnEvent(const std::shared_ptr<WatchResponse> &response, bool synced);
+    Status OnEvent(const std::shared_ptr<WatchResponse> &response, bool synced, bool more = false);
 
     litebus::Future<Status> Sync(size_t index);
 
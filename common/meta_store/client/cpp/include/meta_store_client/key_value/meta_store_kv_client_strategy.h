@@ -70,6 +70,8 @@ private:
                                                             const SyncerFunction &syncer,
                                                             const std::shared_ptr<WatchRecord> &reconnectRecord);
 
+    void Resync(const std::shared_ptr<WatchRecord> &record);
+
     void ReconnectSuccess();
     void ReconnectSuccess(uint32_t watchID);
     bool ReconnectWatch() override;
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_META_STORE_CLIENT_KEY_VALUE_READ_CACHE_H
+#define COMMON_META_STORE_CLIENT_KEY_VALUE_READ_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "meta_store_client/meta_store_struct.h"
+#include "metrics/metrics_adapter.h"
+#include "watcher.h"
+
+namespace functionsystem::meta_store {
+// Serves the gets under the cached prefixes in the process. A prefix is served while a watch on it is live, filled by
+// the get responses and kept coherent by the watch events, a key only moves to a later revision. The keys are the
+// ones of the store, with the table prefix.
+class ReadCache {
+public:
+    ReadCache(const std::unordered_set<std::string> &prefixes, const std::string &tablePrefix);
+
+    ~ReadCache() = default;
+
+    // the cached prefix covering the key, empty if none
+    std::string Match(const std::string &key) const;
+
+    // the cache of the prefix is served while one of its watchers is not canceled
+    void AddWatcher(const std::string &prefix, const std::shared_ptr<Watcher> &watcher);
+
+    // synced events are a page of the get of a get and watch, more if other pages follow
+    void OnEvents(const std::string &prefix, const std::vector<WatchEvent> &events, bool synced, bool more = false);
+
+    // a write of this client under the prefix, the cache is not served until its event arrives
+    void OnWrite(const std::string &key, int64_t revision);
+
+    // the events of the prefix may have been missed, its kvs are dropped until filled again
+    void Invalidate(const std::string &prefix);
+
+    void InvalidateAll();
+
+    // nullptr if not served, the epoch returned with a miss goes with its response to OnGetResponse
+    std::shared_ptr<GetResponse> Get(const std::string &key, const GetOption &option, uint64_t &epoch);
+
+    void OnGetResponse(const std::string &key, const GetOption &option, uint64_t epoch,
+                       const std::shared_ptr<GetResponse> &response);
+
+private:
+    struct PrefixCache {
+        std::map<std::string, KeyValue> kvs;
+
+        // the keys got as absent while not complete
+        std::unordered_set<std::string> absent;
+
+        // all the kvs of the prefix are in
+        bool complete{ false };
+
+        // the pages of the get of a get and watch are coming, in the key order
+        bool paging{ false };
+
+        // the pages started on an empty cache, they fill the whole prefix unless dropped before the last one
+        bool filling{ false };
+
+        // the last key of the pages so far
+        std::string pageKey;
+
+        // the revision the kvs are known to be current at
+        int64_t revision{ 0 };
+
+        // the latest revision of a write under the prefix the store returned
+        int64_t latest{ 0 };
+
+        // increased when the cache is dropped, a get issued before is not filled in
+        uint64_t epoch{ 0 };
+
+        std::vector<std::weak_ptr<Watcher>> watchers;
+
+        std::shared_ptr<metrics::MetaStoreCacheCounters> counters;
+    };
+
+    static bool Watched(PrefixCache &cache);
+
+    static bool IsServable(const GetOption &option);
+
+    static void Apply(PrefixCache &cache, const WatchEvent &event);
+
+    static void UpdateLag(PrefixCache &cache);
+
+    std::shared_ptr<GetResponse> Range(const PrefixCache &cache, const std::string &key,
+                                       const GetOption &option) const;
+
+    std::string tablePrefix_;
+
+    // the longest first, fixed after constructed
+    std::vector<std::string> prefixes_;
+
+    mutable std::mutex mutex_;
+
+    // by the prefix without the table prefix
+    std::map<std::string, PrefixCache> caches_;
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // COMMON_META_STORE_CLIENT_KEY_VALUE_READ_CACHE_H
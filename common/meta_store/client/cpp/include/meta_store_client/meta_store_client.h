@@ -19,6 +19,7 @@
 
 #include "async/future.hpp"
 #include "meta_store_monitor/meta_store_healthy_observer.h"
+#include "meta_store_client/key_value/read_cache.h"
 #include "meta_store_client/key_value/watcher.h"
 #include "meta_store_client/maintenance/maintenance_client_strategy.h"
 #include "meta_store_client/meta_store_client_mgr.h"
@@ -114,7 +115,26 @@ public:
         return metaStoreConfig_.etcdTablePrefix;
     }
 
+    const MetaStoreConfig &GetMetaStoreConfig() const
+    {
+        return metaStoreConfig_;
+    }
+
+    // the key is routed to the kv client of BeginTransaction
+    bool IsRoutedWithTxn(const std::string &key);
+
+    // a put or delete of the key committed in a txn of this client
+    void OnTxnWrite(const std::string &key, int64_t revision);
+
 private:
+    // the watch keeps the read cache of its prefix coherent, it covers the whole prefix and is synced on compaction
+    bool WatchesCachedPrefix(const std::string &key, const WatchOption &option, const SyncerFunction &syncer) const;
+
+    litebus::Future<std::shared_ptr<Watcher>> WatchCachedPrefix(
+        const std::string &key, const WatchOption &option,
+        const std::function<bool(const std::vector<WatchEvent> &, bool)> &observer, const SyncerFunction &syncer,
+        bool withGet);
+
     MetaStoreConfig metaStoreConfig_;
 
     GrpcSslConfig sslConfig_;
@@ -124,6 +144,9 @@ private:
     std::shared_ptr<MetaStoreExplorer> metaStoreExplorer_{ nullptr };
 
     std::shared_ptr<MetaStoreClientMgr> metaStoreClientMgr_{ nullptr };
+
+    // nullptr if no prefix is cached
+    std::shared_ptr<meta_store::ReadCache> readCache_{ nullptr };
 };
 }  // namespace functionsystem
 
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "async/future.hpp"
+#include "constants.h"
 #include "status/status.h"
 #include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
 
@@ -34,6 +35,8 @@ const int64_t KV_OPERATE_RETRY_INTERVAL_LOWER_BOUND = 1000;  // ms
 const int64_t KV_OPERATE_RETRY_INTERVAL_UPPER_BOUND = 5000;  // ms
 const uint32_t DEFAULT_META_STORE_MAX_FLUSH_CONCURRENCY = 1000;
 const uint32_t DEFAULT_META_STORE_MAX_FLUSH_BATCH_SIZE = 100;
+const int64_t DEFAULT_GET_AND_WATCH_PAGE_SIZE = 1000;  // kvs of a page of the snapshot before a watch
+const uint64_t DEFAULT_META_STORE_SNAPSHOT_THRESHOLD = 64 * 1024 * 1024;  // bytes of wal
 const std::string METASTORE_LOCAL_MODE = "local";
 
 using WatchResponse = etcdserverpb::WatchResponse;
@@ -254,6 +257,11 @@ struct MetaStoreConfig {
     bool enableAutoSync = false;
     uint32_t autoSyncInterval = 0;  // ms
     std::unordered_set<std::string> excludedKeys = {};
+    // the gets under the prefixes are served from the watches of this client, none if empty
+    std::unordered_set<std::string> readCachePrefixes = {};
+    // the puts and deletes of the accessor are committed in one txn per window, none if 0
+    uint32_t writeCoalesceWindowMs = 0;
+    uint32_t writeCoalesceMaxBatchSize = DEFAULT_META_STORE_WRITE_COALESCE_MAX_BATCH_SIZE;
 };
 
 struct MetaStoreTimeoutOption {
@@ -267,6 +275,9 @@ struct MetaStoreBackupOption {
     bool enableSyncSysFunc = false;
     uint32_t metaStoreMaxFlushConcurrency = DEFAULT_META_STORE_MAX_FLUSH_CONCURRENCY;
     uint32_t metaStoreMaxFlushBatchSize = DEFAULT_META_STORE_MAX_FLUSH_BATCH_SIZE;
+    // if set, persist to the wal and snapshot under it instead of etcd
+    std::string persistPath = "";
+    uint64_t snapshotThreshold = DEFAULT_META_STORE_SNAPSHOT_THRESHOLD;
 };
 
 template <class TwithStatus>
@@ -22,12 +22,23 @@ MetaStorageAccessor::MetaStorageAccessor(const std::shared_ptr<MetaStoreClient>
     auto uuid = litebus::uuid_generator::UUID::GetRandomUUID();
     leaseActor_ = std::make_shared<LeaseActor>("lease-actor-" + uuid.ToString(), metaClient_);
     litebus::Spawn(leaseActor_);
+    if (metaClient_ != nullptr && metaClient_->GetMetaStoreConfig().writeCoalesceWindowMs > 0) {
+        const auto &config = metaClient_->GetMetaStoreConfig();
+        writeCoalescerActor_ = std::make_shared<WriteCoalescerActor>(
+            "write-coalescer-actor-" + uuid.ToString(), metaClient_, config.writeCoalesceWindowMs,
+            config.writeCoalesceMaxBatchSize);
+        litebus::Spawn(writeCoalescerActor_);
+    }
 }
 
 MetaStorageAccessor::~MetaStorageAccessor()
 {
     litebus::Terminate(leaseActor_->GetAID());
     litebus::Await(leaseActor_->GetAID());
+    if (writeCoalescerActor_ != nullptr) {
+        litebus::Terminate(writeCoalescerActor_->GetAID());
+        litebus::Await(writeCoalescerActor_->GetAID());
+    }
 }
 
 litebus::Future<std::shared_ptr<Watcher>> MetaStorageAccessor::RegisterObserver(
@@ -64,6 +75,9 @@ std::pair<std::vector<WatchEvent>, int64_t> MetaStorageAccessor::Sync(const std:
 
 litebus::Future<Status> MetaStorageAccessor::Put(const std::string &key, const std::string &value)
 {
+    if (writeCoalescerActor_ != nullptr) {
+        return litebus::Async(writeCoalescerActor_->GetAID(), &WriteCoalescerActor::Put, key, value);
+    }
     YRLOG_DEBUG("put into meta store, key: {}", key);
     ASSERT_IF_NULL(metaClient_);
     return metaClient_->Put(key, value, {}).Then([key](const std::shared_ptr<PutResponse> &putResponse) {
@@ -161,6 +175,9 @@ litebus::Future<Status> MetaStorageAccessor::Delete(const std::string &key)
 
 litebus::Future<Status> MetaStorageAccessor::Delete(const std::string &key, bool isPrefix)
 {
+    if (writeCoalescerActor_ != nullptr) {
+        return litebus::Async(writeCoalescerActor_->GetAID(), &WriteCoalescerActor::Delete, key, isPrefix);
+    }
     YRLOG_DEBUG("delete from meta store, key: {}, is prefix: {}", key, isPrefix);
     ASSERT_IF_NULL(metaClient_);
     return metaClient_->Delete(key, { false, isPrefix })
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "write_coalescer_actor.h"
+
+#include <list>
+#include <unordered_set>
+
+#include "async/collect.hpp"
+#include "async/defer.hpp"
+
+namespace functionsystem {
+using meta_store::TxnOperationType;
+
+WriteCoalescerActor::WriteCoalescerActor(const std::string &name,
+                                         const std::shared_ptr<MetaStoreClient> &metaStoreClient, uint32_t windowMs,
+                                         uint32_t maxBatchSize)
+    : litebus::ActorBase(name),
+      metaClient_(metaStoreClient),
+      windowMs_(windowMs),
+      maxBatchSize_(maxBatchSize == 0 ? 1 : maxBatchSize)
+{
+}
+
+void WriteCoalescerActor::Finalize()
+{
+    litebus::TimerTools::Cancel(windowTimer_);
+    // the response of the txn in flight is deferred to this actor and never handled, its result is unknown
+    if (committingTxn_ != nullptr) {
+        for (auto &write : *committingTxn_) {
+            Fail(write, "meta storage accessor is finalized while its txn is committed, key: ");
+        }
+        committingTxn_ = nullptr;
+    }
+    for (auto &write : pending_) {
+        Fail(write, "meta storage accessor is finalized, key: ");
+    }
+    pending_.clear();
+}
+
+void WriteCoalescerActor::Fail(PendingWrite &write, const std::string &message)
+{
+    write.promise.SetValue(Status(write.type == TxnOperationType::OPERATION_PUT
+                                      ? StatusCode::BP_META_STORAGE_PUT_ERROR
+                                      : StatusCode::BP_META_STORAGE_DELETE_ERROR,
+                                  message + write.key));
+}
+
+litebus::Future<Status> WriteCoalescerActor::Put(const std::string &key, const std::string &value)
+{
+    YRLOG_DEBUG("coalesce put into meta store, key: {}", key);
+    return Enqueue(PendingWrite{ TxnOperationType::OPERATION_PUT, key, value, false, {}, {} });
+}
+
+litebus::Future<Status> WriteCoalescerActor::Delete(const std::string &key, bool isPrefix)
+{
+    YRLOG_DEBUG("coalesce delete from meta store, key: {}, is prefix: {}", key, isPrefix);
+    return Enqueue(PendingWrite{ TxnOperationType::OPERATION_DELETE, key, "", isPrefix, {}, {} });
+}
+
+litebus::Future<Status> WriteCoalescerActor::Enqueue(PendingWrite &&write)
+{
+    ASSERT_IF_NULL(metaClient_);
+    write.alone = write.isPrefix || !metaClient_->IsRoutedWithTxn(write.key);
+    auto future = write.promise.GetFuture();
+    pending_.emplace_back(std::move(write));
+    if (pending_.size() >= maxBatchSize_) {
+        Flush();
+    } else if (!windowStarted_ && !committing_) {
+        windowStarted_ = true;
+        windowTimer_ = litebus::AsyncAfter(windowMs_, GetAID(), &WriteCoalescerActor::OnWindow);
+    }
+    return future;
+}
+
+void WriteCoalescerActor::OnWindow()
+{
+    windowStarted_ = false;
+    Flush();
+}
+
+void WriteCoalescerActor::Flush()
+{
+    if (committing_ || pending_.empty()) {
+        return;
+    }
+    if (windowStarted_) {
+        litebus::TimerTools::Cancel(windowTimer_);
+        windowStarted_ = false;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    std::unordered_set<std::string> keys;
+    while (!pending_.empty() && batch->size() < maxBatchSize_) {
+        auto &write = pending_.front();
+        if (!batch->empty() && (write.alone || batch->front().alone || keys.find(write.key) != keys.end())) {
+            break;
+        }
+        (void)keys.emplace(write.key);
+        batch->emplace_back(std::move(write));
+        pending_.pop_front();
+    }
+
+    committing_ = true;
+    if (batch->size() == 1) {
+        CommitOneByOne(batch);
+        return;
+    }
+    auto txn = metaClient_->BeginTransaction();
+    ASSERT_IF_NULL(txn);
+    for (const auto &write : *batch) {
+        if (write.type == TxnOperationType::OPERATION_PUT) {
+            txn->Then(meta_store::TxnOperation::Create(write.key, write.value, PutOption{}));
+        } else {
+            txn->Then(meta_store::TxnOperation::Create(write.key, DeleteOption{}));
+        }
+    }
+    YRLOG_DEBUG("commit {} coalesced writes to meta store, {} pending", batch->size(), pending_.size());
+    committingTxn_ = batch;
+    (void)txn->Commit().OnComplete(
+        litebus::Defer(GetAID(), &WriteCoalescerActor::OnCommitted, std::placeholders::_1, batch));
+}
+
+void WriteCoalescerActor::OnCommitted(const litebus::Future<std::shared_ptr<TxnResponse>> &response,
+                                      const std::shared_ptr<Batch> &batch)
+{
+    committingTxn_ = nullptr;
+    if (response.IsError() || response.Get() == nullptr || response.Get()->status.IsError()
+        || response.Get()->responses.size() != batch->size()) {
+        YRLOG_WARN("failed to commit {} coalesced writes to meta store, commit them one by one", batch->size());
+        CommitOneByOne(batch);
+        return;
+    }
+    for (size_t i = 0; i < batch->size(); ++i) {
+        const auto &write = (*batch)[i];
+        const auto &operationResponse = response.Get()->responses[i];
+        bool written = write.type == TxnOperationType::OPERATION_PUT
+                       || std::get<DeleteResponse>(operationResponse.response).deleted > 0;
+        if (written) {
+            metaClient_->OnTxnWrite(write.key, operationResponse.header.revision);
+        }
+        write.promise.SetValue(Status::OK());
+    }
+    committing_ = false;
+    Flush();
+}
+
+void WriteCoalescerActor::CommitOneByOne(const std::shared_ptr<Batch> &batch)
+{
+    std::list<litebus::Future<Status>> futures;
+    for (const auto &write : *batch) {
+        auto future = CommitOne(write);
+        write.promise.Associate(future);
+        futures.emplace_back(future);
+    }
+    (void)litebus::Collect(futures).OnComplete(
+        litebus::Defer(GetAID(), &WriteCoalescerActor::OnCommittedOneByOne));
+}
+
+litebus::Future<Status> WriteCoalescerActor::CommitOne(const PendingWrite &write)
+{
+    auto key = write.key;
+    if (write.type == TxnOperationType::OPERATION_PUT) {
+        return metaClient_->Put(key, write.value, {}).Then([key](const std::shared_ptr<PutResponse> &putResponse) {
+            if (putResponse->status.IsError()) {
+                YRLOG_ERROR("failed to put key {} using meta client, error: {}", key,
+                            putResponse->status.GetMessage());
+                return Status(StatusCode::BP_META_STORAGE_PUT_ERROR, "failed to put key: " + key);
+            }
+            return Status::OK();
+        });
+    }
+    return metaClient_->Delete(key, { false, write.isPrefix })
+        .Then([key](const litebus::Future<std::shared_ptr<DeleteResponse>> &deleteResponseFuture) {
+            if (deleteResponseFuture.IsError()) {
+                YRLOG_ERROR("failed to delete key {} using meta client, error: {}", key,
+                            deleteResponseFuture.GetErrorCode());
+                return Status(StatusCode::BP_META_STORAGE_DELETE_ERROR, "key: " + key);
+            }
+            return Status::OK();
+        });
+}
+
+void WriteCoalescerActor::OnCommittedOneByOne()
+{
+    committing_ = false;
+    Flush();
+}
+
+}  // namespace functionsystem
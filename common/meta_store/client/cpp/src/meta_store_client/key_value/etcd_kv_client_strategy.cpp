@@ -16,6 +16,8 @@
 
 #include "etcd_kv_client_strategy.h"
 
+#include <algorithm>
+
 #include "async/asyncafter.hpp"
 #include "async/defer.hpp"
 #include "meta_store_client/utils/etcd_util.h"
@@ -558,29 +560,119 @@ litebus::Future<std::shared_ptr<Watcher>> EtcdKvClientStrategy::GetAndWatch(
 {
     // if revision eq 0, need to sync
     if (option.revision == 0) {
-        GetOption opts{ .prefix = option.prefix };
-        return Get(key, opts).Then([aid(GetAID()), key, option, observer, syncer,
-                                    reconnectRecord](const std::shared_ptr<GetResponse> &getResponse) {
-            std::vector<WatchEvent> events;
-            WatchOption watchOption{ option };
-            events.reserve(getResponse->kvs.size());
-            for (auto &kv : getResponse->kvs) {
-                WatchEvent event{ .eventType = EVENT_TYPE_PUT, .kv = kv, .prevKv = {} };
-                (void)events.emplace_back(event);
-            }
-            YRLOG_DEBUG("process get response for key {}, event size: {}", key, events.size());
-            if (!events.empty()) {
-                (void)observer(events, true);
-            }
-            watchOption.revision = getResponse->header.revision + 1;
-            return litebus::Async(aid, &EtcdKvClientStrategy::Watch, key, watchOption, observer, syncer,
-                                  reconnectRecord);
-        });
+        return GetPageAndWatch(key, option, observer, syncer, reconnectRecord, "", 0, 0,
+                               std::make_shared<SnapshotKeys>());
     }
     WatchOption watchOption{ option };
     return Watch(key, watchOption, observer, syncer, reconnectRecord);
 }
 
+litebus::Future<std::shared_ptr<Watcher>> EtcdKvClientStrategy::GetPageAndWatch(
+    const std::string &key, const WatchOption &option, const ObserverFunction &observer, const SyncerFunction &syncer,
+    const std::shared_ptr<WatchRecord> &reconnectRecord, const std::string &pageKey, int64_t revision,
+    int restartTimes, const std::shared_ptr<SnapshotKeys> &keys)
+{
+    // the snapshot is read in pages at the revision of the first page, the pages go to the observer one by one
+    etcdserverpb::RangeRequest request;
+    BuildRangeRequest(request, key, GetOption{ .prefix = option.prefix });
+    if (!pageKey.empty()) {
+        request.set_key(pageKey);
+    }
+    request.set_limit(DEFAULT_GET_AND_WATCH_PAGE_SIZE);
+    request.set_revision(revision);
+
+    auto response = std::make_shared<etcdserverpb::RangeResponse>();
+    auto promise = std::make_shared<litebus::Promise<functionsystem::Status>>();
+    DoGet(promise, request, response, 1);  // do retry
+    return promise->GetFuture().Then([aid(GetAID()), key, option, observer, syncer, reconnectRecord, response, revision,
+                                      restartTimes, keys, timeoutOption(timeoutOption_)](
+                                         const functionsystem::Status &status)
+                                         -> litebus::Future<std::shared_ptr<Watcher>> {
+        WatchOption watchOption{ option };
+        if (status.IsError()) {
+            if (revision == 0) {
+                YRLOG_WARN("failed to get key {} before watch: {}", key, status.ToString());
+                watchOption.revision = 1;
+                return litebus::Async(aid, &EtcdKvClientStrategy::Watch, key, watchOption, observer, syncer,
+                                      reconnectRecord);
+            }
+            // the revision of the first page may be compacted, the snapshot is read again from the start, after a
+            // backoff growing with the restarts up to the interval of retrying a watch. the keys delivered so far are
+            // deleted at the end if the new snapshot does not have them
+            keys->Restart();
+            auto nextSleepTime = std::min<uint64_t>(
+                RETRY_INTERVAL,
+                GenerateRandomNumber(timeoutOption.operationRetryIntervalLowerBound * (restartTimes + 1),
+                                     timeoutOption.operationRetryIntervalUpperBound * (restartTimes + 1)));
+            YRLOG_WARN("failed to get the page of key {} at revision {}: {}, restart for the {} times after {} ms", key,
+                       revision, status.ToString(), restartTimes + 1, nextSleepTime);
+            auto restart = std::make_shared<litebus::Promise<std::shared_ptr<Watcher>>>();
+            (void)litebus::TimerTools::AddTimer(
+                nextSleepTime, aid,
+                [aid, key, option, observer, syncer, reconnectRecord, restartTimes, keys, restart]() {
+                    restart->Associate(litebus::Async(aid, &EtcdKvClientStrategy::GetPageAndWatch, key, option,
+                                                      observer, syncer, reconnectRecord, std::string(), int64_t{ 0 },
+                                                      restartTimes + 1, keys));
+                });
+            return restart->GetFuture();
+        }
+
+        std::vector<WatchEvent> events;
+        events.reserve(static_cast<size_t>(response->kvs_size()));
+        for (const auto &kv : response->kvs()) {
+            WatchEvent event{ .eventType = EVENT_TYPE_PUT, .kv = kv, .prevKv = {} };
+            (void)events.emplace_back(event);
+        }
+        YRLOG_DEBUG("process get response for key {}, event size: {}, more: {}", key, events.size(),
+                    response->more());
+        auto more = response->more() && response->kvs_size() > 0;
+        keys->OnPage(events);
+        NotifySnapshotPage(observer, events, more);
+        auto pageRevision = revision == 0 ? response->header().revision() : revision;
+        if (more) {
+            auto nextKey = response->kvs(response->kvs_size() - 1).key() + '\0';
+            return litebus::Async(aid, &EtcdKvClientStrategy::GetPageAndWatch, key, option, observer, syncer,
+                                  reconnectRecord, nextKey, pageRevision, restartTimes, keys);
+        }
+        if (auto deleted = keys->TakeDeleted(pageRevision); !deleted.empty()) {
+            YRLOG_INFO("{} keys of {} delivered before the snapshot restarted are deleted", deleted.size(), key);
+            (void)observer(deleted, false);
+        }
+        watchOption.revision = pageRevision + 1;
+        return litebus::Async(aid, &EtcdKvClientStrategy::Watch, key, watchOption, observer, syncer,
+                              reconnectRecord);
+    });
+}
+
+void SnapshotKeys::OnPage(const std::vector<WatchEvent> &events)
+{
+    for (const auto &event : events) {
+        (void)stale.erase(event.kv.key());
+        (void)delivered.emplace(event.kv.key());
+    }
+}
+
+void SnapshotKeys::Restart()
+{
+    stale.merge(delivered);
+    delivered.clear();
+}
+
+std::vector<WatchEvent> SnapshotKeys::TakeDeleted(int64_t revision)
+{
+    std::vector<WatchEvent> events;
+    events.reserve(stale.size());
+    for (const auto &key : stale) {
+        WatchEvent event{ .eventType = EVENT_TYPE_DELETE, .kv = {}, .prevKv = {} };
+        event.kv.set_key(key);
+        event.kv.set_mod_revision(revision);
+        (void)events.emplace_back(event);
+    }
+    stale.clear();
+    delivered.clear();
+    return events;
+}
+
 void EtcdKvClientStrategy::OnAddressUpdated(const std::string &address)
 {
     YRLOG_WARN("etcd kv client doesn't support address update yet");
@@ -151,7 +151,7 @@ void KvClientStrategy::CancelWatch(int64_t watchId)
     }
 }
 
-Status KvClientStrategy::OnEvent(const std::shared_ptr<WatchResponse> &response, bool synced)
+Status KvClientStrategy::OnEvent(const std::shared_ptr<WatchResponse> &response, bool synced, bool more)
 {
     auto iterator = readyRecords_.find(response->watch_id());
     if (iterator == readyRecords_.end()) {
@@ -193,6 +193,10 @@ Status KvClientStrategy::OnEvent(const std::shared_ptr<WatchResponse> &response,
         YRLOG_WARN("the event's type is not supported for key({})", event.kv().key());
     }
 
+    if (synced) {
+        NotifySnapshotPage(iterator->second->observer, events, more);
+        return Status::OK();
+    }
     (void)iterator->second->observer(events, synced);
     return Status::OK();
 }
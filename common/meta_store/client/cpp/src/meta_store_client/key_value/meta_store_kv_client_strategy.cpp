@@ -17,6 +17,7 @@
 #include "meta_store_kv_client_strategy.h"
 
 #include "async/async.hpp"
+#include "async/collect.hpp"
 #include "async/defer.hpp"
 #include "meta_store_client/utils/etcd_util.h"
 #include "proto/pb/message_pb.h"
@@ -70,7 +71,15 @@ void MetaStoreKvClientStrategy::Finalize()
 void MetaStoreKvClientStrategy::ReconnectSuccess()
 {
     YRLOG_INFO("reconnect to meta-store success");
-    SyncAll().OnComplete(litebus::Defer(GetAID(), &MetaStoreKvClientStrategy::ReconnectWatch));
+    // a watcher with a revision resumes from the server history, it is synced only when that is compacted
+    std::list<litebus::Future<Status>> futures;
+    for (uint32_t index = 0; index < records_.size(); ++index) {
+        if (records_[index] != nullptr && records_[index]->option.revision > 0) {
+            continue;
+        }
+        futures.push_back(Sync(index));
+    }
+    litebus::Collect(futures).OnComplete(litebus::Defer(GetAID(), &MetaStoreKvClientStrategy::ReconnectWatch));
 }
 
 litebus::Future<std::shared_ptr<PutResponse>> MetaStoreKvClientStrategy::Put(const std::string &key,
@@ -307,7 +316,14 @@ void MetaStoreKvClientStrategy::OnWatch(const litebus::AID &from, std::string &&
         }
 
         (void)OnCreateWithID(response, message.responseid());
-    } else if (response->canceled()) {
+        if (!response->canceled()) {
+            return;
+        }
+        // created and canceled at once when the start revision has been compacted
+        YRLOG_WARN("{}|watcher({}) start revision is compacted, compact revision: {}", message.responseid(),
+                   response->watch_id(), response->compact_revision());
+    }
+    if (response->canceled()) {
         (void)OnCancel(response);
     } else {
         (void)OnEvent(response, false);
@@ -407,17 +423,44 @@ void MetaStoreKvClientStrategy::OnGetAndWatch(const litebus::AID &from, std::str
     if (watchServiceActorAID_ == nullptr) {
         watchServiceActorAID_ = std::make_shared<litebus::AID>(from);
     }
-    (void)OnCreateWithID(watchResponse, message.responseid());
+    // the snapshot of a large range comes in pages of one revision, the watcher is created by the first one
+    if (auto pending = pendingRecordMap_.find(message.responseid()); pending != pendingRecordMap_.end()) {
+        auto record = pending->second;
+        (void)OnCreateWithID(watchResponse, message.responseid());
+        // a watch from a revision is answered with a snapshot when the server has no history to resume it from
+        if (record != nullptr && record->option.revision > 0) {
+            Resync(record);
+        }
+    }
 
-    YRLOG_DEBUG("process get response for watch id {}, event size: {}", watchResponse->watch_id(),
-                getResponse->kvs_size());
-    if (!getResponse->kvs().empty()) {
+    YRLOG_DEBUG("process get response for watch id {}, event size: {}, more: {}", watchResponse->watch_id(),
+                getResponse->kvs_size(), getResponse->more());
+    // the last page goes to the observer even if empty, the snapshot is complete with it
+    if (!getResponse->kvs().empty() || !getResponse->more()) {
         auto output = std::make_shared<etcdserverpb::WatchResponse>();
         ConvertGetRespToWatchResp(watchResponse->watch_id(), *getResponse, *output);
-        (void)OnEvent(output, true);
+        (void)OnEvent(output, true, getResponse->more());
     }
 }
 
+void MetaStoreKvClientStrategy::Resync(const std::shared_ptr<WatchRecord> &record)
+{
+    // the events since the revision are lost, the snapshot has no delete for the keys removed meanwhile, so the state
+    // of the watcher is replaced through the syncer. The watch is already open, nothing after the sync is missed.
+    if (record->syncer == nullptr) {
+        YRLOG_WARN("watcher({}) for key({}) is not resumed from revision {}, no syncer to resync",
+                   record->watcher->GetWatchId(), record->key, record->option.revision);
+        return;
+    }
+    YRLOG_WARN("watcher({}) for key({}) is not resumed from revision {}, resync", record->watcher->GetWatchId(),
+               record->key, record->option.revision);
+    (void)record->syncer().OnComplete([key(record->key)](const litebus::Future<SyncResult> &syncResult) {
+        if (syncResult.IsError() || syncResult.Get().status.IsError()) {
+            YRLOG_WARN("failed to resync key {}", key);
+        }
+    });
+}
+
 bool MetaStoreKvClientStrategy::ReconnectWatch()
 {
     pendingRecordMap_.clear();
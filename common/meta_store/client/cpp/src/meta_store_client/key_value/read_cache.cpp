@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "read_cache.h"
+
+#include <algorithm>
+
+#include "logs/logging.h"
+#include "meta_store_client/utils/string_util.h"
+
+namespace functionsystem::meta_store {
+ReadCache::ReadCache(const std::unordered_set<std::string> &prefixes, const std::string &tablePrefix)
+    : tablePrefix_(tablePrefix)
+{
+    for (const auto &prefix : prefixes) {
+        if (prefix.empty()) {
+            continue;
+        }
+        prefixes_.emplace_back(prefix);
+        auto &cache = caches_[prefix];
+        cache.counters = std::make_shared<metrics::MetaStoreCacheCounters>();
+        metrics::MetricsAdapter::GetInstance().AddMetaStoreCacheCounters(prefix, cache.counters);
+        YRLOG_INFO("cache the meta store reads under prefix {}", prefix);
+    }
+    std::sort(prefixes_.begin(), prefixes_.end(),
+              [](const std::string &l, const std::string &r) { return l.size() > r.size(); });
+}
+
+std::string ReadCache::Match(const std::string &key) const
+{
+    for (const auto &prefix : prefixes_) {
+        if (key.compare(0, prefix.size(), prefix) == 0) {
+            return prefix;
+        }
+    }
+    return "";
+}
+
+void ReadCache::AddWatcher(const std::string &prefix, const std::shared_ptr<Watcher> &watcher)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = caches_.find(prefix);
+    if (iter == caches_.end() || watcher == nullptr) {
+        return;
+    }
+    auto &cache = iter->second;
+    cache.watchers.erase(std::remove_if(cache.watchers.begin(), cache.watchers.end(),
+                                        [](const std::weak_ptr<Watcher> &w) {
+                                            auto locked = w.lock();
+                                            return locked == nullptr || locked->IsCanceled();
+                                        }),
+                         cache.watchers.end());
+    cache.watchers.emplace_back(watcher);
+    // a get issued before the watch may miss the events up to its start
+    ++cache.epoch;
+}
+
+void ReadCache::OnEvents(const std::string &prefix, const std::vector<WatchEvent> &events, bool synced, bool more)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = caches_.find(prefix);
+    if (iter == caches_.end()) {
+        return;
+    }
+    auto &cache = iter->second;
+    if (synced) {
+        // the get of a get and watch is the whole prefix at the watch start, unless another watch filled in before
+        if (!cache.paging) {
+            cache.paging = true;
+            cache.filling = cache.kvs.empty() && cache.absent.empty() && cache.revision == 0;
+        } else if (!events.empty() && events.front().kv.key() <= cache.pageKey) {
+            // the pages start over at another revision, as the etcd client does after a failed page
+            cache.filling = false;
+        }
+        if (!events.empty()) {
+            cache.pageKey = events.back().kv.key();
+        }
+    }
+    for (const auto &event : events) {
+        Apply(cache, event);
+    }
+    if (synced && !more) {
+        cache.complete = cache.complete || cache.filling;
+        cache.paging = false;
+        cache.filling = false;
+        cache.pageKey.clear();
+    }
+    UpdateLag(cache);
+}
+
+void ReadCache::OnWrite(const std::string &key, int64_t revision)
+{
+    auto prefix = Match(key);
+    if (prefix.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &cache = caches_[prefix];
+    cache.latest = std::max(cache.latest, revision);
+    UpdateLag(cache);
+}
+
+void ReadCache::Invalidate(const std::string &prefix)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = caches_.find(prefix);
+    if (iter == caches_.end()) {
+        return;
+    }
+    auto &cache = iter->second;
+    YRLOG_INFO("drop the meta store read cache of prefix {}, {} keys at revision {}", prefix, cache.kvs.size(),
+               cache.revision);
+    cache.kvs.clear();
+    cache.absent.clear();
+    cache.complete = false;
+    cache.filling = false;
+    cache.revision = 0;
+    ++cache.epoch;
+}
+
+void ReadCache::InvalidateAll()
+{
+    for (const auto &prefix : prefixes_) {
+        Invalidate(prefix);
+    }
+}
+
+std::shared_ptr<GetResponse> ReadCache::Get(const std::string &key, const GetOption &option, uint64_t &epoch)
+{
+    auto prefix = Match(key);
+    if (prefix.empty()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &cache = caches_[prefix];
+    epoch = cache.epoch;
+    // a write of this client not seen yet is not read stale
+    if (Watched(cache) && IsServable(option) && cache.revision >= cache.latest) {
+        auto realKey = tablePrefix_ + key;
+        bool known = option.prefix ? cache.complete
+                                   : cache.complete || cache.kvs.find(realKey) != cache.kvs.end()
+                                         || cache.absent.find(realKey) != cache.absent.end();
+        if (known) {
+            cache.counters->hits.fetch_add(1, std::memory_order_relaxed);
+            return Range(cache, realKey, option);
+        }
+    }
+    cache.counters->misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void ReadCache::OnGetResponse(const std::string &key, const GetOption &option, uint64_t epoch,
+                              const std::shared_ptr<GetResponse> &response)
+{
+    if (response == nullptr || response->status.IsError() || option.keysOnly || option.countOnly) {
+        return;
+    }
+    auto prefix = Match(key);
+    if (prefix.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &cache = caches_[prefix];
+    for (const auto &kv : response->kvs) {
+        cache.latest = std::max(cache.latest, kv.mod_revision());
+    }
+    // a response older than the events applied may hold a key deleted since, it would come back with no tombstone
+    if (cache.epoch != epoch || !Watched(cache) || response->header.revision < cache.revision) {
+        UpdateLag(cache);
+        return;
+    }
+
+    auto realKey = tablePrefix_ + key;
+    if (option.prefix && key == prefix && option.limit == 0) {
+        // the whole prefix at a revision not older than the events applied
+        cache.kvs.clear();
+        cache.absent.clear();
+        for (const auto &kv : response->kvs) {
+            cache.kvs[kv.key()] = kv;
+        }
+        cache.complete = true;
+        cache.revision = response->header.revision;
+    } else {
+        for (const auto &kv : response->kvs) {
+            Apply(cache, WatchEvent{ EVENT_TYPE_PUT, kv, {} });
+        }
+        if (!option.prefix && response->kvs.empty()) {
+            // absent at the revision of the response, no event applied is later
+            cache.kvs.erase(realKey);
+            if (!cache.complete) {
+                cache.absent.emplace(realKey);
+            }
+        }
+    }
+    UpdateLag(cache);
+}
+
+bool ReadCache::Watched(PrefixCache &cache)
+{
+    return std::any_of(cache.watchers.begin(), cache.watchers.end(), [](const std::weak_ptr<Watcher> &w) {
+        auto locked = w.lock();
+        return locked != nullptr && !locked->IsCanceled();
+    });
+}
+
+bool ReadCache::IsServable(const GetOption &option)
+{
+    // served in the key order of the cache only
+    return option.sortOrder == SortOrder::NONE
+           || (option.sortOrder == SortOrder::ASCEND && option.sortTarget == SortTarget::KEY);
+}
+
+void ReadCache::Apply(PrefixCache &cache, const WatchEvent &event)
+{
+    const auto &key = event.kv.key();
+    auto revision = event.kv.mod_revision();
+    auto iter = cache.kvs.find(key);
+    if (iter != cache.kvs.end() && iter->second.mod_revision() >= revision) {
+        return;
+    }
+    if (event.eventType == EVENT_TYPE_PUT) {
+        cache.kvs[key] = event.kv;
+        cache.absent.erase(key);
+    } else {
+        if (iter != cache.kvs.end()) {
+            cache.kvs.erase(iter);
+        }
+        if (!cache.complete) {
+            cache.absent.emplace(key);
+        }
+    }
+    cache.revision = std::max(cache.revision, revision);
+}
+
+void ReadCache::UpdateLag(PrefixCache &cache)
+{
+    cache.counters->revisionLag.store(std::max<int64_t>(0, cache.latest - cache.revision), std::memory_order_relaxed);
+}
+
+std::shared_ptr<GetResponse> ReadCache::Range(const PrefixCache &cache, const std::string &key,
+                                              const GetOption &option) const
+{
+    auto response = std::make_shared<GetResponse>();
+    response->header.revision = cache.revision;
+    auto begin = cache.kvs.lower_bound(key);
+    auto end = option.prefix ? cache.kvs.lower_bound(StringPlusOne(key)) : cache.kvs.upper_bound(key);
+    response->count = static_cast<int64_t>(std::distance(begin, end));
+    if (option.countOnly) {
+        return response;
+    }
+    for (auto iter = begin; iter != end; ++iter) {
+        if (option.limit > 0 && response->kvs.size() >= static_cast<size_t>(option.limit)) {
+            break;
+        }
+        auto &kv = response->kvs.emplace_back(iter->second);
+        if (option.keysOnly) {
+            kv.clear_value();
+        }
+    }
+    return response;
+}
+}  // namespace functionsystem::meta_store
@@ -45,6 +45,10 @@ MetaStoreClient::MetaStoreClient(const MetaStoreConfig &metaStoreConfig, const G
         metaStoreExplorer_ = std::make_shared<MetaStoreDefaultExplorer>(
             metaStoreConfig_.enableMetaStore ? metaStoreConfig_.metaStoreAddress : metaStoreConfig_.etcdAddress);
     }
+    if (!metaStoreConfig_.readCachePrefixes.empty()) {
+        readCache_ = std::make_shared<meta_store::ReadCache>(metaStoreConfig_.readCachePrefixes,
+                                                             metaStoreConfig_.etcdTablePrefix);
+    }
 }
 
 Status MetaStoreClient::Init()
@@ -86,23 +90,54 @@ litebus::Future<std::shared_ptr<PutResponse>> MetaStoreClient::Put(const std::st
                                                                    const PutOption &option)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
-    return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(),
-                          &meta_store::KvClientStrategy::Put, key, value, option);
+    auto future = litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(), &meta_store::KvClientStrategy::Put,
+                                 key, value, option);
+    if (readCache_ != nullptr) {
+        future.OnComplete([readCache(readCache_), key](const litebus::Future<std::shared_ptr<PutResponse>> &rsp) {
+            if (rsp.IsOK() && rsp.Get() != nullptr && rsp.Get()->status.IsOk()) {
+                readCache->OnWrite(key, rsp.Get()->header.revision);
+            }
+        });
+    }
+    return future;
 }
 
 litebus::Future<std::shared_ptr<DeleteResponse>> MetaStoreClient::Delete(const std::string &key,
                                                                          const DeleteOption &option)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
-    return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(),
-                          &meta_store::KvClientStrategy::Delete, key, option);
+    auto future = litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(),
+                                 &meta_store::KvClientStrategy::Delete, key, option);
+    if (readCache_ != nullptr) {
+        future.OnComplete([readCache(readCache_), key](const litebus::Future<std::shared_ptr<DeleteResponse>> &rsp) {
+            if (rsp.IsOK() && rsp.Get() != nullptr && rsp.Get()->status.IsOk() && rsp.Get()->deleted > 0) {
+                readCache->OnWrite(key, rsp.Get()->header.revision);
+            }
+        });
+    }
+    return future;
 }
 
 litebus::Future<std::shared_ptr<GetResponse>> MetaStoreClient::Get(const std::string &key, const GetOption &option)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
-    return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(),
-                          &meta_store::KvClientStrategy::Get, key, option);
+    if (readCache_ == nullptr) {
+        return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(), &meta_store::KvClientStrategy::Get,
+                              key, option);
+    }
+    uint64_t epoch = 0;
+    if (auto cached = readCache_->Get(key, option, epoch); cached != nullptr) {
+        return cached;
+    }
+    auto future = litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(), &meta_store::KvClientStrategy::Get,
+                                 key, option);
+    future.OnComplete(
+        [readCache(readCache_), key, option, epoch](const litebus::Future<std::shared_ptr<GetResponse>> &rsp) {
+            if (rsp.IsOK()) {
+                readCache->OnGetResponse(key, option, epoch, rsp.Get());
+            }
+        });
+    return future;
 }
 
 std::shared_ptr<meta_store::TxnTransaction> MetaStoreClient::BeginTransaction()
@@ -119,6 +154,22 @@ litebus::Future<std::shared_ptr<::etcdserverpb::TxnResponse>> MetaStoreClient::C
                           &meta_store::KvClientStrategy::CommitWithReq, request, asyncBackup);
 }
 
+bool MetaStoreClient::IsRoutedWithTxn(const std::string &key)
+{
+    if (!metaStoreConfig_.enableMetaStore || metaStoreConfig_.isMetaStorePassthrough) {
+        return true;
+    }
+    ASSERT_IF_NULL(metaStoreClientMgr_);
+    return metaStoreClientMgr_->GetKvClient(key) == metaStoreClientMgr_->GetKvClient("");
+}
+
+void MetaStoreClient::OnTxnWrite(const std::string &key, int64_t revision)
+{
+    if (readCache_ != nullptr) {
+        readCache_->OnWrite(key, revision);
+    }
+}
+
 litebus::Future<std::shared_ptr<TxnResponse>> meta_store::TxnTransaction::Commit() const
 {
     return litebus::Async(actorAid_, &meta_store::KvClientStrategy::Commit, compares, thenOps, elseOps);
@@ -150,6 +201,9 @@ litebus::Future<std::shared_ptr<Watcher>> MetaStoreClient::Watch(
     const std::function<bool(const std::vector<WatchEvent> &, bool)> &observer, const SyncerFunction &syncer)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
+    if (WatchesCachedPrefix(key, option, syncer)) {
+        return WatchCachedPrefix(key, option, observer, syncer, false);
+    }
     return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(), &meta_store::KvClientStrategy::Watch,
                           key, option, observer, syncer, nullptr);
 }
@@ -159,10 +213,48 @@ litebus::Future<std::shared_ptr<Watcher>> MetaStoreClient::GetAndWatch(
     const std::function<bool(const std::vector<WatchEvent> &, bool)> &observer, const SyncerFunction &syncer)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
+    if (WatchesCachedPrefix(key, option, syncer)) {
+        return WatchCachedPrefix(key, option, observer, syncer, true);
+    }
     return litebus::Async(metaStoreClientMgr_->GetKvClient(key)->GetAID(), &meta_store::KvClientStrategy::GetAndWatch,
                           key, option, observer, syncer, nullptr);
 }
 
+bool MetaStoreClient::WatchesCachedPrefix(const std::string &key, const WatchOption &option,
+                                          const SyncerFunction &syncer) const
+{
+    return readCache_ != nullptr && option.prefix && syncer != nullptr && readCache_->Match(key) == key;
+}
+
+litebus::Future<std::shared_ptr<Watcher>> MetaStoreClient::WatchCachedPrefix(
+    const std::string &key, const WatchOption &option,
+    const std::function<bool(const std::vector<WatchEvent> &, bool)> &observer, const SyncerFunction &syncer,
+    bool withGet)
+{
+    // told of the last page of the get, the observer does not get an empty one
+    std::function<bool(const std::vector<WatchEvent> &, bool)> cacheObserver = PagedObserver{
+        [readCache(readCache_), key, observer](const std::vector<WatchEvent> &events, bool synced, bool more) {
+            readCache->OnEvents(key, events, synced, more);
+            return events.empty() || observer(events, synced);
+        } };
+    // the events from the compacted revision are missed
+    SyncerFunction cacheSyncer = [readCache(readCache_), key, syncer]() {
+        readCache->Invalidate(key);
+        return syncer();
+    };
+    auto aid = metaStoreClientMgr_->GetKvClient(key)->GetAID();
+    auto future = withGet ? litebus::Async(aid, &meta_store::KvClientStrategy::GetAndWatch, key, option,
+                                           cacheObserver, cacheSyncer, nullptr)
+                          : litebus::Async(aid, &meta_store::KvClientStrategy::Watch, key, option, cacheObserver,
+                                           cacheSyncer, nullptr);
+    future.OnComplete([readCache(readCache_), key](const litebus::Future<std::shared_ptr<Watcher>> &watcher) {
+        if (watcher.IsOK()) {
+            readCache->AddWatcher(key, watcher.Get());
+        }
+    });
+    return future;
+}
+
 litebus::Future<CampaignResponse> MetaStoreClient::Campaign(const std::string &name, int64_t lease,
                                                             const std::string &value)
 {
@@ -209,6 +301,10 @@ litebus::Future<StatusResponse> MetaStoreClient::HealthCheck()
 void MetaStoreClient::OnHealthyStatus(const Status &status)
 {
     ASSERT_IF_NULL(metaStoreClientMgr_);
+    if (status.IsError() && readCache_ != nullptr) {
+        // the watch events may be missed while the meta store is unhealthy
+        readCache_->InvalidateAll();
+    }
     metaStoreClientMgr_->OnHealthyStatus(status);
 }
 
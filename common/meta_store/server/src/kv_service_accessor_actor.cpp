@@ -16,13 +16,17 @@
 
 #include "kv_service_accessor_actor.h"
 
+#include <algorithm>
+
 #include "async/async.hpp"
+#include "async/collect.hpp"
 #include "async/defer.hpp"
 #include "logs/logging.h"
 #include "meta_store_client/meta_store_struct.h"
 #include "proto/pb/message_pb.h"
 #include "kv_service_actor.h"
 #include "meta_store_common.h"
+#include "watch_service_actor.h"
 
 namespace functionsystem::meta_store {
 KvServiceAccessorActor::KvServiceAccessorActor(const litebus::AID &kvServiceActor)
@@ -35,6 +39,13 @@ KvServiceAccessorActor::KvServiceAccessorActor(const litebus::AID &kvServiceActo
 {
 }
 
+KvServiceAccessorActor::KvServiceAccessorActor(const std::shared_ptr<KvShards> &shards, const std::string &namePrefix)
+    : ActorBase(namePrefix + "KvServiceAccessorActor"),
+      kvServiceActor_(shards->kvServiceActors[shards->router->DefaultShard()]),
+      shards_(shards)
+{
+}
+
 void KvServiceAccessorActor::Init()
 {
     Receive("Put", &KvServiceAccessorActor::AsyncPut);
@@ -44,7 +55,15 @@ void KvServiceAccessorActor::Init()
     Receive("Watch", &KvServiceAccessorActor::AsyncWatch);
     Receive("GetAndWatch", &KvServiceAccessorActor::AsyncGetAndWatch);
 
-    isRecoverReady_ = litebus::Async(kvServiceActor_, &KvServiceActor::Recover);
+    if (shards_ == nullptr) {
+        isRecoverReady_ = litebus::Async(kvServiceActor_, &KvServiceActor::Recover);
+        return;
+    }
+    std::list<litebus::Future<bool>> recovers;
+    for (const auto &aid : shards_->kvServiceActors) {
+        recovers.emplace_back(litebus::Async(aid, &KvServiceActor::Recover));
+    }
+    isRecoverReady_ = litebus::Collect(recovers).Then([](const std::list<bool> &) { return true; });
 }
 
 void KvServiceAccessorActor::Finalize()
@@ -64,11 +83,42 @@ void KvServiceAccessorActor::AsyncWatch(const litebus::AID &from, std::string &&
     }
     YRLOG_DEBUG("{}|receive watch request from {}", req->requestid(), from.HashString());
 
+    // every shard registers the watch on the shared watch service, the one of the range replays its history
+    auto target = kvServiceActor_;
+    etcdserverpb::WatchRequest watchRequest;
+    if (shards_ != nullptr && watchRequest.ParseFromString(req->requestmsg())) {
+        auto *createRequest = watchRequest.mutable_create_request();
+        auto shardIndexes = RouteRange(createRequest->key(), createRequest->range_end());
+        if (shardIndexes.size() == 1) {
+            target = ShardActor(shardIndexes.front());
+        } else if (createRequest->start_revision() > 0) {
+            // the shards count their own revisions, there is no history across them to resume from. Open the watch at
+            // the present with a snapshot of every shard instead, on which the watcher resyncs, rather than cancel it
+            // as compacted, since a resync would watch from a revision again.
+            YRLOG_WARN("{}|watch key {} across shards from revision {} can't be resumed, open it with a snapshot",
+                       req->requestid(), createRequest->key(), createRequest->start_revision());
+            auto present = std::make_shared<::etcdserverpb::WatchCreateRequest>(*createRequest);
+            present->set_start_revision(0);
+            if (isRecoverReady_.IsInit()) {
+                isRecoverReady_
+                    .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::GetAndWatchAcrossShards, from,
+                                         req->requestid(), present, shardIndexes))
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            } else {
+                GetAndWatchAcrossShards(from, req->requestid(), present, shardIndexes)
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            }
+            return;
+        }
+    }
+
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncWatch, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncWatch, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncWatch, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncWatch, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -86,11 +136,33 @@ void KvServiceAccessorActor::AsyncGetAndWatch(const litebus::AID &from, std::str
     }
     YRLOG_DEBUG("{}|receive get and watch request from {}", req->requestid(), from.HashString());
 
+    auto target = kvServiceActor_;
+    etcdserverpb::WatchRequest watchRequest;
+    if (shards_ != nullptr && watchRequest.ParseFromString(req->requestmsg())) {
+        auto createRequest = std::make_shared<::etcdserverpb::WatchCreateRequest>(watchRequest.create_request());
+        auto shardIndexes = RouteRange(createRequest->key(), createRequest->range_end());
+        if (shardIndexes.size() > 1) {
+            if (isRecoverReady_.IsInit()) {
+                isRecoverReady_
+                    .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::GetAndWatchAcrossShards, from,
+                                         req->requestid(), createRequest, shardIndexes))
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            } else {
+                GetAndWatchAcrossShards(from, req->requestid(), createRequest, shardIndexes)
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            }
+            return;
+        }
+        target = ShardActor(shardIndexes.front());
+    }
+
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncGetAndWatch, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncGetAndWatch, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncGetAndWatch, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncGetAndWatch, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -108,11 +180,12 @@ void KvServiceAccessorActor::AsyncPut(const litebus::AID &from, std::string &&,
     }
     YRLOG_DEBUG("{}|receive put request from {}", req->requestid(), from.HashString());
 
+    const auto &target = shards_ == nullptr ? kvServiceActor_ : shards_->Route(req->key());
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncPut, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncPut, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncPut, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncPut, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -130,11 +203,24 @@ void KvServiceAccessorActor::AsyncDelete(const litebus::AID &from, std::string &
     }
     YRLOG_DEBUG("{}|receive delete request from {}", req->requestid(), from.HashString());
 
+    auto target = kvServiceActor_;
+    ::etcdserverpb::DeleteRangeRequest payload;
+    if (shards_ != nullptr && payload.ParseFromString(req->requestmsg())) {
+        auto shardIndexes = RouteRange(payload.key(), payload.range_end());
+        if (shardIndexes.size() > 1) {
+            // a delete is one revision of one shard
+            Reject(from, "OnDelete", req->requestid(), "delete range across meta store shards is not supported");
+            RemoveRequestSet(req->requestid());
+            return;
+        }
+        target = ShardActor(shardIndexes.front());
+    }
+
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncDelete, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncDelete, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncDelete, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncDelete, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -152,11 +238,32 @@ void KvServiceAccessorActor::AsyncGet(const litebus::AID &from, std::string &&,
     }
     YRLOG_DEBUG("{}|receive get request from {}", req->requestid(), from.HashString());
 
+    auto target = kvServiceActor_;
+    auto payload = std::make_shared<::etcdserverpb::RangeRequest>();
+    if (shards_ != nullptr && payload->ParseFromString(req->requestmsg())) {
+        auto shardIndexes = RouteRange(payload->key(), payload->range_end());
+        if (shardIndexes.size() > 1) {
+            if (isRecoverReady_.IsInit()) {
+                isRecoverReady_
+                    .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::GetAcrossShards, from, req, payload,
+                                         shardIndexes))
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            } else {
+                GetAcrossShards(from, req, payload, shardIndexes)
+                    .OnComplete(
+                        litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
+            }
+            return;
+        }
+        target = ShardActor(shardIndexes.front());
+    }
+
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncGet, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncGet, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncGet, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncGet, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -174,11 +281,24 @@ void KvServiceAccessorActor::AsyncTxn(const litebus::AID &from, std::string &&,
     }
     YRLOG_DEBUG("{}|receive txn request from {}", req->requestid(), from.HashString());
 
+    auto target = kvServiceActor_;
+    ::etcdserverpb::TxnRequest payload;
+    if (shards_ != nullptr && payload.ParseFromString(req->requestmsg())) {
+        // a txn is atomic in one shard only
+        auto shardIndex = shards_->router->RouteTxn(payload);
+        if (shardIndex.IsNone()) {
+            Reject(from, "OnTxn", req->requestid(), "txn across meta store shards is not supported");
+            RemoveRequestSet(req->requestid());
+            return;
+        }
+        target = ShardActor(shardIndex.Get());
+    }
+
     if (isRecoverReady_.IsInit()) {
-        isRecoverReady_.Then(litebus::Defer(kvServiceActor_, &KvServiceActor::AsyncTxn, from, req))
+        isRecoverReady_.Then(litebus::Defer(target, &KvServiceActor::AsyncTxn, from, req))
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     } else {
-        litebus::Async(kvServiceActor_, &KvServiceActor::AsyncTxn, from, req)
+        litebus::Async(target, &KvServiceActor::AsyncTxn, from, req)
             .OnComplete(litebus::Defer(GetAID(), &KvServiceAccessorActor::RemoveRequestSet, req->requestid()));
     }
 }
@@ -195,4 +315,134 @@ void KvServiceAccessorActor::RemoveRequestSet(const std::string &id)
         requestSet_.erase(iter);
     }
 }
+
+std::vector<size_t> KvServiceAccessorActor::RouteRange(const std::string &key, const std::string &rangeEnd) const
+{
+    if (shards_ == nullptr) {
+        return { 0 };
+    }
+    return shards_->router->RouteRange(key, rangeEnd);
+}
+
+const litebus::AID &KvServiceAccessorActor::ShardActor(size_t index) const
+{
+    if (shards_ == nullptr) {
+        return kvServiceActor_;
+    }
+    return shards_->kvServiceActors[index];
+}
+
+void KvServiceAccessorActor::Reject(const litebus::AID &from, const std::string &method, const std::string &requestId,
+                                    const std::string &reason)
+{
+    YRLOG_ERROR("{}|{}", requestId, reason);
+    messages::MetaStoreResponse response;
+    response.set_responseid(requestId);
+    response.set_status(static_cast<int32_t>(StatusCode::FAILED));
+    response.set_errormsg(reason);
+    Send(from, std::string(method), response.SerializeAsString());
+}
+
+litebus::Future<KvServiceAccessorActor::RangeResponses> KvServiceAccessorActor::CollectRange(
+    const std::shared_ptr<::etcdserverpb::RangeRequest> &request, const std::vector<size_t> &shardIndexes)
+{
+    std::list<litebus::Future<std::shared_ptr<::etcdserverpb::RangeResponse>>> ranges;
+    for (auto index : shardIndexes) {
+        ranges.emplace_back(litebus::Async(ShardActor(index), &KvServiceActor::ShardRange, request));
+    }
+    return litebus::Collect(ranges);
+}
+
+::etcdserverpb::RangeResponse KvServiceAccessorActor::MergeRange(const ::etcdserverpb::RangeRequest &request,
+                                                                 const RangeResponses &responses)
+{
+    ::etcdserverpb::RangeResponse merged;
+    auto header = merged.mutable_header();
+    header->set_cluster_id(META_STORE_CLUSTER_ID);
+    int64_t count = 0;
+    std::vector<const ::mvccpb::KeyValue *> targets;
+    for (const auto &response : responses) {
+        header->set_revision(std::max(header->revision(), response->header().revision()));
+        count += response->count();
+        for (const auto &kv : response->kvs()) {
+            targets.emplace_back(&kv);
+        }
+    }
+    merged.set_count(count);
+
+    // every shard returns its first limit ones, sort them in key order first as a single cache walk would
+    std::sort(targets.begin(), targets.end(),
+              [](const ::mvccpb::KeyValue *s, const ::mvccpb::KeyValue *t) { return s->key() < t->key(); });
+    auto limit = request.limit() > 0 && static_cast<size_t>(request.limit()) < targets.size()
+                     ? static_cast<size_t>(request.limit())
+                     : targets.size();
+    KvServiceActor::SortTarget(&request, targets, limit);
+    for (size_t i = 0; i < limit; ++i) {
+        *merged.add_kvs() = *targets[i];
+    }
+    merged.set_more(static_cast<int64_t>(limit) < count && !request.count_only());
+    return merged;
+}
+
+litebus::Future<Status> KvServiceAccessorActor::GetAcrossShards(
+    const litebus::AID &from, const std::shared_ptr<messages::MetaStoreRequest> &request,
+    const std::shared_ptr<::etcdserverpb::RangeRequest> &payload, const std::vector<size_t> &shardIndexes)
+{
+    YRLOG_DEBUG("{}|get {} across {} shards", request->requestid(), payload->key(), shardIndexes.size());
+    return CollectRange(payload, shardIndexes)
+        .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::OnGetAcrossShards, from, request->requestid(),
+                             payload, std::placeholders::_1));
+}
+
+Status KvServiceAccessorActor::OnGetAcrossShards(const litebus::AID &from, const std::string &requestId,
+                                                 const std::shared_ptr<::etcdserverpb::RangeRequest> &payload,
+                                                 const RangeResponses &responses)
+{
+    messages::MetaStoreResponse response;
+    response.set_responseid(requestId);
+    response.set_responsemsg(MergeRange(*payload, responses).SerializeAsString());
+    Send(from, "OnGet", response.SerializeAsString());
+    return Status::OK();
+}
+
+litebus::Future<Status> KvServiceAccessorActor::GetAndWatchAcrossShards(
+    const litebus::AID &from, const std::string &requestId,
+    const std::shared_ptr<::etcdserverpb::WatchCreateRequest> &createRequest, const std::vector<size_t> &shardIndexes)
+{
+    auto payload = std::make_shared<::etcdserverpb::RangeRequest>();
+    payload->set_key(createRequest->key());
+    payload->set_range_end(createRequest->range_end());
+    // get after create watch, in order to ensure the kv is the latest version
+    return litebus::Async(shards_->watchServiceActor, &WatchServiceActor::CreateWatch, from, createRequest)
+        .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::OnCreateWatchAcrossShards, from, requestId, payload,
+                             shardIndexes, std::placeholders::_1));
+}
+
+litebus::Future<Status> KvServiceAccessorActor::OnCreateWatchAcrossShards(
+    const litebus::AID &from, const std::string &requestId,
+    const std::shared_ptr<::etcdserverpb::RangeRequest> &payload, const std::vector<size_t> &shardIndexes,
+    const std::shared_ptr<::etcdserverpb::WatchResponse> &watchResponse)
+{
+    return CollectRange(payload, shardIndexes)
+        .Then(litebus::Defer(GetAID(), &KvServiceAccessorActor::OnGetAndWatchAcrossShards, from, requestId, payload,
+                             watchResponse, std::placeholders::_1));
+}
+
+Status KvServiceAccessorActor::OnGetAndWatchAcrossShards(
+    const litebus::AID &from, const std::string &requestId,
+    const std::shared_ptr<::etcdserverpb::RangeRequest> &payload,
+    const std::shared_ptr<::etcdserverpb::WatchResponse> &watchResponse, const RangeResponses &responses)
+{
+    auto getResponse = std::make_shared<::etcdserverpb::RangeResponse>(MergeRange(*payload, responses));
+    YRLOG_DEBUG("send GetAndWatch reponse across shards to {}, watch id: {}, get key count: {}", from.HashString(),
+                watchResponse->watch_id(), getResponse->kvs_size());
+    auto paging = std::make_shared<GetAndWatchPaging>();
+    paging->to = from;
+    paging->uuid = requestId;
+    paging->watchResponseMsg = watchResponse->SerializeAsString();
+    paging->header = getResponse->header();
+    paging->count = getResponse->count();
+    KvServiceActor::SendGetAndWatchPages(shards_->watchServiceActor, paging, getResponse, 0);
+    return Status::OK();
+}
 }  // namespace functionsystem::meta_store
@@ -17,10 +17,16 @@
 #ifndef FUNCTION_MASTER_META_STORE_KV_SERVICE_ACCESSOR_ACTOR_H
 #define FUNCTION_MASTER_META_STORE_KV_SERVICE_ACCESSOR_ACTOR_H
 
+#include <list>
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "actor/actor.hpp"
 #include "async/future.hpp"
+#include "kv_shard_router.h"
+#include "proto/pb/message_pb.h"
+#include "status/status.h"
 
 namespace functionsystem::meta_store {
 class KvServiceAccessorActor : public litebus::ActorBase {
@@ -29,6 +35,9 @@ public:
 
     KvServiceAccessorActor(const litebus::AID &kvServiceActor, const std::string &namePrefix);
 
+    // routes the requests to the kv service actors of the shards
+    KvServiceAccessorActor(const std::shared_ptr<KvShards> &shards, const std::string &namePrefix);
+
     ~KvServiceAccessorActor() override = default;
 
 protected:
@@ -47,8 +56,42 @@ private:
     bool InsertRequestSet(const std::string &id);
     void RemoveRequestSet(const std::string &id);
 
+    std::vector<size_t> RouteRange(const std::string &key, const std::string &rangeEnd) const;
+    const litebus::AID &ShardActor(size_t index) const;
+    void Reject(const litebus::AID &from, const std::string &method, const std::string &requestId,
+                const std::string &reason);
+
+    using RangeResponses = std::list<std::shared_ptr<::etcdserverpb::RangeResponse>>;
+    litebus::Future<RangeResponses> CollectRange(const std::shared_ptr<::etcdserverpb::RangeRequest> &request,
+                                                 const std::vector<size_t> &shardIndexes);
+    static ::etcdserverpb::RangeResponse MergeRange(const ::etcdserverpb::RangeRequest &request,
+                                                    const RangeResponses &responses);
+
+    litebus::Future<Status> GetAcrossShards(const litebus::AID &from,
+                                            const std::shared_ptr<messages::MetaStoreRequest> &request,
+                                            const std::shared_ptr<::etcdserverpb::RangeRequest> &payload,
+                                            const std::vector<size_t> &shardIndexes);
+    Status OnGetAcrossShards(const litebus::AID &from, const std::string &requestId,
+                             const std::shared_ptr<::etcdserverpb::RangeRequest> &payload,
+                             const RangeResponses &responses);
+
+    litebus::Future<Status> GetAndWatchAcrossShards(
+        const litebus::AID &from, const std::string &requestId,
+        const std::shared_ptr<::etcdserverpb::WatchCreateRequest> &createRequest,
+        const std::vector<size_t> &shardIndexes);
+    litebus::Future<Status> OnCreateWatchAcrossShards(
+        const litebus::AID &from, const std::string &requestId,
+        const std::shared_ptr<::etcdserverpb::RangeRequest> &payload, const std::vector<size_t> &shardIndexes,
+        const std::shared_ptr<::etcdserverpb::WatchResponse> &watchResponse);
+    Status OnGetAndWatchAcrossShards(const litebus::AID &from, const std::string &requestId,
+                                     const std::shared_ptr<::etcdserverpb::RangeRequest> &payload,
+                                     const std::shared_ptr<::etcdserverpb::WatchResponse> &watchResponse,
+                                     const RangeResponses &responses);
+
 private:
+    // the default shard if sharded
     litebus::AID kvServiceActor_;
+    std::shared_ptr<KvShards> shards_;
     std::unordered_set<std::string> requestSet_;
     litebus::Future<bool> isRecoverReady_;
 };
@@ -39,13 +39,18 @@ KvServiceActor::KvServiceActor(const std::string &namePrefix)
 {
 }
 
+KvServiceActor::KvServiceActor(const litebus::AID &backupActor, const std::string &namePrefix)
+    : ActorBase(namePrefix + "KvServiceActor"), backupActor_(backupActor), namePrefix_(namePrefix)
+{
+}
+
 void KvServiceActor::Init()
 {
 }
 
 void KvServiceActor::Finalize()
 {
-    if (watchServiceActor_.OK()) {
+    if (watchServiceActor_.OK() && ownWatchServiceActor_) {
         litebus::Terminate(watchServiceActor_);
         litebus::Await(watchServiceActor_);
     }
@@ -64,6 +69,7 @@ void KvServiceActor::CheckAndCreateWatchServiceActor()
         const std::string watchServiceActorName = namePrefix_ + "WatchServiceActor";
         auto watchSrvActor = std::make_shared<WatchServiceActor>(watchServiceActorName);
         watchServiceActor_ = litebus::Spawn(watchSrvActor);
+        ownWatchServiceActor_ = true;
     }
 }
 
@@ -77,8 +83,26 @@ litebus::Future<Status> KvServiceActor::AsyncWatch(const litebus::AID &from,
         return Status(StatusCode::FAILED, "receive illegal watch request");
     }
     CheckAndCreateWatchServiceActor();
-    return litebus::Async(watchServiceActor_, &WatchServiceActor::Create, from, request->requestid(),
-                          std::make_shared<::etcdserverpb::WatchCreateRequest>(watchRequest.create_request()));
+    auto createRequest = std::make_shared<::etcdserverpb::WatchCreateRequest>(watchRequest.create_request());
+    int64_t startRevision = createRequest->start_revision();
+    if (startRevision <= 0 || startRevision == modRevision_ + 1) {
+        return litebus::Async(watchServiceActor_, &WatchServiceActor::Create, from, request->requestid(),
+                              createRequest);
+    }
+
+    // a start revision beyond the current one is from a store this one has not recovered, resync as compacted
+    auto events = std::make_shared<std::vector<::mvccpb::Event>>();
+    if (startRevision > modRevision_ || !history_.Replay(startRevision, *createRequest, *events)) {
+        YRLOG_WARN("{}|watch key {} from revision {} is compacted, compact revision: {}, current revision: {}",
+                   request->requestid(), createRequest->key(), startRevision, history_.CompactRevision(),
+                   modRevision_);
+        events = nullptr;
+    } else {
+        YRLOG_INFO("{}|resume watch key {} from revision {} with {} events", request->requestid(),
+                   createRequest->key(), startRevision, events->size());
+    }
+    return litebus::Async(watchServiceActor_, &WatchServiceActor::Resume, from, request->requestid(), createRequest,
+                          events, history_.CompactRevision());
 }
 
 void KvServiceActor::ConvertWatchCreateRequestToRangeRequest(
@@ -112,20 +136,93 @@ litebus::Future<Status> KvServiceActor::OnAsyncGetAndWatch(
     std::shared_ptr<::etcdserverpb::WatchResponse> watchResponse)
 {
     ::etcdserverpb::RangeRequest getRequest;
-    ::etcdserverpb::RangeResponse getResponse;
     ConvertWatchCreateRequestToRangeRequest(watchRequest, getRequest);
-    Range(&getRequest, &getResponse);
+    auto paging = std::make_shared<GetAndWatchPaging>();
+    paging->to = from;
+    paging->uuid = uuid;
+    paging->watchResponseMsg = watchResponse->SerializeAsString();
+    paging->header.set_cluster_id(META_STORE_CLUSTER_ID);
+    paging->header.set_revision(modRevision_);
+    paging->key = getRequest.key();
+    // a single key is the range up to the key after it
+    paging->rangeEnd = getRequest.range_end().empty() ? getRequest.key() + '\0' : getRequest.range_end();
+    auto range = SeekRange(paging->key, paging->rangeEnd);
+    paging->count = static_cast<int64_t>(std::distance(range.first, range.second));
+
+    YRLOG_DEBUG("send GetAndWatch reponse to {}, watch id: {}, get key count: {}", from.HashString(),
+                watchResponse->watch_id(), paging->count);
+    SendGetAndWatchPages(paging);
+    return Status::OK();
+}
 
+void KvServiceActor::SendGetAndWatchPages(const std::shared_ptr<GetAndWatchPaging> &paging)
+{
+    ::etcdserverpb::RangeResponse page;
+    // a write may erase the kv of an iterator between the pages, every page seeks from its first key
+    auto [iterator, end] = SeekRange(paging->key, paging->rangeEnd);
+    size_t bytes = 0;
+    for (; iterator != end && !IsPageFull(page, bytes); ++iterator) {
+        // the watcher was created before the snapshot, a kv changed since goes with its event
+        if (iterator->second.mod_revision() > paging->header.revision()) {
+            continue;
+        }
+        bytes += iterator->first.size() + iterator->second.value().size();
+        *page.add_kvs() = iterator->second;
+    }
+    page.set_more(iterator != end);
+    auto sent = SendGetAndWatchPage(watchServiceActor_, *paging, page);
+    if (!page.more()) {
+        return;
+    }
+    paging->key = iterator->first;
+    sent.OnComplete([aid(GetAID()), paging](const litebus::Future<Status> &) {
+        litebus::Async(aid, &KvServiceActor::SendGetAndWatchPages, paging);
+    });
+}
+
+void KvServiceActor::SendGetAndWatchPages(const litebus::AID &watchServiceActor,
+                                          const std::shared_ptr<GetAndWatchPaging> &paging,
+                                          const std::shared_ptr<const ::etcdserverpb::RangeResponse> &snapshot,
+                                          int index)
+{
+    ::etcdserverpb::RangeResponse page;
+    size_t bytes = 0;
+    while (index < snapshot->kvs_size() && !IsPageFull(page, bytes)) {
+        const auto &kv = snapshot->kvs(index++);
+        bytes += kv.key().size() + kv.value().size();
+        *page.add_kvs() = kv;
+    }
+    page.set_more(index < snapshot->kvs_size());
+    auto sent = SendGetAndWatchPage(watchServiceActor, *paging, page);
+    if (!page.more()) {
+        return;
+    }
+    // the snapshot is not shared with any actor, the next page is built where the one before is sent
+    sent.OnComplete([watchServiceActor, paging, snapshot, index](const litebus::Future<Status> &) {
+        SendGetAndWatchPages(watchServiceActor, paging, snapshot, index);
+    });
+}
+
+litebus::Future<Status> KvServiceActor::SendGetAndWatchPage(const litebus::AID &watchServiceActor,
+                                                            const GetAndWatchPaging &paging,
+                                                            const ::etcdserverpb::RangeResponse &page)
+{
+    ::etcdserverpb::RangeResponse response(page);
+    *response.mutable_header() = paging.header;
+    response.set_count(paging.count);
     messages::GetAndWatchResponse gwResponse;
-    gwResponse.set_getresponsemsg(getResponse.SerializeAsString());
-    gwResponse.set_watchresponsemsg(watchResponse->SerializeAsString());
+    gwResponse.set_getresponsemsg(response.SerializeAsString());
+    gwResponse.set_watchresponsemsg(paging.watchResponseMsg);
     messages::MetaStoreResponse res;
-    res.set_responseid(uuid);
+    res.set_responseid(paging.uuid);
     res.set_responsemsg(gwResponse.SerializeAsString());
-    YRLOG_DEBUG("send GetAndWatch reponse to {}, watch id: {}, get key count: {}", from.HashString(),
-                watchResponse->watch_id(), getResponse.kvs_size());
-    litebus::Async(watchServiceActor_, &WatchServiceActor::SendResponse, from, "OnGetAndWatch", res);
-    return Status::OK();
+    return litebus::Async(watchServiceActor, &WatchServiceActor::SendPage, paging.to, res);
+}
+
+bool KvServiceActor::IsPageFull(const ::etcdserverpb::RangeResponse &page, size_t bytes)
+{
+    return page.kvs_size() >= DEFAULT_GET_AND_WATCH_PAGE_SIZE
+           || (page.kvs_size() > 0 && bytes >= META_STORE_GET_AND_WATCH_PAGE_BYTES);
 }
 
 Status KvServiceActor::AddWatchServiceActor(const litebus::AID &aid)
@@ -137,6 +234,14 @@ Status KvServiceActor::AddWatchServiceActor(const litebus::AID &aid)
 Status KvServiceActor::RemoveWatchServiceActor()
 {
     watchServiceActor_ = litebus::AID();
+    ownWatchServiceActor_ = false;
+    return Status::OK();
+}
+
+Status KvServiceActor::SetShard(const std::shared_ptr<KvShardRouter> &router, size_t index)
+{
+    shardRouter_ = router;
+    shardIndex_ = index;
     return Status::OK();
 }
 
@@ -191,13 +296,7 @@ litebus::Future<Status> KvServiceActor::AsyncPut(const litebus::AID &from,
 
     ::mvccpb::KeyValue prevKv = cache_[request->key()];  // 1.copy,temporary
     ::mvccpb::KeyValue &kv = cache_[request->key()];     // 2.get reference
-    if (modRevision_ >= std::numeric_limits<int64_t>::max()) {
-        YRLOG_WARN("modRevision_ reached maximum value. Auto-reset to 0.");
-        modRevision_ = 0;
-    } else {
-        ++modRevision_;
-    }
-    kv.set_mod_revision(modRevision_);
+    kv.set_mod_revision(NextRevision());
     if (!kv.key().empty()) {
         if (request->prevkv()) {  // 3.return preview
             response->set_prevkv(prevKv.SerializeAsString());
@@ -212,6 +311,7 @@ litebus::Future<Status> KvServiceActor::AsyncPut(const litebus::AID &from,
     kv.set_value(request->value());
     kv.set_lease(request->lease());
 
+    history_.AddPut(kv, prevKv);
     litebus::Async(watchServiceActor_, &WatchServiceActor::OnPut, kv, prevKv);
     litebus::Async(leaseServiceActor_, &LeaseServiceActor::Attach, request->key(), request->lease());
 
@@ -314,12 +414,8 @@ DeleteResults KvServiceActor::DeleteRange(const ::etcdserverpb::DeleteRangeReque
         }
         cache_.erase(request->key());
     } else {
-        for (auto iterator = cache_.begin(); iterator != cache_.end();) {
-            if (iterator->first < request->key() || iterator->first >= request->range_end()) {
-                iterator++;  // not in range, next
-                continue;
-            }
-
+        auto range = SeekRange(request->key(), request->range_end());
+        for (auto iterator = range.first; iterator != range.second;) {
             ::mvccpb::KeyValue &kv = iterator->second;  // 1.get reference of key-value.
             deletes->emplace_back(kv);                  // 2.add key-value to list and copy.
             if (request->prev_kv()) {                   // 3.makeUp preview key-value.
@@ -331,7 +427,12 @@ DeleteResults KvServiceActor::DeleteRange(const ::etcdserverpb::DeleteRangeReque
 
     response->set_deleted(static_cast<int64_t>(deletes->size()));
     if (!deletes->empty()) {
-        litebus::Async(watchServiceActor_, &WatchServiceActor::OnDeleteList, deletes);
+        // all the keys of a delete range go at one revision
+        header->set_revision(NextRevision());
+        for (const auto &kv : *deletes) {
+            history_.AddDelete(modRevision_, kv);
+        }
+        litebus::Async(watchServiceActor_, &WatchServiceActor::OnDeleteList, deletes, modRevision_);
     }
 
     return deletes;
@@ -376,6 +477,31 @@ litebus::Future<Status> KvServiceActor::AsyncGet(const litebus::AID &from,
     return OnAsyncGet(from, request, response);
 }
 
+KvServiceActor::CacheRange KvServiceActor::SeekRange(const std::string &key, const std::string &rangeEnd)
+{
+    // etcd: range_end "\0" means every key not less than key
+    auto begin = cache_.lower_bound(key);
+    if (rangeEnd.size() == 1 && rangeEnd[0] == '\0') {
+        return { begin, cache_.end() };
+    }
+    if (rangeEnd <= key) {
+        return { begin, begin };
+    }
+    return { begin, cache_.lower_bound(rangeEnd) };
+}
+
+void KvServiceActor::AddRangeKv(const etcdserverpb::RangeRequest *request, etcdserverpb::RangeResponse *response,
+                                const ::mvccpb::KeyValue &kv)
+{
+    auto addKv = response->add_kvs();
+    addKv->set_key(kv.key());
+    addKv->set_mod_revision(kv.mod_revision());
+    if (request->keys_only()) {
+        return;
+    }
+    addKv->set_value(kv.value());
+}
+
 ::grpc::Status KvServiceActor::Range(const ::etcdserverpb::RangeRequest *request,
                                      ::etcdserverpb::RangeResponse *response)
 {
@@ -398,89 +524,102 @@ litebus::Future<Status> KvServiceActor::AsyncGet(const litebus::AID &from,
             return grpc::Status::OK;
         }
 
-        auto kv = response->add_kvs();
-        kv->set_key(iterator->first);
-        kv->set_mod_revision(iterator->second.mod_revision());
-        if (request->keys_only()) {
-            return grpc::Status::OK;
-        }
-
-        kv->set_value(iterator->second.value());
-
+        AddRangeKv(request, response, iterator->second);
         return grpc::Status::OK;
     }
-    std::vector<::mvccpb::KeyValue> targets;
-    for (auto &iterator : cache_) {
-        if (iterator.first < request->key() || iterator.first >= request->range_end()) {
-            continue;
-        }
 
-        response->set_count(response->count() + 1);
-        targets.emplace_back(iterator.second);
+    auto range = SeekRange(request->key(), request->range_end());
+    auto count = static_cast<int64_t>(std::distance(range.first, range.second));
+    response->set_count(count);
+    int64_t limit = request->limit() > 0 && request->limit() < count ? request->limit() : count;
+    response->set_more(limit < count);
+    if (request->count_only() || limit == 0) {
+        return grpc::Status::OK;
     }
 
-    if (request->count_only()) {
+    // the cache is ordered by key, a key sort is a walk from either end of the range and stops at the limit
+    if (request->sort_target() == etcdserverpb::RangeRequest_SortTarget_KEY) {
+        if (request->sort_order() == etcdserverpb::RangeRequest_SortOrder_DESCEND) {
+            auto iterator = range.second;
+            for (int64_t i = 0; i < limit; ++i) {
+                AddRangeKv(request, response, (--iterator)->second);
+            }
+        } else {
+            auto iterator = range.first;
+            for (int64_t i = 0; i < limit; ++i, ++iterator) {
+                AddRangeKv(request, response, iterator->second);
+            }
+        }
         return grpc::Status::OK;
     }
 
-    SortTarget(request, targets);
+    std::vector<const ::mvccpb::KeyValue *> targets;
+    targets.reserve(static_cast<size_t>(count));
+    for (auto iterator = range.first; iterator != range.second; ++iterator) {
+        targets.emplace_back(&iterator->second);
+    }
 
-    for (auto &iterator : targets) {
-        auto kv = response->add_kvs();
-        kv->set_key(iterator.key());
-        kv->set_mod_revision(iterator.mod_revision());
-        if (request->keys_only()) {
-            continue;
-        }
-        kv->set_value(iterator.value());
+    SortTarget(request, targets, static_cast<size_t>(limit));
+
+    for (int64_t i = 0; i < limit; ++i) {
+        AddRangeKv(request, response, *targets[static_cast<size_t>(i)]);
     }
 
     return grpc::Status::OK;
 }
 
-void KvServiceActor::SortTarget(const etcdserverpb::RangeRequest *request, std::vector<mvccpb::KeyValue> &targets)
+std::shared_ptr<::etcdserverpb::RangeResponse> KvServiceActor::ShardRange(
+    const std::shared_ptr<::etcdserverpb::RangeRequest> &request)
 {
-    etcdserverpb::RangeRequest_SortOrder order = request->sort_order();
+    auto response = std::make_shared<::etcdserverpb::RangeResponse>();
+    (void)Range(request.get(), response.get());
+    return response;
+}
+
+template <typename F>
+static void SortTargetBy(std::vector<const mvccpb::KeyValue *> &targets, size_t limit, bool descend, F field)
+{
+    auto compare = [descend, &field](const mvccpb::KeyValue *s, const mvccpb::KeyValue *t) -> bool {
+        return descend ? field(*s) > field(*t) : field(*s) < field(*t);
+    };
+    // the cache walk is in key order, keep it among the equal ones
+    if (limit < targets.size()) {
+        std::partial_sort(targets.begin(), targets.begin() + static_cast<std::ptrdiff_t>(limit), targets.end(),
+                          [&compare](const mvccpb::KeyValue *s, const mvccpb::KeyValue *t) -> bool {
+                              return compare(s, t) || (!compare(t, s) && s->key() < t->key());
+                          });
+        return;
+    }
+    std::stable_sort(targets.begin(), targets.end(), compare);
+}
+
+void KvServiceActor::SortTarget(const etcdserverpb::RangeRequest *request,
+                                std::vector<const mvccpb::KeyValue *> &targets, size_t limit)
+{
+    bool descend = request->sort_order() == etcdserverpb::RangeRequest_SortOrder_DESCEND;
     switch (request->sort_target()) {
         case etcdserverpb::RangeRequest_SortTarget_KEY: {
-            std::sort(targets.begin(), targets.end(),
-                      [&order](const mvccpb::KeyValue &s, const mvccpb::KeyValue &t) -> bool {
-                          return order == etcdserverpb::RangeRequest_SortOrder_DESCEND ? s.key() > t.key()
-                                                                                       : s.key() < t.key();
-                      });
+            SortTargetBy(targets, limit, descend, [](const mvccpb::KeyValue &kv) -> const std::string & {
+                return kv.key();
+            });
             break;
         }
         case etcdserverpb::RangeRequest_SortTarget_VERSION: {
-            std::sort(targets.begin(), targets.end(),
-                      [&order](const mvccpb::KeyValue &s, const mvccpb::KeyValue &t) -> bool {
-                          return order == etcdserverpb::RangeRequest_SortOrder_DESCEND ? s.version() > t.version()
-                                                                                       : s.version() < t.version();
-                      });
+            SortTargetBy(targets, limit, descend, [](const mvccpb::KeyValue &kv) { return kv.version(); });
             break;
         }
         case etcdserverpb::RangeRequest_SortTarget_CREATE: {
-            std::sort(targets.begin(), targets.end(),
-                      [&order](const mvccpb::KeyValue &s, const mvccpb::KeyValue &t) -> bool {
-                          return order == etcdserverpb::RangeRequest_SortOrder_DESCEND
-                                     ? s.create_revision() > t.create_revision()
-                                     : s.create_revision() < t.create_revision();
-                      });
+            SortTargetBy(targets, limit, descend, [](const mvccpb::KeyValue &kv) { return kv.create_revision(); });
             break;
         }
         case etcdserverpb::RangeRequest_SortTarget_MOD: {
-            std::sort(
-                targets.begin(), targets.end(), [&order](const mvccpb::KeyValue &s, const mvccpb::KeyValue &t) -> bool {
-                    return order == etcdserverpb::RangeRequest_SortOrder_DESCEND ? s.mod_revision() > t.mod_revision()
-                                                                                 : s.mod_revision() < t.mod_revision();
-                });
+            SortTargetBy(targets, limit, descend, [](const mvccpb::KeyValue &kv) { return kv.mod_revision(); });
             break;
         }
         case etcdserverpb::RangeRequest_SortTarget_VALUE: {
-            std::sort(targets.begin(), targets.end(),
-                      [&order](const mvccpb::KeyValue &s, const mvccpb::KeyValue &t) -> bool {
-                          return order == etcdserverpb::RangeRequest_SortOrder_DESCEND ? s.value() > t.value()
-                                                                                       : s.value() < t.value();
-                      });
+            SortTargetBy(targets, limit, descend, [](const mvccpb::KeyValue &kv) -> const std::string & {
+                return kv.value();
+            });
             break;
         }
         case etcdserverpb::RangeRequest_SortTarget_RangeRequest_SortTarget_INT_MIN_SENTINEL_DO_NOT_USE_:
@@ -698,7 +837,7 @@ TxnResults KvServiceActor::TxnElse(const ::etcdserverpb::TxnRequest *request, ::
     return txn;
 }
 
-Status KvServiceActor::OnRevoke(const std::set<std::string> &keys)
+Status KvServiceActor::OnRevoke(const std::vector<std::string> &keys)
 {
     auto deletes = std::make_shared<std::vector<::mvccpb::KeyValue>>();
     for (const auto &key : keys) {
@@ -712,7 +851,11 @@ Status KvServiceActor::OnRevoke(const std::set<std::string> &keys)
         cache_.erase(iterator);
     }
     if (!deletes->empty()) {
-        litebus::Async(watchServiceActor_, &WatchServiceActor::OnDeleteList, deletes);
+        (void)NextRevision();
+        for (const auto &kv : *deletes) {
+            history_.AddDelete(modRevision_, kv);
+        }
+        litebus::Async(watchServiceActor_, &WatchServiceActor::OnDeleteList, deletes, modRevision_);
     }
     if (backupActor_.OK()) {
         litebus::Async(backupActor_, &BackupActor::WriteDeletes, deletes, true);
@@ -740,18 +883,34 @@ bool KvServiceActor::Sync(const std::shared_ptr<GetResponse> &getResponse)
             YRLOG_WARN("failed to parse value for key({})", item.key());
             continue;
         }
-        cache_[item.key().substr(META_STORE_BACKUP_KV_PREFIX.size())] = kv;
-        YRLOG_INFO("success to sync kv({})", item.key().substr(META_STORE_BACKUP_KV_PREFIX.size()));
+        auto key = item.key().substr(META_STORE_BACKUP_KV_PREFIX.size());
+        if (shardRouter_ != nullptr && shardRouter_->Route(key) != shardIndex_) {
+            continue;
+        }
+        cache_[key] = kv;
+        YRLOG_INFO("success to sync kv({})", key);
 
         // set max mod_revision for current mod reversion
         if (modRevision_ < kv.mod_revision()) {
             modRevision_ = kv.mod_revision();
         }
     }
+    // the history before the recovery is lost, the watchers resuming from it resync
+    history_.Reset(modRevision_ + 1);
     YRLOG_INFO("success to sync kvs with mod revision({})", modRevision_);
     return true;
 }
 
+int64_t KvServiceActor::NextRevision()
+{
+    if (modRevision_ >= std::numeric_limits<int64_t>::max()) {
+        YRLOG_WARN("modRevision_ reached maximum value. Auto-reset to 0.");
+        modRevision_ = 0;
+        history_.Reset(1);
+    }
+    return ++modRevision_;
+}
+
 void KvServiceActor::OnHealthyStatus(const Status &status)
 {
     YRLOG_DEBUG("KvServiceActor health status changes to healthy({})", status.IsOk());
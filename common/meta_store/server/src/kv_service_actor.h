@@ -19,13 +19,34 @@
 
 #include "actor/actor.hpp"
 #include "backup_actor.h"
+#include "kv_shard_router.h"
 #include "meta_store_monitor/meta_store_healthy_observer.h"
 #include "meta_store_client/meta_store_struct.h"
 #include "proto/pb/message_pb.h"
+#include "revision_history.h"
 #include "status/status.h"
 #include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
 
 namespace functionsystem::meta_store {
+// the state of the pages of the snapshot of a get and watch between the turns that send them
+struct GetAndWatchPaging {
+    litebus::AID to;
+
+    std::string uuid;
+
+    std::string watchResponseMsg;
+
+    // the revision of the snapshot
+    ::etcdserverpb::ResponseHeader header;
+
+    int64_t count{ 0 };
+
+    // the first key of the next page and the end of the range
+    std::string key;
+
+    std::string rangeEnd;
+};
+
 class KvServiceActor : public litebus::ActorBase, public MetaStoreHealthyObserver {
 public:
     KvServiceActor();
@@ -34,6 +55,8 @@ public:
 
     explicit KvServiceActor(const std::string &namePrefix);
 
+    KvServiceActor(const litebus::AID &backupActor, const std::string &namePrefix);
+
     ~KvServiceActor() override = default;
 
 public:
@@ -53,7 +76,10 @@ public:
 public:
     Status AddLeaseServiceActor(const litebus::AID &aid);
 
-    Status AddWatchServiceActor(const litebus::AID &aid);  // for test
+    Status AddWatchServiceActor(const litebus::AID &aid);  // for test and the watch service shared by the shards
+
+    // serves the keys of the shard only, the recovery skips the others
+    Status SetShard(const std::shared_ptr<KvShardRouter> &router, size_t index);
 
     Status RemoveWatchServiceActor();  // for test
 
@@ -67,9 +93,35 @@ public:
     DeleteResults DeleteRange(const ::etcdserverpb::DeleteRangeRequest *request,
                               ::etcdserverpb::DeleteRangeResponse *response);
 
-    Status OnRevoke(const std::set<std::string> &keys);
+    Status OnRevoke(const std::vector<std::string> &keys);
 
     ::grpc::Status Range(const ::etcdserverpb::RangeRequest *request, ::etcdserverpb::RangeResponse *response);
+
+    // the part of a range across shards in this shard
+    std::shared_ptr<::etcdserverpb::RangeResponse> ShardRange(
+        const std::shared_ptr<::etcdserverpb::RangeRequest> &request);
+
+    // sends the snapshot of a get and watch in pages of its revision, every page but the last is marked with more.
+    // A page is built from the cache once the one before is sent, the kvs changed since the snapshot are left to the
+    // events of the watcher.
+    void SendGetAndWatchPages(const std::shared_ptr<GetAndWatchPaging> &paging);
+
+    // the same for a snapshot already read, as the one merged across shards
+    static void SendGetAndWatchPages(const litebus::AID &watchServiceActor,
+                                     const std::shared_ptr<GetAndWatchPaging> &paging,
+                                     const std::shared_ptr<const ::etcdserverpb::RangeResponse> &snapshot, int index);
+
+    // the future is set once the watch service sent the page
+    static litebus::Future<Status> SendGetAndWatchPage(const litebus::AID &watchServiceActor,
+                                                       const GetAndWatchPaging &paging,
+                                                       const ::etcdserverpb::RangeResponse &page);
+
+    // a page is bounded by both the kv count and the bytes of the kvs, it holds one kv at least
+    static bool IsPageFull(const ::etcdserverpb::RangeResponse &page, size_t bytes);
+
+    // sorts the first limit targets only
+    static void SortTarget(const etcdserverpb::RangeRequest *request, std::vector<const ::mvccpb::KeyValue *> &targets,
+                           size_t limit);
     TxnResults Txn(const ::etcdserverpb::TxnRequest *request, ::etcdserverpb::TxnResponse *response,
                    const std::string &requestId);
 
@@ -104,15 +156,26 @@ protected:
 
     std::map<std::string, ::mvccpb::KeyValue> cache_;
 
+    RevisionHistory history_;
+
     litebus::AID leaseServiceActor_;
 
     litebus::AID watchServiceActor_;
 
+    // terminated with this actor if created by it
+    bool ownWatchServiceActor_{ false };
+
+    std::shared_ptr<KvShardRouter> shardRouter_;
+
+    size_t shardIndex_{ 0 };
+
     litebus::AID etcdKvClientActor_;
 
     litebus::AID backupActor_;
 
 protected:
+    int64_t NextRevision();
+
     virtual void CheckAndCreateWatchServiceActor();
     void ConvertWatchCreateRequestToRangeRequest(std::shared_ptr<::etcdserverpb::WatchCreateRequest> createReq,
                                                  etcdserverpb::RangeRequest &rangeReq);
@@ -126,7 +189,14 @@ protected:
 
     TxnResults TxnElse(const ::etcdserverpb::TxnRequest *request, ::etcdserverpb::TxnResponse *response);
 
-    static void SortTarget(const etcdserverpb::RangeRequest *request, std::vector<::mvccpb::KeyValue> &targets);
+    using CacheRange = std::pair<std::map<std::string, ::mvccpb::KeyValue>::iterator,
+                                 std::map<std::string, ::mvccpb::KeyValue>::iterator>;
+
+    // seeks the [key, rangeEnd) bounds in the cache instead of walking it
+    CacheRange SeekRange(const std::string &key, const std::string &rangeEnd);
+
+    static void AddRangeKv(const etcdserverpb::RangeRequest *request, etcdserverpb::RangeResponse *response,
+                           const ::mvccpb::KeyValue &kv);
 
     void AddPrevKv(etcdserverpb::DeleteRangeResponse *response, const ::mvccpb::KeyValue &kv);
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kv_shard_router.h"
+
+#include "logs/logging.h"
+#include "meta_store_client/utils/string_util.h"
+
+namespace functionsystem::meta_store {
+KvShardRouter::KvShardRouter(const std::vector<std::string> &prefixes)
+{
+    for (const auto &prefix : prefixes) {
+        bool nested = prefix.empty();
+        for (const auto &accepted : prefixes_) {
+            if (prefix.compare(0, accepted.size(), accepted) == 0 || accepted.compare(0, prefix.size(), prefix) == 0) {
+                nested = true;
+                break;
+            }
+        }
+        if (nested) {
+            YRLOG_WARN("drop meta store shard prefix({}), it is empty or nested in another one", prefix);
+            continue;
+        }
+        prefixes_.emplace_back(prefix);
+        prefixEnds_.emplace_back(StringPlusOne(prefix));
+    }
+}
+
+size_t KvShardRouter::Route(const std::string &key) const
+{
+    for (size_t i = 0; i < prefixes_.size(); ++i) {
+        if (key.compare(0, prefixes_[i].size(), prefixes_[i]) == 0) {
+            return i;
+        }
+    }
+    return DefaultShard();
+}
+
+std::vector<size_t> KvShardRouter::RouteRange(const std::string &key, const std::string &rangeEnd) const
+{
+    bool toEnd = rangeEnd == std::string(1, '\0');
+    if (rangeEnd.empty() || (!toEnd && rangeEnd <= key)) {
+        return { Route(key) };
+    }
+    // the prefix ranges are disjoint, a range inside one of them overlaps no other
+    std::vector<size_t> shards;
+    for (size_t i = 0; i < prefixes_.size(); ++i) {
+        if (key >= prefixes_[i] && !toEnd && rangeEnd <= prefixEnds_[i]) {
+            return { i };
+        }
+        if (key < prefixEnds_[i] && (toEnd || prefixes_[i] < rangeEnd)) {
+            shards.emplace_back(i);
+        }
+    }
+    shards.emplace_back(DefaultShard());
+    return shards;
+}
+
+litebus::Option<size_t> KvShardRouter::RouteTxn(const ::etcdserverpb::TxnRequest &request) const
+{
+    litebus::Option<size_t> shard;
+    if (!CollectTxnShards(request, shard)) {
+        return litebus::None();
+    }
+    if (shard.IsNone()) {
+        // no key at all
+        return DefaultShard();
+    }
+    return shard;
+}
+
+bool KvShardRouter::CollectTxnShards(const ::etcdserverpb::TxnRequest &request, litebus::Option<size_t> &shard) const
+{
+    auto add = [this, &shard](const std::string &key, const std::string &rangeEnd) {
+        auto shards = RouteRange(key, rangeEnd);
+        if (shards.size() != 1 || (shard.IsSome() && shard.Get() != shards[0])) {
+            return false;
+        }
+        shard = shards[0];
+        return true;
+    };
+    for (const auto &compare : request.compare()) {
+        if (!add(compare.key(), compare.range_end())) {
+            return false;
+        }
+    }
+    for (const auto *ops : { &request.success(), &request.failure() }) {
+        for (const auto &op : *ops) {
+            bool single = true;
+            if (op.has_request_range()) {
+                single = add(op.request_range().key(), op.request_range().range_end());
+            } else if (op.has_request_put()) {
+                single = add(op.request_put().key(), "");
+            } else if (op.has_request_delete_range()) {
+                single = add(op.request_delete_range().key(), op.request_delete_range().range_end());
+            } else if (op.has_request_txn()) {
+                single = CollectTxnShards(op.request_txn(), shard);
+            }
+            if (!single) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}  // namespace functionsystem::meta_store
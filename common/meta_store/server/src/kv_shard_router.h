@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTION_MASTER_META_STORE_KV_SHARD_ROUTER_H
+#define FUNCTION_MASTER_META_STORE_KV_SHARD_ROUTER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "actor/aid.hpp"
+#include "async/option.hpp"
+#include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
+
+namespace functionsystem::meta_store {
+// Partitions the meta store keys by prefix: shard i serves the keys under prefixes[i] and the last shard the rest.
+// A prefix nested in another one is dropped, so a key belongs to one shard.
+class KvShardRouter {
+public:
+    explicit KvShardRouter(const std::vector<std::string> &prefixes);
+
+    ~KvShardRouter() = default;
+
+    size_t ShardCount() const
+    {
+        return prefixes_.size() + 1;
+    }
+
+    size_t DefaultShard() const
+    {
+        return prefixes_.size();
+    }
+
+    const std::vector<std::string> &Prefixes() const
+    {
+        return prefixes_;
+    }
+
+    size_t Route(const std::string &key) const;
+
+    // the shards overlapping [key, rangeEnd) with the etcd range conventions, in shard order
+    std::vector<size_t> RouteRange(const std::string &key, const std::string &rangeEnd) const;
+
+    // the shard of every key the txn compares, reads or writes, none if they span shards
+    litebus::Option<size_t> RouteTxn(const ::etcdserverpb::TxnRequest &request) const;
+
+private:
+    bool CollectTxnShards(const ::etcdserverpb::TxnRequest &request, litebus::Option<size_t> &shard) const;
+
+    std::vector<std::string> prefixes_;
+
+    // StringPlusOne of each prefix, the exclusive end of its range
+    std::vector<std::string> prefixEnds_;
+};
+
+// The kv service actors of the shards sharing one watch service actor, so a watch across shards is one watcher.
+struct KvShards {
+    std::shared_ptr<KvShardRouter> router;
+
+    std::vector<litebus::AID> kvServiceActors;
+
+    litebus::AID watchServiceActor;
+
+    const litebus::AID &Route(const std::string &key) const
+    {
+        return kvServiceActors[router->Route(key)];
+    }
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // FUNCTION_MASTER_META_STORE_KV_SHARD_ROUTER_H
@@ -91,6 +91,7 @@ bool LeaseServiceActor::Sync(const std::shared_ptr<GetResponse> &getResponse)
             lease.set_expiry(milliseconds + (lease.ttl() * MILLISECONDS_PRE_SECOND));
         }
         leases_[lease.id()] = lease;
+        ScheduleExpiry(lease.id(), lease.expiry());
         YRLOG_INFO("success to sync lease({})", lease.id());
     }
     YRLOG_INFO("success to sync leases");
@@ -99,6 +100,29 @@ bool LeaseServiceActor::Sync(const std::shared_ptr<GetResponse> &getResponse)
     return true;
 }
 
+Status LeaseServiceActor::SetKvShards(const std::shared_ptr<KvShards> &shards)
+{
+    kvShards_ = shards;
+    return Status::OK();
+}
+
+void LeaseServiceActor::RevokeItems(std::vector<std::string> &&items)
+{
+    if (kvShards_ == nullptr) {
+        litebus::Async(kvServiceActor_, &KvServiceActor::OnRevoke, std::move(items));
+        return;
+    }
+    std::vector<std::vector<std::string>> shardItems(kvShards_->kvServiceActors.size());
+    for (auto &item : items) {
+        shardItems[kvShards_->router->Route(item)].emplace_back(std::move(item));
+    }
+    for (size_t i = 0; i < shardItems.size(); ++i) {
+        if (!shardItems[i].empty()) {
+            litebus::Async(kvShards_->kvServiceActors[i], &KvServiceActor::OnRevoke, std::move(shardItems[i]));
+        }
+    }
+}
+
 Status LeaseServiceActor::Attach(const std::string &item, int64_t leaseID)
 {
     auto iterator = leases_.find(leaseID);
@@ -171,6 +195,7 @@ void LeaseServiceActor::ReceiveGrant(const litebus::AID &from, std::string &&nam
     litebus::Async(backupActor_, &BackupActor::Put, META_STORE_BACKUP_LEASE_PREFIX + std::to_string(lease.id()),
                    lease.SerializeAsString(), putOption);
     leases_[response->id()] = lease;
+    ScheduleExpiry(lease.id(), lease.expiry());
     return grpc::Status::OK;
 }
 
@@ -217,17 +242,14 @@ void LeaseServiceActor::ReceiveRevoke(const litebus::AID &from, std::string &&na
         return status;
     }
 
-    std::set<std::string> items;
-    for (const auto &item : iterator->second.items()) {
-        // trans to std::set<std::string>
-        items.emplace(item);
-    }
-    litebus::Async(kvServiceActor_, &KvServiceActor::OnRevoke, items);
+    std::vector<std::string> items(iterator->second.items().begin(), iterator->second.items().end());
+    RevokeItems(std::move(items));
 
     DeleteOption option;
     litebus::Async(backupActor_, &BackupActor::Delete, META_STORE_BACKUP_LEASE_PREFIX + std::to_string(request->id()),
                    option);
     leases_.erase(iterator);
+    expiryQueued_.erase(request->id());
 
     return grpc::Status::OK;
 }
@@ -288,6 +310,19 @@ void LeaseServiceActor::ReceiveKeepAlive(const litebus::AID &from, std::string &
     return grpc::Status::OK;
 }
 
+void LeaseServiceActor::ScheduleExpiry(int64_t leaseID, int64_t expiry)
+{
+    auto [iterator, inserted] = expiryQueued_.emplace(leaseID, expiry);
+    if (!inserted) {
+        if (iterator->second <= expiry) {
+            return;
+        }
+        // granted again with a shorter ttl, the queued entry turns stale
+        iterator->second = expiry;
+    }
+    expiryQueue_.emplace(expiry, leaseID);
+}
+
 void LeaseServiceActor::CheckpointScheduledLeases()
 {
     if (!running_) {
@@ -297,21 +332,37 @@ void LeaseServiceActor::CheckpointScheduledLeases()
     int64_t milliseconds =
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
             .count();
-    for (auto iterator = leases_.begin(); iterator != leases_.end();) {
+    std::vector<std::string> items;
+    size_t expired = 0;
+    while (!expiryQueue_.empty() && expiryQueue_.top().first < milliseconds) {
+        auto [expiry, leaseID] = expiryQueue_.top();
+        expiryQueue_.pop();
+        auto queued = expiryQueued_.find(leaseID);
+        if (queued == expiryQueued_.end() || queued->second != expiry) {
+            continue;  // stale
+        }
+        auto iterator = leases_.find(leaseID);
+        if (iterator == leases_.end()) {
+            expiryQueued_.erase(queued);
+            continue;
+        }
         if (iterator->second.expiry() >= milliseconds) {
-            iterator++;
+            // kept alive since queued
+            queued->second = iterator->second.expiry();
+            expiryQueue_.emplace(queued->second, leaseID);
             continue;
         }
 
-        std::set<std::string> items;
-        for (const auto &item : iterator->second.items()) {
-            // trans to std::set<std::string>
-            items.emplace(item);
-        }
-        litebus::Async(kvServiceActor_, &KvServiceActor::OnRevoke, items);
-        litebus::Async(backupActor_, &BackupActor::Delete,
-                       META_STORE_BACKUP_LEASE_PREFIX + std::to_string(iterator->second.id()), DeleteOption{});
-        leases_.erase(iterator++);
+        items.insert(items.end(), iterator->second.items().begin(), iterator->second.items().end());
+        litebus::Async(backupActor_, &BackupActor::Delete, META_STORE_BACKUP_LEASE_PREFIX + std::to_string(leaseID),
+                       DeleteOption{});
+        leases_.erase(iterator);
+        expiryQueued_.erase(queued);
+        ++expired;
+    }
+    if (expired > 0) {
+        YRLOG_DEBUG("{} leases expired with {} items", expired, items.size());
+        RevokeItems(std::move(items));
     }
     litebus::AsyncAfter(LEASE_WAIT_TIME_MS, GetAID(), &LeaseServiceActor::CheckpointScheduledLeases);
 }
@@ -17,11 +17,13 @@
 #ifndef FUNCTION_MASTER_META_STORE_LEASE_SERVICE_ACTOR_H
 #define FUNCTION_MASTER_META_STORE_LEASE_SERVICE_ACTOR_H
 
+#include <queue>
 #include <thread>
 
 #include "actor/actor.hpp"
 #include "async/future.hpp"
 #include "backup_actor.h"
+#include "kv_shard_router.h"
 #include "meta_store_monitor/meta_store_healthy_observer.h"
 #include "meta_store_client/meta_store_struct.h"
 #include "proto/pb/message_pb.h"
@@ -43,6 +45,9 @@ public:
 
     Status Attach(const std::string &item, int64_t leaseID);
 
+    // the items of a lease may span shards, each shard revokes its own
+    Status SetKvShards(const std::shared_ptr<KvShards> &shards);
+
     virtual void ReceiveGrant(const litebus::AID &from, std::string &&name, std::string &&msg);
     ::grpc::Status LeaseGrant(const ::etcdserverpb::LeaseGrantRequest *request,
                               ::etcdserverpb::LeaseGrantResponse *response);
@@ -64,11 +69,18 @@ protected:
 private:
     void CheckpointScheduledLeases();
 
+    // queues the lease by its expiry, a later expiry from a keep alive is re-keyed lazily when the old one is due
+    void ScheduleExpiry(int64_t leaseID, int64_t expiry);
+
     bool Sync(const std::shared_ptr<GetResponse> &getResponse);
 
+    void RevokeItems(std::vector<std::string> &&items);
+
 private:
     litebus::AID kvServiceActor_;
 
+    std::shared_ptr<KvShards> kvShards_;
+
     litebus::AID backupActor_;
 
     bool running_;
@@ -78,6 +90,13 @@ private:
     int64_t index_{ time(nullptr) };
 
     std::unordered_map<int64_t, ::messages::Lease> leases_;
+
+    // (expiry, lease id) min-heap, an entry not matching expiryQueued_ is stale and dropped when popped
+    std::priority_queue<std::pair<int64_t, int64_t>, std::vector<std::pair<int64_t, int64_t>>, std::greater<>>
+        expiryQueue_;
+
+    // lease id to the expiry of its live entry in expiryQueue_
+    std::unordered_map<int64_t, int64_t> expiryQueued_;
 };
 }  // namespace functionsystem::meta_store
 
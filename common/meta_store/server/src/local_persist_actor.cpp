@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "local_persist_actor.h"
+
+#include "async/async.hpp"
+#include "logs/logging.h"
+#include "meta_store_client/utils/etcd_util.h"
+#include "meta_store_client/utils/string_util.h"
+
+namespace functionsystem::meta_store {
+LocalPersistActor::LocalPersistActor(const std::string &name, const std::string &dir, uint64_t snapshotThreshold)
+    : KvClientStrategy(name, dir, MetaStoreTimeoutOption{}), store_(dir), snapshotThreshold_(snapshotThreshold)
+{
+}
+
+void LocalPersistActor::Init()
+{
+    ::etcdserverpb::RangeResponse snapshot;
+    status_ = store_.LoadSnapshot(snapshot);
+    if (status_.IsOk()) {
+        for (const auto &kv : snapshot.kvs()) {
+            kvs_[kv.key()] = kv.value();
+        }
+        revision_ = snapshot.header().revision();
+        status_ = store_.Replay(revision_, [this](int64_t revision, const ::etcdserverpb::TxnRequest &ops) {
+            Apply(ops, nullptr);
+            revision_ = revision;
+        });
+    }
+    if (status_.IsError()) {
+        YRLOG_ERROR("failed to recover meta store persistence from {}: {}", address_, status_.ToString());
+        return;
+    }
+    YRLOG_INFO("recover meta store persistence from {}, kvs: {}, revision: {}", address_, kvs_.size(), revision_);
+}
+
+void LocalPersistActor::Finalize()
+{
+    if (!pending_.empty()) {
+        Flush();
+    }
+}
+
+litebus::Future<std::shared_ptr<PutResponse>> LocalPersistActor::Put(const std::string &key, const std::string &value,
+                                                                     const PutOption &)
+{
+    ::etcdserverpb::TxnRequest request;
+    auto *put = request.add_success()->mutable_request_put();
+    put->set_key(GetKeyWithPrefix(key));
+    put->set_value(value);
+    auto txnResponse = std::make_shared<::etcdserverpb::TxnResponse>();
+    return Write(request, txnResponse).Then([txnResponse](const Status &status) {
+        auto response = std::make_shared<PutResponse>();
+        response->status = status;
+        Transform(response->header, txnResponse->header());
+        return response;
+    });
+}
+
+litebus::Future<std::shared_ptr<DeleteResponse>> LocalPersistActor::Delete(const std::string &key,
+                                                                           const DeleteOption &option)
+{
+    ::etcdserverpb::TxnRequest request;
+    auto *deleteRange = request.add_success()->mutable_request_delete_range();
+    deleteRange->set_key(GetKeyWithPrefix(key));
+    if (option.prefix) {
+        deleteRange->set_range_end(StringPlusOne(deleteRange->key()));
+    }
+    auto txnResponse = std::make_shared<::etcdserverpb::TxnResponse>();
+    return Write(request, txnResponse).Then([txnResponse](const Status &status) {
+        auto response = std::make_shared<DeleteResponse>();
+        response->status = status;
+        Transform(response->header, txnResponse->header());
+        response->deleted = txnResponse->responses_size() > 0
+                                ? txnResponse->responses(0).response_delete_range().deleted()
+                                : 0;
+        return response;
+    });
+}
+
+litebus::Future<std::shared_ptr<GetResponse>> LocalPersistActor::Get(const std::string &key, const GetOption &option)
+{
+    auto response = std::make_shared<GetResponse>();
+    if (status_.IsError()) {
+        response->status = status_;
+        return response;
+    }
+    ::etcdserverpb::RangeRequest request;
+    BuildRangeRequest(request, key, option);
+    ::etcdserverpb::RangeResponse rangeResponse;
+    ApplyRange(request, rangeResponse);
+    response->header.revision = revision_;
+    response->count = rangeResponse.count();
+    response->kvs.reserve(rangeResponse.kvs_size());
+    for (auto &kv : *rangeResponse.mutable_kvs()) {
+        response->kvs.emplace_back(std::move(kv));
+    }
+    return response;
+}
+
+litebus::Future<std::shared_ptr<TxnResponse>> LocalPersistActor::CommitTxn(const ::etcdserverpb::TxnRequest &request,
+                                                                           bool asyncBackup)
+{
+    return CommitWithReq(request, asyncBackup).Then([](const std::shared_ptr<::etcdserverpb::TxnResponse> &response) {
+        auto output = std::make_shared<TxnResponse>();
+        if (!response->has_header()) {
+            output->status = Status(StatusCode::FAILED, "local meta store persistence txn fail");
+            return output;
+        }
+        Transform(output->header, response->header());
+        output->success = response->succeeded();
+        KvClientStrategy::Convert(response, output);
+        return output;
+    });
+}
+
+litebus::Future<std::shared_ptr<::etcdserverpb::TxnResponse>> LocalPersistActor::CommitWithReq(
+    const ::etcdserverpb::TxnRequest &request, bool)
+{
+    auto response = std::make_shared<::etcdserverpb::TxnResponse>();
+    if (request.compare_size() > 0) {
+        YRLOG_ERROR("local meta store persistence doesn't support txn compares");
+        return response;
+    }
+    return Write(request, response).Then([response](const Status &status) {
+        if (status.IsError()) {
+            // as the etcd persistor, return an empty response
+            YRLOG_ERROR("local meta store persistence txn fail: {}", status.ToString());
+            return std::make_shared<::etcdserverpb::TxnResponse>();
+        }
+        return response;
+    });
+}
+
+litebus::Future<std::shared_ptr<Watcher>> LocalPersistActor::Watch(const std::string &key, const WatchOption &,
+                                                                   const ObserverFunction &, const SyncerFunction &,
+                                                                   const std::shared_ptr<WatchRecord> &)
+{
+    YRLOG_WARN("local meta store persistence doesn't support watch, key: {}", key);
+    return std::shared_ptr<Watcher>(nullptr);
+}
+
+litebus::Future<std::shared_ptr<Watcher>> LocalPersistActor::GetAndWatch(const std::string &key,
+                                                                         const WatchOption &option,
+                                                                         const ObserverFunction &observer,
+                                                                         const SyncerFunction &syncer,
+                                                                         const std::shared_ptr<WatchRecord> &record)
+{
+    return Watch(key, option, observer, syncer, record);
+}
+
+litebus::Future<bool> LocalPersistActor::IsConnected()
+{
+    return status_.IsOk();
+}
+
+void LocalPersistActor::OnAddressUpdated(const std::string &)
+{
+    YRLOG_WARN("local meta store persistence doesn't support address update");
+}
+
+litebus::Future<Status> LocalPersistActor::Write(const ::etcdserverpb::TxnRequest &request,
+                                                 const std::shared_ptr<::etcdserverpb::TxnResponse> &response)
+{
+    if (status_.IsError()) {
+        return status_;
+    }
+    bool mutation = false;
+    for (const auto &op : request.success()) {
+        if (op.has_request_put() || op.has_request_delete_range()) {
+            mutation = true;
+            break;
+        }
+    }
+    if (!mutation) {
+        Apply(request, response.get());
+        response->set_succeeded(true);
+        response->mutable_header()->set_revision(revision_);
+        return Status::OK();
+    }
+
+    // the kvs and the revision move on once the record is durable, a failed sync leaves them as they were
+    auto revision = revision_ + static_cast<int64_t>(pending_.size()) + 1;
+    store_.Append(revision, request);
+    auto &write = pending_.emplace_back();
+    write.revision = revision;
+    write.request = request;
+    write.response = response;
+    write.promise = std::make_shared<litebus::Promise<Status>>();
+    if (!flushScheduled_) {
+        // the writes queued in the mailbox before the flush share its fdatasync
+        flushScheduled_ = true;
+        litebus::Async(GetAID(), &LocalPersistActor::Flush);
+    }
+    return write.promise->GetFuture();
+}
+
+void LocalPersistActor::Flush()
+{
+    flushScheduled_ = false;
+    if (pending_.empty()) {
+        return;
+    }
+    auto status = store_.Sync();
+    if (status.IsError()) {
+        YRLOG_ERROR("failed to sync {} meta store wal records: {}", pending_.size(), status.ToString());
+    }
+    auto writes = std::move(pending_);
+    pending_.clear();
+    for (auto &write : writes) {
+        if (status.IsOk()) {
+            Apply(write.request, write.response.get());
+            revision_ = write.revision;
+            write.response->set_succeeded(true);
+            write.response->mutable_header()->set_revision(revision_);
+        }
+        write.promise->SetValue(status);
+    }
+    if (status.IsOk() && store_.LogSize() >= snapshotThreshold_) {
+        TakeSnapshot();
+    }
+}
+
+void LocalPersistActor::TakeSnapshot()
+{
+    ::etcdserverpb::RangeResponse snapshot;
+    snapshot.mutable_header()->set_revision(revision_);
+    for (const auto &[key, value] : kvs_) {
+        auto *kv = snapshot.add_kvs();
+        kv->set_key(key);
+        kv->set_value(value);
+    }
+    auto logSize = store_.LogSize();
+    if (auto status = store_.Snapshot(snapshot); status.IsError()) {
+        YRLOG_ERROR("failed to snapshot meta store at revision {}: {}", revision_, status.ToString());
+        return;
+    }
+    YRLOG_INFO("snapshot {} meta store kvs at revision {}, compact {} bytes of wal", kvs_.size(), revision_, logSize);
+}
+
+void LocalPersistActor::Apply(const ::etcdserverpb::TxnRequest &request, ::etcdserverpb::TxnResponse *response)
+{
+    for (const auto &op : request.success()) {
+        if (op.has_request_put()) {
+            kvs_[op.request_put().key()] = op.request_put().value();
+            if (response != nullptr) {
+                (void)response->add_responses()->mutable_response_put();
+            }
+        } else if (op.has_request_delete_range()) {
+            const auto &deleteRange = op.request_delete_range();
+            auto [begin, end] = SeekRange(deleteRange.key(), deleteRange.range_end());
+            auto deleted = std::distance(begin, end);
+            (void)kvs_.erase(begin, end);
+            if (response != nullptr) {
+                response->add_responses()->mutable_response_delete_range()->set_deleted(deleted);
+            }
+        } else if (op.has_request_range() && response != nullptr) {
+            ApplyRange(op.request_range(), *response->add_responses()->mutable_response_range());
+        }
+    }
+}
+
+void LocalPersistActor::ApplyRange(const ::etcdserverpb::RangeRequest &request,
+                                   ::etcdserverpb::RangeResponse &response) const
+{
+    auto [begin, end] = SeekRange(request.key(), request.range_end());
+    response.mutable_header()->set_revision(revision_);
+    response.set_count(std::distance(begin, end));
+    if (request.count_only()) {
+        return;
+    }
+    // in key order, the sort options are not used by the backup
+    int64_t limit = request.limit() > 0 ? request.limit() : response.count();
+    for (auto iterator = begin; iterator != end && response.kvs_size() < limit; ++iterator) {
+        auto *kv = response.add_kvs();
+        kv->set_key(iterator->first);
+        if (!request.keys_only()) {
+            kv->set_value(iterator->second);
+        }
+    }
+    response.set_more(response.kvs_size() < response.count());
+}
+
+std::pair<std::map<std::string, std::string>::const_iterator, std::map<std::string, std::string>::const_iterator>
+LocalPersistActor::SeekRange(const std::string &key, const std::string &rangeEnd) const
+{
+    if (rangeEnd.empty()) {
+        auto iterator = kvs_.find(key);
+        return { iterator, iterator == kvs_.end() ? iterator : std::next(iterator) };
+    }
+    auto begin = kvs_.lower_bound(key);
+    if (rangeEnd == std::string(1, '\0')) {
+        return { begin, kvs_.end() };
+    }
+    if (rangeEnd <= key) {
+        return { begin, begin };
+    }
+    return { begin, kvs_.lower_bound(rangeEnd) };
+}
+}  // namespace functionsystem::meta_store
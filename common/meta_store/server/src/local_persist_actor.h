@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTION_MASTER_META_STORE_LOCAL_PERSIST_ACTOR_H
+#define FUNCTION_MASTER_META_STORE_LOCAL_PERSIST_ACTOR_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "meta_store_client/key_value/kv_client_strategy.h"
+#include "wal_store.h"
+
+namespace functionsystem::meta_store {
+// Persists the meta store backup into a local directory, it takes the place of the etcd persistor of the
+// BackupActor. The writes queued in the mailbox are group committed with one fdatasync and the wal is compacted into
+// a snapshot when it grows over the threshold. Txn compares and watches are not supported.
+class LocalPersistActor : public KvClientStrategy {
+public:
+    LocalPersistActor(const std::string &name, const std::string &dir,
+                      uint64_t snapshotThreshold = DEFAULT_META_STORE_SNAPSHOT_THRESHOLD);
+
+    ~LocalPersistActor() override = default;
+
+public:
+    litebus::Future<std::shared_ptr<PutResponse>> Put(const std::string &key, const std::string &value,
+                                                      const PutOption &option) override;
+
+    litebus::Future<std::shared_ptr<DeleteResponse>> Delete(const std::string &key,
+                                                            const DeleteOption &option) override;
+
+    litebus::Future<std::shared_ptr<GetResponse>> Get(const std::string &key, const GetOption &option) override;
+
+    litebus::Future<std::shared_ptr<TxnResponse>> CommitTxn(const ::etcdserverpb::TxnRequest &request, bool) override;
+
+    litebus::Future<std::shared_ptr<::etcdserverpb::TxnResponse>> CommitWithReq(
+        const ::etcdserverpb::TxnRequest &request, bool) override;
+
+    litebus::Future<std::shared_ptr<Watcher>> Watch(const std::string &key, const WatchOption &option,
+                                                    const ObserverFunction &observer, const SyncerFunction &syncer,
+                                                    const std::shared_ptr<WatchRecord> &reconnectRecord) override;
+
+    litebus::Future<std::shared_ptr<Watcher>> GetAndWatch(const std::string &key, const WatchOption &option,
+                                                          const ObserverFunction &observer,
+                                                          const SyncerFunction &syncer,
+                                                          const std::shared_ptr<WatchRecord> &reconnectRecord) override;
+
+    litebus::Future<bool> IsConnected() override;
+
+    void OnAddressUpdated(const std::string &address) override;
+
+protected:
+    void Init() override;
+
+    void Finalize() override;
+
+    // logs the mutations of the request, they are applied in memory and the future is set once they are synced. A
+    // request without mutations is applied at once.
+    litebus::Future<Status> Write(const ::etcdserverpb::TxnRequest &request,
+                                  const std::shared_ptr<::etcdserverpb::TxnResponse> &response);
+
+    void Flush();
+
+    void TakeSnapshot();
+
+    // a null response for the wal replay
+    void Apply(const ::etcdserverpb::TxnRequest &request, ::etcdserverpb::TxnResponse *response);
+
+    void ApplyRange(const ::etcdserverpb::RangeRequest &request, ::etcdserverpb::RangeResponse &response) const;
+
+    std::pair<std::map<std::string, std::string>::const_iterator, std::map<std::string, std::string>::const_iterator>
+    SeekRange(const std::string &key, const std::string &rangeEnd) const;
+
+protected:
+    std::map<std::string, std::string> kvs_;
+
+    int64_t revision_{ 0 };
+
+    WalStore store_;
+
+    uint64_t snapshotThreshold_;
+
+    // the recovery result, the writes fail with it
+    Status status_ = Status::OK();
+
+    // a mutation logged but not synced yet
+    struct PendingWrite {
+        int64_t revision{ 0 };
+        ::etcdserverpb::TxnRequest request;
+        std::shared_ptr<::etcdserverpb::TxnResponse> response;
+        std::shared_ptr<litebus::Promise<Status>> promise;
+    };
+
+    std::vector<PendingWrite> pending_;
+
+    bool flushScheduled_{ false };
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // FUNCTION_MASTER_META_STORE_LOCAL_PERSIST_ACTOR_H
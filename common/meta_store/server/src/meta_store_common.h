@@ -17,6 +17,7 @@
 #ifndef FUNCTION_MASTER_META_STORE_META_STORE_COMMON_H
 #define FUNCTION_MASTER_META_STORE_META_STORE_COMMON_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace functionsystem::meta_store {
@@ -25,6 +26,10 @@ constexpr uint64_t META_STORE_MEMBER_ID = 456789;
 
 constexpr int64_t META_STORE_REVISION = 32;
 constexpr uint64_t META_STORE_RAFT_TERM = 2;
+
+// the snapshot of a get and watch is sent in pages of DEFAULT_GET_AND_WATCH_PAGE_SIZE kvs at most, bounded by the
+// bytes of the kvs as well
+constexpr size_t META_STORE_GET_AND_WATCH_PAGE_BYTES = 4 * 1024 * 1024;
 }
 
 #endif // FUNCTION_MASTER_META_STORE_META_STORE_COMMON_H
@@ -16,22 +16,63 @@
 
 #include "meta_store_driver.h"
 
+#include "logs/logging.h"
 #include "meta_store_monitor/meta_store_monitor_factory.h"
 
 namespace functionsystem::meta_store {
 
-Status MetaStoreDriver::Start()
+void MetaStoreDriver::StartKvService(const litebus::AID &backupAID)
 {
-    kvServiceActor_ = std::make_shared<KvServiceActor>();
-    litebus::Spawn(kvServiceActor_);
+    if (shardPrefixes_.empty()) {
+        kvServiceActor_ = std::make_shared<KvServiceActor>(backupAID);
+        litebus::Spawn(kvServiceActor_);
+
+        kvServiceAccessorActor_ = std::make_shared<KvServiceAccessorActor>(kvServiceActor_->GetAID());
+        litebus::Spawn(kvServiceAccessorActor_);
+
+        leaseServiceActor_ = std::make_shared<LeaseServiceActor>(kvServiceActor_->GetAID(), backupAID);
+        litebus::Spawn(leaseServiceActor_);
+        litebus::Async(leaseServiceActor_->GetAID(), &LeaseServiceActor::Start);
+        kvServiceActor_->AddLeaseServiceActor(leaseServiceActor_->GetAID());
+        return;
+    }
+
+    auto shards = std::make_shared<KvShards>();
+    shards->router = std::make_shared<KvShardRouter>(shardPrefixes_);
+    watchServiceActor_ = std::make_shared<WatchServiceActor>("ShardWatchServiceActor");
+    shards->watchServiceActor = litebus::Spawn(watchServiceActor_);
+    // the shards set up before spawned, the default one is the last as kvServiceActor_
+    std::vector<std::shared_ptr<KvServiceActor>> actors;
+    for (size_t i = 0; i < shards->router->ShardCount(); ++i) {
+        auto actor = std::make_shared<KvServiceActor>(backupAID, "Shard" + std::to_string(i));
+        actor->AddWatchServiceActor(shards->watchServiceActor);
+        actor->SetShard(shards->router, i);
+        actors.emplace_back(actor);
+    }
+    kvServiceActor_ = actors.back();
+    actors.pop_back();
+    kvShardActors_ = actors;
 
-    kvServiceAccessorActor_ = std::make_shared<KvServiceAccessorActor>(kvServiceActor_->GetAID());
+    leaseServiceActor_ = std::make_shared<LeaseServiceActor>(kvServiceActor_->GetAID(), backupAID);
+    leaseServiceActor_->SetKvShards(shards);
+    for (const auto &actor : kvShardActors_) {
+        actor->AddLeaseServiceActor(leaseServiceActor_->GetAID());
+        shards->kvServiceActors.emplace_back(litebus::Spawn(actor));
+    }
+    kvServiceActor_->AddLeaseServiceActor(leaseServiceActor_->GetAID());
+    shards->kvServiceActors.emplace_back(litebus::Spawn(kvServiceActor_));
+    YRLOG_INFO("meta store kv service is sharded into {}", shards->kvServiceActors.size());
+
+    kvServiceAccessorActor_ = std::make_shared<KvServiceAccessorActor>(shards, "");
     litebus::Spawn(kvServiceAccessorActor_);
 
-    leaseServiceActor_ = std::make_shared<LeaseServiceActor>(kvServiceActor_->GetAID());
     litebus::Spawn(leaseServiceActor_);
     litebus::Async(leaseServiceActor_->GetAID(), &LeaseServiceActor::Start);
-    kvServiceActor_->AddLeaseServiceActor(leaseServiceActor_->GetAID());
+}
+
+Status MetaStoreDriver::Start()
+{
+    StartKvService(litebus::AID());
 
     maintenanceServiceActor_ = std::make_shared<MaintenanceServiceActor>();
     litebus::Spawn(maintenanceServiceActor_);
@@ -43,24 +84,21 @@ Status MetaStoreDriver::Start(const std::string &backupAddress, const MetaStoreT
                               const GrpcSslConfig &sslConfig, const MetaStoreBackupOption &backupOption)
 {
     litebus::AID backupAID;
-    if (!backupAddress.empty()) {
+    if (!backupOption.persistPath.empty()) {
+        YRLOG_INFO("persist meta store to local path {}", backupOption.persistPath);
+        persistActor_ =
+            std::make_shared<LocalPersistActor>("Persist", backupOption.persistPath, backupOption.snapshotThreshold);
+    } else if (!backupAddress.empty()) {
         persistActor_ = std::make_shared<EtcdKvClientStrategy>("Persist", backupAddress, timeoutOption, sslConfig);
+    }
+    if (persistActor_ != nullptr) {
         litebus::Spawn(persistActor_);
         backupActor_ = std::make_shared<BackupActor>("BackupActor", persistActor_->GetAID(), backupOption);
         litebus::Spawn(backupActor_);
         backupAID = backupActor_->GetAID();
     }
 
-    kvServiceActor_ = std::make_shared<KvServiceActor>(backupAID);
-    litebus::Spawn(kvServiceActor_);
-
-    kvServiceAccessorActor_ = std::make_shared<KvServiceAccessorActor>(kvServiceActor_->GetAID());
-    litebus::Spawn(kvServiceAccessorActor_);
-
-    leaseServiceActor_ = std::make_shared<LeaseServiceActor>(kvServiceActor_->GetAID(), backupAID);
-    litebus::Spawn(leaseServiceActor_);
-    litebus::Async(leaseServiceActor_->GetAID(), &LeaseServiceActor::Start);
-    kvServiceActor_->AddLeaseServiceActor(leaseServiceActor_->GetAID());
+    StartKvService(backupAID);
 
     maintenanceServiceActor_ = std::make_shared<MaintenanceServiceActor>();
     litebus::Spawn(maintenanceServiceActor_);
@@ -73,6 +111,12 @@ Status MetaStoreDriver::Stop()
     if (kvServiceActor_ != nullptr) {
         litebus::Terminate(kvServiceActor_->GetAID());
     }
+    for (const auto &actor : kvShardActors_) {
+        litebus::Terminate(actor->GetAID());
+    }
+    if (watchServiceActor_ != nullptr) {
+        litebus::Terminate(watchServiceActor_->GetAID());
+    }
     if (kvServiceAccessorActor_ != nullptr) {
         litebus::Terminate(kvServiceAccessorActor_->GetAID());
     }
@@ -96,6 +140,12 @@ void MetaStoreDriver::Await()
     if (kvServiceActor_ != nullptr) {
         litebus::Await(kvServiceActor_);
     }
+    for (const auto &actor : kvShardActors_) {
+        litebus::Await(actor);
+    }
+    if (watchServiceActor_ != nullptr) {
+        litebus::Await(watchServiceActor_);
+    }
     if (kvServiceAccessorActor_ != nullptr) {
         litebus::Await(kvServiceAccessorActor_);
     }
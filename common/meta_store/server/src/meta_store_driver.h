@@ -24,7 +24,9 @@
 #include "kv_service_accessor_actor.h"
 #include "kv_service_actor.h"
 #include "lease_service_actor.h"
+#include "local_persist_actor.h"
 #include "maintenance_service_actor.h"
+#include "watch_service_actor.h"
 #include "litebus.hpp"
 
 namespace functionsystem::meta_store {
@@ -33,6 +35,9 @@ class MetaStoreDriver : public ModuleDriver {
 public:
     MetaStoreDriver(){};
 
+    // the kv service is sharded by the key prefixes if any
+    explicit MetaStoreDriver(const std::vector<std::string> &shardPrefixes) : shardPrefixes_(shardPrefixes){};
+
     ~MetaStoreDriver() override = default;
 
     Status Start() override;
@@ -45,10 +50,16 @@ public:
     void Await() override;
 
 private:
-    std::shared_ptr<EtcdKvClientStrategy> persistActor_ = nullptr;
+    void StartKvService(const litebus::AID &backupAID);
+
+    std::vector<std::string> shardPrefixes_;
+    std::shared_ptr<KvClientStrategy> persistActor_ = nullptr;
     std::shared_ptr<BackupActor> backupActor_ = nullptr;
     std::shared_ptr<KvServiceActor> kvServiceActor_ = nullptr;
     std::shared_ptr<KvServiceAccessorActor> kvServiceAccessorActor_ = nullptr;
+    // the other shards and their shared watch service if sharded, kvServiceActor_ is the default one
+    std::vector<std::shared_ptr<KvServiceActor>> kvShardActors_;
+    std::shared_ptr<WatchServiceActor> watchServiceActor_ = nullptr;
     std::shared_ptr<LeaseServiceActor> leaseServiceActor_ = nullptr;
     std::shared_ptr<MaintenanceServiceActor> maintenanceServiceActor_ = nullptr;
 };  // class MetaStoreDriver
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTION_MASTER_META_STORE_PREFIX_TRIE_H
+#define FUNCTION_MASTER_META_STORE_PREFIX_TRIE_H
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace functionsystem::meta_store {
+// A radix tree of key prefixes, finding every prefix of a key costs O(key length + matched prefixes). It does not own
+// the values.
+template <typename T>
+class PrefixTrie {
+public:
+    PrefixTrie() = default;
+
+    ~PrefixTrie() = default;
+
+    void Insert(const std::string &prefix, T *value)
+    {
+        Node *node = &root_;
+        size_t pos = 0;
+        while (pos < prefix.size()) {
+            auto iterator = node->children.find(prefix[pos]);
+            if (iterator == node->children.end()) {
+                auto child = std::make_unique<Node>();
+                child->label = prefix.substr(pos);
+                child->value = value;
+                node->children.emplace(prefix[pos], std::move(child));
+                ++size_;
+                return;
+            }
+            Node *child = iterator->second.get();
+            size_t common = 0;
+            while (common < child->label.size() && pos + common < prefix.size()
+                   && child->label[common] == prefix[pos + common]) {
+                ++common;
+            }
+            if (common < child->label.size()) {
+                // split the edge at the first different char
+                auto split = std::make_unique<Node>();
+                split->label = child->label.substr(0, common);
+                iterator->second->label = child->label.substr(common);
+                split->children.emplace(iterator->second->label[0], std::move(iterator->second));
+                iterator->second = std::move(split);
+                child = iterator->second.get();
+            }
+            node = child;
+            pos += common;
+        }
+        if (node->value == nullptr) {
+            ++size_;
+        }
+        node->value = value;
+    }
+
+    T *Find(const std::string &prefix) const
+    {
+        const Node *node = &root_;
+        size_t pos = 0;
+        while (pos < prefix.size()) {
+            auto iterator = node->children.find(prefix[pos]);
+            if (iterator == node->children.end()
+                || prefix.compare(pos, iterator->second->label.size(), iterator->second->label) != 0) {
+                return nullptr;
+            }
+            pos += iterator->second->label.size();
+            node = iterator->second.get();
+        }
+        return node->value;
+    }
+
+    // calls func with the value of every inserted prefix of key, the shorter first
+    template <typename F>
+    void ForEachPrefixOf(const std::string &key, F &&func) const
+    {
+        const Node *node = &root_;
+        size_t pos = 0;
+        while (true) {
+            if (node->value != nullptr) {
+                func(*node->value);
+            }
+            if (pos >= key.size()) {
+                return;
+            }
+            auto iterator = node->children.find(key[pos]);
+            if (iterator == node->children.end()
+                || key.compare(pos, iterator->second->label.size(), iterator->second->label) != 0) {
+                return;
+            }
+            pos += iterator->second->label.size();
+            node = iterator->second.get();
+        }
+    }
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+private:
+    struct Node {
+        std::string label;  // the chars of the edge from the parent
+        T *value = nullptr;
+        std::map<char, std::unique_ptr<Node>> children;
+    };
+
+    Node root_;
+
+    size_t size_{ 0 };
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // FUNCTION_MASTER_META_STORE_PREFIX_TRIE_H
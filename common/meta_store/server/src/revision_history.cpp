@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "revision_history.h"
+
+#include <algorithm>
+
+namespace functionsystem::meta_store {
+RevisionHistory::RevisionHistory(size_t capacity, size_t byteCapacity)
+    : capacity_(std::max<size_t>(capacity, 1)), byteCapacity_(byteCapacity)
+{
+}
+
+void RevisionHistory::AddPut(const ::mvccpb::KeyValue &kv, const ::mvccpb::KeyValue &prevKv)
+{
+    ::mvccpb::Event event;
+    event.set_type(::mvccpb::Event_EventType::Event_EventType_PUT);
+    *event.mutable_kv() = kv;
+    if (!prevKv.key().empty()) {
+        *event.mutable_prev_kv() = prevKv;
+    }
+    Add(std::move(event));
+}
+
+void RevisionHistory::AddDelete(int64_t revision, const ::mvccpb::KeyValue &prevKv)
+{
+    ::mvccpb::Event event;
+    event.set_type(::mvccpb::Event_EventType::Event_EventType_DELETE);
+    event.mutable_kv()->set_key(prevKv.key());
+    event.mutable_kv()->set_mod_revision(revision);
+    *event.mutable_prev_kv() = prevKv;
+    Add(std::move(event));
+}
+
+void RevisionHistory::Add(::mvccpb::Event &&event)
+{
+    bytes_ += event.ByteSizeLong();
+    events_.emplace_back(std::move(event));
+    while (!events_.empty() && (events_.size() > capacity_ || bytes_ > byteCapacity_)) {
+        // a delete range shares one revision among its events, compact them all or a resume would miss some
+        int64_t revision = events_.front().kv().mod_revision();
+        while (!events_.empty() && events_.front().kv().mod_revision() == revision) {
+            bytes_ -= events_.front().ByteSizeLong();
+            events_.pop_front();
+        }
+        compactRevision_ = revision + 1;
+    }
+}
+
+void RevisionHistory::Reset(int64_t compactRevision)
+{
+    events_.clear();
+    bytes_ = 0;
+    compactRevision_ = compactRevision;
+}
+
+bool RevisionHistory::IsWatched(const std::string &key, const ::etcdserverpb::WatchCreateRequest &request)
+{
+    if (request.range_end().empty()) {
+        return key == request.key();
+    }
+    if (key < request.key()) {
+        return false;
+    }
+    // etcd: range_end "\0" means every key not less than key
+    return (request.range_end().size() == 1 && request.range_end()[0] == '\0') || key < request.range_end();
+}
+
+bool RevisionHistory::Replay(int64_t startRevision, const ::etcdserverpb::WatchCreateRequest &request,
+                             std::vector<::mvccpb::Event> &events) const
+{
+    if (startRevision < compactRevision_) {
+        return false;
+    }
+    auto iterator = std::lower_bound(events_.begin(), events_.end(), startRevision,
+                                     [](const ::mvccpb::Event &event, int64_t revision) -> bool {
+                                         return event.kv().mod_revision() < revision;
+                                     });
+    for (; iterator != events_.end(); ++iterator) {
+        if (!IsWatched(iterator->kv().key(), request)) {
+            continue;
+        }
+        auto &event = events.emplace_back(*iterator);
+        if (!request.prev_kv()) {
+            event.clear_prev_kv();
+        }
+    }
+    return true;
+}
+}  // namespace functionsystem::meta_store
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTION_MASTER_META_STORE_REVISION_HISTORY_H
+#define FUNCTION_MASTER_META_STORE_REVISION_HISTORY_H
+
+#include <deque>
+#include <vector>
+
+#include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
+
+namespace functionsystem::meta_store {
+constexpr size_t META_STORE_HISTORY_CAPACITY = 100000;
+// serialized bytes of the events, large values would make the event count alone hold gigabytes
+constexpr size_t META_STORE_HISTORY_BYTES = 64 * 1024 * 1024;
+
+// The latest events of the kv store in revision order, a watcher resumes from it after a reconnect. The oldest
+// revisions are compacted when either the event count or the event bytes are over their limit.
+class RevisionHistory {
+public:
+    explicit RevisionHistory(size_t capacity = META_STORE_HISTORY_CAPACITY,
+                             size_t byteCapacity = META_STORE_HISTORY_BYTES);
+
+    ~RevisionHistory() = default;
+
+    void AddPut(const ::mvccpb::KeyValue &kv, const ::mvccpb::KeyValue &prevKv);
+
+    void AddDelete(int64_t revision, const ::mvccpb::KeyValue &prevKv);
+
+    // drops every event, the next watchable revision is the given one
+    void Reset(int64_t compactRevision);
+
+    // the oldest revision a watcher can start from, as etcd compact_revision
+    int64_t CompactRevision() const
+    {
+        return compactRevision_;
+    }
+
+    size_t Size() const
+    {
+        return events_.size();
+    }
+
+    size_t Bytes() const
+    {
+        return bytes_;
+    }
+
+    // collects the events from startRevision on for the watched key or range, false if they have been compacted
+    bool Replay(int64_t startRevision, const ::etcdserverpb::WatchCreateRequest &request,
+                std::vector<::mvccpb::Event> &events) const;
+
+private:
+    void Add(::mvccpb::Event &&event);
+
+    static bool IsWatched(const std::string &key, const ::etcdserverpb::WatchCreateRequest &request);
+
+    // events with prev_kv, dropped for the watchers not asking for it
+    std::deque<::mvccpb::Event> events_;
+
+    size_t capacity_;
+
+    size_t byteCapacity_;
+
+    size_t bytes_{ 0 };
+
+    int64_t compactRevision_{ 1 };
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // FUNCTION_MASTER_META_STORE_REVISION_HISTORY_H
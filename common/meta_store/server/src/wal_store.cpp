@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wal_store.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "logs/logging.h"
+#include "utils/os_utils.hpp"
+
+namespace functionsystem::meta_store {
+namespace {
+// length, crc32 and revision
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(int64_t);
+constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+constexpr mode_t PERSIST_FILE_MODE = 0640;
+constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+uint32_t Crc32(uint32_t crc, const char *data, size_t size)
+{
+    static const auto table = []() {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < entries.size(); ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) != 0 ? (value >> 1) ^ CRC32_POLYNOMIAL : value >> 1;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t RecordCrc(int64_t revision, const char *payload, size_t size)
+{
+    return Crc32(Crc32(0, reinterpret_cast<const char *>(&revision), sizeof(revision)), payload, size);
+}
+
+Status ErrnoStatus(const std::string &operation, const std::string &path)
+{
+    return Status(StatusCode::FAILED, "failed to " + operation + " " + path + ": " + litebus::os::Strerror(errno));
+}
+}  // namespace
+
+WalStore::WalStore(const std::string &dir) : dir_(dir)
+{
+}
+
+WalStore::~WalStore()
+{
+    Close();
+}
+
+void WalStore::Close()
+{
+    if (logFd_ >= 0) {
+        (void)close(logFd_);
+        logFd_ = -1;
+    }
+}
+
+Status WalStore::LoadSnapshot(::etcdserverpb::RangeResponse &snapshot)
+{
+    snapshot.Clear();
+    if (litebus::os::Mkdir(dir_).IsSome()) {
+        return ErrnoStatus("create", dir_);
+    }
+    std::string data;
+    auto path = litebus::os::Join(dir_, META_STORE_SNAPSHOT_FILE);
+    if (auto status = ReadFile(path, data); status.IsError()) {
+        return status;
+    }
+    if (data.empty()) {
+        return Status::OK();
+    }
+    size_t offset = 0;
+    int64_t revision = 0;
+    std::string payload;
+    // the snapshot is renamed into place as a whole, a bad one is not a torn write
+    if (!Unframe(data, offset, revision, payload) || !snapshot.ParseFromString(payload)) {
+        return Status(StatusCode::FAILED, "corrupted meta store snapshot " + path);
+    }
+    snapshot.mutable_header()->set_revision(revision);
+    return Status::OK();
+}
+
+Status WalStore::Replay(int64_t snapshotRevision, const WalReplayFunction &replay)
+{
+    Close();
+    buffer_.clear();
+    std::string data;
+    auto logPath = litebus::os::Join(dir_, META_STORE_WAL_FILE);
+    if (auto status = ReadFile(logPath, data); status.IsError()) {
+        return status;
+    }
+    size_t offset = 0;
+    size_t records = 0;
+    std::string payload;
+    ::etcdserverpb::TxnRequest ops;
+    while (offset < data.size()) {
+        size_t begin = offset;
+        int64_t revision = 0;
+        if (!Unframe(data, offset, revision, payload) || !ops.ParseFromString(payload)) {
+            YRLOG_WARN("cut the torn meta store wal tail at {} of {} bytes", begin, data.size());
+            offset = begin;
+            break;
+        }
+        // the records before the snapshot are left by a crash between the snapshot and the truncate of the log
+        if (revision > snapshotRevision) {
+            replay(revision, ops);
+            ++records;
+        }
+    }
+
+    logFd_ = open(logPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, PERSIST_FILE_MODE);
+    if (logFd_ < 0) {
+        return ErrnoStatus("open", logPath);
+    }
+    if (offset < data.size() && ftruncate(logFd_, static_cast<off_t>(offset)) != 0) {
+        return ErrnoStatus("truncate", logPath);
+    }
+    logSize_ = offset;
+    YRLOG_INFO("replay {} meta store wal records after revision {} from {}", records, snapshotRevision, dir_);
+    return Status::OK();
+}
+
+void WalStore::Append(int64_t revision, const ::etcdserverpb::TxnRequest &ops)
+{
+    Frame(revision, ops.SerializeAsString(), buffer_);
+}
+
+Status WalStore::Sync()
+{
+    if (buffer_.empty()) {
+        return Status::OK();
+    }
+    if (logFd_ < 0) {
+        return Status(StatusCode::FAILED, "meta store wal is not open");
+    }
+    auto status = WriteAll(logFd_, buffer_);
+    if (status.IsOk() && fdatasync(logFd_) != 0) {
+        status = ErrnoStatus("sync", litebus::os::Join(dir_, META_STORE_WAL_FILE));
+    }
+    if (status.IsError()) {
+        // drops a partial write, the records of this batch are reported as failed
+        (void)ftruncate(logFd_, static_cast<off_t>(logSize_));
+    } else {
+        logSize_ += buffer_.size();
+    }
+    buffer_.clear();
+    return status;
+}
+
+Status WalStore::Snapshot(const ::etcdserverpb::RangeResponse &snapshot)
+{
+    if (logFd_ < 0) {
+        return Status(StatusCode::FAILED, "meta store wal is not open");
+    }
+    std::string data;
+    Frame(snapshot.header().revision(), snapshot.SerializeAsString(), data);
+    auto path = litebus::os::Join(dir_, META_STORE_SNAPSHOT_FILE);
+    auto tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, PERSIST_FILE_MODE);
+    if (fd < 0) {
+        return ErrnoStatus("open", tmpPath);
+    }
+    auto status = WriteAll(fd, data);
+    if (status.IsOk() && fsync(fd) != 0) {
+        status = ErrnoStatus("sync", tmpPath);
+    }
+    (void)close(fd);
+    if (status.IsError()) {
+        return status;
+    }
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        return ErrnoStatus("rename", tmpPath);
+    }
+    // the rename is durable once the directory is synced
+    int dirFd = open(dir_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        (void)fsync(dirFd);
+        (void)close(dirFd);
+    }
+    if (ftruncate(logFd_, 0) != 0) {
+        return ErrnoStatus("truncate", litebus::os::Join(dir_, META_STORE_WAL_FILE));
+    }
+    logSize_ = 0;
+    return Status::OK();
+}
+
+void WalStore::Frame(int64_t revision, const std::string &payload, std::string &out)
+{
+    auto size = static_cast<uint32_t>(payload.size());
+    uint32_t crc = RecordCrc(revision, payload.data(), payload.size());
+    out.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.append(reinterpret_cast<const char *>(&crc), sizeof(crc));
+    out.append(reinterpret_cast<const char *>(&revision), sizeof(revision));
+    out.append(payload);
+}
+
+bool WalStore::Unframe(const std::string &data, size_t &offset, int64_t &revision, std::string &payload)
+{
+    if (offset > data.size() || data.size() - offset < RECORD_HEADER_SIZE) {
+        return false;
+    }
+    uint32_t size = 0;
+    uint32_t crc = 0;
+    const char *header = data.data() + offset;
+    (void)memcpy(&size, header, sizeof(size));
+    (void)memcpy(&crc, header + sizeof(size), sizeof(crc));
+    (void)memcpy(&revision, header + sizeof(size) + sizeof(crc), sizeof(revision));
+    if (data.size() - offset - RECORD_HEADER_SIZE < size) {
+        return false;
+    }
+    const char *body = header + RECORD_HEADER_SIZE;
+    if (RecordCrc(revision, body, size) != crc) {
+        return false;
+    }
+    payload.assign(body, size);
+    offset += RECORD_HEADER_SIZE + size;
+    return true;
+}
+
+Status WalStore::ReadFile(const std::string &path, std::string &data)
+{
+    data.clear();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT ? Status::OK() : ErrnoStatus("open", path);
+    }
+    std::string buf(READ_BUFFER_SIZE, '\0');
+    while (true) {
+        ssize_t n = read(fd, buf.data(), buf.size());
+        if (n == 0) {
+            break;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            auto status = ErrnoStatus("read", path);
+            (void)close(fd);
+            return status;
+        }
+        data.append(buf.data(), static_cast<size_t>(n));
+    }
+    (void)close(fd);
+    return Status::OK();
+}
+
+Status WalStore::WriteAll(int fd, const std::string &data)
+{
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return Status(StatusCode::FAILED, "failed to write meta store persistence: " + litebus::os::Strerror(errno));
+        }
+        written += static_cast<size_t>(n);
+    }
+    return Status::OK();
+}
+}  // namespace functionsystem::meta_store
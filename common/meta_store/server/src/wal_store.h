@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTION_MASTER_META_STORE_WAL_STORE_H
+#define FUNCTION_MASTER_META_STORE_WAL_STORE_H
+
+#include <functional>
+#include <string>
+
+#include "status/status.h"
+#include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
+
+namespace functionsystem::meta_store {
+const std::string META_STORE_WAL_FILE = "wal";
+const std::string META_STORE_SNAPSHOT_FILE = "snapshot";
+
+using WalReplayFunction = std::function<void(int64_t revision, const ::etcdserverpb::TxnRequest &ops)>;
+
+// The files of the local persistence in one directory: a snapshot of all the kvs at a revision and an append-only
+// log of the mutations after it. A record is framed with its length, a crc32 and its revision, a torn tail left by a
+// crash is cut off at the recovery.
+class WalStore {
+public:
+    explicit WalStore(const std::string &dir);
+
+    ~WalStore();
+
+    WalStore(const WalStore &) = delete;
+    WalStore &operator=(const WalStore &) = delete;
+
+    // loads the latest snapshot, empty with revision 0 if there is none
+    Status LoadSnapshot(::etcdserverpb::RangeResponse &snapshot);
+
+    // replays the records after the snapshot revision and opens the log for appending
+    Status Replay(int64_t snapshotRevision, const WalReplayFunction &replay);
+
+    // buffers the mutations of one revision, they are durable after the next Sync
+    void Append(int64_t revision, const ::etcdserverpb::TxnRequest &ops);
+
+    // writes the buffered records with one fdatasync
+    Status Sync();
+
+    // replaces the snapshot and starts an empty log, the buffered records must be synced before
+    Status Snapshot(const ::etcdserverpb::RangeResponse &snapshot);
+
+    size_t LogSize() const
+    {
+        return logSize_;
+    }
+
+    size_t Buffered() const
+    {
+        return buffer_.size();
+    }
+
+private:
+    static void Frame(int64_t revision, const std::string &payload, std::string &out);
+
+    // parses the record at offset, false if it is torn or corrupted
+    static bool Unframe(const std::string &data, size_t &offset, int64_t &revision, std::string &payload);
+
+    static Status ReadFile(const std::string &path, std::string &data);
+
+    static Status WriteAll(int fd, const std::string &data);
+
+    void Close();
+
+    std::string dir_;
+
+    int logFd_{ -1 };
+
+    size_t logSize_{ 0 };
+
+    std::string buffer_;
+};
+}  // namespace functionsystem::meta_store
+
+#endif  // FUNCTION_MASTER_META_STORE_WAL_STORE_H
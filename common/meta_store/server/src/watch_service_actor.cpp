@@ -99,6 +99,12 @@ void WatchServiceActor::SendResponse(const litebus::AID &from, std::string metho
     Send(from, std::move(method), resp.SerializeAsString());
 }
 
+Status WatchServiceActor::SendPage(const litebus::AID &to, const messages::MetaStoreResponse &resp)
+{
+    Send(to, "OnGetAndWatch", resp.SerializeAsString());
+    return Status::OK();
+}
+
 litebus::AID WatchServiceActor::RemoveRangeObserverById(int64_t watchId,
                                                         std::vector<std::shared_ptr<WatchClientInfo>> &vec)
 {
@@ -186,8 +192,12 @@ std::shared_ptr<::etcdserverpb::WatchResponse> WatchServiceActor::CreateInternal
     observer->clientInfo = std::make_shared<WatchClientInfo>(from, index_);
     observer->request = request;
     if (isRangeObserver) {
-        rangeObserverCaches_.emplace(request->key(), RangeObserverCache(request->key()));
-        auto &cache = rangeObserverCaches_[request->key()];
+        auto [iterator, inserted] = rangeObserverCaches_.emplace(request->key(), RangeObserverCache(request->key()));
+        auto &cache = iterator->second;
+        // a prefix without an end, empty or all 0xff, matches no key
+        if (inserted && !cache.keyPrefixEnd.empty()) {
+            rangeObserverIndex_.Insert(cache.keyPrefix, &cache);
+        }
         cache.AddObserver(observer);
         YRLOG_DEBUG("update range cache for {}, watcher size: ({}, {})", request->key(), cache.to.size(),
                     cache.toWithPrevKv.size());
@@ -222,6 +232,47 @@ litebus::Future<Status> WatchServiceActor::Create(const litebus::AID &from, cons
         });
 }
 
+litebus::Future<Status> WatchServiceActor::Resume(const litebus::AID &from, const std::string &uuid,
+                                                  std::shared_ptr<::etcdserverpb::WatchCreateRequest> request,
+                                                  std::shared_ptr<std::vector<::mvccpb::Event>> events,
+                                                  int64_t compactRevision)
+{
+    messages::MetaStoreResponse res;
+    res.set_responseid(uuid);
+    if (events == nullptr) {
+        ::etcdserverpb::WatchResponse response;
+        response.mutable_header()->set_cluster_id(META_STORE_CLUSTER_ID);
+        response.set_watch_id(index_++);
+        response.set_created(true);
+        response.set_canceled(true);
+        response.set_compact_revision(compactRevision);
+        response.set_cancel_reason("required revision has been compacted");
+        res.set_responsemsg(response.SerializeAsString());
+        SendResponse(from, "OnWatch", res);
+        return Status::OK();
+    }
+
+    auto response = CreateInternal(from, request);
+    res.set_responsemsg(response->SerializeAsString());
+    // sent before the new events, which are queued by the async push actor after this
+    SendResponse(from, "OnWatch", res);
+    if (events->empty()) {
+        return Status::OK();
+    }
+
+    ::etcdserverpb::WatchResponse catchUp;
+    catchUp.mutable_header()->set_cluster_id(META_STORE_CLUSTER_ID);
+    catchUp.mutable_header()->set_revision(events->back().kv().mod_revision());
+    catchUp.set_watch_id(response->watch_id());
+    for (auto &event : *events) {
+        *catchUp.add_events() = std::move(event);
+    }
+    messages::MetaStoreResponse eventRes;
+    eventRes.set_responsemsg(catchUp.SerializeAsString());
+    SendResponse(from, "OnWatch", eventRes);
+    return Status::OK();
+}
+
 void WatchServiceActor::ReceiveCancel(const litebus::AID &from, std::string &&name, std::string &&msg)
 {
     messages::MetaStoreRequest req;
@@ -254,11 +305,6 @@ bool WatchServiceActor::Cancel(const litebus::AID &from, int64_t watchId, const
     return true;
 }
 
-bool WatchServiceActor::IsPrefix(const std::string &key, const RangeObserverCache &cache)
-{
-    return (key >= cache.keyPrefix && key < cache.keyPrefixEnd);
-}
-
 UnsyncedEvents::Ptr WatchServiceActor::BuildUnsyncedEventsForPut(const mvccpb::KeyValue &kv,
                                                                  const mvccpb::KeyValue &prevKv) const
 {
@@ -277,17 +323,19 @@ UnsyncedEvents::Ptr WatchServiceActor::BuildUnsyncedEventsForPut(const mvccpb::K
     return response;
 }
 
-UnsyncedEvents::Ptr WatchServiceActor::BuildUnsyncedEventsForDelete(const mvccpb::KeyValue &prevKv) const
+UnsyncedEvents::Ptr WatchServiceActor::BuildUnsyncedEventsForDelete(const mvccpb::KeyValue &prevKv,
+                                                                    int64_t revision) const
 {
     auto response = std::make_shared<UnsyncedEvents>();
     auto event = std::make_shared<mvccpb::Event>();
     event->set_type(::mvccpb::Event_EventType::Event_EventType_DELETE);
     event->mutable_kv()->set_key(prevKv.key());
-    event->mutable_kv()->set_mod_revision(prevKv.mod_revision() + 1);
+    event->mutable_kv()->set_mod_revision(revision);
 
     auto eventWithPrevKv = std::make_shared<mvccpb::Event>();
     eventWithPrevKv->set_type(::mvccpb::Event_EventType::Event_EventType_DELETE);
     eventWithPrevKv->mutable_kv()->set_key(prevKv.key());
+    eventWithPrevKv->mutable_kv()->set_mod_revision(revision);
     SetPrevKv(prevKv, eventWithPrevKv);
 
     response->event = event;
@@ -298,13 +346,11 @@ UnsyncedEvents::Ptr WatchServiceActor::BuildUnsyncedEventsForDelete(const mvccpb
 void WatchServiceActor::CheckIfValidRangeCacheAndUpdateResponse(const mvccpb::KeyValue &kv,
                                                                 UnsyncedEvents::Ptr response)
 {
-    for (const auto &cache : rangeObserverCaches_) {
-        if (IsPrefix(kv.key(), cache.second)) {
-            YRLOG_DEBUG("Hit range cache for prefix {}, watcher size: ({}, {})", cache.second.keyPrefix,
-                        cache.second.to.size(), cache.second.toWithPrevKv.size());
-            cache.second.UpdateResponseWithCache(response);
-        }
-    }
+    rangeObserverIndex_.ForEachPrefixOf(kv.key(), [&response](const RangeObserverCache &cache) {
+        YRLOG_DEBUG("Hit range cache for prefix {}, watcher size: ({}, {})", cache.keyPrefix, cache.to.size(),
+                    cache.toWithPrevKv.size());
+        cache.UpdateResponseWithCache(response);
+    });
 }
 
 void WatchServiceActor::AddObserverToResponse(UnsyncedEvents::Ptr response, Observer::Ptr observer)
@@ -330,19 +376,19 @@ void WatchServiceActor::OnPut(const mvccpb::KeyValue &kv, const mvccpb::KeyValue
     (void)AddToUnsyncedEvents(response);
 }
 
-void WatchServiceActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs)
+void WatchServiceActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs, int64_t revision)
 {
     if (kvs == nullptr) {
         return;
     }
     for (const auto &preKv : *kvs) {
-        OnDelete(preKv);
+        OnDelete(preKv, revision);
     }
 }
 
-void WatchServiceActor::OnDelete(const mvccpb::KeyValue &prevKv)
+void WatchServiceActor::OnDelete(const mvccpb::KeyValue &prevKv, int64_t revision)
 {
-    auto response = BuildUnsyncedEventsForDelete(prevKv);
+    auto response = BuildUnsyncedEventsForDelete(prevKv, revision);
     CheckIfValidRangeCacheAndUpdateResponse(prevKv, response);
 
     if (auto iter = strictObserversByKey_.find(prevKv.key()); iter != strictObserversByKey_.end()) {
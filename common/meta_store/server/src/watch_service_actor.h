@@ -22,6 +22,7 @@
 
 #include "proto/pb/message_pb.h"
 #include "etcd/api/etcdserverpb/rpc.grpc.pb.h"
+#include "prefix_trie.h"
 #include "watch_service_async_push_actor.h"
 
 namespace functionsystem::meta_store {
@@ -34,21 +35,31 @@ public:
     virtual litebus::Future<Status> Create(const litebus::AID &from, const std::string &uuid,
                           std::shared_ptr<::etcdserverpb::WatchCreateRequest> request);
 
+    // creates the watcher and sends the events it missed since its start revision right after the created response,
+    // a null events means they have been compacted and the watcher is canceled as etcd does
+    virtual litebus::Future<Status> Resume(const litebus::AID &from, const std::string &uuid,
+                                           std::shared_ptr<::etcdserverpb::WatchCreateRequest> request,
+                                           std::shared_ptr<std::vector<::mvccpb::Event>> events,
+                                           int64_t compactRevision);
+
     void ReceiveCancel(const litebus::AID &from, std::string &&name, std::string &&msg);
 
     virtual bool Cancel(const litebus::AID &from, int64_t watchId, const std::string &msg);
 
     virtual void OnPut(const ::mvccpb::KeyValue &kv, const ::mvccpb::KeyValue &prevKv);
 
-    virtual void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs);
+    virtual void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs, int64_t revision);
 
-    virtual void OnDelete(const ::mvccpb::KeyValue &prevKv);
+    virtual void OnDelete(const ::mvccpb::KeyValue &prevKv, int64_t revision);
 
     virtual litebus::Future<std::shared_ptr<::etcdserverpb::WatchResponse>> CreateWatch(
         const litebus::AID &from, std::shared_ptr<::etcdserverpb::WatchCreateRequest> request);
 
     void SendResponse(const litebus::AID &from, std::string method, const messages::MetaStoreResponse &resp);
 
+    // sends a page of the snapshot of a get and watch, the next one is built once it is sent
+    Status SendPage(const litebus::AID &to, const messages::MetaStoreResponse &resp);
+
 protected:
     using WatchClientInfo = std::pair<litebus::AID, int64_t>;
     struct Observer {
@@ -85,8 +96,11 @@ protected:
 
     std::unordered_map<std::string, RangeObserverCache> rangeObserverCaches_;
 
+    // the range observer caches by prefix, an event visits only the caches of its key's prefixes
+    PrefixTrie<RangeObserverCache> rangeObserverIndex_;
+
     UnsyncedEvents::Ptr BuildUnsyncedEventsForPut(const mvccpb::KeyValue &kv, const mvccpb::KeyValue &prevKv) const;
-    UnsyncedEvents::Ptr BuildUnsyncedEventsForDelete(const mvccpb::KeyValue &prevKv) const;
+    UnsyncedEvents::Ptr BuildUnsyncedEventsForDelete(const mvccpb::KeyValue &prevKv, int64_t revision) const;
 
     void CheckIfValidRangeCacheAndUpdateResponse(const mvccpb::KeyValue &kv, UnsyncedEvents::Ptr response);
 
@@ -116,8 +130,6 @@ protected:
 protected:
     litebus::Future<bool> AddToUnsyncedEvents(UnsyncedEvents::Ptr response);
 
-    static bool IsPrefix(const std::string &key, const RangeObserverCache &cache);
-
     static void SetPrevKv(const mvccpb::KeyValue &prevKv, std::shared_ptr<mvccpb::Event> event);
 };
 }  // namespace functionsystem::meta_store
@@ -36,6 +36,9 @@ const uint32_t META_HEALTH_CHECK_INTERVAL_MS = 10000;
 const uint32_t MIN_META_HEALTH_CHECK_TIMEOUTS = 100;
 const uint32_t MAX_META_HEALTH_CHECK_TIMEOUTS = 600000;
 const uint32_t META_HEALTH_CHECK_TIMEOUTS = 20000;
+const uint32_t MAX_META_STORE_WRITE_COALESCE_WINDOW_MS = 1000;
+const uint32_t MIN_META_STORE_WRITE_COALESCE_BATCH_SIZE = 1;
+const uint32_t MAX_META_STORE_WRITE_COALESCE_BATCH_SIZE = 10000;
 const std::string DEFAULT_ETCD_TLS_PATH = "/home/sn/resource/etcd";
 
 using namespace litebus::flag;
@@ -65,6 +68,16 @@ CommonFlags::CommonFlags()
     AddFlag(&CommonFlags::etcdTablePrefix_, "etcd_table_prefix", "etcd table prefix", "");
     AddFlag(&CommonFlags::metaStoreExcludedKeys_, "meta_store_excluded_keys", "keys not stored in meta store",
             "/yr/podpools,/yr/functions,/yr/iam");
+    AddFlag(&CommonFlags::metaStoreReadCachePrefixes_, "meta_store_read_cache_prefixes",
+            "key prefixes whose reads are served from the watches of the meta store client", "");
+    AddFlag(&CommonFlags::metaStoreWriteCoalesceWindowMs_, "meta_store_write_coalesce_window_ms",
+            "the window the puts and deletes are committed in one txn, 0 to disable, ms", 0,
+            NumCheck(uint32_t(0), MAX_META_STORE_WRITE_COALESCE_WINDOW_MS));
+    AddFlag(&CommonFlags::metaStoreWriteCoalesceMaxBatchSize_, "meta_store_write_coalesce_max_batch_size",
+            "max number of writes committed in one txn", DEFAULT_META_STORE_WRITE_COALESCE_MAX_BATCH_SIZE,
+            NumCheck(MIN_META_STORE_WRITE_COALESCE_BATCH_SIZE, MAX_META_STORE_WRITE_COALESCE_BATCH_SIZE));
+    AddFlag(&CommonFlags::metadataBinaryEncoding_, "metadata_binary_encoding",
+            "write instance, route and group metadata as binary protobuf instead of json", false);
     AddFlag(&CommonFlags::maxPriority_, "max_priority", "schedule max priority", 0,
             NumCheck(uint16_t(0), MAX_PRIORITY_VALUE));
     AddFlag(&CommonFlags::enablePreemption_, "enable_preemption",
@@ -78,6 +91,10 @@ CommonFlags::CommonFlags()
             "enable the relaxed scheduling policy. When the relaxed number of available nodes or pods is selected, the "
             "scheduling progress exits without traversing all nodes or pods.(default -1)",
             -1);
+    AddFlag(&CommonFlags::scheduleParallelism_, "schedule_parallelism",
+            "the number of threads filtering and scoring the nodes or pods of a request, only valid for the concurrency "
+            "safe schedule plugins. 0 or 1 means serial.(default 0)",
+            0);
     InitMetaHealthyCheckFlag();
     InitMetricsFlag();
     InitETCDAuthFlag();
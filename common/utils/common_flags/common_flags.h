@@ -179,6 +179,33 @@ public:
         return set;
     }
 
+    const std::unordered_set<std::string> GetMetaStoreReadCachePrefixes() const
+    {
+        std::unordered_set<std::string> set;
+        auto splits = litebus::strings::Split(metaStoreReadCachePrefixes_, ",");
+        for (const auto &split : splits) {
+            if (!split.empty()) {
+                set.insert(split);
+            }
+        }
+        return set;
+    }
+
+    uint32_t GetMetaStoreWriteCoalesceWindowMs() const
+    {
+        return metaStoreWriteCoalesceWindowMs_;
+    }
+
+    uint32_t GetMetaStoreWriteCoalesceMaxBatchSize() const
+    {
+        return metaStoreWriteCoalesceMaxBatchSize_;
+    }
+
+    bool GetMetadataBinaryEncoding() const
+    {
+        return metadataBinaryEncoding_;
+    }
+
     uint32_t GetMaxTolerateMetaStoreFailedTimes() const
     {
         return maxTolerateMetaStoreFailedTimes_;
@@ -219,6 +246,11 @@ public:
         return scheduleRelaxed_;
     }
 
+    int32_t GetScheduleParallelism() const
+    {
+        return scheduleParallelism_;
+    }
+
     bool GetEnablePreemption() const
     {
         return enablePreemption_;
@@ -260,6 +292,10 @@ protected:
     uint32_t metaStoreCheckHealthIntervalMs_;
     uint32_t metaStoreTimeoutMs_;
     std::string metaStoreExcludedKeys_;
+    std::string metaStoreReadCachePrefixes_;
+    uint32_t metaStoreWriteCoalesceWindowMs_;
+    uint32_t metaStoreWriteCoalesceMaxBatchSize_;
+    bool metadataBinaryEncoding_{ false };
 
     uint16_t maxPriority_;
 
@@ -269,6 +305,7 @@ protected:
 
     std::string systemAuthMode_;
     int32_t scheduleRelaxed_;
+    int32_t scheduleParallelism_;
     bool enablePreemption_;
 };
 
@@ -65,6 +65,8 @@ const int32_t LITEBUS_THREAD_NUM = 20;
 
 const uint32_t DEFAULT_SYSTEM_TIMEOUT = 180000;
 const uint64_t DEFAULT_PULL_RESOURCE_INTERVAL = 1000;
+// writes of the meta storage accessor committed in one txn
+const uint32_t DEFAULT_META_STORE_WRITE_COALESCE_MAX_BATCH_SIZE = 128;
 
 enum class EXECUTOR_TYPE { RUNTIME = 0, UNKNOWN = -1 };
 
@@ -16,6 +16,8 @@
 #ifndef METADATA_H
 #define METADATA_H
 
+#include <atomic>
+
 #include <google/protobuf/util/json_util.h>
 
 #include "metadata_type.h"
@@ -24,21 +26,88 @@
 namespace functionsystem {
 using namespace functionsystem::resource_view;
 
+// the encoding of the instance, route and group values written to the meta store, both are read
+enum class MetadataEncoding : int { JSON = 0, BINARY = 1 };
+
+// a binary value is the magic, the version byte and the serialized message, a json value never starts with '\0'
+const std::string METADATA_BINARY_MAGIC("\0YRPB", 5);
+const char METADATA_BINARY_VERSION = 1;
+const size_t METADATA_BINARY_HEADER_SIZE = 6;
+
+inline std::atomic<MetadataEncoding> &MetadataWriteEncoding()
+{
+    static std::atomic<MetadataEncoding> encoding{ MetadataEncoding::JSON };
+    return encoding;
+}
+
+inline void SetMetadataWriteEncoding(MetadataEncoding encoding)
+{
+    MetadataWriteEncoding().store(encoding);
+}
+
+inline bool IsBinaryMetadata(const std::string &value)
+{
+    return value.size() >= METADATA_BINARY_HEADER_SIZE
+           && value.compare(0, METADATA_BINARY_MAGIC.size(), METADATA_BINARY_MAGIC) == 0;
+}
+
+/**
+ * parse a metadata value of either encoding
+ * @param message: protobuf struct to fill
+ * @param value: binary value with the header, or json string
+ * @param jsonOpt: options for the json string
+ * @return true if parse success, false if parse failed
+ */
+inline bool ParseMetadata(google::protobuf::Message &message, const std::string &value,
+                          const google::protobuf::util::JsonParseOptions &jsonOpt)
+{
+    if (IsBinaryMetadata(value)) {
+        if (value[METADATA_BINARY_MAGIC.size()] != METADATA_BINARY_VERSION) {
+            YRLOG_WARN("failed parse {}, unknown binary version {}", message.GetTypeName(),
+                       static_cast<int>(value[METADATA_BINARY_MAGIC.size()]));
+            return false;
+        }
+        if (!message.ParseFromArray(value.data() + METADATA_BINARY_HEADER_SIZE,
+                                    static_cast<int>(value.size() - METADATA_BINARY_HEADER_SIZE))) {
+            YRLOG_WARN("failed parse binary {}", message.GetTypeName());
+            return false;
+        }
+        return true;
+    }
+    auto status = google::protobuf::util::JsonStringToMessage(value, &message, jsonOpt);
+    if (!status.ok()) {
+        YRLOG_WARN("failed trans json to {}, {}", message.GetTypeName(), status.ToString());
+    }
+    return status.ok();
+}
+
+/**
+ * serialize a metadata value in the write encoding
+ * @param value: binary value with the header, or json string
+ * @param message: protobuf struct
+ * @return true if serialize success, false if serialize failed
+ */
+inline bool SerializeMetadata(std::string &value, const google::protobuf::Message &message)
+{
+    if (MetadataWriteEncoding().load() == MetadataEncoding::BINARY) {
+        value.assign(METADATA_BINARY_MAGIC);
+        value.push_back(METADATA_BINARY_VERSION);
+        return message.AppendToString(&value);
+    }
+    return google::protobuf::util::MessageToJsonString(message, &value).ok();
+}
+
 /**
- * trans to protobuf struct of InstanceInfo from json string
+ * trans to protobuf struct of InstanceInfo from json string or binary value
  * @param instanceInfo: protobuf struct of InstanceInfo
- * @param jsonStr: json string
+ * @param jsonStr: json string or binary value
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToInstanceInfoFromJson(InstanceInfo &instanceInfo, const std::string &jsonStr)
 {
     auto jsonOpt = google::protobuf::util::JsonParseOptions();
     jsonOpt.ignore_unknown_fields = true;
-    auto status = google::protobuf::util::JsonStringToMessage(jsonStr, &instanceInfo, jsonOpt);
-    if (!status.ok()) {
-        YRLOG_WARN("failed trans json to instance info, {}", status.ToString());
-    }
-    return status.ok();
+    return ParseMetadata(instanceInfo, jsonStr, jsonOpt);
 }
 
 [[maybe_unused]] inline bool TransToDebugInstanceInfoFromJson(messages::DebugInstanceInfo &debugInstInfo,
@@ -54,70 +123,62 @@ using namespace functionsystem::resource_view;
 }
 
 /**
- * trans to protobuf struct of GroupInfo from json string
+ * trans to protobuf struct of GroupInfo from json string or binary value
  * @param groupInfo: protobuf struct of GroupInfo
- * @param jsonStr: json string
+ * @param jsonStr: json string or binary value
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToGroupInfoFromJson(messages::GroupInfo &groupInfo, const std::string &jsonStr)
 {
     auto jsonOpt = google::protobuf::util::JsonParseOptions();
     jsonOpt.ignore_unknown_fields = true;
-    auto status = google::protobuf::util::JsonStringToMessage(jsonStr, &groupInfo, jsonOpt);
-    if (!status.ok()) {
-        YRLOG_WARN("failed trans json to group info, {}", status.ToString());
-    }
-    return status.ok();
+    return ParseMetadata(groupInfo, jsonStr, jsonOpt);
 }
 
 /**
- * trans to json string from protobuf struct of InstanceInfo
- * @param jsonStr: json string
+ * trans to json string, or binary value if the write encoding is binary, from protobuf struct of InstanceInfo
+ * @param jsonStr: json string or binary value
  * @param instanceInfo: protobuf struct of InstanceInfo
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToJsonFromInstanceInfo(std::string &jsonStr, const InstanceInfo &instanceInfo)
 {
-    return google::protobuf::util::MessageToJsonString(instanceInfo, &jsonStr).ok();
+    return SerializeMetadata(jsonStr, instanceInfo);
 }
 
 /**
- * trans to json string from protobuf struct of GroupInfo
- * @param jsonStr: json string
+ * trans to json string, or binary value if the write encoding is binary, from protobuf struct of GroupInfo
+ * @param jsonStr: json string or binary value
  * @param groupInfo: protobuf struct of GroupInfo
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToJsonFromGroupInfo(std::string &jsonStr, const messages::GroupInfo &groupInfo)
 {
-    return google::protobuf::util::MessageToJsonString(groupInfo, &jsonStr).ok();
+    return SerializeMetadata(jsonStr, groupInfo);
 }
 
 /**
- * trans to protobuf struct of RouteInfo from json string
+ * trans to protobuf struct of RouteInfo from json string or binary value
  * @param routeInfo: protobuf struct of RouteInfo
- * @param jsonStr: json string
+ * @param jsonStr: json string or binary value
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToRouteInfoFromJson(resources::RouteInfo &routeInfo, const std::string &jsonStr)
 {
     auto jsonOpt = google::protobuf::util::JsonParseOptions();
     jsonOpt.ignore_unknown_fields = true;
-    auto status = google::protobuf::util::JsonStringToMessage(jsonStr, &routeInfo, jsonOpt);
-    if (!status.ok()) {
-        YRLOG_WARN("failed trans json to route info, {}", status.ToString());
-    }
-    return status.ok();
+    return ParseMetadata(routeInfo, jsonStr, jsonOpt);
 }
 
 /**
- * trans to json string from protobuf struct of RouteInfo
- * @param jsonStr: json string
+ * trans to json string, or binary value if the write encoding is binary, from protobuf struct of RouteInfo
+ * @param jsonStr: json string or binary value
  * @param routeInfo: protobuf struct of RouteInfo
  * @return true if trans success, false if trans failed
  */
 [[maybe_unused]] static bool TransToJsonFromRouteInfo(std::string &jsonStr, const resources::RouteInfo &routeInfo)
 {
-    return google::protobuf::util::MessageToJsonString(routeInfo, &jsonStr).ok();
+    return SerializeMetadata(jsonStr, routeInfo);
 }
 
 [[maybe_unused]] static void TransToInstanceInfoFromRouteInfo(const resources::RouteInfo &routeInfo,
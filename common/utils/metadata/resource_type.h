@@ -20,6 +20,7 @@
 #include <google/protobuf/repeated_field.h>
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 #include "proto/pb/posix_pb.h"
@@ -89,10 +90,15 @@ enum class UnitStatus {
     TO_BE_DELETED = 3,
 };
 
+class BucketShapeIndex;
+
 struct ResourceViewInfo {
-    ResourceUnit resourceUnit;
+    // an immutable snapshot of the view, shared with the resource view and the other consumers of the same version
+    std::shared_ptr<const ResourceUnit> resourceUnit = std::make_shared<ResourceUnit>();
     std::unordered_map<std::string, std::string> alreadyScheduled;
     std::unordered_map<std::string, ::google::protobuf::Map<std::string, ValueCounter>> allLocalLabels;
+    // the numeric shapes of the bucket indexes of resourceUnit, nullptr if not indexed
+    std::shared_ptr<const BucketShapeIndex> bucketShapeIndex;
 };
 
 struct HeteroDeviceCompare {
@@ -16,6 +16,7 @@
 
 #include "metrics_adapter.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <unordered_map>
@@ -23,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "litebus.hpp"
 #include "logs/logging.h"
 #include "resource_type.h"
 #include "status/status.h"
@@ -796,6 +798,203 @@ std::pair<MetricsApi::MetricLabels, double> MetricsAdapter::BuildPodResourceData
     return std::pair{ labels, 0 };
 }
 
+void MetricsAdapter::RegisterLitebusWorkerMetrics()
+{
+    if (enabledInstruments_.find(YRInstrument::YR_LITEBUS_WORKER) == enabledInstruments_.end()) {
+        YRLOG_DEBUG("litebus worker metrics is not enabled");
+        return;
+    }
+    MeterTitle depthTitle{ YR_LITEBUS_WORKER_QUEUE_DEPTH, "Ready actors queued on each litebus worker", "count" };
+    MetricsApi::CallbackPtr depthCb =
+        std::bind(&MetricsAdapter::CollectLitebusWorkerQueueDepth, this, std::placeholders::_1);
+    InitObservableGauge(depthTitle, LITEBUS_WORKER_COLLECT_INTERVAL, depthCb,
+                        observability::sdk::metrics::InstrumentValueType::DOUBLE);
+
+    MeterTitle stealsTitle{ YR_LITEBUS_WORKER_STEALS, "Ready actors stolen by each litebus worker", "count" };
+    MetricsApi::CallbackPtr stealsCb =
+        std::bind(&MetricsAdapter::CollectLitebusWorkerSteals, this, std::placeholders::_1);
+    InitObservableCounter(stealsTitle, LITEBUS_WORKER_COLLECT_INTERVAL, stealsCb,
+                          observability::sdk::metrics::InstrumentValueType::UINT64);
+}
+
+void MetricsAdapter::CollectLitebusWorkerQueueDepth(MetricsApi::ObserveResult obRes)
+{
+    std::vector<std::pair<MetricsApi::MetricLabels, double>> vec;
+    for (const auto &stats : litebus::GetActorWorkerStats()) {
+        MetricsApi::MetricLabels labels{ { "worker", std::to_string(stats.worker) } };
+        vec.emplace_back(labels, static_cast<double>(stats.queueDepth));
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<double>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<double>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::CollectLitebusWorkerSteals(MetricsApi::ObserveResult obRes)
+{
+    std::vector<std::pair<MetricsApi::MetricLabels, uint64_t>> vec;
+    for (const auto &stats : litebus::GetActorWorkerStats()) {
+        MetricsApi::MetricLabels labels{ { "worker", std::to_string(stats.worker) } };
+        vec.emplace_back(labels, stats.steals);
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::RegisterLitebusActorMetrics()
+{
+    if (enabledInstruments_.find(YRInstrument::YR_LITEBUS_ACTOR) == enabledInstruments_.end()) {
+        YRLOG_DEBUG("litebus actor metrics is not enabled");
+        return;
+    }
+    MeterTitle msgsTitle{ YR_LITEBUS_ACTOR_MSGS, "Messages handled by the busiest litebus actors", "count" };
+    MetricsApi::CallbackPtr msgsCb = std::bind(&MetricsAdapter::CollectLitebusActorMsgs, this, std::placeholders::_1);
+    InitObservableCounter(msgsTitle, LITEBUS_ACTOR_COLLECT_INTERVAL, msgsCb,
+                          observability::sdk::metrics::InstrumentValueType::UINT64);
+
+    MeterTitle runTimeTitle{ YR_LITEBUS_ACTOR_RUN_TIME, "Time the busiest litebus actors spent in handling messages",
+                             "us" };
+    MetricsApi::CallbackPtr runTimeCb =
+        std::bind(&MetricsAdapter::CollectLitebusActorRunTime, this, std::placeholders::_1);
+    InitObservableCounter(runTimeTitle, LITEBUS_ACTOR_COLLECT_INTERVAL, runTimeCb,
+                          observability::sdk::metrics::InstrumentValueType::UINT64);
+}
+
+static std::vector<litebus::ActorRunStats> GetBusiestActors()
+{
+    auto allStats = litebus::GetActorRunStats();
+    size_t topN = std::min(allStats.size(), LITEBUS_ACTOR_METRICS_TOP_N);
+    std::partial_sort(allStats.begin(), allStats.begin() + static_cast<std::ptrdiff_t>(topN), allStats.end(),
+                      [](const litebus::ActorRunStats &l, const litebus::ActorRunStats &r) {
+                          return l.runTimeUs > r.runTimeUs;
+                      });
+    allStats.resize(topN);
+    return allStats;
+}
+
+void MetricsAdapter::CollectLitebusActorMsgs(MetricsApi::ObserveResult obRes)
+{
+    std::vector<std::pair<MetricsApi::MetricLabels, uint64_t>> vec;
+    for (const auto &stats : GetBusiestActors()) {
+        MetricsApi::MetricLabels labels{ { "actor", stats.name } };
+        vec.emplace_back(labels, stats.msgs);
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::CollectLitebusActorRunTime(MetricsApi::ObserveResult obRes)
+{
+    std::vector<std::pair<MetricsApi::MetricLabels, uint64_t>> vec;
+    for (const auto &stats : GetBusiestActors()) {
+        MetricsApi::MetricLabels labels{ { "actor", stats.name } };
+        vec.emplace_back(labels, stats.runTimeUs);
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::RegisterMetaStoreCacheMetrics()
+{
+    if (enabledInstruments_.find(YRInstrument::YR_META_STORE_CACHE) == enabledInstruments_.end()) {
+        YRLOG_DEBUG("meta store cache metrics is not enabled");
+        return;
+    }
+    MeterTitle hitsTitle{ YR_META_STORE_CACHE_HITS, "Gets served by the meta store client read cache", "count" };
+    MetricsApi::CallbackPtr hitsCb = std::bind(&MetricsAdapter::CollectMetaStoreCacheHits, this, std::placeholders::_1);
+    InitObservableCounter(hitsTitle, META_STORE_CACHE_COLLECT_INTERVAL, hitsCb,
+                          observability::sdk::metrics::InstrumentValueType::UINT64);
+
+    MeterTitle missesTitle{ YR_META_STORE_CACHE_MISSES, "Gets under a cached prefix sent to the meta store", "count" };
+    MetricsApi::CallbackPtr missesCb =
+        std::bind(&MetricsAdapter::CollectMetaStoreCacheMisses, this, std::placeholders::_1);
+    InitObservableCounter(missesTitle, META_STORE_CACHE_COLLECT_INTERVAL, missesCb,
+                          observability::sdk::metrics::InstrumentValueType::UINT64);
+
+    MeterTitle lagTitle{ YR_META_STORE_CACHE_REVISION_LAG,
+                         "Revisions the cached prefix is behind the latest one of the meta store", "count" };
+    MetricsApi::CallbackPtr lagCb =
+        std::bind(&MetricsAdapter::CollectMetaStoreCacheRevisionLag, this, std::placeholders::_1);
+    InitObservableGauge(lagTitle, META_STORE_CACHE_COLLECT_INTERVAL, lagCb,
+                        observability::sdk::metrics::InstrumentValueType::DOUBLE);
+}
+
+void MetricsAdapter::AddMetaStoreCacheCounters(const std::string &prefix,
+                                               const std::shared_ptr<MetaStoreCacheCounters> &counters)
+{
+    std::lock_guard<std::mutex> lock(metaStoreCacheMutex_);
+    metaStoreCacheCounters_.emplace(prefix, counters);
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<MetaStoreCacheCounters>>>
+MetricsAdapter::GetMetaStoreCacheCounters()
+{
+    std::vector<std::pair<std::string, std::shared_ptr<MetaStoreCacheCounters>>> live;
+    std::lock_guard<std::mutex> lock(metaStoreCacheMutex_);
+    for (auto iter = metaStoreCacheCounters_.begin(); iter != metaStoreCacheCounters_.end();) {
+        if (auto counters = iter->second.lock(); counters != nullptr) {
+            live.emplace_back(iter->first, counters);
+            ++iter;
+        } else {
+            iter = metaStoreCacheCounters_.erase(iter);
+        }
+    }
+    return live;
+}
+
+void MetricsAdapter::CollectMetaStoreCacheHits(MetricsApi::ObserveResult obRes)
+{
+    // the caches of the clients in a process may share a prefix
+    std::map<std::string, uint64_t> hits;
+    for (const auto &[prefix, counters] : GetMetaStoreCacheCounters()) {
+        hits[prefix] += counters->hits.load(std::memory_order_relaxed);
+    }
+    std::vector<std::pair<MetricsApi::MetricLabels, uint64_t>> vec;
+    for (const auto &[prefix, value] : hits) {
+        MetricsApi::MetricLabels labels{ { "prefix", prefix } };
+        vec.emplace_back(labels, value);
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::CollectMetaStoreCacheMisses(MetricsApi::ObserveResult obRes)
+{
+    std::map<std::string, uint64_t> misses;
+    for (const auto &[prefix, counters] : GetMetaStoreCacheCounters()) {
+        misses[prefix] += counters->misses.load(std::memory_order_relaxed);
+    }
+    std::vector<std::pair<MetricsApi::MetricLabels, uint64_t>> vec;
+    for (const auto &[prefix, value] : misses) {
+        MetricsApi::MetricLabels labels{ { "prefix", prefix } };
+        vec.emplace_back(labels, value);
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<uint64_t>>>(obRes)->Observe(vec);
+    }
+}
+
+void MetricsAdapter::CollectMetaStoreCacheRevisionLag(MetricsApi::ObserveResult obRes)
+{
+    // the most stale of the caches sharing a prefix
+    std::map<std::string, int64_t> lags;
+    for (const auto &[prefix, counters] : GetMetaStoreCacheCounters()) {
+        auto &lag = lags[prefix];
+        lag = std::max(lag, counters->revisionLag.load(std::memory_order_relaxed));
+    }
+    std::vector<std::pair<MetricsApi::MetricLabels, double>> vec;
+    for (const auto &[prefix, value] : lags) {
+        MetricsApi::MetricLabels labels{ { "prefix", prefix } };
+        vec.emplace_back(labels, static_cast<double>(value));
+    }
+    if (std::holds_alternative<std::shared_ptr<MetricsApi::ObserveResultT<double>>>(obRes)) {
+        std::get<std::shared_ptr<MetricsApi::ObserveResultT<double>>>(obRes)->Observe(vec);
+    }
+}
+
 void MetricsAdapter::ReportBillingInvokeLatency(const std::string &requestID, uint32_t errCode,
                                                 long long startTimeMillis, long long endTimeMillis)
 {
@@ -17,6 +17,8 @@
 #ifndef FUNCTIONSYSTEM_METRICSADAPTER_H
 #define FUNCTIONSYSTEM_METRICSADAPTER_H
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -51,6 +53,14 @@ struct MeterData {
     LabelType labels;
 };
 
+// counters of a prefix in the meta store client read cache, updated by the cache and collected by the adapter
+struct MetaStoreCacheCounters {
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> misses{ 0 };
+    // revisions the cached prefix is behind the latest one the store returned
+    std::atomic<int64_t> revisionLag{ 0 };
+};
+
 class MetricsAdapter : public Singleton<MetricsAdapter> {
 public:
     MetricsAdapter() = default;
@@ -88,6 +98,19 @@ public:
     void RegisterPodResource();
     void CollectPodResource(MetricsApi::ObserveResult obRes);
 
+    void RegisterLitebusWorkerMetrics();
+    void CollectLitebusWorkerQueueDepth(MetricsApi::ObserveResult obRes);
+    void CollectLitebusWorkerSteals(MetricsApi::ObserveResult obRes);
+    void RegisterLitebusActorMetrics();
+    void CollectLitebusActorMsgs(MetricsApi::ObserveResult obRes);
+    void CollectLitebusActorRunTime(MetricsApi::ObserveResult obRes);
+    void RegisterMetaStoreCacheMetrics();
+    // kept weakly, the counters of a dropped cache are no longer reported
+    void AddMetaStoreCacheCounters(const std::string &prefix, const std::shared_ptr<MetaStoreCacheCounters> &counters);
+    void CollectMetaStoreCacheHits(MetricsApi::ObserveResult obRes);
+    void CollectMetaStoreCacheMisses(MetricsApi::ObserveResult obRes);
+    void CollectMetaStoreCacheRevisionLag(MetricsApi::ObserveResult obRes);
+
     void SendK8sAlarm(const std::string &locationInfo);
     void SendSchedulerAlarm(const std::string &locationInfo);
     void SendTokenRotationFailureAlarm();
@@ -162,6 +185,8 @@ private:
     static std::pair<MetricsApi::MetricLabels, double> BuildPodResourceData(const std::string &agentID,
                                                                             const PodResource &podResource);
 
+    std::vector<std::pair<std::string, std::shared_ptr<MetaStoreCacheCounters>>> GetMetaStoreCacheCounters();
+
     MetricsContext metricsContext_;
     std::unique_ptr<observability::api::metrics::Gauge<uint64_t>> alarmGauge_{ nullptr };
     bool enableMetrics_{ false };
@@ -175,6 +200,9 @@ private:
 
     AlarmHandler alarmHandler_;
 
+    std::mutex metaStoreCacheMutex_{};
+    std::multimap<std::string, std::weak_ptr<MetaStoreCacheCounters>> metaStoreCacheCounters_{};
+
     std::string GetExportModeDesc(const MetricsSdk::ExportMode &mode);
 };
 
@@ -29,6 +29,16 @@ const std::string YR_INSTANCE_RUNNING_DURATION = "yr_instance_running_duration";
 const std::string YR_APP_INSTANCE_BILLING_INVOKE_LATENCY = "yr_app_instance_billing_invoke_latency";
 const std::string YR_METRICS_KEY = "YR_Metrics";
 const std::string YR_POD_RESOURCE("yr_pod_resource");
+const std::string YR_LITEBUS_WORKER("yr_litebus_worker");
+const std::string YR_LITEBUS_WORKER_QUEUE_DEPTH("yr_litebus_worker_queue_depth");
+const std::string YR_LITEBUS_WORKER_STEALS("yr_litebus_worker_steals");
+const std::string YR_LITEBUS_ACTOR("yr_litebus_actor");
+const std::string YR_LITEBUS_ACTOR_MSGS("yr_litebus_actor_msgs");
+const std::string YR_LITEBUS_ACTOR_RUN_TIME("yr_litebus_actor_run_time");
+const std::string YR_META_STORE_CACHE("yr_meta_store_cache");
+const std::string YR_META_STORE_CACHE_HITS("yr_meta_store_cache_hits");
+const std::string YR_META_STORE_CACHE_MISSES("yr_meta_store_cache_misses");
+const std::string YR_META_STORE_CACHE_REVISION_LAG("yr_meta_store_cache_revision_lag");
 
 // alarm
 const std::string K8S_ALARM("yr_k8s_alarm");
@@ -44,6 +54,10 @@ const std::string FILE_EXPORTER("fileExporter");
 const uint32_t SIZE_MEGA_BYTES = 1024 * 1024;  // 1 MB
 const uint32_t INSTANCE_RUNNING_DURATION_COLLECT_INTERVAL = 15;  // unit:second
 const uint32_t POD_RESOURCE_COLLECT_INTERVAL = 15;  // unit:second
+const uint32_t LITEBUS_WORKER_COLLECT_INTERVAL = 15;  // unit:second
+const uint32_t LITEBUS_ACTOR_COLLECT_INTERVAL = 15;  // unit:second
+const size_t LITEBUS_ACTOR_METRICS_TOP_N = 32;  // only the actors with the longest run time are reported
+const uint32_t META_STORE_CACHE_COLLECT_INTERVAL = 15;  // unit:second
 
 const int TOKEN_ROTATION_FAILURE_TIMES_THRESHOLD = 3;
 
@@ -61,6 +75,9 @@ enum class YRInstrument {
     YR_POD_ALARM = 8,
     YR_POD_RESOURCE = 9,
     YR_ELECTION_ALARM = 10,
+    YR_LITEBUS_WORKER = 11,
+    YR_LITEBUS_ACTOR = 12,
+    YR_META_STORE_CACHE = 13,
 };
 
 enum class AlarmLevel { OFF, NOTICE, INFO, MINOR, MAJOR, CRITICAL };
@@ -75,6 +92,9 @@ const std::unordered_map<std::string, YRInstrument> INSTRUMENT_DESC_2_ENUM = {
     { POD_ALARM, YRInstrument::YR_POD_ALARM },
     { YR_POD_RESOURCE, YRInstrument::YR_POD_RESOURCE },
     { ELECTION_ALARM, YRInstrument::YR_ELECTION_ALARM },
+    { YR_LITEBUS_WORKER, YRInstrument::YR_LITEBUS_WORKER },
+    { YR_LITEBUS_ACTOR, YRInstrument::YR_LITEBUS_ACTOR },
+    { YR_META_STORE_CACHE, YRInstrument::YR_META_STORE_CACHE },
 };
 
 const std::unordered_map<YRInstrument, std::string> ENUM_2_INSTRUMENT_DESC = {
@@ -87,6 +107,9 @@ const std::unordered_map<YRInstrument, std::string> ENUM_2_INSTRUMENT_DESC = {
     { YRInstrument::YR_POD_ALARM, POD_ALARM },
     { YRInstrument::YR_POD_RESOURCE, YR_POD_RESOURCE },
     { YRInstrument::YR_ELECTION_ALARM, ELECTION_ALARM },
+    { YRInstrument::YR_LITEBUS_WORKER, YR_LITEBUS_WORKER },
+    { YRInstrument::YR_LITEBUS_ACTOR, YR_LITEBUS_ACTOR },
+    { YRInstrument::YR_META_STORE_CACHE, YR_META_STORE_CACHE },
 };
 }
 }
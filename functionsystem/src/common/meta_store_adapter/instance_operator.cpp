@@ -382,6 +382,19 @@ litebus::Future<OperateResult> InstanceOperator::GetInstance(const std::string &
 
 void InstanceOperator::OnPrintResponse(const KeyValue& kv)
 {
+    if (IsBinaryMetadata(kv.value())) {
+        // never log the raw bytes of a binary value
+        InstanceInfo instanceInfo;
+        if (TransToInstanceInfoFromJson(instanceInfo, kv.value())) {
+            YRLOG_DEBUG("{}| instance status ({}), create_revision ({}), mod_revision ({}), version ({}),",
+                        instanceInfo.instanceid(), instanceInfo.instancestatus().code(), kv.create_revision(),
+                        kv.mod_revision(), kv.version());
+        } else {
+            YRLOG_DEBUG("{}| create_revision ({}), mod_revision ({}), version ({}), binary value of {} bytes",
+                        kv.key(), kv.create_revision(), kv.mod_revision(), kv.version(), kv.value().size());
+        }
+        return;
+    }
     nlohmann::json bodyJson;
     try {
         bodyJson = nlohmann::json::parse(kv.value());
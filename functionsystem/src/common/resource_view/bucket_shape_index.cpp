@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bucket_shape_index.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include "logs/logging.h"
+#include "scala_resource_tool.h"
+
+namespace functionsystem::resource_view {
+
+BucketShape BucketShape::Of(double cpu, double mem)
+{
+    return BucketShape{ static_cast<int64_t>(ToLong(mem)), static_cast<int64_t>(ToLong(cpu)) };
+}
+
+BucketKeys BucketKeys::Of(double cpu, double mem)
+{
+    return BucketKeys{ std::to_string(mem / cpu), std::to_string(mem) };
+}
+
+size_t BucketShapeIndex::CountShapes(const ResourceUnit &view)
+{
+    size_t count = 0;
+    for (const auto &bucketIndex : view.bucketindexs()) {
+        count += static_cast<size_t>(bucketIndex.second.buckets_size());
+    }
+    return count;
+}
+
+size_t BucketShapeIndex::Update(const ResourceUnit &view)
+{
+    size_t added = 0;
+    for (const auto &[proportionKey, bucketIndex] : view.bucketindexs()) {
+        // the keys are written by std::to_string, a key that does not parse is not a shape
+        char *end = nullptr;
+        auto proportion = std::strtod(proportionKey.c_str(), &end);
+        if (end == proportionKey.c_str() || proportion <= 0) {
+            continue;
+        }
+        for (const auto &bucket : bucketIndex.buckets()) {
+            const auto &memKey = bucket.first;
+            auto mem = std::strtod(memKey.c_str(), &end);
+            if (end == memKey.c_str()) {
+                continue;
+            }
+            // the proportion is rounded to 6 decimals, the cpu is taken whole if it is formatted to the same key
+            auto cpu = mem / proportion;
+            if (auto whole = std::round(cpu); whole > 0 && std::to_string(mem / whole) == proportionKey) {
+                cpu = whole;
+            }
+            if (shapes_.emplace(BucketShape::Of(cpu, mem), BucketKeys{ proportionKey, memKey }).second) {
+                ++added;
+            }
+        }
+    }
+    if (added > 0) {
+        YRLOG_DEBUG("add {} shapes to the bucket shape index of {}, {} shapes in total", added, view.id(),
+                    shapes_.size());
+    }
+    return added;
+}
+
+const Bucket *BucketShapeIndex::Find(const ResourceUnit &view, const BucketKeys &keys)
+{
+    auto bucketIndex = view.bucketindexs().find(keys.proportion);
+    if (bucketIndex == view.bucketindexs().end()) {
+        return nullptr;
+    }
+    auto bucket = bucketIndex->second.buckets().find(keys.mem);
+    return bucket == bucketIndex->second.buckets().end() ? nullptr : &bucket->second;
+}
+
+const Bucket *BucketShapeIndex::BestFit(const ResourceUnit &view, const BucketShape &shape, BucketKeys &found) const
+{
+    for (auto iter = shapes_.lower_bound(shape); iter != shapes_.end(); ++iter) {
+        if (!iter->first.Covers(shape)) {
+            continue;
+        }
+        const auto *bucket = Find(view, iter->second);
+        if (bucket != nullptr && bucket->total().monopolynum() > 0) {
+            found = iter->second;
+            return bucket;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace functionsystem::resource_view
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_RESOURCE_VIEW_BUCKET_SHAPE_INDEX_H
+#define COMMON_RESOURCE_VIEW_BUCKET_SHAPE_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "resource_type.h"
+
+namespace functionsystem::resource_view {
+
+// the cpu and memory of the pods of a bucket, in fixed point (see ToLong)
+struct BucketShape {
+    int64_t mem{ 0 };
+    int64_t cpu{ 0 };
+
+    static BucketShape Of(double cpu, double mem);
+
+    // smaller memory first, then smaller cpu
+    bool operator<(const BucketShape &other) const
+    {
+        return mem != other.mem ? mem < other.mem : cpu < other.cpu;
+    }
+
+    bool operator==(const BucketShape &other) const
+    {
+        return mem == other.mem && cpu == other.cpu;
+    }
+
+    bool Covers(const BucketShape &other) const
+    {
+        return mem >= other.mem && cpu >= other.cpu;
+    }
+};
+
+// the keys of the bucket of the pods of a shape, bucketindexs[proportion].buckets[mem], formatted by std::to_string as
+// the resource view writes them
+struct BucketKeys {
+    std::string proportion;
+    std::string mem;
+
+    static BucketKeys Of(double cpu, double mem);
+
+    bool operator==(const BucketKeys &other) const
+    {
+        return proportion == other.proportion && mem == other.mem;
+    }
+};
+
+/**
+ * An ordered index over the keys of the bucket indexes of a view, bucketindexs[proportion].buckets[mem]. The keys are
+ * formatted doubles, the index parses them once to numeric shapes, so that a larger shape is found without walking the
+ * maps. The proportion key keeps 6 decimals, the cpu parsed back from it is the whole cpu the key is formatted from if
+ * there is one, else an approximation, so a bucket of exactly a shape is found by its keys rather than by the index.
+ * The buckets stay in the view, the index only keeps their keys, it may be shared by the snapshots of a view as long as
+ * no shape is added.
+ */
+class BucketShapeIndex {
+public:
+    BucketShapeIndex() = default;
+    ~BucketShapeIndex() = default;
+
+    // the number of bucket keys of the view
+    static size_t CountShapes(const ResourceUnit &view);
+
+    // indexes the bucket keys of the view not indexed yet, returns the number of added shapes
+    size_t Update(const ResourceUnit &view);
+
+    size_t Size() const
+    {
+        return shapes_.size();
+    }
+
+    // the bucket of the keys, nullptr if the view has no such bucket
+    static const Bucket *Find(const ResourceUnit &view, const BucketKeys &keys);
+
+    // the smallest bucket covering the shape and having monopoly pods left, nullptr if there is none. O(log n) to the
+    // first shape with enough memory, the shapes are then checked in order, skipping those with too little cpu or no
+    // monopoly pod left, which is O(n) in the worst case.
+    const Bucket *BestFit(const ResourceUnit &view, const BucketShape &shape, BucketKeys &found) const;
+
+private:
+    std::map<BucketShape, BucketKeys> shapes_;
+};
+
+}  // namespace functionsystem::resource_view
+
+#endif  // COMMON_RESOURCE_VIEW_BUCKET_SHAPE_INDEX_H
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "label_index.h"
+
+#include <utility>
+
+#include "logs/logging.h"
+#include "status/status.h"
+
+namespace functionsystem::resource_view {
+
+LabelIndex::LabelIndex(const std::shared_ptr<const ResourceUnit> &snapshot) : snapshot_(snapshot)
+{
+    ASSERT_IF_NULL(snapshot_);
+    const auto &fragment = snapshot_->fragment();
+    rows_.reserve(fragment.size());
+    units_.reserve(fragment.size());
+    for (const auto &unit : fragment) {
+        auto row = static_cast<int32_t>(units_.size());
+        (void)rows_.emplace(unit.first, row);
+        units_.push_back(&unit.second);
+    }
+    size_t values = 0;
+    for (size_t row = 0; row < units_.size(); ++row) {
+        for (const auto &[key, counter] : units_[row]->nodelabels()) {
+            auto &posting = postings_[key];
+            if (posting.units.empty()) {
+                posting.units = None();
+            }
+            Set(posting.units, static_cast<int32_t>(row));
+            for (const auto &item : counter.items()) {
+                auto [iter, added] = posting.values.try_emplace(item.first);
+                if (added) {
+                    iter->second = None();
+                    ++values;
+                }
+                Set(iter->second, static_cast<int32_t>(row));
+            }
+        }
+    }
+    YRLOG_DEBUG("build label index of {} units, {} label keys and {} label values", units_.size(), postings_.size(),
+                values);
+}
+
+int32_t LabelIndex::Row(const ResourceUnit &fragment) const
+{
+    auto iter = rows_.find(fragment.id());
+    if (iter == rows_.end() || units_[iter->second] != &fragment) {
+        return -1;
+    }
+    return iter->second;
+}
+
+LabelBitset LabelIndex::All() const
+{
+    LabelBitset bits(None().size(), ~uint64_t{ 0 });
+    if (auto tail = units_.size() % WORD_BITS; tail != 0) {
+        bits.back() = (uint64_t{ 1 } << tail) - 1;
+    }
+    return bits;
+}
+
+LabelBitset LabelIndex::None() const
+{
+    return LabelBitset((units_.size() + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+void LabelIndex::Set(LabelBitset &bits, int32_t row) const
+{
+    auto bit = static_cast<size_t>(row);
+    bits[bit / WORD_BITS] |= uint64_t{ 1 } << (bit % WORD_BITS);
+}
+
+void LabelIndex::Flip(LabelBitset &bits) const
+{
+    const auto all = All();
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = ~bits[i] & all[i];
+    }
+}
+
+LabelBitset LabelIndex::Match(const affinity::LabelExpression &expression) const
+{
+    const auto &op = expression.op();
+    auto posting = postings_.find(expression.key());
+    switch (op.LabelOperator_case()) {
+        case affinity::LabelOperator::LabelOperatorCase::kIn:
+        case affinity::LabelOperator::LabelOperatorCase::kNotIn: {
+            auto bits = None();
+            const auto &values =
+                op.LabelOperator_case() == affinity::LabelOperator::LabelOperatorCase::kIn ? op.in().values()
+                                                                                         : op.notin().values();
+            for (const auto &value : values) {
+                if (posting == postings_.end()) {
+                    break;
+                }
+                auto units = posting->second.values.find(value);
+                if (units == posting->second.values.end()) {
+                    continue;
+                }
+                for (size_t i = 0; i < bits.size(); ++i) {
+                    bits[i] |= units->second[i];
+                }
+            }
+            if (op.LabelOperator_case() == affinity::LabelOperator::LabelOperatorCase::kNotIn) {
+                Flip(bits);
+            }
+            return bits;
+        }
+        case affinity::LabelOperator::LabelOperatorCase::kExists: {
+            return posting == postings_.end() ? None() : posting->second.units;
+        }
+        case affinity::LabelOperator::LabelOperatorCase::kNotExist: {
+            auto bits = posting == postings_.end() ? None() : posting->second.units;
+            Flip(bits);
+            return bits;
+        }
+        default:
+            return All();
+    }
+}
+
+LabelBitset LabelIndex::Match(const affinity::SubCondition &subCondition) const
+{
+    auto bits = All();
+    for (const auto &expression : subCondition.expressions()) {
+        auto matched = Match(expression);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            bits[i] &= matched[i];
+        }
+    }
+    return bits;
+}
+
+std::vector<int64_t> LabelIndex::Score(const affinity::Selector &selector, bool anti) const
+{
+    std::vector<int64_t> score(units_.size(), 0);
+    // units no satisfied sub condition is found for yet
+    auto unscored = All();
+    for (const auto &subCondition : selector.condition().subconditions()) {
+        auto satisfied = Match(subCondition);
+        if (anti) {
+            Flip(satisfied);
+        }
+        for (size_t i = 0; i < satisfied.size(); ++i) {
+            auto word = satisfied[i] & unscored[i];
+            unscored[i] &= ~word;
+            for (; word != 0; word &= word - 1) {
+                score[i * WORD_BITS + static_cast<size_t>(__builtin_ctzll(word))] = subCondition.weight();
+            }
+        }
+    }
+    return score;
+}
+
+LabelBitset LabelIndex::Required(const affinity::Selector &selector, bool anti) const
+{
+    if (selector.condition().orderpriority()) {
+        auto bits = None();
+        auto score = Score(selector, anti);
+        for (size_t row = 0; row < score.size(); ++row) {
+            if (score[row] != 0) {
+                Set(bits, static_cast<int32_t>(row));
+            }
+        }
+        return bits;
+    }
+    // without priority, every expression of every sub condition is required
+    auto bits = All();
+    for (const auto &subCondition : selector.condition().subconditions()) {
+        auto matched = Match(subCondition);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            bits[i] &= matched[i];
+        }
+    }
+    if (anti) {
+        Flip(bits);
+    }
+    return bits;
+}
+
+LabelFit LabelIndex::Fit(const InstanceInfo &instance) const
+{
+    LabelFit fit;
+    fit.requestID = instance.requestid();
+    fit.index = this;
+    const auto &affinity = instance.scheduleoption().affinity();
+    if (!affinity.has_resource()) {
+        return fit;
+    }
+    const auto &resource = affinity.resource();
+    if (resource.has_requiredaffinity() || resource.has_requiredantiaffinity()) {
+        fit.required = resource.has_requiredaffinity() ? Required(resource.requiredaffinity(), false) : All();
+        if (resource.has_requiredantiaffinity()) {
+            auto passed = Required(resource.requiredantiaffinity(), true);
+            for (size_t i = 0; i < passed.size(); ++i) {
+                fit.required[i] &= passed[i];
+            }
+        }
+    }
+    // the same selectors as CalculateResourceAffinityScore
+    std::vector<std::pair<const affinity::Selector *, bool>> scored;
+    if (resource.has_preferredaffinity()) {
+        scored.emplace_back(&resource.preferredaffinity(), false);
+    }
+    if (resource.has_preferredantiaffinity()) {
+        scored.emplace_back(&resource.preferredantiaffinity(), true);
+    }
+    if (resource.has_requiredaffinity() && resource.requiredaffinity().condition().orderpriority()) {
+        scored.emplace_back(&resource.requiredaffinity(), false);
+    }
+    if (resource.has_requiredantiaffinity() && resource.requiredantiaffinity().condition().orderpriority()) {
+        scored.emplace_back(&resource.requiredantiaffinity(), true);
+    }
+    if (!scored.empty()) {
+        fit.score.assign(units_.size(), 0);
+    }
+    for (const auto &[selector, anti] : scored) {
+        auto score = Score(*selector, anti);
+        for (size_t row = 0; row < score.size(); ++row) {
+            fit.score[row] += score[row];
+        }
+    }
+    return fit;
+}
+
+}  // namespace functionsystem::resource_view
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_RESOURCE_VIEW_LABEL_INDEX_H
+#define COMMON_RESOURCE_VIEW_LABEL_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "resource_type.h"
+
+namespace functionsystem::resource_view {
+
+class LabelIndex;
+
+// one bit per row of a label index
+using LabelBitset = std::vector<uint64_t>;
+
+// the resource affinity of one request against every unit of a label index, indexed by the row of the unit
+struct LabelFit {
+    std::string requestID;
+    const LabelIndex *index{ nullptr };
+    // units passing the required resource affinity and anti-affinity, empty if the request requires none
+    LabelBitset required;
+    // resource affinity score of every unit, empty if the request scores none
+    std::vector<int64_t> score;
+};
+
+/**
+ * An inverted index from the node labels of the fragments of an immutable view snapshot to the units having them:
+ * label key -> units having the key, label key and value -> units having the value. Every unit is a row, a set of units
+ * is a bitset over the rows, so that a selector is evaluated once for all units by intersecting the bitsets of its
+ * expressions, in time of the number of words and matched values instead of the number of units times expressions.
+ * The protobuf snapshot stays the source of truth.
+ */
+class LabelIndex {
+public:
+    explicit LabelIndex(const std::shared_ptr<const ResourceUnit> &snapshot);
+    ~LabelIndex() = default;
+
+    bool IsBuiltFrom(const ResourceUnit &view) const
+    {
+        return snapshot_.get() == &view;
+    }
+
+    // -1 if the unit is not a fragment of the snapshot. Only the fragment object itself has a row, a copy of it may
+    // carry other labels.
+    int32_t Row(const ResourceUnit &fragment) const;
+
+    size_t Rows() const
+    {
+        return rows_.size();
+    }
+
+    static bool Test(const LabelBitset &bits, int32_t row)
+    {
+        auto bit = static_cast<size_t>(row);
+        return row >= 0 && ((bits[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1U) != 0;
+    }
+
+    // units matching the expression, the same as IsMatchLabelExpression on their node labels
+    LabelBitset Match(const affinity::LabelExpression &expression) const;
+
+    // units matching every expression of the sub condition
+    LabelBitset Match(const affinity::SubCondition &subCondition) const;
+
+    // score of every unit for the selector, the weight of the first satisfied sub condition as GetAffinityScore
+    std::vector<int64_t> Score(const affinity::Selector &selector, bool anti) const;
+
+    // units passing the required selector, the same as RequiredAffinityFilter and RequiredAntiAffinityFilter
+    LabelBitset Required(const affinity::Selector &selector, bool anti) const;
+
+    // required and scored resource affinity of the instance, nothing is evaluated if it has no resource affinity
+    LabelFit Fit(const InstanceInfo &instance) const;
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    struct Posting {
+        LabelBitset units;
+        std::unordered_map<std::string, LabelBitset> values;
+    };
+
+    LabelBitset All() const;
+    LabelBitset None() const;
+    void Set(LabelBitset &bits, int32_t row) const;
+    void Flip(LabelBitset &bits) const;
+
+    std::shared_ptr<const ResourceUnit> snapshot_;
+    std::unordered_map<std::string, int32_t> rows_;
+    // the fragment of every row
+    std::vector<const ResourceUnit *> units_;
+    // key: label key
+    std::unordered_map<std::string, Posting> postings_;
+};
+
+}  // namespace functionsystem::resource_view
+
+#endif  // COMMON_RESOURCE_VIEW_LABEL_INDEX_H
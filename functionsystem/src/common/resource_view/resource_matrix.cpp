@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resource_matrix.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "logs/logging.h"
+#include "resource_tool.h"
+#include "scala_resource_tool.h"
+#include "status/status.h"
+
+namespace functionsystem::resource_view {
+
+ResourceMatrix::ResourceMatrix(const std::shared_ptr<const ResourceUnit> &snapshot) : snapshot_(snapshot)
+{
+    ASSERT_IF_NULL(snapshot_);
+    const auto &fragment = snapshot_->fragment();
+    rows_.reserve(fragment.size());
+    for (const auto &unit : fragment) {
+        (void)rows_.emplace(unit.first, static_cast<int32_t>(rows_.size()));
+        for (const auto *resources : { &unit.second.capacity(), &unit.second.allocatable() }) {
+            for (const auto &resource : resources->resources()) {
+                if (columns_.emplace(resource.first, static_cast<int32_t>(columnNames_.size())).second) {
+                    columnNames_.push_back(resource.first);
+                }
+            }
+        }
+    }
+    capacity_.assign(rows_.size() * columnNames_.size(), ABSENT);
+    allocatable_.assign(rows_.size() * columnNames_.size(), ABSENT);
+    for (const auto &unit : fragment) {
+        auto row = rows_.at(unit.first);
+        for (const auto &resource : unit.second.capacity().resources()) {
+            capacity_[Offset(row, columns_.at(resource.first))] = ToLong(resource.second.scalar().value());
+        }
+        for (const auto &resource : unit.second.allocatable().resources()) {
+            allocatable_[Offset(row, columns_.at(resource.first))] = ToLong(resource.second.scalar().value());
+        }
+    }
+    YRLOG_DEBUG("build resource matrix of {} units and {} resources", rows_.size(), columnNames_.size());
+}
+
+int32_t ResourceMatrix::Row(const std::string &unitID) const
+{
+    auto iter = rows_.find(unitID);
+    return iter == rows_.end() ? -1 : iter->second;
+}
+
+int32_t ResourceMatrix::Column(const std::string &name) const
+{
+    auto iter = columns_.find(name);
+    return iter == columns_.end() ? -1 : iter->second;
+}
+
+ResourceFit ResourceMatrix::Fit(const InstanceInfo &instance) const
+{
+    ResourceFit fit;
+    fit.requestID = instance.requestid();
+    fit.matrix = this;
+    fit.failure.assign(rows_.size(), FitFailure::NONE);
+    fit.failedResource.assign(rows_.size(), -1);
+    fit.maxAllocatable.assign(rows_.size(), std::numeric_limits<int32_t>::max());
+    fit.score.assign(rows_.size(), 0);
+    int64_t scored = 0;
+    for (const auto &req : instance.resources().resources()) {
+        // hetero resources are filtered and scored by the hetero plugins, a zero request is always met
+        if (IsHeteroResourceName(req.first) || ScalaValueIsEmpty(req.second)) {
+            continue;
+        }
+        auto value = req.second.scalar().value();
+        if (value <= 0) {
+            continue;
+        }
+        // a request below the fixed point is one unit of it, not nothing
+        auto required = std::max<int64_t>(ToLong(value), 1);
+        auto resource = static_cast<int32_t>(fit.resources.size());
+        fit.resources.push_back(req.first);
+        // the units fail with the first resource they miss in the order of the request, as the protobuf view is read
+        if (auto column = Column(req.first); column >= 0) {
+            FitColumn(column, required, resource, fit);
+            scored++;
+        } else {
+            FitAbsent(resource, fit);
+        }
+    }
+    if (scored > 0) {
+        for (auto &score : fit.score) {
+            score /= scored;
+        }
+    }
+    return fit;
+}
+
+void ResourceMatrix::FitColumn(int32_t column, int64_t required, int32_t resource, ResourceFit &fit) const
+{
+    // branch free over contiguous arrays, so that the compiler is able to vectorize it
+    const auto rows = rows_.size();
+    const int64_t *capacity = capacity_.data() + Offset(0, column);
+    const int64_t *allocatable = allocatable_.data() + Offset(0, column);
+    auto *failure = fit.failure.data();
+    auto *failedResource = fit.failedResource.data();
+    auto *maxAllocatable = fit.maxAllocatable.data();
+    auto *score = fit.score.data();
+    const auto maxInt32 = static_cast<int64_t>(std::numeric_limits<int32_t>::max());
+    for (size_t row = 0; row < rows; ++row) {
+        auto cap = capacity[row];
+        auto avail = allocatable[row];
+        auto failed = cap == ABSENT        ? FitFailure::NOT_FOUND
+                      : required > cap     ? FitFailure::OUT_OF_CAPACITY
+                      : avail == ABSENT    ? FitFailure::NOT_FOUND
+                      : required > avail   ? FitFailure::NOT_ENOUGH
+                                           : FitFailure::NONE;
+        bool first = failure[row] == FitFailure::NONE && failed != FitFailure::NONE;
+        failure[row] = first ? failed : failure[row];
+        failedResource[row] = first ? resource : failedResource[row];
+        auto count = static_cast<int32_t>(std::min(std::max(avail, int64_t{ 0 }) / required, maxInt32));
+        maxAllocatable[row] = std::min(maxAllocatable[row], count);
+        auto ratio = avail > 0 ? static_cast<double>(required) / static_cast<double>(avail) : 1.0;
+        score[row] += static_cast<int64_t>((1.0f - ratio) * 100);
+    }
+}
+
+void ResourceMatrix::FitAbsent(int32_t resource, ResourceFit &fit)
+{
+    for (size_t row = 0; row < fit.failure.size(); ++row) {
+        if (fit.failure[row] == FitFailure::NONE) {
+            fit.failure[row] = FitFailure::NOT_FOUND;
+            fit.failedResource[row] = resource;
+        }
+    }
+}
+
+}  // namespace functionsystem::resource_view
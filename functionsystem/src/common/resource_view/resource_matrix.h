@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_RESOURCE_VIEW_RESOURCE_MATRIX_H
+#define COMMON_RESOURCE_VIEW_RESOURCE_MATRIX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "resource_type.h"
+
+namespace functionsystem::resource_view {
+
+class ResourceMatrix;
+
+enum class FitFailure : uint8_t {
+    NONE = 0,
+    NOT_FOUND = 1,
+    OUT_OF_CAPACITY = 2,
+    NOT_ENOUGH = 3,
+};
+
+// the fit of one request against every unit of a resource matrix, indexed by the row of the unit
+struct ResourceFit {
+    std::string requestID;
+    const ResourceMatrix *matrix{ nullptr };
+    // the scalar resources fitted, in the order of the request
+    std::vector<std::string> resources;
+    std::vector<FitFailure> failure;
+    // the index in resources of the first one the unit fails with, a resource no unit has fails every unit
+    std::vector<int32_t> failedResource;
+    std::vector<int32_t> maxAllocatable;
+    std::vector<int64_t> score;
+};
+
+/**
+ * A dense copy of the scalar resources of the fragments of an immutable view snapshot. Resource names are interned to
+ * columns and the values of a column are kept in fixed point (see ToLong) in one contiguous array, one row per unit.
+ * The protobuf snapshot stays the source of truth, the matrix is only a faster way of reading it.
+ */
+class ResourceMatrix {
+public:
+    // resource values are never negative in a valid unit
+    static constexpr int64_t ABSENT = -1;
+
+    explicit ResourceMatrix(const std::shared_ptr<const ResourceUnit> &snapshot);
+    ~ResourceMatrix() = default;
+
+    bool IsBuiltFrom(const ResourceUnit &view) const
+    {
+        return snapshot_.get() == &view;
+    }
+
+    // -1 if the unit is not a fragment of the snapshot
+    int32_t Row(const std::string &unitID) const;
+
+    // -1 if no unit has the resource
+    int32_t Column(const std::string &name) const;
+
+    const std::string &ColumnName(int32_t column) const
+    {
+        return columnNames_[column];
+    }
+
+    size_t Rows() const
+    {
+        return rows_.size();
+    }
+
+    size_t Columns() const
+    {
+        return columnNames_.size();
+    }
+
+    int64_t Capacity(int32_t row, int32_t column) const
+    {
+        return capacity_[Offset(row, column)];
+    }
+
+    int64_t Allocatable(int32_t row, int32_t column) const
+    {
+        return allocatable_[Offset(row, column)];
+    }
+
+    // filters and scores every unit for the scalar resources of the instance, heterogeneous resources are skipped
+    ResourceFit Fit(const InstanceInfo &instance) const;
+
+private:
+    size_t Offset(int32_t row, int32_t column) const
+    {
+        return static_cast<size_t>(column) * rows_.size() + static_cast<size_t>(row);
+    }
+
+    void FitColumn(int32_t column, int64_t required, int32_t resource, ResourceFit &fit) const;
+
+    static void FitAbsent(int32_t resource, ResourceFit &fit);
+
+    std::shared_ptr<const ResourceUnit> snapshot_;
+    std::unordered_map<std::string, int32_t> rows_;
+    std::unordered_map<std::string, int32_t> columns_;
+    std::vector<std::string> columnNames_;
+    // column major, Offset(row, column)
+    std::vector<int64_t> capacity_;
+    std::vector<int64_t> allocatable_;
+};
+
+}  // namespace functionsystem::resource_view
+
+#endif  // COMMON_RESOURCE_VIEW_RESOURCE_MATRIX_H
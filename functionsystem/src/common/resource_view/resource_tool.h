@@ -17,6 +17,7 @@
 #ifndef COMMON_RESOURCE_VIEW_RESOURCE_TOOL_H
 #define COMMON_RESOURCE_VIEW_RESOURCE_TOOL_H
 
+#include <algorithm>
 #include <numeric>
 #include <utils/string_utils.hpp>
 
@@ -250,6 +251,12 @@ inline bool HasAffinity(const resource_view::InstanceInfo &instance)
            || HasResourceAffinity(instance) || HasInnerAffinity(instance);
 }
 
+// same as splitting the name by "/" into HETERO_RESOURCE_FIELD_NUM fields, without the allocations
+inline bool IsHeteroResourceName(const std::string &name)
+{
+    return std::count(name.begin(), name.end(), '/') + 1 == HETERO_RESOURCE_FIELD_NUM;
+}
+
 inline bool HasHeterogeneousResource(const resource_view::InstanceInfo &instance)
 {
     for (auto &req : instance.resources().resources()) {
@@ -16,6 +16,7 @@
 
 #include "resource_view_actor.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "async/async.hpp"
@@ -33,6 +34,8 @@ namespace functionsystem::resource_view {
 static const int32_t DEFAULT_PRINT_RESOURCE_VIEW_TIMER_COUNT = 60;
 static const std::string NEED_RECOVER_VIEW = "needRecoverView";
 static const std::string IDLE_TO_RECYCLE = "yr-idle-to-recycle";
+// one snapshot held by the schedule queue while the other one is patched
+static const size_t MAX_VIEW_SNAPSHOTS = 2;
 ResourceViewActor::ResourceViewActor(const std::string &name, std::string id, const Param &param)
     : BasisActor(name), unitID_(std::move(id)), isLocal_(param.isLocal),
       enableTenantAffinity_(param.enableTenantAffinity), tenantPodReuseTimeWindow_(param.tenantPodReuseTimeWindow)
@@ -153,6 +156,7 @@ Status ResourceViewActor::AddResourceUnit(const ResourceUnit &value)
     auto fragment = view_->mutable_fragment();
     YRLOG_DEBUG("add unit({}) to top level's fragment", value.id());
     (*fragment)[value.id()] = value;
+    MarkFragmentChanged(value.id());
 
     // map request id to unit id
     for (auto &valueInstIter : value.instances()) {
@@ -201,6 +205,7 @@ Status ResourceViewActor::AddResourceUnitWithUrl(const ResourceUnit &value, cons
             return status;
         }
         view_->mutable_fragment()->at(agentFragmentIter.second.id()).set_ownerid(value.id());
+        MarkFragmentChanged(agentFragmentIter.second.id());
         localInfoMap_[value.id()].agentIDs.insert(agentFragmentIter.second.id());
         if (isHeader_) {
             if (view_->fragment().contains(agentFragmentIter.second.id())) {
@@ -339,6 +344,7 @@ Status ResourceViewActor::DeleteResourceUnit(const std::string &unitID)
         }
     }
     (void)fragment->erase(fragmentIter);
+    MarkFragmentChanged(unitID);
 
     view_->set_revision(view_->revision() + 1);
     UpdateTime();
@@ -423,6 +429,7 @@ Status ResourceViewActor::UpdateUnitStatus(const std::string &unitID, UnitStatus
         PodRecycler(unit->second);
     }
     unit->second.set_status(static_cast<uint32_t>(status));
+    MarkFragmentChanged(unitID);
     view_->set_revision(view_->revision() + 1);
 
     Modification modification;
@@ -555,6 +562,7 @@ void ResourceViewActor::UpdateDomainUrlForLocal(const std::string &addr)
     if (!domainUrlForLocal_.empty()) {
         litebus::uuid_generator::UUID uuid = litebus::uuid_generator::UUID::GetRandomUUID();
         view_->set_viewinittime(uuid.ToString());
+        ++snapshotVersion_;
         YRLOG_INFO("Potential domain switch detected, new viewInitTime is {}", view_->viewinittime());
     }
     domainUrlForLocal_ = addr;
@@ -573,9 +581,10 @@ ResourceViewInfo ResourceViewActor::GetResourceInfo()
     }
     using LableProtoMap = ::google::protobuf::Map<std::string, ValueCounter>;
     return ResourceViewInfo{
-        *view_, reqIDToUnitIDMap_,
+        GetViewSnapshot(), reqIDToUnitIDMap_,
         isLocal_ ? std::unordered_map<std::string, LableProtoMap>{ { view_->id(), view_->nodelabels() } }
-                 : allLocalLabels_
+                 : allLocalLabels_,
+        GetBucketShapeIndex()
     };
 }
 
@@ -620,6 +629,7 @@ void ResourceViewActor::ClearResourceView()
 {
     view_.reset(new ResourceUnit());
     reqIDToUnitIDMap_.clear();
+    ClearViewSnapshots();
 }
 
 void ResourceViewActor::AddResourceUpdateHandler(const ResourceUpdateHandler &handler)
@@ -760,6 +770,7 @@ void ResourceViewActor::AddLabels(const InstanceInfo &instance)
     auto fragment = view_->mutable_fragment();
     if (auto iter = fragment->find(instance.unitid()); iter != fragment->end()) {
         AddLabel(instance, *iter->second.mutable_nodelabels());
+        MarkFragmentChanged(instance.unitid());
     }
 }
 
@@ -812,6 +823,8 @@ inline void ResourceViewActor::ClearAgentTenantLabels(const std::string &functio
     if (tenantKv != nodeLabels->end()) {
         YRLOG_INFO("Clear functionAgent({}) labels", functionAgentID);
         (void)nodeLabels->erase(TENANT_ID);
+        // only the top level is changed
+        ++snapshotVersion_;
     }
 }
 
@@ -930,6 +943,7 @@ void ResourceViewActor::AddInstanceToView(const InstanceInfo &instance)
     }
     auto &agentResourceUnit = agentFragmentIter->second;
     auto substraction = AddInstanceToAgentView(instance, agentResourceUnit);
+    MarkFragmentChanged(agentId);
 
     (*view_->mutable_allocatable()) = view_->allocatable() - substraction;
     // add instance to top level resourceunit
@@ -1031,6 +1045,7 @@ void ResourceViewActor::DeleteLabels(const InstanceInfo &instInfo)
     auto fragment = view_->mutable_fragment();
     if (auto iter = fragment->find(instInfo.unitid()); iter != fragment->end()) {
         DeleteLabel(instInfo, *iter->second.mutable_nodelabels());
+        MarkFragmentChanged(instInfo.unitid());
     }
 }
 
@@ -1048,6 +1063,7 @@ void ResourceViewActor::DeleteInstanceFromView(const InstanceInfo &instance)
     }
     auto &agentResourceUnit = agentFragmentIter->second;
     auto addend = DeleteInstanceFromAgentView(instance, agentResourceUnit);
+    MarkFragmentChanged(agentId);
 
     (*view_->mutable_allocatable()) = view_->allocatable() + addend;
 
@@ -1075,6 +1091,7 @@ void ResourceViewActor::UpdateResourceUnitActual(const std::shared_ptr<ResourceU
 
     // update fragment
     *unit->second.mutable_actualuse() = std::move(*value->mutable_actualuse());
+    MarkFragmentChanged(value->id());
 }
 
 void ResourceViewActor::PrintResourceView()
@@ -1505,6 +1522,7 @@ Status ResourceViewActor::HandleReportedModification(const ResourceUnitChange &c
 
     if (modification.has_statuschange()) {
         agentResourceUnit.set_status(static_cast<uint32_t>(modification.statuschange().status()));
+        MarkFragmentChanged(agentId);
     }
 
     if (modification.instancechanges().empty()) {
@@ -1704,6 +1722,131 @@ void ResourceViewActor::NotifyResourceUpdated()
     hasResourceUpdated_ = false;
 }
 
+void ResourceViewActor::MarkFragmentChanged(const std::string &unitID)
+{
+    auto &version = fragmentVersions_[unitID];
+    if (version != 0) {
+        (void)changedFragments_.erase(version);
+    }
+    version = ++snapshotVersion_;
+    changedFragments_[version] = unitID;
+}
+
+void ResourceViewActor::ClearViewSnapshots()
+{
+    viewSnapshots_.clear();
+    fragmentVersions_.clear();
+    changedFragments_.clear();
+}
+
+std::shared_ptr<const ResourceUnit> ResourceViewActor::GetViewSnapshot()
+{
+    ASSERT_IF_NULL(view_);
+    // consumers of the same version share one snapshot
+    if (auto current = std::find_if(viewSnapshots_.begin(), viewSnapshots_.end(),
+                                    [this](const ViewSnapshot &snapshot) {
+                                        return snapshot.version == snapshotVersion_;
+                                    });
+        current != viewSnapshots_.end()) {
+        return current->unit;
+    }
+    // a snapshot only referenced here is not read by any consumer, it is safe to patch it in place
+    auto iter = std::find_if(viewSnapshots_.begin(), viewSnapshots_.end(),
+                             [](const ViewSnapshot &snapshot) { return snapshot.unit.use_count() == 1; });
+    if (iter != viewSnapshots_.end()) {
+        PatchViewSnapshot(*iter);
+    } else {
+        if (viewSnapshots_.size() >= MAX_VIEW_SNAPSHOTS) {
+            // the oldest one lives on with its consumers
+            (void)viewSnapshots_.erase(std::min_element(
+                viewSnapshots_.begin(), viewSnapshots_.end(),
+                [](const ViewSnapshot &lhs, const ViewSnapshot &rhs) { return lhs.version < rhs.version; }));
+        }
+        YRLOG_DEBUG("copy the whole resource view to a new snapshot at version {}", snapshotVersion_);
+        iter = viewSnapshots_.insert(viewSnapshots_.end(),
+                                     ViewSnapshot{ std::make_shared<ResourceUnit>(*view_), snapshotVersion_ });
+    }
+    std::shared_ptr<const ResourceUnit> result = iter->unit;
+
+    // the changes seen by every snapshot are not needed anymore
+    auto oldest = std::min_element(
+        viewSnapshots_.begin(), viewSnapshots_.end(),
+        [](const ViewSnapshot &lhs, const ViewSnapshot &rhs) { return lhs.version < rhs.version; })->version;
+    for (auto change = changedFragments_.begin(); change != changedFragments_.end() && change->first <= oldest;) {
+        (void)fragmentVersions_.erase(change->second);
+        change = changedFragments_.erase(change);
+    }
+    return result;
+}
+
+std::shared_ptr<const BucketShapeIndex> ResourceViewActor::GetBucketShapeIndex()
+{
+    ASSERT_IF_NULL(view_);
+    // bucket keys are only added while the view lives, a fewer count means the view was replaced
+    auto shapes = BucketShapeIndex::CountShapes(*view_);
+    if (bucketShapeIndex_ != nullptr && shapes == indexedBucketShapes_) {
+        return bucketShapeIndex_;
+    }
+    // the index held by the consumers of former snapshots is left as it is, new shapes go to a copy
+    auto index = bucketShapeIndex_ == nullptr || shapes < indexedBucketShapes_
+                     ? std::make_shared<BucketShapeIndex>()
+                     : std::make_shared<BucketShapeIndex>(*bucketShapeIndex_);
+    (void)index->Update(*view_);
+    bucketShapeIndex_ = index;
+    indexedBucketShapes_ = shapes;
+    return bucketShapeIndex_;
+}
+
+void ResourceViewActor::PatchViewSnapshot(ViewSnapshot &snapshot)
+{
+    auto &unit = *snapshot.unit;
+    auto *instances = unit.mutable_instances();
+    size_t patched = 0;
+    for (auto change = changedFragments_.upper_bound(snapshot.version); change != changedFragments_.end(); ++change) {
+        const auto &unitID = change->second;
+        if (auto old = unit.fragment().find(unitID); old != unit.fragment().end()) {
+            for (const auto &inst : old->second.instances()) {
+                (void)instances->erase(inst.first);
+            }
+        }
+        ++patched;
+        auto current = view_->fragment().find(unitID);
+        if (current == view_->fragment().end()) {
+            (void)unit.mutable_fragment()->erase(unitID);
+            continue;
+        }
+        (*unit.mutable_fragment())[unitID] = current->second;
+        for (const auto &inst : current->second.instances()) {
+            if (auto topInst = view_->instances().find(inst.first); topInst != view_->instances().end()) {
+                (*instances)[inst.first] = topInst->second;
+            }
+        }
+    }
+    CopyTopLevelToSnapshot(unit);
+    YRLOG_DEBUG("patch the resource view snapshot from version {} to {} with {} fragments", snapshot.version,
+                snapshotVersion_, patched);
+    snapshot.version = snapshotVersion_;
+}
+
+void ResourceViewActor::CopyTopLevelToSnapshot(ResourceUnit &snapshot)
+{
+    // the fragments and their instances are patched one by one, the rest of the top level is copied, the maps are
+    // swapped aside so that the copy does not walk them
+    ::google::protobuf::Map<std::string, ResourceUnit> viewFragments;
+    ::google::protobuf::Map<std::string, InstanceInfo> viewInstances;
+    ::google::protobuf::Map<std::string, ResourceUnit> snapshotFragments;
+    ::google::protobuf::Map<std::string, InstanceInfo> snapshotInstances;
+    viewFragments.swap(*view_->mutable_fragment());
+    viewInstances.swap(*view_->mutable_instances());
+    snapshotFragments.swap(*snapshot.mutable_fragment());
+    snapshotInstances.swap(*snapshot.mutable_instances());
+    snapshot.CopyFrom(*view_);
+    view_->mutable_fragment()->swap(viewFragments);
+    view_->mutable_instances()->swap(viewInstances);
+    snapshot.mutable_fragment()->swap(snapshotFragments);
+    snapshot.mutable_instances()->swap(snapshotInstances);
+}
+
 void ResourceViewActor::PodRecycler(const ResourceUnit &unit)
 {
     int recycleTime = ParseRecyclePodLabel(unit);
@@ -18,6 +18,7 @@
 #define COMMON_RESOURCE_VIEW_RESOURCE_VIEW_ACTOR_H
 
 #include <list>
+#include <map>
 
 #include "actor/actor.hpp"
 #include "async/future.hpp"
@@ -25,6 +26,7 @@
 #include "common/utils/actor_driver.h"
 #include "status/status.h"
 #include "resource_type.h"
+#include "bucket_shape_index.h"
 #include "resource_poller.h"
 
 namespace functionsystem::resource_view {
@@ -340,6 +342,23 @@ private:
     void MarkResourceUpdated();
     void NotifyResourceUpdated();
 
+    /**
+     * brief Get an immutable snapshot of the view. A snapshot no longer held by any consumer is reused and patched
+     * with the fragments changed since its version, instead of copying the whole view.
+     */
+    std::shared_ptr<const ResourceUnit> GetViewSnapshot();
+    void MarkFragmentChanged(const std::string &unitID);
+    void ClearViewSnapshots();
+
+    struct ViewSnapshot {
+        std::shared_ptr<ResourceUnit> unit;
+        uint64_t version{ 0 };
+    };
+    void PatchViewSnapshot(ViewSnapshot &snapshot);
+    void CopyTopLevelToSnapshot(ResourceUnit &snapshot);
+    // the shapes of the bucket indexes of the view, only the shapes added since the last call are indexed
+    std::shared_ptr<const BucketShapeIndex> GetBucketShapeIndex();
+
     void PodRecycler(const ResourceUnit &unit);
     int32_t ParseRecyclePodLabel(const ResourceUnit &unit);
 
@@ -379,6 +398,16 @@ private:
     // key: revision, value: changes in the current revision
     std::map<int64_t, ResourceUnitChange> versionChanges_;
 
+    // the version of the view seen by the snapshots, increased by every change of a fragment
+    uint64_t snapshotVersion_ = 0;
+    // key: unit id, value: the version of its last change
+    std::unordered_map<std::string, uint64_t> fragmentVersions_;
+    // key: version, value: the unit id changed in the version
+    std::map<uint64_t, std::string> changedFragments_;
+    std::vector<ViewSnapshot> viewSnapshots_;
+    std::shared_ptr<BucketShapeIndex> bucketShapeIndex_;
+    size_t indexedBucketShapes_ = 0;
+
     // Only used in domain
     std::unordered_map<std::string, LocalResourceViewInfo> localInfoMap_;
     // Only used in domain; key: localId; value: all instance label
@@ -41,7 +41,7 @@ std::shared_ptr<std::deque<ScheduleResult>> AggregatedSchedulePerformer::DoMulti
     std::unordered_map<std::string, int32_t> _;
     ASSERT_IF_NULL(framework_);
     auto results = framework_->SelectFeasible(context, instanceItem->scheduleReq->instance(),
-	                                          resourceInfo.resourceUnit, items->size());
+	                                          *resourceInfo.resourceUnit, items->size());
     if (results.code != static_cast<int32_t>(StatusCode::SUCCESS)) {
         schedResults->emplace_back(ScheduleResult{ "", results.code, results.reason, {}, "", {} });
         return schedResults;
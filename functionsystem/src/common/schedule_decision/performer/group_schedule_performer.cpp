@@ -55,7 +55,7 @@ ScheduleResult GroupSchedulePerformer::Selected(
     // on local: ownerid() == real agent id
     // on domain: ownerid == localid
     result.unitID = result.id;
-    result.id = resourceInfo.resourceUnit.fragment().at(result.id).ownerid();
+    result.id = resourceInfo.resourceUnit->fragment().at(result.id).ownerid();
 
     PreAllocated(scheReq->instance(), context, requestID, traceID, result);
     return result;
@@ -120,7 +120,7 @@ GroupScheduleResult GroupSchedulePerformer::Schedule(
         ASSERT_IF_NULL(framework_);
         auto instanceSpec = scheduleItem->groupReqs[0]->scheduleReq->instance();
         context->pluginCtx = scheduleItem->groupReqs[0]->scheduleReq->mutable_contexts();
-        results = framework_->SelectFeasible(context, instanceSpec, resourceInfo.resourceUnit,
+        results = framework_->SelectFeasible(context, instanceSpec, *resourceInfo.resourceUnit,
                                              scheduleItem->groupReqs.size());
     }
     std::vector<PreemptResult> preemptResults;
@@ -129,6 +129,7 @@ GroupScheduleResult GroupSchedulePerformer::Schedule(
     uint32_t min = scheduleItem->GetRangeOpt().isRange ? static_cast<uint32_t>(scheduleItem->GetRangeOpt().min)
                                                        : static_cast<uint32_t>(scheduleItem->groupReqs.size());
     std::shared_ptr<resource_view::ResourceViewInfo> cachedForPreemption = nullptr;
+    std::shared_ptr<resource_view::ResourceUnit> unitForPreemption = nullptr;
     std::list<ScheduleResult> scheduleResults;
     std::unordered_map<std::string, int32_t> preAllocated;
     for (auto instanceItem : scheduleItem->groupReqs) {
@@ -150,8 +151,10 @@ GroupScheduleResult GroupSchedulePerformer::Schedule(
         }
         // copy is triggered only when preemption is enabled and resources are insufficient for the first time.
         if (preemptInstanceCallback_ != nullptr && cachedForPreemption == nullptr) {
-            auto tmp = resource_view::ResourceViewInfo{ resourceInfo.resourceUnit, resourceInfo.alreadyScheduled,
-                                                        resourceInfo.allLocalLabels };
+            // the snapshot is shared with the resource view, the preempted instances are taken off a copy of it
+            unitForPreemption = std::make_shared<resource_view::ResourceUnit>(*resourceInfo.resourceUnit);
+            auto tmp = resource_view::ResourceViewInfo{ unitForPreemption, resourceInfo.alreadyScheduled,
+                                                        resourceInfo.allLocalLabels, resourceInfo.bucketShapeIndex };
             cachedForPreemption = std::make_shared<resource_view::ResourceViewInfo>(std::move(tmp));
         }
         // if unPreemptable failure happened break to return failed.
@@ -163,7 +166,7 @@ GroupScheduleResult GroupSchedulePerformer::Schedule(
         YRLOG_INFO("{}|{}|start to check preempt result", traceID, reqID);
         ASSERT_IF_NULL(preemptController_);
         auto preemptRes = preemptController_->PreemptDecision(context, instanceItem->scheduleReq->instance(),
-                                                              cachedForPreemption->resourceUnit);
+                                                              *cachedForPreemption->resourceUnit);
         if (!preemptRes.status.IsOk()) {
             YRLOG_ERROR("{}|{}|preempt status is err, {}", traceID, reqID, preemptRes.status.ToString());
             isPreempt = false;
@@ -171,7 +174,7 @@ GroupScheduleResult GroupSchedulePerformer::Schedule(
         }
         preemptResults.emplace_back(preemptRes);
         for (auto &ins : preemptRes.preemptedInstances) {
-            PrePreemptFromResourceView(ins, cachedForPreemption->resourceUnit);
+            PrePreemptFromResourceView(ins, *unitForPreemption);
         }
         DoPreAllocated(instanceItem->scheduleReq->instance(), context, preemptRes.unitID, result);
         // preempt success, continue to schedule
@@ -29,7 +29,7 @@ ScheduleResult InstanceSchedulePerformer::DoSchedule(
                    instanceItem->scheduleReq->requestid());
         ASSERT_IF_NULL(preemptController_);
         auto preemptRes = preemptController_->PreemptDecision(context, instanceItem->scheduleReq->instance(),
-                                                              resourceInfo.resourceUnit);
+                                                              *resourceInfo.resourceUnit);
         if (preemptRes.status.IsOk()) {
             YRLOG_INFO("{}|{}|start to trigger preempt instance", instanceItem->scheduleReq->traceid(),
                        instanceItem->scheduleReq->requestid());
@@ -91,7 +91,7 @@ std::string SchedulePerformer::GetAlreadyScheduledResult(const std::string &requ
     if (type_ == AllocateType::ALLOCATION) {
         return alreadyScheduledResult;
     }
-    auto &resourceUnit = resourceInfo.resourceUnit;
+    auto &resourceUnit = *resourceInfo.resourceUnit;
     if (resourceUnit.fragment().find(alreadyScheduledResult) == resourceUnit.fragment().end()) {
         YRLOG_ERROR("resource view does not have a agent unit with ID {}.", alreadyScheduledResult);
         return "";
@@ -157,7 +157,7 @@ bool SchedulePerformer::IsScheduled(const std::shared_ptr<schedule_framework::Pr
         && groupContext.find(GROUP_SCHEDULE_CONTEXT) != groupContext.end()
         && !groupContext.at(GROUP_SCHEDULE_CONTEXT).groupschedctx().reserved().empty()) {
         auto &unitID = groupContext.at(GROUP_SCHEDULE_CONTEXT).groupschedctx().reserved();
-        if (resourceInfo.resourceUnit.fragment().find(unitID) == resourceInfo.resourceUnit.fragment().end()) {
+        if (resourceInfo.resourceUnit->fragment().find(unitID) == resourceInfo.resourceUnit->fragment().end()) {
             return false;
         }
         result.code = static_cast<int32_t>(StatusCode::SUCCESS);
@@ -175,7 +175,7 @@ bool SchedulePerformer::IsScheduled(const std::shared_ptr<schedule_framework::Pr
         }
         context->preAllocatedSelectedFunctionAgentMap[scheReq->instance().instanceid()] = result.id;
         context->preAllocatedSelectedFunctionAgentSet.insert(result.id);
-        result.id = resourceInfo.resourceUnit.fragment().at(result.id).ownerid();
+        result.id = resourceInfo.resourceUnit->fragment().at(result.id).ownerid();
         return true;
     }
     auto alreadyScheduledResult = GetAlreadyScheduledResult(requestID, resourceInfo);
@@ -200,7 +200,7 @@ ScheduleResult SchedulePerformer::DoSelectOne(const std::shared_ptr<schedule_fra
     }
     ASSERT_IF_NULL(framework_);
     auto results = framework_->SelectFeasible(context, instanceItem->scheduleReq->instance(),
-                                              resourceInfo.resourceUnit, 1);
+                                              *resourceInfo.resourceUnit, 1);
     if (results.code != static_cast<int32_t>(StatusCode::SUCCESS)) {
         return ScheduleResult{ "", results.code, results.reason, {}, "", {} };
     }
@@ -279,7 +279,7 @@ ScheduleResult SchedulePerformer::SelectFromResults(
         // on local: ownerid() == real agent id
         // on domain: ownerid == localid
         result.unitID = result.id;
-        result.id = resourceInfo.resourceUnit.fragment().at(result.id).ownerid();
+        result.id = resourceInfo.resourceUnit->fragment().at(result.id).ownerid();
 
         PreAllocated(scheReq->instance(), context, requestID, traceID, result);
         return result;
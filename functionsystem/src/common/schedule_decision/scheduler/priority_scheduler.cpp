@@ -96,6 +96,16 @@ void PriorityScheduler::HandleResourceInfoUpdate(const resource_view::ResourceVi
     resourceInfo_ = resourceInfo;
     preContext_ = std::make_shared<schedule_framework::PreAllocatedContext>();
     preContext_->allLocalLabels = resourceInfo_.allLocalLabels;
+    // the snapshot is immutable, its matrix and label index are built once and shared by the rounds of the same version
+    if (resourceMatrix_ == nullptr || !resourceMatrix_->IsBuiltFrom(*resourceInfo_.resourceUnit)) {
+        resourceMatrix_ = std::make_shared<resource_view::ResourceMatrix>(resourceInfo_.resourceUnit);
+    }
+    if (labelIndex_ == nullptr || !labelIndex_->IsBuiltFrom(*resourceInfo_.resourceUnit)) {
+        labelIndex_ = std::make_shared<resource_view::LabelIndex>(resourceInfo_.resourceUnit);
+    }
+    preContext_->resourceMatrix = resourceMatrix_;
+    preContext_->labelIndex = labelIndex_;
+    preContext_->bucketShapeIndex = resourceInfo_.bucketShapeIndex;
 }
 
 void PriorityScheduler::ConsumeRunningQueue()
@@ -60,6 +60,8 @@ private:
     std::shared_ptr<ScheduleQueue> pendingQueue_;
     std::shared_ptr<schedule_framework::PreAllocatedContext> preContext_;
     resource_view::ResourceViewInfo resourceInfo_;
+    std::shared_ptr<const resource_view::ResourceMatrix> resourceMatrix_;
+    std::shared_ptr<const resource_view::LabelIndex> labelIndex_;
     std::shared_ptr<ScheduleRecorder> recorder_;
     int maxPriority_;
 };
@@ -23,6 +23,7 @@ namespace functionsystem::schedule_plugin {
 
 // prefilter name
 const std::string DEFAULT_PREFILTER_NAME = "DefaultPreFilter";
+const std::string BEST_FIT_PREFILTER_NAME = "BestFitPreFilter";
 
 // filter name
 const std::string DEFAULT_FILTER_NAME = "DefaultFilter";
@@ -21,6 +21,9 @@
 #include <unordered_map>
 
 #include "resource_type.h"
+#include "common/resource_view/bucket_shape_index.h"
+#include "common/resource_view/label_index.h"
+#include "common/resource_view/resource_matrix.h"
 #include "common/resource_view/resource_tool.h"
 #include "common/scheduler_framework/framework/framework.h"
 #include "constants.h"
@@ -106,10 +109,51 @@ struct PreAllocatedContext : public schedule_framework::ScheduleContext {
 
     ::google::protobuf::Map<std::string, resource_view::ValueCounter>* allLabels;
 
+    // dense resources of the view snapshot being scheduled, nullptr means the plugins read the protobuf view
+    std::shared_ptr<const resource_view::ResourceMatrix> resourceMatrix;
+    // fit of the request being scheduled against resourceMatrix, prepared by the prefilter
+    resource_view::ResourceFit resourceFit;
+
+    // shapes of the monopoly buckets of the view snapshot being scheduled, nullptr means the prefilter indexes them
+    std::shared_ptr<const resource_view::BucketShapeIndex> bucketShapeIndex;
+    // a monopoly request without a pod of its own shape is placed in the larger pod shape selected by the prefilter
+    std::string bestFitRequestID;
+    resource_view::BucketKeys bestFitKeys;
+
+    // node labels of the view snapshot being scheduled, nullptr means the label plugins read the protobuf view
+    std::shared_ptr<const resource_view::LabelIndex> labelIndex;
+    // resource affinity of the request being scheduled against labelIndex, prepared by the prefilter
+    resource_view::LabelFit labelFit;
+
     PreAllocatedContext() = default;
     ~PreAllocatedContext() override = default;
 };
 
+// row of the unit in the prepared fit of the instance, -1 if the plugin has to read the protobuf view instead. The units
+// pre-allocated in this round are always read from the protobuf view.
+inline int32_t FittedRow(const PreAllocatedContext &ctx, const resource_view::InstanceInfo &instance,
+                         const std::string &unitID)
+{
+    const auto &fit = ctx.resourceFit;
+    if (fit.matrix == nullptr || fit.requestID != instance.requestid()
+        || ctx.allocated.find(unitID) != ctx.allocated.end()) {
+        return -1;
+    }
+    return fit.matrix->Row(unitID);
+}
+
+// row of the unit in the prepared label fit of the instance, -1 if the plugin has to read the node labels of the unit
+// instead. Node labels do not change in a round, the pre-allocated units are read from the index as well.
+inline int32_t LabelFittedRow(const PreAllocatedContext &ctx, const resource_view::InstanceInfo &instance,
+                              const resource_view::ResourceUnit &unit)
+{
+    const auto &fit = ctx.labelFit;
+    if (fit.index == nullptr || fit.requestID != instance.requestid()) {
+        return -1;
+    }
+    return fit.index->Row(unit);
+}
+
 inline void ClearContext(::google::protobuf::Map<std::string, messages::PluginContext> &pluginCtx)
 {
     pluginCtx[LABEL_AFFINITY_PLUGIN].mutable_affinityctx()->mutable_scheduledresult()->clear();
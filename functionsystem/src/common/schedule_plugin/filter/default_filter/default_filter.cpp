@@ -56,8 +56,11 @@ Status DefaultFilter::MonopolyFilter(const std::shared_ptr<schedule_framework::P
     const auto &fragmentResources = unit.allocatable().resources();
     double fragmentMem = fragmentResources.at(resource_view::MEMORY_RESOURCE_NAME).scalar().value();
     double fragmentCpu = fragmentResources.at(resource_view::CPU_RESOURCE_NAME).scalar().value();
-    // monopoly need to be match precisely
-    if (abs(instanceMem - fragmentMem) > EPSINON || abs(instanceCpu - fragmentCpu) > EPSINON) {
+    // monopoly need to be match precisely, unless the pod is of the larger shape selected by the prefilter for the
+    // request
+    auto podKeys = resource_view::BucketKeys::Of(fragmentCpu, fragmentMem);
+    bool bestFit = preContext->bestFitRequestID == instance.requestid() && preContext->bestFitKeys == podKeys;
+    if (!bestFit && (abs(instanceMem - fragmentMem) > EPSINON || abs(instanceCpu - fragmentCpu) > EPSINON)) {
         return Status(RESOURCE_NOT_ENOUGH, "(" + std::to_string(static_cast<int>(instanceCpu)) + ", "
                                                + std::to_string(static_cast<int>(instanceMem))
                                                + ") Don't Match Precisely");
@@ -66,45 +69,83 @@ Status DefaultFilter::MonopolyFilter(const std::shared_ptr<schedule_framework::P
     if (abs(instanceCpu) < EPSINON) {
         return Status(INVALID_RESOURCE_PARAMETER, "Invalid CPU: " + std::to_string(instanceCpu));
     }
-    auto bucketIndexesIter(unit.bucketindexs().find(std::to_string(instanceMem / instanceCpu)));
-    if (bucketIndexesIter == unit.bucketindexs().end()) {
-        return Status(RESOURCE_NOT_ENOUGH, "(" + std::to_string(static_cast<int>(instanceCpu)) + ", "
-                                               + std::to_string(static_cast<int>(instanceMem)) + ") Not Found");
-    }
-    auto bucketsIter(bucketIndexesIter->second.buckets().find(std::to_string(fragmentMem)));
-    if (bucketsIter == bucketIndexesIter->second.buckets().end()) {
+    // the bucket of the pod is keyed by the resources of the pod
+    const auto *bucket = resource_view::BucketShapeIndex::Find(unit, podKeys);
+    if (bucket == nullptr) {
         return Status(RESOURCE_NOT_ENOUGH, "(" + std::to_string(static_cast<int>(instanceCpu)) + ", "
                                                + std::to_string(static_cast<int>(instanceMem)) + ") Not Found");
     }
 
     // if mono num is 0 in node, the set of feasible node is empty
-    if (bucketsIter->second.total().monopolynum() == 0) {
+    if (bucket->total().monopolynum() == 0) {
         return Status(RESOURCE_NOT_ENOUGH, "(" + std::to_string(static_cast<int>(instanceCpu)) + ", "
                                                + std::to_string(static_cast<int>(instanceMem)) + ") Not Enough");
     }
     return Status::OK();
 }
 
+std::string RequiredResource(const std::string &name, const resource_view::Resource &required)
+{
+    auto requestResource = name + ": " + std::to_string(static_cast<int>(required.scalar().value()));
+    if (auto iter = RESOURCE_UNIT.find(name); iter != RESOURCE_UNIT.end()) {
+        // add unit
+        requestResource += iter->second;
+    }
+    return requestResource;
+}
+
+schedule_framework::Filtered DefaultFilter::MatrixFilter(const resource_view::ResourceFit &fit, int32_t row,
+                                                         const resource_view::InstanceInfo &instance)
+{
+    const auto &required = instance.resources().resources();
+    if (fit.failure[row] != resource_view::FitFailure::NONE) {
+        const auto &name = fit.resources[fit.failedResource[row]];
+        auto requestResource = RequiredResource(name, required.at(name));
+        switch (fit.failure[row]) {
+            case resource_view::FitFailure::OUT_OF_CAPACITY:
+                return schedule_framework::Filtered{ Status(RESOURCE_NOT_ENOUGH, name + ": Out Of Capacity"), false,
+                                                     -1, std::move(requestResource) };
+            case resource_view::FitFailure::NOT_ENOUGH:
+                return schedule_framework::Filtered{ Status(RESOURCE_NOT_ENOUGH, name + ": Not Enough"), false, -1,
+                                                     std::move(requestResource) };
+            case resource_view::FitFailure::NOT_FOUND:
+            default:
+                return schedule_framework::Filtered{ Status(PARAMETER_ERROR, name + ": Not Found"), false, -1,
+                                                     std::move(requestResource) };
+        }
+    }
+    int32_t maxAllocatable = fit.maxAllocatable[row];
+    if (maxAllocatable == MAX_INT_32 || maxAllocatable <= 0) {
+        YRLOG_WARN("failed to calculate maxAllocatable Num");
+        maxAllocatable = 1;
+    }
+    return schedule_framework::Filtered{ Status::OK(), false, maxAllocatable };
+}
+
 schedule_framework::Filtered DefaultFilter::ResourceFilter(
     const std::shared_ptr<schedule_framework::PreAllocatedContext> &preContext,
     const resource_view::InstanceInfo &instance, const resource_view::ResourceUnit &unit)
 {
-    auto available = unit.allocatable();
+    if (auto row = schedule_framework::FittedRow(*preContext, instance, unit.id()); row >= 0) {
+        return MatrixFilter(preContext->resourceFit, row, instance);
+    }
+    const resource_view::Resources *available = &unit.allocatable();
+    resource_view::Resources remained;
     // calculate new available
     if (auto iter(preContext->allocated.find(unit.id())); iter != preContext->allocated.end()) {
-        available = unit.allocatable() - iter->second.resource;
-        if (!resource_view::IsValid(available)) {
+        remained = unit.allocatable() - iter->second.resource;
+        if (!resource_view::IsValid(remained)) {
             YRLOG_WARN("Invalid available resource, unit {}", unit.id());
             return schedule_framework::Filtered{ Status{ StatusCode::RESOURCE_NOT_ENOUGH, "No Resources Available" },
                                                  false, -1 };
         }
+        available = &remained;
     }
     const auto &required = instance.resources().resources();
     const auto &capacity = unit.capacity();
     int32_t maxAllocatable = MAX_INT_32;
     for (auto &req : required) {
-        auto resourceNameFields = litebus::strings::Split(req.first, "/");
-        if (resourceNameFields.size() == HETERO_RESOURCE_FIELD_NUM) {
+        if (resource_view::IsHeteroResourceName(req.first)) {
             continue;
         }
 
@@ -114,32 +155,27 @@ schedule_framework::Filtered DefaultFilter::ResourceFilter(
                         req.second.scalar().value(), unit.id());
             continue;
         }
-        auto requestResource = req.first + ": " + std::to_string(static_cast<int>(req.second.scalar().value()));
-        if (auto iter = RESOURCE_UNIT.find(req.first); iter != RESOURCE_UNIT.end()) {
-            // add unit
-            requestResource += iter->second;
-        }
         // Find the same type of resource as the request, like CPU and MEM.
         auto cap = capacity.resources().find(req.first);
         if (cap == capacity.resources().end()) {
             return schedule_framework::Filtered{ Status(PARAMETER_ERROR, req.first + ": Not Found"), false, -1,
-                                                 std::move(requestResource) };
+                                                 RequiredResource(req.first, req.second) };
         }
 
         if (req.second.scalar().value() > cap->second.scalar().value()) {
             return schedule_framework::Filtered{ Status(RESOURCE_NOT_ENOUGH, req.first + ": Out Of Capacity"), false,
-                                                 -1, std::move(requestResource) };
+                                                 -1, RequiredResource(req.first, req.second) };
         }
 
-        auto avail = available.resources().find(req.first);
-        if (avail == available.resources().end()) {
+        auto avail = available->resources().find(req.first);
+        if (avail == available->resources().end()) {
             return schedule_framework::Filtered{ Status(PARAMETER_ERROR, req.first + ": Not Found"), false, -1,
-                                                 std::move(requestResource) };
+                                                 RequiredResource(req.first, req.second) };
         }
         // available resources not meet requirements.
         if (!(req.second <= avail->second)) {
             return schedule_framework::Filtered{ Status(RESOURCE_NOT_ENOUGH, req.first + ": Not Enough"), false, -1,
-                                                 std::move(requestResource) };
+                                                 RequiredResource(req.first, req.second) };
         }
         auto availValue = avail->second.scalar().value();
         auto requireValue = req.second.scalar().value();
@@ -30,6 +30,10 @@ public:
     DefaultFilter() = default;
     ~DefaultFilter() override = default;
     std::string GetPluginName() override;
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &) override
+    {
+        return true;
+    }
 
     schedule_framework::Filtered Filter(const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
                                         const resource_view::InstanceInfo &instance,
@@ -38,6 +42,8 @@ public:
 private:
     static Status MonopolyFilter(const std::shared_ptr<schedule_framework::PreAllocatedContext> &preContext,
                                  const resource_view::InstanceInfo &instance, const resource_view::ResourceUnit &unit);
+    static schedule_framework::Filtered MatrixFilter(const resource_view::ResourceFit &fit, int32_t row,
+                                                     const resource_view::InstanceInfo &instance);
     static schedule_framework::Filtered ResourceFilter(
         const std::shared_ptr<schedule_framework::PreAllocatedContext> &preContext,
         const resource_view::InstanceInfo &instance, const resource_view::ResourceUnit &unit);
@@ -35,6 +35,10 @@ public:
     DefaultHeterogeneousFilter() = default;
     ~DefaultHeterogeneousFilter() override = default;
     std::string GetPluginName() override;
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &) override
+    {
+        return true;
+    }
 
     schedule_framework::Filtered Filter(const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
                                         const resource_view::InstanceInfo &instance,
@@ -298,6 +298,17 @@ bool IsResourceRequiredAffinityPassed(const std::string &unitID, const resource_
     return true;
 }
 
+bool IsResourceRequiredAffinityPassed(const resource_view::ResourceUnit &resourceUnit,
+                                      const resource_view::InstanceInfo &instance,
+                                      const schedule_framework::PreAllocatedContext &ctx)
+{
+    if (auto row = schedule_framework::LabelFittedRow(ctx, instance, resourceUnit); row >= 0) {
+        const auto &required = ctx.labelFit.required;
+        return required.empty() || resource_view::LabelIndex::Test(required, row);
+    }
+    return IsResourceRequiredAffinityPassed(resourceUnit.id(), instance, resourceUnit.nodelabels());
+}
+
 bool IsInnerResourceGroupRequiredAffinityPassed(
     const std::string &unitID, const resource_view::InstanceInfo &instance,
     const ::google::protobuf::Map<std::string, resource_view::ValueCounter> &labels)
@@ -418,8 +429,8 @@ bool LabelAffinityFilter::PerformLabelFilter(
                     instance.requestid(), instance.instanceid(), unitId, DebugProtoMapString(unitLabels));
         return false;
     }
-    // 2.Filter resource-related affinity
-    if (!IsResourceRequiredAffinityPassed(resourceUnit.id(), instance, resourceUnit.nodelabels())) {
+    // 2.Filter resource-related affinity, the units passing it are prepared by the prefilter from the label index
+    if (!IsResourceRequiredAffinityPassed(resourceUnit, instance, *ctx)) {
         YRLOG_DEBUG("{}|instance({}) agent({}) failed to perform resource affinity filtering. nodelabels({})",
                     instance.requestid(), instance.instanceid(), unitId,
                     DebugProtoMapString(resourceUnit.nodelabels()));
@@ -483,6 +494,11 @@ bool LabelAffinityFilter::PerformScoreOptimalityCheck(
     return true;
 }
 
+bool LabelAffinityFilter::IsConcurrencySafe(const resource_view::InstanceInfo &instance)
+{
+    return !NeedLabelFilter(instance) && !NeedAffinityScorer(instance);
+}
+
 schedule_framework::Filtered LabelAffinityFilter::Filter(
     const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
     const resource_view::InstanceInfo &instance,
@@ -498,6 +514,10 @@ schedule_framework::Filtered LabelAffinityFilter::Filter(
         result.status = Status(StatusCode::PARAMETER_ERROR, "Invalid context");
         return result;
     }
+    // nothing to filter, and the affinity context is only read for a request with label affinity
+    if (!NeedLabelFilter(instance) && !NeedAffinityScorer(instance)) {
+        return result;
+    }
 
     auto &pluginCtx = *preContext->pluginCtx;
     auto &affinityCtx = *pluginCtx[LABEL_AFFINITY_PLUGIN].mutable_affinityctx();
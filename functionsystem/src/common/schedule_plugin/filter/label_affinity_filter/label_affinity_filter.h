@@ -29,6 +29,8 @@ public:
         : isRelaxed_(isRelaxed), isRootDomainLevel_(isRootDomainLevel) {}
     ~LabelAffinityFilter() override = default;
     std::string GetPluginName() override;
+    // only a request with label affinity writes the affinity context of the round, and in the order of the units
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &instance) override;
 
     schedule_framework::Filtered Filter(
         const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
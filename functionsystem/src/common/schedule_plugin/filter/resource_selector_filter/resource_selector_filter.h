@@ -30,6 +30,10 @@ public:
     ResourceSelectorFilter() = default;
     ~ResourceSelectorFilter() override = default;
     std::string GetPluginName() override;
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &) override
+    {
+        return true;
+    }
 
     schedule_framework::Filtered Filter(const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
                                         const resource_view::InstanceInfo &instance,
@@ -16,6 +16,7 @@
 
 #include "default_prefilter.h"
 
+#include "common/resource_view/scala_resource_tool.h"
 #include "common/schedule_plugin/common/plugin_register.h"
 
 namespace functionsystem::schedule_plugin::prefilter {
@@ -57,6 +58,16 @@ std::shared_ptr<schedule_framework::PreFilterResult> DefaultPreFilter::PreFilter
     YRLOG_DEBUG("(schedule)request({}) of instance({}), mem: {}, cpu: {}", inst.requestID, inst.instanceID, inst.memVal,
                 inst.cpuVal);
 
+    // the resource filter and scorer read the fit of the request from the matrix instead of the protobuf view
+    const auto &matrix = preContext->resourceMatrix;
+    preContext->resourceFit = inst.policy != MONOPOLY_MODE && matrix != nullptr && matrix->IsBuiltFrom(resourceUnit)
+                                  ? matrix->Fit(instance)
+                                  : resource_view::ResourceFit{};
+    // the label affinity filter and scorer read the resource affinity of the request from the label index
+    const auto &labelIndex = preContext->labelIndex;
+    preContext->labelFit = labelIndex != nullptr && labelIndex->IsBuiltFrom(resourceUnit) ? labelIndex->Fit(instance)
+                                                                                          : resource_view::LabelFit{};
+
     if (inst.policy == MONOPOLY_MODE) {
         // find proportion from fragment index. if proportion exist and the memory meets the requirement,
         // the bucket is directly selected.
@@ -75,49 +86,61 @@ std::shared_ptr<schedule_framework::PreFilterResult> DefaultPreFilter::PrecisePr
         return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
             resourceUnit.fragment(), Status{ StatusCode::RESOURCE_NOT_ENOUGH, "No Resource In Cluster" });
     }
-    const auto &bucketIndexes(resourceUnit.bucketindexs());
-
     if (abs(inst.cpuVal) < EPSINON) {
         std::string errMsg = "Invalid CPU: " + std::to_string(inst.cpuVal);
         return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
             resourceUnit.fragment(), Status{ StatusCode::INVALID_RESOURCE_PARAMETER, errMsg });
     }
-    auto proportionStr = std::to_string(inst.memVal / inst.cpuVal);
-    auto bucketIndexesIter(bucketIndexes.find(proportionStr));
-    if (bucketIndexesIter == bucketIndexes.end()) {
-        YRLOG_WARN("{}|(schedule)the proportion({}) of instance({}) isn't found", inst.requestID, proportionStr,
-                   inst.instanceID);
-        std::string errMsg = "(" + std::to_string(static_cast<int>(inst.cpuVal)) + ", "
-                             + std::to_string(static_cast<int>(inst.memVal)) + ") Not Found";
-        return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
-            resourceUnit.fragment(), Status{ StatusCode::RESOURCE_NOT_ENOUGH, errMsg });
+    // the bucket of the shape of the instance is keyed as the resource view formats the resources of its pods
+    const auto *bucket =
+        resource_view::BucketShapeIndex::Find(resourceUnit, resource_view::BucketKeys::Of(inst.cpuVal, inst.memVal));
+    if (bucket != nullptr && bucket->total().monopolynum() > 0) {
+        YRLOG_DEBUG("{}|(schedule)|instance({}) exact match success", inst.requestID, inst.instanceID);
+        return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::BucketInfo>>(
+            bucket->allocatable(), Status::OK());
     }
-    const auto &buckets(bucketIndexesIter->second.buckets());
-    auto memIndex = std::to_string(inst.memVal);
-    auto bucketsIter(buckets.find(memIndex));
-    if (bucketsIter == buckets.end()) {
-        YRLOG_WARN("{}|(schedule)the mem({}) of instance({}) isn't found", inst.requestID, std::to_string(inst.memVal),
-                   inst.instanceID);
-        std::string errMsg = "(" + std::to_string(static_cast<int>(inst.cpuVal)) + ", "
-                             + std::to_string(static_cast<int>(inst.memVal)) + ") Not Found";
-        return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
-            resourceUnit.fragment(), Status{ StatusCode::RESOURCE_NOT_ENOUGH, errMsg });
+
+    // no pod of the shape of the instance is left, the smallest larger pod is taken instead
+    resource_view::BucketKeys bestFitKeys;
+    if (const auto *bestFit = monopolyBestFit_ ? BestFit(ctx, resourceUnit, inst, bestFitKeys) : nullptr;
+        bestFit != nullptr) {
+        YRLOG_DEBUG("{}|(schedule)|instance({}) best fit pod of proportion({}) mem({})", inst.requestID,
+                    inst.instanceID, bestFitKeys.proportion, bestFitKeys.mem);
+        ctx->bestFitRequestID = inst.requestID;
+        ctx->bestFitKeys = bestFitKeys;
+        return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::BucketInfo>>(
+            bestFit->allocatable(), Status::OK());
     }
 
-    YRLOG_DEBUG("{}|(schedule)|instance({}) exact match success", inst.requestID, inst.instanceID);
-    // if mono num is 0 in node, the set of feasible node is empty
-    const auto &total(bucketsIter->second.total());
-    if (total.monopolynum() == 0) {
-        YRLOG_WARN("{}|(schedule)the num of pod([{}, {}]) required by the instance({}) is 0", inst.requestID,
-                   inst.memVal, inst.cpuVal, inst.instanceID);
+    if (bucket == nullptr) {
+        YRLOG_WARN("{}|(schedule)the pod([{}, {}]) of instance({}) isn't found", inst.requestID, inst.memVal,
+                   inst.cpuVal, inst.instanceID);
         std::string errMsg = "(" + std::to_string(static_cast<int>(inst.cpuVal)) + ", "
-                             + std::to_string(static_cast<int>(inst.memVal)) + ") Not Enough";
+                             + std::to_string(static_cast<int>(inst.memVal)) + ") Not Found";
         return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
             resourceUnit.fragment(), Status{ StatusCode::RESOURCE_NOT_ENOUGH, errMsg });
     }
+    // if mono num is 0 in node, the set of feasible node is empty
+    YRLOG_WARN("{}|(schedule)the num of pod([{}, {}]) required by the instance({}) is 0", inst.requestID, inst.memVal,
+               inst.cpuVal, inst.instanceID);
+    std::string errMsg = "(" + std::to_string(static_cast<int>(inst.cpuVal)) + ", "
+                         + std::to_string(static_cast<int>(inst.memVal)) + ") Not Enough";
+    return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::ResourceUnit>>(
+        resourceUnit.fragment(), Status{ StatusCode::RESOURCE_NOT_ENOUGH, errMsg });
+}
 
-    return std::make_shared<schedule_framework::ProtoMapPreFilterResult<resource_view::BucketInfo>>(
-        bucketsIter->second.allocatable(), Status::OK());
+const resource_view::Bucket *DefaultPreFilter::BestFit(
+    const std::shared_ptr<schedule_framework::PreAllocatedContext> &ctx,
+    const resource_view::ResourceUnit &resourceUnit, const InstanceInfo &inst, resource_view::BucketKeys &found)
+{
+    // the index of the snapshot is maintained by the resource view, a context without it indexes the unit here
+    if (ctx->bucketShapeIndex != nullptr) {
+        return ctx->bucketShapeIndex->BestFit(resourceUnit, resource_view::BucketShape::Of(inst.cpuVal, inst.memVal),
+                                              found);
+    }
+    resource_view::BucketShapeIndex unitIndex;
+    (void)unitIndex.Update(resourceUnit);
+    return unitIndex.BestFit(resourceUnit, resource_view::BucketShape::Of(inst.cpuVal, inst.memVal), found);
 }
 
 std::shared_ptr<schedule_framework::PreFilterResult> DefaultPreFilter::CommonPreFilter(
@@ -139,6 +162,13 @@ std::shared_ptr<schedule_framework::SchedulePolicyPlugin> DefaultPreFilterCreato
     return std::make_shared<DefaultPreFilter>();
 }
 
+std::shared_ptr<schedule_framework::SchedulePolicyPlugin> BestFitPreFilterCreator()
+{
+    bool monopolyBestFit = true;
+    return std::make_shared<DefaultPreFilter>(monopolyBestFit);
+}
+
 REGISTER_SCHEDULER_PLUGIN(DEFAULT_PREFILTER_NAME, DefaultPreFilterCreator);
+REGISTER_SCHEDULER_PLUGIN(BEST_FIT_PREFILTER_NAME, BestFitPreFilterCreator);
 
 }  // namespace functionsystem::schedule_plugin::prefilter
\ No newline at end of file
@@ -41,11 +41,15 @@ struct InstanceInfo {
 
 class DefaultPreFilter : public schedule_framework::PreFilterPlugin {
 public:
-    DefaultPreFilter() = default;
+    // a monopoly request is placed in pods of exactly its shape, with monopolyBestFit in the smallest larger pods
+    // when none of its shape is left
+    explicit DefaultPreFilter(bool monopolyBestFit = false) : monopolyBestFit_(monopolyBestFit)
+    {
+    }
     ~DefaultPreFilter() override = default;
     std::string GetPluginName() override
     {
-        return DEFAULT_PREFILTER_NAME;
+        return monopolyBestFit_ ? BEST_FIT_PREFILTER_NAME : DEFAULT_PREFILTER_NAME;
     }
     std::shared_ptr<schedule_framework::PreFilterResult> PreFilter(
         const std::shared_ptr<schedule_framework::ScheduleContext> &ctx, const resource_view::InstanceInfo &instance,
@@ -56,9 +60,15 @@ private:
         const std::shared_ptr<schedule_framework::PreAllocatedContext> &ctx,
         const resource_view::ResourceUnit &resourceUnit, const InstanceInfo &inst) const;
 
+    static const resource_view::Bucket *BestFit(const std::shared_ptr<schedule_framework::PreAllocatedContext> &ctx,
+                                                const resource_view::ResourceUnit &resourceUnit,
+                                                const InstanceInfo &inst, resource_view::BucketKeys &found);
+
     std::shared_ptr<schedule_framework::PreFilterResult> CommonPreFilter(
         const std::shared_ptr<schedule_framework::PreAllocatedContext> &ctx,
         const resource_view::ResourceUnit &resourceUnit, const InstanceInfo &inst) const;
+
+    bool monopolyBestFit_;
 };
 }  // namespace functionsystem::schedule_plugin::prefilter
 
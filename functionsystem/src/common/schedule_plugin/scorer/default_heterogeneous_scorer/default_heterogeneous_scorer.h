@@ -35,6 +35,10 @@ public:
     DefaultHeterogeneousScorer() = default;
     ~DefaultHeterogeneousScorer() override = default;
     std::string GetPluginName() override;
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &) override
+    {
+        return true;
+    }
 
     schedule_framework::NodeScore Score(const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
                                         const resource_view::InstanceInfo &instance,
@@ -34,10 +34,15 @@ schedule_framework::NodeScore DefaultScorer::Score(const std::shared_ptr<schedul
                                                    const resource_view::InstanceInfo &instance,
                                                    const resource_view::ResourceUnit &resourceUnit)
 {
-    auto available = resourceUnit.allocatable();
     const auto preContext = std::dynamic_pointer_cast<schedule_framework::PreAllocatedContext>(ctx);
+    if (auto row = schedule_framework::FittedRow(*preContext, instance, resourceUnit.id()); row >= 0) {
+        return schedule_framework::NodeScore(preContext->resourceFit.score[row]);
+    }
+    const resource_view::Resources *available = &resourceUnit.allocatable();
+    resource_view::Resources remained;
     if (auto iter(preContext->allocated.find(resourceUnit.id())); iter != preContext->allocated.end()) {
-        available = resourceUnit.allocatable() - iter->second.resource;
+        remained = resourceUnit.allocatable() - iter->second.resource;
+        available = &remained;
     }
 
     const auto &required = instance.resources().resources();
@@ -45,8 +50,7 @@ schedule_framework::NodeScore DefaultScorer::Score(const std::shared_ptr<schedul
     int64_t accumulated = 0;
     for (auto &req : required) {
         // hetero resource score in hetero scorer
-        auto resourceNameFields = litebus::strings::Split(req.first, "/");
-        if (resourceNameFields.size() == HETERO_RESOURCE_FIELD_NUM) {
+        if (resource_view::IsHeteroResourceName(req.first)) {
             continue;
         }
         // required number is zero don't need to score
@@ -56,8 +60,8 @@ schedule_framework::NodeScore DefaultScorer::Score(const std::shared_ptr<schedul
 
         // if a pod is scoring, it must have request resource,
         // if it doesn't have, it is a monopoly instance, we don't verify other resources except CPU and MEM
-        auto avail = available.resources().find(req.first);
-        if (avail == available.resources().end()) {
+        auto avail = available->resources().find(req.first);
+        if (avail == available->resources().end()) {
             YRLOG_WARN("{} not find in agent resources", req.first);
             continue;
         }
@@ -237,13 +237,23 @@ int64_t LabelAffinityScorer::CalculatePreferredScore(
     }
 
     // 2.calculate resource-related affinity score
-    totalScore += CalculateResourceAffinityScore(unitId, instance, resourceUnit.nodelabels());
+    if (auto row = schedule_framework::LabelFittedRow(*preContext, instance, resourceUnit); row >= 0) {
+        const auto &score = preContext->labelFit.score;
+        totalScore += score.empty() ? 0 : score[row];
+    } else {
+        totalScore += CalculateResourceAffinityScore(unitId, instance, resourceUnit.nodelabels());
+    }
 
     // 3.calculate inner-related affinity score
     totalScore += CalculateInnerAffinityScore(resourceUnit, instance, preContext);
     return totalScore;
 }
 
+bool LabelAffinityScorer::IsConcurrencySafe(const resource_view::InstanceInfo &instance)
+{
+    return !NeedAffinityScorer(instance);
+}
+
 schedule_framework::NodeScore LabelAffinityScorer::Score(
     const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
     const resource_view::InstanceInfo &instance,
@@ -28,6 +28,8 @@ public:
     explicit LabelAffinityScorer(bool isRelaxed): isRelaxed_(isRelaxed) {}
     ~LabelAffinityScorer() override = default;
     std::string GetPluginName() override;
+    // only a request with label affinity reads the affinity context of the round
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &instance) override;
 
     schedule_framework::NodeScore Score(const std::shared_ptr<schedule_framework::ScheduleContext> &ctx,
                                         const resource_view::InstanceInfo &instance,
@@ -16,6 +16,7 @@
 
 #include "framework_impl.h"
 
+#include <limits>
 #include <string>
 
 #include "async/try.hpp"
@@ -64,6 +65,9 @@ struct AggregatedStatus {
     }
 };
 
+// the candidates evaluated by one thread of the worker pool in a batch
+const size_t PARALLEL_CHUNK_SIZE = 64;
+
 static std::unordered_map<std::string, double> g_scoreWeights = {
     {schedule_plugin::DEFAULT_SCORER_NAME, 1.0},
     {schedule_plugin::DEFAULT_HETEROGENEOUS_SCORER_NAME, 1.0},
@@ -72,6 +76,13 @@ static std::unordered_map<std::string, double> g_scoreWeights = {
     {schedule_plugin::STRICT_LABEL_AFFINITY_SCORER_NAME, 100.0},
 };
 
+FrameworkImpl::FrameworkImpl(int32_t relaxed, int32_t parallelism) : Framework(), relaxed_(relaxed)
+{
+    if (parallelism > 1) {
+        workerPool_ = std::make_unique<WorkerPool>(static_cast<size_t>(parallelism - 1));
+    }
+}
+
 bool FrameworkImpl::RegisterPolicy(const std::shared_ptr<SchedulePolicyPlugin> &plugin)
 {
     auto ret = plugins_[plugin->GetPluginType()].emplace(plugin->GetPluginName(), plugin);
@@ -130,35 +141,47 @@ ScheduleResults FrameworkImpl::SelectFeasible(const std::shared_ptr<ScheduleCont
     std::priority_queue<NodeScore> sortedFeasibleNodes;
     AggregatedStatus aggregate;
     prefiltered->reset(latelySelected);
-    for (; !prefiltered->end() && !IsReachRelaxed(sortedFeasibleNodes, expectedFeasible); prefiltered->next()) {
-        auto &cur = prefiltered->current();
-        auto iter = resourceUnit.fragment().find(cur);
-        if (iter == resourceUnit.fragment().end()) {
-            continue;
+    bool parallel = workerPool_ != nullptr && IsConcurrencySafe(instance);
+    size_t batchSize = parallel ? workerPool_->Parallelism() * PARALLEL_CHUNK_SIZE : 1;
+    std::vector<Candidate> batch;
+    batch.reserve(batchSize);
+    while (!prefiltered->end() && !IsReachRelaxed(sortedFeasibleNodes, expectedFeasible)) {
+        batch.clear();
+        for (; !prefiltered->end() && batch.size() < batchSize; prefiltered->next()) {
+            auto iter = resourceUnit.fragment().find(prefiltered->current());
+            if (iter == resourceUnit.fragment().end()) {
+                continue;
+            }
+            batch.push_back(Candidate{ &iter->second });
         }
-        const auto &unit = iter->second;
-        if (unit.status() != static_cast<uint32_t>(resource_view::UnitStatus::NORMAL)) {
-            std::string statusDesc =
-                UNIT_STATUS.find(unit.status()) != UNIT_STATUS.end() ? UNIT_STATUS.at(unit.status()) : "Unknown";
-            YRLOG_WARN("the status of resource unit {} is {}, unavailable to schedule", unit.id(), statusDesc);
-            aggregate.Insert(Status(StatusCode::RESOURCE_NOT_ENOUGH,
-                                    "unavailable to schedule, the status of resource unit is " + statusDesc), "");
-            continue;
+        if (parallel) {
+            auto limit = relaxed_ <= 0 ? std::numeric_limits<size_t>::max()
+                                       : std::max(static_cast<size_t>(relaxed_), static_cast<size_t>(expectedFeasible))
+                                             - sortedFeasibleNodes.size();
+            EvaluateParallel(ctx, instance, batch, limit);
         }
-        auto filterStatus = Filter(ctx, instance, unit);
-        if (filterStatus.status.IsError()) {
-            if (filterStatus.isFatalErr) {
-                return ScheduleResults{ static_cast<int32_t>(filterStatus.status.StatusCode()),
-                                        filterStatus.status.RawMessage(),
-                                        {} };
+        // merged in the order of the prefilter, the results are the same as evaluating the units one by one
+        for (auto &candidate : batch) {
+            if (IsReachRelaxed(sortedFeasibleNodes, expectedFeasible)) {
+                break;
             }
-            aggregate.Insert(filterStatus.status, std::move(filterStatus.required));
-            continue;
+            if (!candidate.evaluated) {
+                Evaluate(ctx, instance, candidate);
+            }
+            auto &filterStatus = candidate.filterStatus;
+            if (filterStatus.status.IsError()) {
+                if (filterStatus.isFatalErr) {
+                    return ScheduleResults{ static_cast<int32_t>(filterStatus.status.StatusCode()),
+                                            filterStatus.status.RawMessage(),
+                                            {} };
+                }
+                aggregate.Insert(filterStatus.status, std::move(filterStatus.required));
+                continue;
+            }
+            candidate.score.availableForRequest = filterStatus.availableForRequest;
+            sortedFeasibleNodes.push(std::move(candidate.score));
+            latelySelected = candidate.unit->id();
         }
-        auto score = Score(ctx, instance, unit);
-        score.availableForRequest = filterStatus.availableForRequest;
-        sortedFeasibleNodes.push(score);
-        latelySelected = unit.id();
     }
     if (sortedFeasibleNodes.empty()) {
         auto reason = aggregate.Dump("no available resource that meets the request requirements");
@@ -168,6 +191,65 @@ ScheduleResults FrameworkImpl::SelectFeasible(const std::shared_ptr<ScheduleCont
     return ScheduleResults{ static_cast<int32_t>(StatusCode::SUCCESS), "", std::move(sortedFeasibleNodes) };
 }
 
+void FrameworkImpl::Evaluate(const std::shared_ptr<ScheduleContext> &ctx, const InstanceInfo &instance,
+                             Candidate &candidate)
+{
+    const auto &unit = *candidate.unit;
+    candidate.evaluated = true;
+    if (unit.status() != static_cast<uint32_t>(resource_view::UnitStatus::NORMAL)) {
+        std::string statusDesc =
+            UNIT_STATUS.find(unit.status()) != UNIT_STATUS.end() ? UNIT_STATUS.at(unit.status()) : "Unknown";
+        YRLOG_WARN("the status of resource unit {} is {}, unavailable to schedule", unit.id(), statusDesc);
+        candidate.filterStatus = FilterStatus{
+            Status(StatusCode::RESOURCE_NOT_ENOUGH, "unavailable to schedule, the status of resource unit is " +
+                   statusDesc)
+        };
+        return;
+    }
+    candidate.filterStatus = Filter(ctx, instance, unit);
+    if (candidate.filterStatus.status.IsError()) {
+        return;
+    }
+    candidate.score = Score(ctx, instance, unit);
+}
+
+void FrameworkImpl::EvaluateParallel(const std::shared_ptr<ScheduleContext> &ctx, const InstanceInfo &instance,
+                                     std::vector<Candidate> &batch, size_t limit)
+{
+    if (batch.empty()) {
+        return;
+    }
+    auto chunks = std::min(workerPool_->Parallelism(), batch.size());
+    auto chunkSize = (batch.size() + chunks - 1) / chunks;
+    workerPool_->ParallelFor(chunks, [this, &ctx, &instance, &batch, chunkSize, limit](size_t chunk) {
+        size_t feasible = 0;
+        auto end = std::min(batch.size(), (chunk + 1) * chunkSize);
+        for (auto i = chunk * chunkSize; i < end; ++i) {
+            Evaluate(ctx, instance, batch[i]);
+            const auto &filterStatus = batch[i].filterStatus;
+            if (filterStatus.status.IsOk() ? ++feasible >= limit : filterStatus.isFatalErr) {
+                return;
+            }
+        }
+    });
+}
+
+bool FrameworkImpl::IsConcurrencySafe(const InstanceInfo &instance)
+{
+    for (auto type : { PolicyType::FILTER_POLICY, PolicyType::SCORE_POLICY }) {
+        auto policy = plugins_.find(type);
+        if (policy == plugins_.end()) {
+            continue;
+        }
+        for (const auto &plugin : policy->second) {
+            if (!plugin.second->IsConcurrencySafe(instance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 std::shared_ptr<PreFilterResult> FrameworkImpl::PreFilter(const std::shared_ptr<ScheduleContext> &ctx,
                                                           const InstanceInfo &instance,
                                                           const ResourceUnit &resourceUnit)
@@ -235,7 +317,9 @@ NodeScore FrameworkImpl::Score(const std::shared_ptr<ScheduleContext> &ctx, cons
     for (auto it = policy->second.begin(); it != policy->second.end(); ++it) {
         auto plugin = std::dynamic_pointer_cast<ScorePlugin>(it->second);
         auto pluginScore = plugin->Score(ctx, instance, resourceUnit);
-        pluginScore.score = pluginScore.score * scorePluginWeight[plugin->GetPluginName()];
+        // read only, the units of a request may be scored concurrently
+        auto weight = scorePluginWeight.find(it->first);
+        pluginScore.score = pluginScore.score * (weight == scorePluginWeight.end() ? 1.0 : weight->second);
         result += pluginScore;
         if (!pluginScore.heteroProductName.empty()) {
             result.heteroProductName = pluginScore.heteroProductName;
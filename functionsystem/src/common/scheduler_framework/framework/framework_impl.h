@@ -16,12 +16,15 @@
 #ifndef SCHEDULER_FRAMEWORK_IMPL_H
 #define SCHEDULER_FRAMEWORK_IMPL_H
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "resource_type.h"
 #include "common/scheduler_framework/framework/framework.h"
 #include "common/scheduler_framework/framework/policy.h"
+#include "common/scheduler_framework/utils/worker_pool.h"
 #include "status/status.h"
 
 namespace functionsystem::schedule_framework {
@@ -29,6 +32,9 @@ class FrameworkImpl : public Framework {
 public:
     FrameworkImpl() = default;
     explicit FrameworkImpl(int32_t relaxed) : Framework(), relaxed_(relaxed) {}
+    // while parallelism > 1, the units of a request are filtered and scored by up to parallelism threads if all the
+    // filter and score plugins are concurrency safe
+    FrameworkImpl(int32_t relaxed, int32_t parallelism);
     ~FrameworkImpl() override = default;
     bool RegisterPolicy(const std::shared_ptr<SchedulePolicyPlugin> &plugin) override;
     bool UnRegisterPolicy(const std::string &name) override;
@@ -55,6 +61,23 @@ private:
     NodeScore Score(const std::shared_ptr<ScheduleContext> &ctx, const resource_view::InstanceInfo &instance,
                   const resource_view::ResourceUnit &resourceUnit);
 
+    struct Candidate {
+        const resource_view::ResourceUnit *unit{ nullptr };
+        bool evaluated{ false };
+        FilterStatus filterStatus;
+        NodeScore score{ 0 };
+    };
+    // checks the status of the unit, then filters and scores it
+    void Evaluate(const std::shared_ptr<ScheduleContext> &ctx, const resource_view::InstanceInfo &instance,
+                  Candidate &candidate);
+
+    // evaluates a batch of candidates on the worker pool, the batch is split into contiguous chunks and a chunk stops
+    // after limit feasible units or a fatal error, where the serial loop would have stopped too
+    void EvaluateParallel(const std::shared_ptr<ScheduleContext> &ctx, const resource_view::InstanceInfo &instance,
+                          std::vector<Candidate> &batch, size_t limit);
+
+    bool IsConcurrencySafe(const resource_view::InstanceInfo &instance);
+
     bool IsReachRelaxed(const std::priority_queue<NodeScore> &feasible, uint32_t expectedFeasible) const;
 
     std::unordered_map<std::string, double> scorePluginWeight;
@@ -62,6 +85,7 @@ private:
     std::unordered_map<PolicyType, Plugins> plugins_;
     std::string latelySelected;
     int32_t relaxed_ = -1;
+    std::unique_ptr<WorkerPool> workerPool_;
 };
 }  // namespace functionsystem::schedule_framework
 #endif  // SCHEDULER_FRAMEWORK_IMPL_H
@@ -53,6 +53,12 @@ public:
     virtual ~SchedulePolicyPlugin() = default;
     virtual std::string GetPluginName() = 0;
     virtual PolicyType GetPluginType() = 0;
+    // true if filtering or scoring the instance only reads the context and the unit, the framework is then allowed to
+    // evaluate the units of the request concurrently
+    virtual bool IsConcurrencySafe(const resource_view::InstanceInfo &instance)
+    {
+        return false;
+    }
 };
 
 class PreFilterResult {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "worker_pool.h"
+
+namespace functionsystem::schedule_framework {
+
+WorkerPool::WorkerPool(size_t workers)
+{
+    threads_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back(&WorkerPool::Work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)> &task)
+{
+    std::lock_guard<std::mutex> run(runMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_ = 0;
+        pending_ = count;
+        generation_++;
+    }
+    wakeup_.notify_all();
+    RunTasks();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    // a worker waking up late must not see the task of a returned call
+    task_ = nullptr;
+}
+
+void WorkerPool::Work()
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock, [this, &seen] { return stopped_ || generation_ != seen; });
+            if (stopped_) {
+                return;
+            }
+            seen = generation_;
+        }
+        RunTasks();
+    }
+}
+
+void WorkerPool::RunTasks()
+{
+    while (true) {
+        const std::function<void(size_t)> *task = nullptr;
+        size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (task_ == nullptr || next_ >= count_) {
+                return;
+            }
+            task = task_;
+            index = next_++;
+        }
+        (*task)(index);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            done_.notify_all();
+        }
+    }
+}
+
+}  // namespace functionsystem::schedule_framework
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_SCHEDULER_FRAMEWORK_UTILS_WORKER_POOL_H
+#define COMMON_SCHEDULER_FRAMEWORK_UTILS_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace functionsystem::schedule_framework {
+
+/**
+ * A fixed number of threads running the tasks of one ParallelFor at a time. The calling thread takes part in the
+ * tasks too, so that a pool of n threads runs n + 1 tasks at once.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // the number of tasks run at once
+    size_t Parallelism() const
+    {
+        return threads_.size() + 1;
+    }
+
+    // runs task(0) ... task(count - 1), returns after all of them are done
+    void ParallelFor(size_t count, const std::function<void(size_t)> &task);
+
+private:
+    void Work();
+    void RunTasks();
+
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable done_;
+    const std::function<void(size_t)> *task_{ nullptr };
+    size_t count_{ 0 };
+    size_t next_{ 0 };
+    size_t pending_{ 0 };
+    uint64_t generation_{ 0 };
+    bool stopped_{ false };
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace functionsystem::schedule_framework
+
+#endif  // COMMON_SCHEDULER_FRAMEWORK_UTILS_WORKER_POOL_H
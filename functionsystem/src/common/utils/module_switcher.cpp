@@ -94,6 +94,9 @@ void ModuleSwitcher::InitMetrics(const bool enable, const std::string &config, c
             auto confJson = nlohmann::json::parse(config);
             functionsystem::metrics::MetricsAdapter::GetInstance().InitMetricsFromJson(
                 confJson, [this](std::string backendName) { return GetMetricsFilesName(backendName); }, sslCertConfig);
+            functionsystem::metrics::MetricsAdapter::GetInstance().RegisterLitebusWorkerMetrics();
+            functionsystem::metrics::MetricsAdapter::GetInstance().RegisterLitebusActorMetrics();
+            functionsystem::metrics::MetricsAdapter::GetInstance().RegisterMetaStoreCacheMetrics();
             return;
         } catch (nlohmann::detail::parse_error &e) {
             YRLOG_ERROR("parse config json failed, error: {}", e.what());
@@ -113,6 +116,9 @@ void ModuleSwitcher::InitMetrics(const bool enable, const std::string &config, c
         nlohmann::json confJson = nlohmann::json::parse(f);
         metrics::MetricsAdapter::GetInstance().InitMetricsFromJson(
             confJson, [this](std::string backendName) { return GetMetricsFilesName(backendName); }, sslCertConfig);
+        metrics::MetricsAdapter::GetInstance().RegisterLitebusWorkerMetrics();
+        metrics::MetricsAdapter::GetInstance().RegisterLitebusActorMetrics();
+        metrics::MetricsAdapter::GetInstance().RegisterMetaStoreCacheMetrics();
     } catch (nlohmann::detail::parse_error &e) {
         YRLOG_ERROR("parse config file failed, error: {}", e.what());
     } catch (std::exception &e) {
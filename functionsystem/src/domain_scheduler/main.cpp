@@ -35,6 +35,7 @@
 #include "ssl_config.h"
 #include "domain_scheduler/include/structure.h"
 #include "meta_store_client/meta_store_struct.h"
+#include "metadata/metadata.h"
 
 using namespace functionsystem;
 namespace {
@@ -73,6 +74,10 @@ void OnCreate(const domain_scheduler::Flags &flags)
     metaStoreConfig.etcdAddress = flags.GetMetaStoreAddress();
     metaStoreConfig.etcdTablePrefix = flags.GetETCDTablePrefix();
     metaStoreConfig.excludedKeys = flags.GetMetaStoreExcludedKeys();
+    metaStoreConfig.readCachePrefixes = flags.GetMetaStoreReadCachePrefixes();
+    metaStoreConfig.writeCoalesceWindowMs = flags.GetMetaStoreWriteCoalesceWindowMs();
+    metaStoreConfig.writeCoalesceMaxBatchSize = flags.GetMetaStoreWriteCoalesceMaxBatchSize();
+    SetMetadataWriteEncoding(flags.GetMetadataBinaryEncoding() ? MetadataEncoding::BINARY : MetadataEncoding::JSON);
     // standalone domain never enable metastore
     auto metaClient = MetaStoreClient::Create(metaStoreConfig, GetGrpcSSLConfig(flags), option, true, monitorParam);
     if (metaClient == nullptr) {
@@ -100,6 +105,7 @@ void OnCreate(const domain_scheduler::Flags &flags)
 	param.enablePreemption = flags.GetEnablePreemption();
 	param.relaxed = flags.GetScheduleRelaxed();
     param.aggregatedStrategy = flags.GetAggregatedStrategy();
+    param.parallelism = flags.GetScheduleParallelism();
     domainSchedulerDriver_ = std::make_shared<domain_scheduler::DomainSchedulerLauncher>(param);
     if (auto status = domainSchedulerDriver_->Start(); status.IsError()) {
         YRLOG_ERROR("failed to start {}, errMsg: {}", COMPONENT_NAME, status.ToString());
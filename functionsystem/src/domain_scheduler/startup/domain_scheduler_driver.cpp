@@ -62,7 +62,7 @@ std::shared_ptr<schedule_decision::ScheduleQueueActor> DomainSchedulerDriver::Cr
     const std::shared_ptr<resource_view::ResourceView> resourceView)
 {
     auto scheduleQueueActor = std::make_shared<schedule_decision::ScheduleQueueActor>(param_.identity + tag);
-    auto framework = std::make_shared<schedule_framework::FrameworkImpl>(param_.relaxed);
+    auto framework = std::make_shared<schedule_framework::FrameworkImpl>(param_.relaxed, param_.parallelism);
     auto policyType = schedule_decision::PriorityPolicyType::FIFO;
     schedule_decision::PreemptInstancesFunc preemptCallbackFunc;
     if (param_.maxPriority > 0 && param_.enablePreemption) {
@@ -97,9 +97,11 @@ Status DomainSchedulerDriver::Start()
     }
     YRLOG_INFO(
         "start domain scheduler, identity:{} isScheduleTolerateAbnormal:{} heartbeatTimeoutMs:{} "
-        "pullResourceInterval:{} enableMetrics:{} enablePrintResourceView:{} maxPriority:{} aggregatedStrategy:{}",
+        "pullResourceInterval:{} enableMetrics:{} enablePrintResourceView:{} maxPriority:{} aggregatedStrategy:{} "
+        "parallelism:{}",
         param_.identity, param_.isScheduleTolerateAbnormal, param_.heartbeatTimeoutMs, param_.pullResourceInterval,
-        param_.enableMetrics, param_.enablePrintResourceView, param_.maxPriority, param_.aggregatedStrategy);
+        param_.enableMetrics, param_.enablePrintResourceView, param_.maxPriority, param_.aggregatedStrategy,
+        param_.parallelism);
     auto pingTimeout = param_.heartbeatTimeoutMs / 2;
     domainSrvActor_ = std::make_shared<DomainSchedSrvActor>(param_.identity, param_.metaStoreClient, pingTimeout);
     auto domainSrv = std::make_shared<DomainSchedSrv>(domainSrvActor_->GetAID());
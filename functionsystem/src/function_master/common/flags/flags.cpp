@@ -127,6 +127,12 @@ void Flags::InitMetaStoreFlags()
     AddFlag(&Flags::metaStoreMaxFlushBatchSize_, "meta_store_max_flush_batch_size",
             "max flush batch size for meta store backup", DEFAULT_META_STORE_MAX_FLUSH_BATCH_SIZE,
             NumCheck(static_cast<uint32_t>(0), UINT32_MAX));
+    AddFlag(&Flags::metaStorePersistPath_, "meta_store_persist_path",
+            "local path of the meta store wal and snapshot, persist to etcd if empty", "");
+    AddFlag(&Flags::metaStoreShardPrefixes_, "meta_store_shard_prefixes",
+            "comma separated key prefixes of the local meta store shards, eg. /sn/instance/,/yr/route/, "
+            "the other keys go to one more shard, not sharded if empty",
+            "");
 }
 
 const std::string &Flags::GetLogConfig() const
@@ -178,6 +178,22 @@ public:
         return metaStoreMaxFlushBatchSize_;
     }
 
+    std::string GetMetaStorePersistPath() const
+    {
+        return metaStorePersistPath_;
+    }
+
+    std::vector<std::string> GetMetaStoreShardPrefixes() const
+    {
+        std::vector<std::string> prefixes;
+        for (const auto &split : litebus::strings::Split(metaStoreShardPrefixes_, ",")) {
+            if (!split.empty()) {
+                prefixes.emplace_back(split);
+            }
+        }
+        return prefixes;
+    }
+
     bool GetEnableSyncSysFunc() const
     {
         return enableSyncFuncSysFunc_;
@@ -287,6 +303,9 @@ protected:
     std::string metaStoreMode_;
     uint32_t metaStoreMaxFlushConcurrency_{ 0 };
     uint32_t metaStoreMaxFlushBatchSize_{ 0 };
+    std::string metaStorePersistPath_;
+
+    std::string metaStoreShardPrefixes_;
 
     std::string poolConfigPath_;
     std::string agentTemplatePath_;
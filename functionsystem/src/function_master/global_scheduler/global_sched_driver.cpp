@@ -258,6 +258,7 @@ GlobalSchedDriver::GlobalSchedDriver(std::shared_ptr<GlobalSched> globalSched, c
     enablePrintResourceView_ = flags.GetEnablePrintResourceView();
     schedulePlugins_ = flags.GetSchedulePlugins();
     relaxed_ = flags.GetScheduleRelaxed();
+    parallelism_ = flags.GetScheduleParallelism();
     maxPriority_ = flags.GetMaxPriority();
     enablePreemption_ = flags.GetEnablePreemption();
     aggregatedStrategy_ = flags.GetAggregatedStrategy();
@@ -294,7 +295,7 @@ Status GlobalSchedDriver::Start()
         std::make_shared<domain_scheduler::DomainSchedulerLauncher>(domain_scheduler::DomainSchedulerParam{
             "InnerDomainScheduler", globalSchedAddress_, metaStoreClient_, heartbeatTimeoutMs_, pullResourceInterval_,
             isScheduleTolerateAbnormal_, maxPriority_, enablePreemption_, relaxed_, enableMetrics_,
-            enablePrintResourceView_, schedulePlugins_, aggregatedStrategy_ });
+            enablePrintResourceView_, schedulePlugins_, aggregatedStrategy_, parallelism_ });
     auto domainActivator = std::make_shared<DomainActivator>(domainLauncher);
     auto topologyTree = std::make_unique<SchedTree>(maxLocalSchedPerDomainNode_, maxDomainSchedPerDomainNode_);
     auto globalSchedActor = std::make_shared<GlobalSchedActor>(GLOBAL_SCHED_ACTOR_NAME, metaStoreClient_,
@@ -84,6 +84,7 @@ private:
     bool enableMetrics_{ false };
     bool enablePrintResourceView_{ false };
     int32_t relaxed_ = -1;
+    int32_t parallelism_ = 0;
     bool enablePreemption_{ false };
 };
 
@@ -29,7 +29,7 @@ namespace functionsystem::instance_manager {
 
 bool GenGroupValueJson(const std::shared_ptr<messages::GroupInfo> &group, std::string &jsonStr)
 {
-    return google::protobuf::util::MessageToJsonString(*group, &jsonStr).ok();
+    return TransToJsonFromGroupInfo(jsonStr, *group);
 }
 
 std::shared_ptr<internal::ForwardKillRequest> MakeKillReq(
@@ -47,6 +47,7 @@
 #include "meta_store_driver.h"
 #include "meta_store_monitor/meta_store_monitor.h"
 #include "meta_store_monitor/meta_store_monitor_factory.h"
+#include "metadata/metadata.h"
 #include "param_check.h"
 #include "proto/pb/message_pb.h"
 #include "resource_group_manager/resource_group_manager_driver.h"
@@ -239,6 +240,10 @@ std::shared_ptr<MetaStoreClient> GetMetaStoreClient(const functionmaster::Flags
     metaStoreConfig.enableMetaStore = IsClientEnableMetaStore(flags);
     metaStoreConfig.etcdTablePrefix = flags.GetETCDTablePrefix();
     metaStoreConfig.excludedKeys = flags.GetMetaStoreExcludedKeys();
+    metaStoreConfig.readCachePrefixes = flags.GetMetaStoreReadCachePrefixes();
+    metaStoreConfig.writeCoalesceWindowMs = flags.GetMetaStoreWriteCoalesceWindowMs();
+    metaStoreConfig.writeCoalesceMaxBatchSize = flags.GetMetaStoreWriteCoalesceMaxBatchSize();
+    SetMetadataWriteEncoding(flags.GetMetadataBinaryEncoding() ? MetadataEncoding::BINARY : MetadataEncoding::JSON);
     // if enabled, metastore address is master ip + global scheduler port; etcd
     // address is used for persistence else metastore address is etcd ip
     if (metaStoreConfig.enableMetaStore) {
@@ -316,7 +321,7 @@ void StartMetaStore(const functionmaster::Flags &flags)
         return;
     }
 
-    g_metaStoreDriver = std::make_shared<meta_store::MetaStoreDriver>();
+    g_metaStoreDriver = std::make_shared<meta_store::MetaStoreDriver>(flags.GetMetaStoreShardPrefixes());
     if (flags.GetMetaStoreMode() == META_STORE_MODE_LOCAL && !flags.GetEnablePersistence()) {
         YRLOG_INFO("enable local meta-store without persistence");
         g_metaStoreDriver->Start();
@@ -341,7 +346,8 @@ void StartMetaStore(const functionmaster::Flags &flags)
             etcdAddress, option, GetGrpcSSLConfig(flags),
             MetaStoreBackupOption{ .enableSyncSysFunc = flags.GetEnableSyncSysFunc(),
                                    .metaStoreMaxFlushConcurrency = flags.GetMetaStoreMaxFlushConcurrency(),
-                                   .metaStoreMaxFlushBatchSize = flags.GetMetaStoreMaxFlushBatchSize()});
+                                   .metaStoreMaxFlushBatchSize = flags.GetMetaStoreMaxFlushBatchSize(),
+                                   .persistPath = flags.GetMetaStorePersistPath() });
         return;
     }
 }
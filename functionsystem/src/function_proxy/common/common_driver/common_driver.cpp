@@ -17,6 +17,7 @@
 
 #include "common/constants/actor_name.h"
 #include "meta_store_monitor/meta_store_monitor_factory.h"
+#include "metadata/metadata.h"
 #include "common/posix_client/shared_client/shared_client_manager.h"
 #include "common/posix_client/shared_client/posix_stream_manager_proxy.h"
 #include "function_proxy/common/state_handler/state_handler.h"
@@ -35,6 +36,10 @@ void PrepareMetaStoreConfigs(const function_proxy::Flags &flags, MetaStoreTimeou
     metaStoreConfig.enableMetaStore = flags.GetEnableMetaStore();
     metaStoreConfig.etcdTablePrefix = flags.GetETCDTablePrefix();
     metaStoreConfig.excludedKeys = flags.GetMetaStoreExcludedKeys();
+    metaStoreConfig.readCachePrefixes = flags.GetMetaStoreReadCachePrefixes();
+    metaStoreConfig.writeCoalesceWindowMs = flags.GetMetaStoreWriteCoalesceWindowMs();
+    metaStoreConfig.writeCoalesceMaxBatchSize = flags.GetMetaStoreWriteCoalesceMaxBatchSize();
+    SetMetadataWriteEncoding(flags.GetMetadataBinaryEncoding() ? MetadataEncoding::BINARY : MetadataEncoding::JSON);
     if (metaStoreConfig.enableMetaStore) {
         metaStoreConfig.etcdAddress = flags.GetEtcdAddress();
         metaStoreConfig.metaStoreAddress = flags.GetMetaStoreAddress();
@@ -1303,7 +1303,7 @@ litebus::Future<Status> LocalGroupCtrlActor::GroupOperator::TxnGroupInstances(
     YRLOG_INFO("begin to transaction group instances, key: {}", key);
     // the instance information in the current message is redundant and will be optimized in the future.
     std::string jsonStr;
-    if (!google::protobuf::util::MessageToJsonString(*req, &jsonStr).ok()) {
+    if (!TransToJsonFromGroupInfo(jsonStr, *req)) {
         return Status(StatusCode::ERR_INNER_SYSTEM_ERROR,
                       "failed to trans group info to json string. request:" + req->requestid());
     }
@@ -1340,7 +1340,7 @@ litebus::Future<GroupInfos> LocalGroupCtrlActor::GroupOperator::SyncGroupInstanc
             for (auto &kv : getResponse->kvs) {
                 auto eventKey = TrimKeyPrefix(kv.key(), prefix);
                 auto groupInfo = std::make_shared<messages::GroupInfo>();
-                if (!google::protobuf::util::JsonStringToMessage(kv.value(), groupInfo.get(), jsonOpt).ok()) {
+                if (!ParseMetadata(*groupInfo, kv.value(), jsonOpt)) {
                     YRLOG_WARN("failed to parse {}", eventKey);
                     continue;
                 }
@@ -140,7 +140,7 @@ void EtcdWatchSrvActor::OnPut(const mvccpb::KeyValue &kv, const mvccpb::KeyValue
     }
 }
 
-void EtcdWatchSrvActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs)
+void EtcdWatchSrvActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs, int64_t revision)
 {
     YRLOG_DEBUG("start process OnDeleteList, this: {}", (void *)this);
     for (auto &observer : observers_) {
@@ -175,7 +175,7 @@ void EtcdWatchSrvActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyVa
 
                 mvccpb::KeyValue *mutableKv = event->mutable_kv();
                 mutableKv->set_key(item.key());
-                mutableKv->set_mod_revision(item.mod_revision() + 1);
+                mutableKv->set_mod_revision(revision);
 
                 if (request.prev_kv()) {
                     mvccpb::KeyValue *mutablePrevKv = event->mutable_prev_kv();
@@ -195,7 +195,7 @@ void EtcdWatchSrvActor::OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyVa
     }
 }
 
-void EtcdWatchSrvActor::OnDelete(const mvccpb::KeyValue &prevKv)
+void EtcdWatchSrvActor::OnDelete(const mvccpb::KeyValue &prevKv, int64_t revision)
 {
     YRLOG_DEBUG("start process OnDelete, key: {}, this: {}", prevKv.key(), (void *)this);
     for (auto &observer : observers_) {
@@ -228,7 +228,7 @@ void EtcdWatchSrvActor::OnDelete(const mvccpb::KeyValue &prevKv)
             event->set_type(::mvccpb::Event_EventType::Event_EventType_DELETE);
 
             mvccpb::KeyValue *mutableKv = event->mutable_kv();
-            mutableKv->set_mod_revision(prevKv.mod_revision() + 1);
+            mutableKv->set_mod_revision(revision);
             mutableKv->set_key(prevKv.key());
 
             if (request.prev_kv()) {
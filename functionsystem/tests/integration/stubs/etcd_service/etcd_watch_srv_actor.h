@@ -39,9 +39,9 @@ public:
 
     void OnPut(const ::mvccpb::KeyValue &kv, const ::mvccpb::KeyValue &prevKv) override;
 
-    void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs) override;
+    void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs, int64_t revision) override;
 
-    void OnDelete(const ::mvccpb::KeyValue &prevKv) override;
+    void OnDelete(const ::mvccpb::KeyValue &prevKv, int64_t revision) override;
 
 private:
     std::unordered_map<Stream *, std::unordered_map<int64_t, ::etcdserverpb::WatchCreateRequest>> observers_;
@@ -33,13 +33,13 @@ public:
 
     bool Create(Stream *grpcStream, const ::etcdserverpb::WatchCreateRequest &request);
 
-    void OnDelete(const ::mvccpb::KeyValue &prevKv) override;
+    void OnDelete(const ::mvccpb::KeyValue &prevKv, int64_t revision) override;
 
     bool RemoveClient(Stream *grpcStream);
 
     bool Response(Stream *grpcStream);
 
-    void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs) override;
+    void OnDeleteList(std::shared_ptr<std::vector<::mvccpb::KeyValue>> kvs, int64_t revision) override;
 
     void OnPut(const ::mvccpb::KeyValue &kv, const ::mvccpb::KeyValue &prevKv) override;
 
@@ -21,10 +21,13 @@
 #include <memory>
 
 #include "mocks/mock_meta_store_client.h"
+#include "mocks/mock_txn_transaction.h"
+#include "utils/future_test_helper.h"
 #include "utils/port_helper.h"
 
 namespace functionsystem::test {
 
+using ::testing::Invoke;
 using ::testing::Return;
 
 class MetaStorageAccessorTest : public ::testing::Test {
@@ -217,4 +220,91 @@ TEST_F(MetaStorageAccessorTest, RevokeValidKey)
     EXPECT_TRUE(result.IsOk());
 }
 
-}  // namespace functionsystem::test
\ No newline at end of file
+TEST_F(MetaStorageAccessorTest, CoalesceWrites)
+{
+    uint16_t port = GetPortEnv("LITEBUS_PORT", 8080);
+    std::string address = "127.0.0.1:" + std::to_string(port);
+    std::unique_ptr<MockMetaStoreClient> mockMetaStoreClient = std::make_unique<MockMetaStoreClient>(address);
+    mockMetaStoreClient->metaStoreConfig_.writeCoalesceWindowMs = 50;
+
+    auto txn = std::make_shared<MockTxnTransaction>(litebus::AID());
+    auto txnResponse = std::make_shared<TxnResponse>();
+    txnResponse->success = true;
+    txnResponse->responses.resize(3);
+    txnResponse->responses[2].operationType = meta_store::TxnOperationType::OPERATION_DELETE;
+    txnResponse->responses[2].response = DeleteResponse{ .deleted = 1 };
+    EXPECT_CALL(*mockMetaStoreClient, BeginTransaction).WillOnce(Return(txn));
+    EXPECT_CALL(*txn, Commit).WillOnce(Return(txnResponse));
+    // the key is in the txn already, it goes by itself after the txn
+    EXPECT_CALL(*mockMetaStoreClient, Put).WillOnce(Return(std::make_shared<PutResponse>()));
+
+    MetaStorageAccessor accessor{ std::move(mockMetaStoreClient) };
+    auto put1 = accessor.Put("key1", "value1");
+    auto put2 = accessor.Put("key2", "value2");
+    auto del = accessor.Delete("key3");
+    auto put3 = accessor.Put("key1", "value3");
+    EXPECT_TRUE(put1.Get().IsOk());
+    EXPECT_TRUE(put2.Get().IsOk());
+    EXPECT_TRUE(del.Get().IsOk());
+    EXPECT_TRUE(put3.Get().IsOk());
+    EXPECT_EQ(txn->thenOps.size(), 3u);
+}
+
+TEST_F(MetaStorageAccessorTest, CoalescedTxnFailed)
+{
+    uint16_t port = GetPortEnv("LITEBUS_PORT", 8080);
+    std::string address = "127.0.0.1:" + std::to_string(port);
+    std::unique_ptr<MockMetaStoreClient> mockMetaStoreClient = std::make_unique<MockMetaStoreClient>(address);
+    mockMetaStoreClient->metaStoreConfig_.writeCoalesceWindowMs = 50;
+
+    auto txn = std::make_shared<MockTxnTransaction>(litebus::AID());
+    auto txnResponse = std::make_shared<TxnResponse>();
+    txnResponse->status = Status(StatusCode::FAILED, "txn spans shards");
+    EXPECT_CALL(*mockMetaStoreClient, BeginTransaction).WillOnce(Return(txn));
+    EXPECT_CALL(*txn, Commit).WillOnce(Return(txnResponse));
+    auto putFailed = std::make_shared<PutResponse>();
+    putFailed->status = Status(StatusCode::FAILED);
+    EXPECT_CALL(*mockMetaStoreClient, Put)
+        .WillOnce(Return(std::make_shared<PutResponse>()))
+        .WillOnce(Return(putFailed));
+
+    MetaStorageAccessor accessor{ std::move(mockMetaStoreClient) };
+    auto put1 = accessor.Put("key1", "value1");
+    auto put2 = accessor.Put("key2", "value2");
+    EXPECT_TRUE(put1.Get().IsOk());
+    EXPECT_EQ(put2.Get().StatusCode(), StatusCode::BP_META_STORAGE_PUT_ERROR);
+}
+
+TEST_F(MetaStorageAccessorTest, CoalescedTxnInFlightFinalized)
+{
+    uint16_t port = GetPortEnv("LITEBUS_PORT", 8080);
+    std::string address = "127.0.0.1:" + std::to_string(port);
+    std::unique_ptr<MockMetaStoreClient> mockMetaStoreClient = std::make_unique<MockMetaStoreClient>(address);
+    mockMetaStoreClient->metaStoreConfig_.writeCoalesceWindowMs = 50;
+
+    // the txn never completes
+    auto txn = std::make_shared<MockTxnTransaction>(litebus::AID());
+    litebus::Promise<std::shared_ptr<TxnResponse>> txnResponse;
+    litebus::Promise<bool> committed;
+    EXPECT_CALL(*mockMetaStoreClient, BeginTransaction).WillOnce(Return(txn));
+    EXPECT_CALL(*txn, Commit).WillOnce(Invoke([&txnResponse, &committed]() {
+        committed.SetValue(true);
+        return txnResponse.GetFuture();
+    }));
+
+    litebus::Future<Status> put1;
+    litebus::Future<Status> put2;
+    litebus::Future<Status> put3;
+    {
+        MetaStorageAccessor accessor{ std::move(mockMetaStoreClient) };
+        put1 = accessor.Put("key1", "value1");
+        put2 = accessor.Put("key2", "value2");
+        ASSERT_AWAIT_READY(committed.GetFuture());
+        put3 = accessor.Put("key3", "value3");
+    }
+    EXPECT_EQ(put1.Get().StatusCode(), StatusCode::BP_META_STORAGE_PUT_ERROR);
+    EXPECT_EQ(put2.Get().StatusCode(), StatusCode::BP_META_STORAGE_PUT_ERROR);
+    EXPECT_EQ(put3.Get().StatusCode(), StatusCode::BP_META_STORAGE_PUT_ERROR);
+}
+
+}  // namespace functionsystem::test
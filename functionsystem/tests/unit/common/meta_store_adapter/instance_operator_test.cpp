@@ -521,6 +521,18 @@ TEST_F(InstanceOperatorTest, PrintResponseTest)
     (void)operateInfo.response->responses.emplace_back(getOperationResponse);
     instanceOpt.OnPrintResponse(getKeyValue);
     EXPECT_TRUE(instanceOpt.PrintResponse(operateInfo));
+
+    // a binary value is decoded before it is logged
+    InstanceInfo instanceInfo;
+    instanceInfo.set_instanceid("551d163a-a7c9-4e99-9cf2-84b627ee7167");
+    instanceInfo.mutable_instancestatus()->set_code(3);
+    SetMetadataWriteEncoding(MetadataEncoding::BINARY);
+    std::string binaryValue;
+    EXPECT_TRUE(TransToJsonFromInstanceInfo(binaryValue, instanceInfo));
+    SetMetadataWriteEncoding(MetadataEncoding::JSON);
+    ASSERT_TRUE(IsBinaryMetadata(binaryValue));
+    getKeyValue.set_value(binaryValue);
+    instanceOpt.OnPrintResponse(getKeyValue);
 }
 
 TEST_F(InstanceOperatorTest, ForceDeleteTest)
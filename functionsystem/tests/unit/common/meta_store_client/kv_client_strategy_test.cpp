@@ -22,6 +22,7 @@
 #include "common/etcd_service/etcd_service_driver.h"
 #include "meta_store_client/key_value/etcd_kv_client_strategy.h"
 #include "meta_store_client/key_value/meta_store_kv_client_strategy.h"
+#include "proto/pb/message_pb.h"
 #include "utils/future_test_helper.h"
 #include "utils/port_helper.h"
 
@@ -454,6 +455,64 @@ TEST_F(EtcdKvClientStrategyTest, EtcdCancelTest)
     litebus::Await(client);
 }
 
+/**
+ * a snapshot read again after a failed page deletes the keys delivered before the restart that it does not have
+ */
+TEST_F(EtcdKvClientStrategyTest, RestartedSnapshotDeletesKeysGone)  // NOLINT
+{
+    {
+        SnapshotKeys keys;
+        WatchEvent kept{ .eventType = EVENT_TYPE_PUT, .kv = {}, .prevKv = {} };
+        kept.kv.set_key("llt/page/kept");
+        WatchEvent gone{ .eventType = EVENT_TYPE_PUT, .kv = {}, .prevKv = {} };
+        gone.kv.set_key("llt/page/gone");
+        keys.OnPage({ kept, gone });
+        keys.Restart();
+        keys.OnPage({ kept });
+        auto deleted = keys.TakeDeleted(9);
+        ASSERT_EQ(deleted.size(), 1u);
+        EXPECT_EQ(deleted[0].eventType, EVENT_TYPE_DELETE);
+        EXPECT_EQ(deleted[0].kv.key(), "llt/page/gone");
+        EXPECT_EQ(deleted[0].kv.mod_revision(), 9);
+        EXPECT_TRUE(keys.TakeDeleted(10).empty());
+    }
+
+    PutOption putOption = { .leaseId = 0, .prevKv = false };
+    ASSERT_EQ(client_->Put("llt/page/kept", "1.0", putOption).Get()->status, Status::OK());
+    // the pages of the snapshot read before the restart delivered a key deleted since
+    auto keys = std::make_shared<SnapshotKeys>();
+    keys->stale.emplace("llt/page/gone");
+
+    litebus::Promise<std::vector<WatchEvent>> puts;
+    litebus::Promise<std::vector<WatchEvent>> deletes;
+    ObserverFunction observer = [&](const std::vector<WatchEvent> &events, bool synced) -> bool {
+        (synced ? puts : deletes).SetValue(events);
+        return true;
+    };
+    SyncerFunction syncer = []() -> litebus::Future<SyncResult> { return SyncResult{ Status::OK(), 0 }; };
+    WatchOption option = { .prefix = true, .prevKv = false, .revision = 0 };
+    auto client = std::dynamic_pointer_cast<EtcdKvClientStrategy>(client_);
+    auto watcher = litebus::Async(client->GetAID(), &EtcdKvClientStrategy::GetPageAndWatch, std::string("llt/page/"),
+                                  option, observer, syncer, std::shared_ptr<WatchRecord>(), std::string(), int64_t{ 0 },
+                                  1, keys)
+                       .Get();
+    ASSERT_AWAIT_READY(puts.GetFuture());
+    ASSERT_EQ(puts.GetFuture().Get().size(), 1u);
+    EXPECT_EQ(puts.GetFuture().Get()[0].kv.key(), "llt/page/kept");
+    ASSERT_AWAIT_READY(deletes.GetFuture());
+    ASSERT_EQ(deletes.GetFuture().Get().size(), 1u);
+    EXPECT_EQ(deletes.GetFuture().Get()[0].eventType, EVENT_TYPE_DELETE);
+    EXPECT_EQ(deletes.GetFuture().Get()[0].kv.key(), "llt/page/gone");
+    EXPECT_TRUE(keys->stale.empty());
+
+    watcher->Close();
+    ASSERT_AWAIT_TRUE([&]() -> bool {
+        return (client->readyRecords_.find(watcher->GetWatchId()) == client->readyRecords_.end());
+    });  // wait for cancel success
+    DeleteOption deleteOption = { .prevKv = false, .prefix = true };
+    client_->Delete("llt/page/", deleteOption).Get();
+}
+
 TEST_F(EtcdKvClientStrategyTest, PutTest)  // NOLINT
 {
     PutTest(client_);
@@ -629,4 +688,53 @@ TEST_F(MetaStoreKvClientStrategyTest, GetAndWatchTest)  // NOLINT
 {
     GetAndWatchTest(client_);
 }
-}  // namespace functionsystem::meta_store::test
\ No newline at end of file
+
+/**
+ * A watch from a revision the server can't resume, across meta store shards, is answered with a snapshot. The watcher
+ * is created by it and resyncs through its syncer, since the snapshot has no delete for the keys removed meanwhile.
+ */
+TEST_F(MetaStoreKvClientStrategyTest, ResyncWatchOpenedWithSnapshot)  // NOLINT
+{
+    // no server answers, the test gives the answer of a sharded one
+    auto client = std::make_shared<MetaStoreKvClientStrategy>(
+        META_KV_CLIENT_NAME + litebus::uuid_generator::UUID::GetRandomUUID().ToString(), "127.0.0.1:1",
+        metaStoreTimeoutOpt);
+    litebus::Spawn(client);
+
+    litebus::Promise<bool> synced;
+    auto observer = [](const std::vector<WatchEvent> &, bool) -> bool { return true; };
+    auto syncer = [&synced]() -> litebus::Future<SyncResult> {
+        synced.SetValue(true);
+        return SyncResult{ Status::OK(), 11 };
+    };
+    WatchOption option = { .prefix = true, .prevKv = false, .revision = 5 };
+    auto watcher = client->Watch("llt/sn/resync", option, observer, syncer, nullptr);
+    ASSERT_EQ(client->pendingRecordMap_.size(), 1u);
+    auto uuid = client->pendingRecordMap_.begin()->first;
+
+    etcdserverpb::RangeResponse getResponse;
+    getResponse.mutable_header()->set_revision(10);
+    auto *kv = getResponse.add_kvs();
+    kv->set_key("llt/sn/resync/a");
+    kv->set_value("1.0");
+    getResponse.set_count(1);
+    etcdserverpb::WatchResponse watchResponse;
+    watchResponse.set_created(true);
+    watchResponse.set_watch_id(7);
+    messages::GetAndWatchResponse response;
+    response.set_getresponsemsg(getResponse.SerializeAsString());
+    response.set_watchresponsemsg(watchResponse.SerializeAsString());
+    messages::MetaStoreResponse message;
+    message.set_responseid(uuid);
+    message.set_responsemsg(response.SerializeAsString());
+    client->OnGetAndWatch(litebus::AID("WatchServiceActor", "127.0.0.1:1"), "OnGetAndWatch",
+                          message.SerializeAsString());
+
+    ASSERT_AWAIT_READY(watcher);
+    EXPECT_EQ(watcher.Get()->GetWatchId(), 7);
+    ASSERT_AWAIT_READY(synced.GetFuture());
+
+    litebus::Terminate(client->GetAID());
+    litebus::Await(client);
+}
+}  // namespace functionsystem::meta_store::test
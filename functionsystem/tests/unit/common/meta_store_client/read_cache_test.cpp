@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "meta_store_client/key_value/read_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace functionsystem::meta_store::test {
+const std::string TABLE_PREFIX = "/t";
+const std::string CACHED_PREFIX = "/yr/instance/";
+
+class ReadCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        cache_ = std::make_shared<ReadCache>(std::unordered_set<std::string>{ CACHED_PREFIX }, TABLE_PREFIX);
+        watcher_ = std::make_shared<Watcher>([](int64_t) {});
+        cache_->AddWatcher(CACHED_PREFIX, watcher_);
+    }
+
+    static WatchEvent Event(EventType type, const std::string &key, const std::string &value, int64_t revision)
+    {
+        WatchEvent event{ type, {}, {} };
+        event.kv.set_key(TABLE_PREFIX + key);
+        event.kv.set_value(value);
+        event.kv.set_mod_revision(revision);
+        return event;
+    }
+
+    std::shared_ptr<GetResponse> Get(const std::string &key, const GetOption &option)
+    {
+        uint64_t epoch = 0;
+        return cache_->Get(key, option, epoch);
+    }
+
+    std::shared_ptr<ReadCache> cache_;
+    std::shared_ptr<Watcher> watcher_;
+};
+
+TEST_F(ReadCacheTest, ServeFromSyncedEvents)  // NOLINT
+{
+    GetOption prefixOption{ .prefix = true };
+    EXPECT_EQ(Get(CACHED_PREFIX, prefixOption), nullptr);
+    EXPECT_EQ(Get("/yr/function/a", {}), nullptr);
+
+    cache_->OnEvents(CACHED_PREFIX,
+                     { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 5), Event(EVENT_TYPE_PUT, "/yr/instance/b", "2", 6) },
+                     true);
+    auto response = Get(CACHED_PREFIX, prefixOption);
+    ASSERT_NE(response, nullptr);
+    EXPECT_EQ(response->header.revision, 6);
+    ASSERT_EQ(response->kvs.size(), 2u);
+    EXPECT_EQ(response->kvs[0].value(), "1");
+
+    // the prefix is complete, an unknown key is absent
+    response = Get("/yr/instance/c", {});
+    ASSERT_NE(response, nullptr);
+    EXPECT_TRUE(response->kvs.empty());
+
+    response = Get(CACHED_PREFIX, GetOption{ .prefix = true, .countOnly = true });
+    ASSERT_NE(response, nullptr);
+    EXPECT_EQ(response->count, 2);
+
+    // sorted by another target is not served
+    EXPECT_EQ(Get(CACHED_PREFIX, GetOption{ .prefix = true, .sortOrder = SortOrder::DESCEND }), nullptr);
+
+    auto counters = cache_->caches_[CACHED_PREFIX].counters;
+    EXPECT_EQ(counters->hits.load(), 3u);
+    EXPECT_EQ(counters->misses.load(), 2u);
+}
+
+TEST_F(ReadCacheTest, CompleteOnLastSnapshotPage)  // NOLINT
+{
+    GetOption prefixOption{ .prefix = true };
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 5) }, true, true);
+    // a page serves its keys, not the whole prefix
+    EXPECT_NE(Get("/yr/instance/a", {}), nullptr);
+    EXPECT_EQ(Get(CACHED_PREFIX, prefixOption), nullptr);
+
+    // the last page may be empty
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/b", "2", 6) }, true, true);
+    cache_->OnEvents(CACHED_PREFIX, {}, true, false);
+    auto response = Get(CACHED_PREFIX, prefixOption);
+    ASSERT_NE(response, nullptr);
+    EXPECT_EQ(response->kvs.size(), 2u);
+}
+
+TEST_F(ReadCacheTest, NotCompleteOnRestartedPages)  // NOLINT
+{
+    GetOption prefixOption{ .prefix = true };
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/b", "2", 5) }, true, true);
+    // the pages start over from the first key, the kvs of the first pass may have been deleted since
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 7) }, true, false);
+    EXPECT_EQ(Get(CACHED_PREFIX, prefixOption), nullptr);
+
+    // the prefix is dropped while filling
+    cache_->Invalidate(CACHED_PREFIX);
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 8) }, true, true);
+    cache_->Invalidate(CACHED_PREFIX);
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/b", "2", 8) }, true, false);
+    EXPECT_EQ(Get(CACHED_PREFIX, prefixOption), nullptr);
+}
+
+TEST_F(ReadCacheTest, CoherentWithEvents)  // NOLINT
+{
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 5) }, true);
+
+    // a write of this client is not read stale before its event
+    cache_->OnWrite("/yr/instance/a", 7);
+    EXPECT_EQ(Get("/yr/instance/a", {}), nullptr);
+    EXPECT_EQ(cache_->caches_[CACHED_PREFIX].counters->revisionLag.load(), 2);
+
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "2", 7) }, false);
+    auto response = Get("/yr/instance/a", {});
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(response->kvs.size(), 1u);
+    EXPECT_EQ(response->kvs[0].value(), "2");
+    EXPECT_EQ(cache_->caches_[CACHED_PREFIX].counters->revisionLag.load(), 0);
+
+    // an older event is dropped
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_DELETE, "/yr/instance/a", "", 6) }, false);
+    EXPECT_EQ(Get("/yr/instance/a", {})->kvs.size(), 1u);
+
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_DELETE, "/yr/instance/a", "", 8) }, false);
+    response = Get("/yr/instance/a", {});
+    ASSERT_NE(response, nullptr);
+    EXPECT_TRUE(response->kvs.empty());
+
+    watcher_->Close();
+    EXPECT_EQ(Get("/yr/instance/a", {}), nullptr);
+}
+
+TEST_F(ReadCacheTest, FillFromGetResponse)  // NOLINT
+{
+    GetOption prefixOption{ .prefix = true };
+    uint64_t epoch = 0;
+    EXPECT_EQ(cache_->Get(CACHED_PREFIX, prefixOption, epoch), nullptr);
+    auto response = std::make_shared<GetResponse>();
+    response->header.revision = 10;
+    response->kvs.emplace_back(Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 9).kv);
+
+    // dropped while the get is in flight, the response may be older than the events missed
+    cache_->Invalidate(CACHED_PREFIX);
+    cache_->OnGetResponse(CACHED_PREFIX, prefixOption, epoch, response);
+    EXPECT_EQ(Get(CACHED_PREFIX, prefixOption), nullptr);
+
+    EXPECT_EQ(cache_->Get(CACHED_PREFIX, prefixOption, epoch), nullptr);
+    // a later event applied before the response is kept, the older response is dropped
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/b", "2", 11) }, false);
+    cache_->OnGetResponse(CACHED_PREFIX, prefixOption, epoch, response);
+    auto cached = Get(CACHED_PREFIX, prefixOption);
+    EXPECT_EQ(cached, nullptr);
+    EXPECT_EQ(Get("/yr/instance/a", {}), nullptr);
+    EXPECT_EQ(Get("/yr/instance/b", {})->kvs.size(), 1u);
+
+    // a response at the revision of the events fills in
+    response->header.revision = 11;
+    EXPECT_EQ(cache_->Get("/yr/instance/a", {}, epoch), nullptr);
+    cache_->OnGetResponse("/yr/instance/a", {}, epoch, response);
+    cached = Get("/yr/instance/a", {});
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->kvs.size(), 1u);
+
+    // an absent key is served as absent
+    auto absent = std::make_shared<GetResponse>();
+    absent->header.revision = 11;
+    EXPECT_EQ(cache_->Get("/yr/instance/c", {}, epoch), nullptr);
+    cache_->OnGetResponse("/yr/instance/c", {}, epoch, absent);
+    cached = Get("/yr/instance/c", {});
+    ASSERT_NE(cached, nullptr);
+    EXPECT_TRUE(cached->kvs.empty());
+}
+TEST_F(ReadCacheTest, DeleteNotRevivedBySlowGet)  // NOLINT
+{
+    uint64_t epoch = 0;
+    EXPECT_EQ(cache_->Get("/yr/instance/a", {}, epoch), nullptr);
+    // the get is served at revision 6, the key is deleted at revision 8 and the event arrives first
+    auto response = std::make_shared<GetResponse>();
+    response->header.revision = 6;
+    response->kvs.emplace_back(Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 5).kv);
+    cache_->OnEvents(CACHED_PREFIX, { Event(EVENT_TYPE_PUT, "/yr/instance/a", "1", 5),
+                                      Event(EVENT_TYPE_DELETE, "/yr/instance/a", "", 8) },
+                     false);
+    cache_->OnGetResponse("/yr/instance/a", {}, epoch, response);
+
+    auto cached = Get("/yr/instance/a", {});
+    ASSERT_NE(cached, nullptr);
+    EXPECT_TRUE(cached->kvs.empty());
+}
+}  // namespace functionsystem::meta_store::test
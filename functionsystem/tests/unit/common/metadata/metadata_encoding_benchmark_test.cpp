@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "metadata/metadata.h"
+
+namespace functionsystem::test {
+const int ENCODE_ROUNDS = 20000;
+
+class MetadataEncodingBenchmarkTest : public ::testing::Test {
+public:
+    static InstanceInfo GenInstanceInfo()
+    {
+        InstanceInfo instance;
+        instance.set_instanceid("9f8c2c1e-5a1b-4c3d-8e2f-0123456789ab");
+        instance.set_requestid("1c2d3e4f5a6b7c8d-9e0f");
+        instance.set_runtimeid("runtime-8e2f0123-4567-89ab-cdef");
+        instance.set_runtimeaddress("10.0.12.34:22771");
+        instance.set_functionagentid("function-agent-10.0.12.34-58866");
+        instance.set_functionproxyid("node-10-0-12-34");
+        instance.set_function("12345678901234561234567890123456/0-system-faasExecutorPython3.9/$latest");
+        instance.set_jobid("job-ab12cd34");
+        instance.set_parentid("driver-0123456789ab");
+        instance.set_tenantid("12345678901234561234567890123456");
+        instance.set_version(7);
+        for (const auto &[name, value] : { std::make_pair("CPU", 500.0), std::make_pair("Memory", 1024.0) }) {
+            auto &resource = (*instance.mutable_resources()->mutable_resources())[name];
+            resource.set_name(name);
+            resource.set_type(resource_view::ValueType::Value_Type_SCALAR);
+            resource.mutable_scalar()->set_value(value);
+        }
+        (*instance.mutable_createoptions())["Concurrency"] = "100";
+        (*instance.mutable_createoptions())[RELIABILITY_TYPE] = "high";
+        instance.add_labels("app=benchmark");
+        instance.add_schedulerchain("node-10-0-12-34");
+        instance.add_schedulerchain("domain-scheduler-0");
+        instance.mutable_instancestatus()->set_code(3);
+        instance.mutable_instancestatus()->set_msg("running");
+        return instance;
+    }
+
+    static void Run(const std::string &name, MetadataEncoding encoding, const InstanceInfo &instance)
+    {
+        SetMetadataWriteEncoding(encoding);
+        std::string value;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < ENCODE_ROUNDS; ++i) {
+            value.clear();
+            ASSERT_TRUE(TransToJsonFromInstanceInfo(value, instance));
+        }
+        auto encoded = std::chrono::steady_clock::now();
+        InstanceInfo decoded;
+        for (int i = 0; i < ENCODE_ROUNDS; ++i) {
+            decoded.Clear();
+            ASSERT_TRUE(TransToInstanceInfoFromJson(decoded, value));
+        }
+        auto end = std::chrono::steady_clock::now();
+        SetMetadataWriteEncoding(MetadataEncoding::JSON);
+        EXPECT_EQ(decoded.instanceid(), instance.instanceid());
+
+        auto encodeUs = std::chrono::duration<double, std::micro>(encoded - begin).count() / ENCODE_ROUNDS;
+        auto decodeUs = std::chrono::duration<double, std::micro>(end - encoded).count() / ENCODE_ROUNDS;
+        std::cout << std::fixed << std::setprecision(3) << name << " | bytes: " << value.size()
+                  << " | encode us: " << encodeUs << " | decode us: " << decodeUs << std::endl;
+    }
+};
+
+TEST_F(MetadataEncodingBenchmarkTest, BenchmarkInstanceInfoEncoding)
+{
+    auto instance = GenInstanceInfo();
+    Run("json", MetadataEncoding::JSON, instance);
+    Run("binary", MetadataEncoding::BINARY, instance);
+}
+}  // namespace functionsystem::test
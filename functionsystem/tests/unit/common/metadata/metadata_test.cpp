@@ -191,6 +191,36 @@ TEST_F(LoaderTest, TransToInstanceInfoFromJson)
     EXPECT_EQ(instance1.instanceid(), instance.instanceid());
 }
 
+TEST_F(LoaderTest, TransMetadataWithBinaryEncoding)
+{
+    InstanceInfo instance;
+    instance.set_instanceid("0123456789abcdef0");
+    instance.set_requestid("0123456789abcdef");
+    instance.mutable_instancestatus()->set_code(3);
+    std::string json;
+    EXPECT_TRUE(TransToJsonFromInstanceInfo(json, instance));
+
+    SetMetadataWriteEncoding(MetadataEncoding::BINARY);
+    std::string binary;
+    EXPECT_TRUE(TransToJsonFromInstanceInfo(binary, instance));
+    SetMetadataWriteEncoding(MetadataEncoding::JSON);
+    EXPECT_TRUE(IsBinaryMetadata(binary));
+    EXPECT_FALSE(IsBinaryMetadata(json));
+    EXPECT_LT(binary.size(), json.size());
+
+    // both encodings are read during upgrade
+    InstanceInfo fromJson;
+    EXPECT_TRUE(TransToInstanceInfoFromJson(fromJson, json));
+    InstanceInfo fromBinary;
+    EXPECT_TRUE(TransToInstanceInfoFromJson(fromBinary, binary));
+    EXPECT_EQ(fromBinary.instanceid(), instance.instanceid());
+    EXPECT_EQ(fromBinary.instancestatus().code(), 3);
+
+    resources::RouteInfo route;
+    binary[METADATA_BINARY_MAGIC.size()] = METADATA_BINARY_VERSION + 1;
+    EXPECT_FALSE(TransToRouteInfoFromJson(route, binary));
+}
+
 TEST_F(LoaderTest, GetFuncMetaFromJson)
 {
     std::string func_meta_json = R"({
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <gtest/gtest.h>
+
+#include "common/resource_view/resource_view_actor.h"
+#include "view_utils.h"
+
+namespace functionsystem::test {
+
+using namespace functionsystem::resource_view;
+using namespace functionsystem::test::view_utils;
+
+class ResourceViewSnapshotBenchmarkTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        ResourceViewActor::Param param{ .isLocal = true, .enableTenantAffinity = false };
+        actor_ = std::make_shared<ResourceViewActor>("snapshot-ResourceViewActor", "snapshot", param);
+        actor_->Init();
+    }
+
+    void AddAgents(int32_t agentCount, int32_t instancesPerAgent)
+    {
+        for (int32_t i = 0; i < agentCount; ++i) {
+            auto agent = Get1DResourceUnit("agent-" + std::to_string(i));
+            ASSERT_TRUE(actor_->AddResourceUnit(agent).IsOk());
+            std::map<std::string, InstanceAllocatedInfo> instances;
+            for (int32_t j = 0; j < instancesPerAgent; ++j) {
+                instances.emplace(NewInstance(agent.id()));
+            }
+            ASSERT_TRUE(actor_->AddInstances(instances).IsOk());
+        }
+    }
+
+    static std::pair<std::string, InstanceAllocatedInfo> NewInstance(const std::string &unitID)
+    {
+        auto inst = GetInstanceWithResourceAndPriority(0, 1.0, 1.0);
+        inst.set_unitid(unitID);
+        (*inst.mutable_schedulerchain()->Add()) = unitID;
+        return { inst.instanceid(), InstanceAllocatedInfo{ inst, nullptr } };
+    }
+
+    // changes the instances of a few agents, as a schedule round does between two snapshots
+    void ChangeAgents(int32_t changedAgents, int32_t round)
+    {
+        for (int32_t i = 0; i < changedAgents; ++i) {
+            auto unitID = "agent-" + std::to_string((round * changedAgents + i) % AGENT_COUNT);
+            std::map<std::string, InstanceAllocatedInfo> instances;
+            instances.emplace(NewInstance(unitID));
+            ASSERT_TRUE(actor_->AddInstances(instances).IsOk());
+        }
+    }
+
+    template <typename F>
+    static double AverageMs(int32_t rounds, F &&round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < rounds; ++i) {
+            round(i);
+        }
+        auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return cost / rounds;
+    }
+
+protected:
+    static constexpr int32_t AGENT_COUNT = 5000;
+    static constexpr int32_t INSTANCES_PER_AGENT = 20;
+    static constexpr int32_t ROUNDS = 20;
+    static constexpr int32_t CHANGED_AGENTS = 10;
+    std::shared_ptr<ResourceViewActor> actor_;
+};
+
+/**
+ * A held snapshot keeps its version while the view changes, a new snapshot sees the changes.
+ */
+TEST_F(ResourceViewSnapshotBenchmarkTest, SnapshotImmutableWhileHeld)
+{
+    AddAgents(3, 2);
+    auto held = actor_->GetResourceInfo().resourceUnit;
+    EXPECT_EQ(held->fragment_size(), 3);
+    EXPECT_EQ(held->instances_size(), 6);
+    // unchanged view, the same snapshot is shared
+    EXPECT_EQ(actor_->GetResourceInfo().resourceUnit, held);
+
+    ChangeAgents(1, 0);
+    auto next = actor_->GetResourceInfo().resourceUnit;
+    EXPECT_NE(next, held);
+    EXPECT_EQ(held->instances_size(), 6);
+    EXPECT_EQ(held->fragment().at("agent-0").instances_size(), 2);
+    EXPECT_EQ(next->instances_size(), 7);
+    EXPECT_EQ(next->fragment().at("agent-0").instances_size(), 3);
+
+    // the released snapshot is patched in place with the deleted agent
+    held.reset();
+    ASSERT_TRUE(actor_->DeleteResourceUnit("agent-1").IsOk());
+    auto patched = actor_->GetResourceInfo().resourceUnit;
+    EXPECT_EQ(patched->fragment_size(), 2);
+    EXPECT_EQ(patched->fragment().count("agent-1"), 0u);
+    EXPECT_EQ(patched->instances_size(), actor_->GetResourceView()->instances_size());
+    EXPECT_EQ(patched->allocatable().DebugString(), actor_->GetResourceView()->allocatable().DebugString());
+    EXPECT_EQ(next->fragment_size(), 3);
+}
+
+/**
+ * The bucket shape index given with the snapshots follows the shapes added to the view, a held index is left as it is.
+ */
+TEST_F(ResourceViewSnapshotBenchmarkTest, BucketShapeIndexFollowsView)
+{
+    auto addPod = [this](const std::string &id, const std::string &proportion, const std::string &mem) {
+        auto pod = Get1DResourceUnit(id);
+        auto &bucket = (*(*pod.mutable_bucketindexs())[proportion].mutable_buckets())[mem];
+        bucket.mutable_total()->set_monopolynum(1);
+        (*bucket.mutable_allocatable())[id].set_monopolynum(1);
+        ASSERT_TRUE(actor_->AddResourceUnit(pod).IsOk());
+    };
+    addPod("pod-0", "1.024000", "512.000000");
+    auto held = actor_->GetResourceInfo();
+    ASSERT_NE(held.bucketShapeIndex, nullptr);
+    EXPECT_EQ(held.bucketShapeIndex->Size(), 1u);
+    EXPECT_NE(BucketShapeIndex::Find(*held.resourceUnit, BucketKeys::Of(500, 512)), nullptr);
+
+    // a pod of a known shape does not change the index
+    addPod("pod-1", "1.024000", "512.000000");
+    EXPECT_EQ(actor_->GetResourceInfo().bucketShapeIndex, held.bucketShapeIndex);
+
+    addPod("pod-2", "2.048000", "1024.000000");
+    auto next = actor_->GetResourceInfo();
+    EXPECT_NE(next.bucketShapeIndex, held.bucketShapeIndex);
+    EXPECT_EQ(held.bucketShapeIndex->Size(), 1u);
+    EXPECT_EQ(next.bucketShapeIndex->Size(), 2u);
+    BucketKeys found;
+    const auto *bucket = next.bucketShapeIndex->BestFit(*next.resourceUnit, BucketShape::Of(400, 600), found);
+    ASSERT_NE(bucket, nullptr);
+    EXPECT_TRUE(found == BucketKeys::Of(500, 1024));
+    EXPECT_EQ(bucket->allocatable().count("pod-2"), 1u);
+}
+
+/**
+ * Snapshot cost of a domain-scale view, 5000 agents holding 100000 instances, a round changes 10 agents.
+ * Output: the average cost of a full copy of the view, of the first snapshot, of a snapshot of an unchanged view
+ * and of a snapshot patched with the changed agents while the previous snapshot is still held by a consumer.
+ */
+TEST_F(ResourceViewSnapshotBenchmarkTest, BenchmarkSnapshotDomainScale)
+{
+    AddAgents(AGENT_COUNT, INSTANCES_PER_AGENT);
+    auto view = actor_->GetResourceView();
+    ASSERT_EQ(view->instances_size(), AGENT_COUNT * INSTANCES_PER_AGENT);
+
+    auto fullCopy = AverageMs(ROUNDS, [&view](int32_t) { ResourceUnit copy(*view); });
+    std::shared_ptr<const ResourceUnit> held;
+    auto first = AverageMs(1, [this, &held](int32_t) { held = actor_->GetResourceInfo().resourceUnit; });
+    auto unchanged = AverageMs(ROUNDS, [this](int32_t) { actor_->GetResourceInfo(); });
+
+    // warm up the second snapshot, the rounds then alternate between the two
+    ChangeAgents(CHANGED_AGENTS, 0);
+    held = actor_->GetResourceInfo().resourceUnit;
+    double changeCost = AverageMs(ROUNDS, [this](int32_t round) { ChangeAgents(CHANGED_AGENTS, round + 1); });
+    auto patched = AverageMs(ROUNDS, [this, &held](int32_t round) {
+        ChangeAgents(CHANGED_AGENTS, ROUNDS + round + 1);
+        held = actor_->GetResourceInfo().resourceUnit;
+    }) - changeCost;
+
+    EXPECT_EQ(held->instances_size(), view->instances_size());
+    EXPECT_EQ(held->fragment_size(), view->fragment_size());
+    std::cout << std::fixed << std::setprecision(3) << "agents: " << AGENT_COUNT
+              << ", instances: " << view->instances_size() << ", changed agents per round: " << CHANGED_AGENTS
+              << std::endl
+              << "full copy: " << fullCopy << " ms, first snapshot: " << first << " ms, unchanged: " << unchanged
+              << " ms, patched: " << patched << " ms" << std::endl;
+}
+
+}  // namespace functionsystem::test
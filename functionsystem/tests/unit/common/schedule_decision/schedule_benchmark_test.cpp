@@ -21,6 +21,7 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <thread>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -43,9 +44,12 @@
 #include "common/schedule_plugin/prefilter/default_prefilter/default_prefilter.h"
 #include "common/schedule_plugin/filter/default_filter/default_filter.h"
 #include "common/schedule_plugin/filter/default_heterogeneous_filter/default_heterogeneous_filter.h"
+#include "common/schedule_plugin/filter/label_affinity_filter/label_affinity_filter.h"
 #include "common/schedule_plugin/filter/resource_selector_filter/resource_selector_filter.h"
 #include "common/schedule_plugin/scorer/default_heterogeneous_scorer/default_heterogeneous_scorer.h"
 #include "common/schedule_plugin/scorer/default_scorer/default_scorer.h"
+#include "common/schedule_plugin/scorer/label_affinity_scorer/label_affinity_scorer.h"
+#include "common/scheduler_framework/utils/label_affinity_selector.h"
 
 namespace functionsystem::test {
 using namespace ::testing;
@@ -71,9 +75,11 @@ public:
         scheduler_ = nullptr;
     }
 
-    void SetUpForTest(int32_t relaxed, const std::string &aggregatedStrategy = "no_aggregate")
+    static std::shared_ptr<functionsystem::schedule_framework::FrameworkImpl> NewFramework(int32_t relaxed,
+                                                                                         int32_t parallelism = 0,
+                                                                                         bool withLabel = false)
     {
-        auto fw = std::make_shared<functionsystem::schedule_framework::FrameworkImpl>(relaxed);
+        auto fw = std::make_shared<functionsystem::schedule_framework::FrameworkImpl>(relaxed, parallelism);
         // prefilter plugin
         fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::prefilter::DefaultPreFilter>());
 
@@ -82,10 +88,25 @@ public:
         fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::filter::DefaultHeterogeneousFilter>());
         fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::filter::ResourceSelectorFilter>());
         // strict root
+        if (withLabel) {
+            bool isRelaxed = false;
+            bool isRootDomainLevel = true;
+            fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::filter::LabelAffinityFilter>(
+                isRelaxed, isRootDomainLevel));
+        }
 
         // scorer plugin
         fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::score::DefaultHeterogeneousScorer>());
         fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::scorer::DefaultScorer>());
+        if (withLabel) {
+            fw->RegisterPolicy(std::make_shared<functionsystem::schedule_plugin::score::LabelAffinityScorer>(false));
+        }
+        return fw;
+    }
+
+    void SetUpForTest(int32_t relaxed, const std::string &aggregatedStrategy = "no_aggregate")
+    {
+        auto fw = NewFramework(relaxed);
 
         // resource view
         mockResourceView_ = MockResourceView::CreateMockResourceView();
@@ -171,6 +192,36 @@ public:
         return unit;
     }
 
+    // shared units of different sizes, so that the units get different scores
+    static resource_view::ResourceUnit MakeVariedFragmentResourceUnit(int32_t ids)
+    {
+        resource_view::ResourceUnit unit;
+        unit.set_id("domain");
+        for (int32_t i = 0; i < ids; i++) {
+            auto frag = functionsystem::test::schedule_plugin::GetAgentResourceUnit(300.0 + i % 97, 128.0 + i % 89, 1);
+            auto id = std::to_string(i);
+            frag.set_id(id);
+            (*unit.mutable_fragment())[id] = std::move(frag);
+        }
+        return unit;
+    }
+
+    static std::vector<std::pair<std::string, int64_t>> SelectFeasible(
+        const std::shared_ptr<functionsystem::schedule_framework::FrameworkImpl> &fw,
+        const resource_view::InstanceInfo &instance, const resource_view::ResourceUnit &unit, uint32_t expected)
+    {
+        ::google::protobuf::Map<std::string, messages::PluginContext> pluginCtx;
+        auto ctx = std::make_shared<schedule_framework::PreAllocatedContext>();
+        ctx->pluginCtx = &pluginCtx;
+        auto results = fw->SelectFeasible(ctx, instance, unit, expected);
+        std::vector<std::pair<std::string, int64_t>> selected;
+        while (!results.sortedFeasibleNodes.empty()) {
+            selected.emplace_back(results.sortedFeasibleNodes.top().name, results.sortedFeasibleNodes.top().score);
+            results.sortedFeasibleNodes.pop();
+        }
+        return selected;
+    }
+
     struct TestResult {
         int numAgents;
         double avg;
@@ -356,7 +407,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryAgentCountsNoRelaxNoAggregate)
 
         auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
         resource_view::ResourceViewInfo resourceViewInfo;
-        resourceViewInfo.resourceUnit = resource;
+        resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
         EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
         auto totalReqs = totalAgent;
@@ -393,7 +444,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryRequestCountsNoRelaxNoAggregate)
 
     auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
     resource_view::ResourceViewInfo resourceViewInfo;
-    resourceViewInfo.resourceUnit = resource;
+    resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
     EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
     for (int totalreq : req_counts) {
@@ -435,7 +486,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryAgentCountsWithRelaxNoAggregate)
 
         auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
         resource_view::ResourceViewInfo resourceViewInfo;
-        resourceViewInfo.resourceUnit = resource;
+        resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
         EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
         auto totalReqs = totalAgent;
@@ -472,7 +523,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryRequestCountsWithRelaxNoAggregate)
 
     auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
     resource_view::ResourceViewInfo resourceViewInfo;
-    resourceViewInfo.resourceUnit = resource;
+    resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
     EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
     for (int totalreq : req_counts) {
@@ -514,7 +565,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryAgentCountsWithRelaxAndAggregate)
 
         auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
         resource_view::ResourceViewInfo resourceViewInfo;
-        resourceViewInfo.resourceUnit = resource;
+        resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
         EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
         auto totalReqs = totalAgent;
@@ -551,7 +602,7 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryRequestCountsWithRelaxAndAggregate)
 
     auto resource = MakeMultiFragmentTestResourceUnit(totalAgent, 300.0, 128.0);
     resource_view::ResourceViewInfo resourceViewInfo;
-    resourceViewInfo.resourceUnit = resource;
+    resourceViewInfo.resourceUnit = std::make_shared<resource_view::ResourceUnit>(resource);
     EXPECT_CALL(*mockResourceView_, GetResourceInfo).WillRepeatedly(Return(resourceViewInfo));
 
     for (int totalreq : req_counts) {
@@ -571,4 +622,85 @@ TEST_F(ScheduleBenchmarkTest, BenchmarkVaryRequestCountsWithRelaxAndAggregate)
     ProcessData(results);
 }
 
+/**
+ * The units selected by the parallel candidate evaluation are the same as the units selected one by one, in the same
+ * order, with and without relaxed mode, round after round of the same framework.
+ */
+TEST_F(ScheduleBenchmarkTest, ParallelSelectFeasibleSameAsSerial)
+{
+    auto resource = MakeVariedFragmentResourceUnit(2000);
+    auto instance = view_utils::GetInstanceWithResourceAndPriority(0, 1.0, 1.0);
+    instance.mutable_scheduleoption()->set_schedpolicyname("shared");
+    for (int32_t relaxed : { -1, 1, 10, 500 }) {
+        auto serial = NewFramework(relaxed);
+        auto parallel = NewFramework(relaxed, 4);
+        for (int32_t round = 0; round < 3; ++round) {
+            auto expected = SelectFeasible(serial, instance, resource, 1);
+            ASSERT_FALSE(expected.empty());
+            EXPECT_EQ(SelectFeasible(parallel, instance, resource, 1), expected) << "relaxed: " << relaxed;
+        }
+    }
+}
+
+/**
+ * With the label affinity plugins registered as in a domain scheduler, a request without label affinity is evaluated in
+ * parallel and a request with label affinity one unit after another, both select the same units as the serial loop.
+ */
+TEST_F(ScheduleBenchmarkTest, ParallelSelectFeasibleWithLabelPluginsSameAsSerial)
+{
+    auto resource = MakeVariedFragmentResourceUnit(2000);
+    auto instance = view_utils::GetInstanceWithResourceAndPriority(0, 1.0, 1.0);
+    instance.mutable_scheduleoption()->set_schedpolicyname("shared");
+    auto affinityInstance = instance;
+    (*affinityInstance.mutable_scheduleoption()->mutable_affinity()->mutable_resource()->mutable_requiredaffinity()) =
+        Selector(false, { { NotExist("key1") } });
+
+    auto serial = NewFramework(-1, 0, true);
+    auto parallel = NewFramework(-1, 4, true);
+    EXPECT_TRUE(parallel->IsConcurrencySafe(instance));
+    EXPECT_FALSE(parallel->IsConcurrencySafe(affinityInstance));
+    for (const auto &request : { instance, affinityInstance }) {
+        for (int32_t round = 0; round < 3; ++round) {
+            auto expected = SelectFeasible(serial, request, resource, 1);
+            ASSERT_FALSE(expected.empty());
+            EXPECT_EQ(SelectFeasible(parallel, request, resource, 1), expected);
+        }
+    }
+}
+
+/**
+ * Test the speedup of the parallel candidate evaluation of SelectFeasible.
+ * - Disabled relaxed mode, every unit is filtered and scored.
+ * Parameters(Set the parameter range for performance testing as needed):
+ *   - agentCount: 10000 (number of shared agents).
+ *   - parallelisms: {1, 2, 4, 8} (number of threads evaluating the candidates, 1 is the serial loop).
+ *   - rounds: 20 (number of SelectFeasible per parallelism).
+ * Output: The average cost of a SelectFeasible and the speedup against the serial loop per parallelism.
+ */
+TEST_F(ScheduleBenchmarkTest, BenchmarkParallelSelectFeasibleSpeedup)
+{
+    const int32_t agentCount = 10000;
+    const std::vector<int32_t> parallelisms = { 1, 2, 4, 8 };
+    const int32_t rounds = 20;
+    auto resource = MakeVariedFragmentResourceUnit(agentCount);
+    auto instance = view_utils::GetInstanceWithResourceAndPriority(0, 1.0, 1.0);
+    instance.mutable_scheduleoption()->set_schedpolicyname("shared");
+
+    double serialCost = 0;
+    std::cout << std::fixed << std::setprecision(3) << "agents: " << agentCount
+              << ", cores: " << std::thread::hardware_concurrency() << std::endl;
+    for (auto parallelism : parallelisms) {
+        auto fw = NewFramework(-1, parallelism);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int32_t i = 0; i < rounds; ++i) {
+            EXPECT_EQ(SelectFeasible(fw, instance, resource, 1).size(), static_cast<size_t>(agentCount));
+        }
+        auto cost = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start)
+                        .count() / rounds;
+        serialCost = parallelism == 1 ? cost : serialCost;
+        std::cout << "parallelism: " << parallelism << " | cost: " << cost << " ms | speedup: " << serialCost / cost
+                  << std::endl;
+    }
+}
+
 }  // namespace functionsystem::test
\ No newline at end of file
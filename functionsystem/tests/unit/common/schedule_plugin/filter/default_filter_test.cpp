@@ -32,10 +32,11 @@ class DefaultFilterTest : public Test {};
  * Description: Test default filter with MonopolyFilter is Error
  * Steps:
  * 2. MONOPOLY_MODE, pod is selected in context -> RESOURCE_NOT_ENOUGH
- * 3. MONOPOLY_MODE, pod resource is not match precisely -> RESOURCE_NOT_ENOUGH
+ * 3. MONOPOLY_MODE, pod resource is not match precisely -> RESOURCE_NOT_ENOUGH, unless it is the best fit pod
  * 4. MONOPOLY_MODE, instance cpu is very small -> INVALID_RESOURCE_PARAMETER
  * 5. MONOPOLY_MODE, total monopoly num is 0 -> RESOURCE_NOT_ENOUGH
  * 6. MONOPOLY_MODE, total monopoly num is 1 -> SUCCESS
+ * 7. MONOPOLY_MODE, pod of a shape whose proportion key does not give back its cpu exactly -> SUCCESS
  */
 TEST_F(DefaultFilterTest, MonopolyFilterTest)
 {
@@ -68,6 +69,19 @@ TEST_F(DefaultFilterTest, MonopolyFilterTest)
         EXPECT_STREQ(res.status.GetMessage().c_str(), "[(500, 512) Don't Match Precisely]");
         EXPECT_EQ(res.availableForRequest, -1);
     }
+    // MONOPOLY_MODE, pod is the larger shape selected by the prefilter for the request -> SUCCESS
+    {
+        unit = GetAgentResourceUnit(1000, 512, 1);
+        preAllocated->bestFitRequestID = ins.requestid();
+        preAllocated->bestFitKeys = resource_view::BucketKeys::Of(1000, 512);
+        auto res = filter.Filter(preAllocated, ins, unit);
+        EXPECT_EQ(res.status.StatusCode(), StatusCode::SUCCESS);
+
+        preAllocated->bestFitRequestID = "otherRequest";
+        res = filter.Filter(preAllocated, ins, unit);
+        EXPECT_STREQ(res.status.GetMessage().c_str(), "[(500, 512) Don't Match Precisely]");
+        preAllocated->bestFitRequestID.clear();
+    }
     // MONOPOLY_MODE, instance cpu is very small -> INVALID_RESOURCE_PARAMETER
     {
         unit = GetAgentResourceUnit(0, 512, 1);
@@ -94,6 +108,25 @@ TEST_F(DefaultFilterTest, MonopolyFilterTest)
         EXPECT_EQ(res.status.StatusCode(), StatusCode::SUCCESS);
         EXPECT_EQ(res.availableForRequest, 1);
     }
+    // MONOPOLY_MODE, pod (3000, 4096) keyed by proportion 1.365333 -> SUCCESS, as the best fit of a smaller instance
+    // too
+    {
+        unit = GetAgentResourceUnit(3000, 4096, 1);
+        auto index = std::make_shared<resource_view::BucketShapeIndex>();
+        (void)index->Update(unit);
+        preAllocated->bucketShapeIndex = index;
+        ins = GetInstance("instance1", "monopoly", 4096, 3000);
+        auto res = filter.Filter(preAllocated, ins, unit);
+        EXPECT_EQ(res.status.StatusCode(), StatusCode::SUCCESS);
+
+        ins = GetInstance("instance2", "monopoly", 4096, 2000);
+        preAllocated->bestFitRequestID = ins.requestid();
+        preAllocated->bestFitKeys = resource_view::BucketKeys::Of(3000, 4096);
+        res = filter.Filter(preAllocated, ins, unit);
+        EXPECT_EQ(res.status.StatusCode(), StatusCode::SUCCESS);
+        preAllocated->bestFitRequestID.clear();
+        preAllocated->bucketShapeIndex = nullptr;
+    }
 }
 
 /**
@@ -210,4 +243,112 @@ TEST_F(DefaultFilterTest, ResourceFilterTest)
     }
 }
 
+/**
+ * Description: Test default filter reading the resource matrix of the snapshot
+ * Steps:
+ * 1. the units fit, run out of capacity or are not enough, same as reading the protobuf view
+ * 2. a pre-allocated unit is read from the protobuf view
+ * 3. a resource no unit has --> PARAMETER_ERROR
+ */
+TEST_F(DefaultFilterTest, ResourceFilterWithMatrixTest)
+{
+    auto view = std::make_shared<resource_view::ResourceUnit>();
+    auto fit = GetAgentResourceUnit(2500, 2560, 1);
+    auto small = GetAgentResourceUnit(400, 2560, 1);
+    auto busy = GetAgentResourceUnit(2500, 2560, 1);
+    busy.mutable_allocatable()->mutable_resources()->at(resource_view::MEMORY_RESOURCE_NAME).mutable_scalar()
+        ->set_value(256);
+    for (const auto &unit : { fit, small, busy }) {
+        (*view->mutable_fragment())[unit.id()] = unit;
+    }
+    auto ins = GetInstance("instance1", "shared", 512, 500);
+    functionsystem::schedule_plugin::filter::DefaultFilter filter;
+    auto withMatrix = std::make_shared<PreAllocatedContext>();
+    withMatrix->resourceMatrix = std::make_shared<resource_view::ResourceMatrix>(view);
+    withMatrix->resourceFit = withMatrix->resourceMatrix->Fit(ins);
+    auto withoutMatrix = std::make_shared<PreAllocatedContext>();
+
+    for (const auto &unit : { fit, small, busy }) {
+        auto expected = filter.Filter(withoutMatrix, ins, unit);
+        auto res = filter.Filter(withMatrix, ins, unit);
+        EXPECT_EQ(res.status.StatusCode(), expected.status.StatusCode());
+        EXPECT_EQ(res.status.GetMessage(), expected.status.GetMessage());
+        EXPECT_EQ(res.required, expected.required);
+        EXPECT_EQ(res.availableForRequest, expected.availableForRequest);
+    }
+    EXPECT_EQ(filter.Filter(withMatrix, ins, fit).availableForRequest, 5);
+    EXPECT_STREQ(filter.Filter(withMatrix, ins, small).status.GetMessage().c_str(), "[CPU: Out Of Capacity]");
+    EXPECT_STREQ(filter.Filter(withMatrix, ins, busy).status.GetMessage().c_str(), "[Memory: Not Enough]");
+
+    // a pre-allocated unit is read from the protobuf view
+    resource_view::Resources rs = view_utils::GetCpuMemResources();
+    rs.mutable_resources()->at(resource_view::CPU_RESOURCE_NAME).mutable_scalar()->set_value(1500);
+    rs.mutable_resources()->at(resource_view::MEMORY_RESOURCE_NAME).mutable_scalar()->set_value(100);
+    withMatrix->allocated[fit.id()].resource = std::move(rs);
+    EXPECT_EQ(filter.Filter(withMatrix, ins, fit).availableForRequest, 2);
+
+    // a resource no unit has
+    (*ins.mutable_resources()->mutable_resources())["NotFoundResource"] =
+        view_utils::GetNameResourceWithValue("NotFoundResource", 100);
+    withMatrix->resourceFit = withMatrix->resourceMatrix->Fit(ins);
+    auto res = filter.Filter(withMatrix, ins, busy);
+    auto expected = filter.Filter(withoutMatrix, ins, busy);
+    EXPECT_EQ(res.status.StatusCode(), expected.status.StatusCode());
+    EXPECT_EQ(res.status.GetMessage(), expected.status.GetMessage());
+    EXPECT_EQ(res.required, expected.required);
+}
+
+/**
+ * Description: Test default filter reading the resource matrix fails a unit with the first resource it misses
+ * Steps:
+ * 1. a unit one cpu short and a resource no unit has --> the same failure as reading the protobuf view
+ * 2. a unit having every other resource --> PARAMETER_ERROR of the resource no unit has
+ * 3. a request below the fixed point of the matrix --> not met by a unit having none of it
+ */
+TEST_F(DefaultFilterTest, ResourceFilterWithMatrixAbsentResourceTest)
+{
+    auto view = std::make_shared<resource_view::ResourceUnit>();
+    auto fit = GetAgentResourceUnit(2500, 2560, 1);
+    auto cpuShort = GetAgentResourceUnit(2500, 2560, 1);
+    cpuShort.mutable_allocatable()->mutable_resources()->at(resource_view::CPU_RESOURCE_NAME).mutable_scalar()
+        ->set_value(499);
+    for (const auto &unit : { fit, cpuShort }) {
+        (*view->mutable_fragment())[unit.id()] = unit;
+    }
+    auto ins = GetInstance("instance1", "shared", 512, 500);
+    (*ins.mutable_resources()->mutable_resources())["NotFoundResource"] =
+        view_utils::GetNameResourceWithValue("NotFoundResource", 100);
+    functionsystem::schedule_plugin::filter::DefaultFilter filter;
+    auto withMatrix = std::make_shared<PreAllocatedContext>();
+    withMatrix->resourceMatrix = std::make_shared<resource_view::ResourceMatrix>(view);
+    withMatrix->resourceFit = withMatrix->resourceMatrix->Fit(ins);
+    auto withoutMatrix = std::make_shared<PreAllocatedContext>();
+
+    for (const auto &unit : { fit, cpuShort }) {
+        auto expected = filter.Filter(withoutMatrix, ins, unit);
+        auto res = filter.Filter(withMatrix, ins, unit);
+        EXPECT_EQ(res.status.StatusCode(), expected.status.StatusCode());
+        EXPECT_EQ(res.status.GetMessage(), expected.status.GetMessage());
+        EXPECT_EQ(res.required, expected.required);
+    }
+    auto res = filter.Filter(withMatrix, ins, fit);
+    EXPECT_EQ(res.status.StatusCode(), StatusCode::PARAMETER_ERROR);
+    EXPECT_STREQ(res.status.GetMessage().c_str(), "[NotFoundResource: Not Found]");
+    EXPECT_STREQ(res.required.c_str(), "NotFoundResource: 100");
+
+    // a request below the fixed point of the matrix
+    auto none = GetAgentResourceUnit(2500, 2560, 1);
+    (*none.mutable_capacity()->mutable_resources())["Tiny"] = view_utils::GetNameResourceWithValue("Tiny", 1);
+    (*none.mutable_allocatable()->mutable_resources())["Tiny"] = view_utils::GetNameResourceWithValue("Tiny", 0);
+    view->mutable_fragment()->clear();
+    (*view->mutable_fragment())[none.id()] = none;
+    auto tiny = GetInstance("instance2", "shared", 512, 500);
+    (*tiny.mutable_resources()->mutable_resources())["Tiny"] = view_utils::GetNameResourceWithValue("Tiny", 0.0004);
+    withMatrix->resourceMatrix = std::make_shared<resource_view::ResourceMatrix>(view);
+    withMatrix->resourceFit = withMatrix->resourceMatrix->Fit(tiny);
+    res = filter.Filter(withMatrix, tiny, none);
+    EXPECT_EQ(res.status.StatusCode(), filter.Filter(withoutMatrix, tiny, none).status.StatusCode());
+    EXPECT_EQ(res.status.StatusCode(), StatusCode::RESOURCE_NOT_ENOUGH);
+}
+
 }  // namespace functionsystem::test::schedule_plugin::filter
\ No newline at end of file
@@ -859,4 +859,82 @@ TEST_F(LabelAffinityFilterTest, GroupSchedulePolicyAffinityTest)
         EXPECT_EQ(result.status.IsOk(), true);
     }
 }
-}
\ No newline at end of file
+
+TEST_F(LabelAffinityFilterTest, ResourceRequiredAffinityWithLabelIndexTest)
+{
+    LabelAffinityFilter relaxedNonRootFilterPlugin(true, false);
+
+    auto local1 = NewResourceUnit("local1", {});
+    for (const auto &agent : { NewResourceUnit("agent1", { { "key1", "value1" }, { "key2", "value2" } }),
+                               NewResourceUnit("agent2", { { "key1", "value2" } }),
+                               NewResourceUnit("agent3", { { "key2", "value2" } }),
+                               NewResourceUnit("agent4", { { "key3", "value3" } }),
+                               NewResourceUnit("agent5", {}) }) {
+        AddFragmentToUnit(local1, agent);
+        (*local1.mutable_fragment())[agent.id()].set_ownerid(local1.id());
+    }
+    auto snapshot = std::make_shared<const resource_view::ResourceUnit>(local1);
+    auto labelIndex = std::make_shared<resource_view::LabelIndex>(snapshot);
+    EXPECT_EQ(labelIndex->Rows(), 5U);
+
+    auto newContext = [](const std::shared_ptr<const resource_view::LabelIndex> &index,
+                         const resource_view::InstanceInfo &instance,
+                         ::google::protobuf::Map<std::string, messages::PluginContext> &map) {
+        auto preAllocated = std::make_shared<schedule_framework::PreAllocatedContext>();
+        map[LABEL_AFFINITY_PLUGIN].mutable_affinityctx()->set_maxscore(100);
+        preAllocated->pluginCtx = &map;
+        if (index != nullptr) {
+            preAllocated->labelIndex = index;
+            preAllocated->labelFit = index->Fit(instance);
+        }
+        return preAllocated;
+    };
+
+    std::vector<std::pair<affinity::Selector, affinity::Selector>> cases = {
+        { Selector(false, { { Exist("key1") }, { Exist("key2") } }), affinity::Selector() },
+        { Selector(false, { { In("key1", { "value1", "value2" }) } }), Selector(false, { { Exist("key2") } }) },
+        { Selector(true, { { In("key2", { "value2" }) }, { NotIn("key1", { "value1" }) } }), affinity::Selector() },
+        { Selector(false, { { NotExist("key3") } }), Selector(true, { { In("key1", { "value2" }) } }) },
+        { affinity::Selector(), Selector(false, { { Exist("key1"), NotExist("key2") } }) },
+    };
+    std::vector<std::vector<bool>> expected = {
+        { true, false, false, false, false },
+        { false, true, false, false, false },
+        { true, true, true, true, true },
+        { true, false, true, false, true },
+        { true, false, true, true, true },
+    };
+    auto instance1 = view_utils::Get1DInstance();
+    for (size_t i = 0; i < cases.size(); ++i) {
+        instance1.mutable_scheduleoption()->clear_affinity();
+        auto resourceAffinity = instance1.mutable_scheduleoption()->mutable_affinity()->mutable_resource();
+        if (cases[i].first.condition().subconditions_size() > 0) {
+            (*resourceAffinity->mutable_requiredaffinity()) = cases[i].first;
+        }
+        if (cases[i].second.condition().subconditions_size() > 0) {
+            (*resourceAffinity->mutable_requiredantiaffinity()) = cases[i].second;
+        }
+        ::google::protobuf::Map<std::string, messages::PluginContext> indexedMap;
+        ::google::protobuf::Map<std::string, messages::PluginContext> plainMap;
+        auto indexed = newContext(labelIndex, instance1, indexedMap);
+        auto plain = newContext(nullptr, instance1, plainMap);
+        for (size_t agent = 0; agent < expected[i].size(); ++agent) {
+            const auto &unit = snapshot->fragment().at("agent" + std::to_string(agent + 1));
+            EXPECT_GE(schedule_framework::LabelFittedRow(*indexed, instance1, unit), 0);
+            auto result = relaxedNonRootFilterPlugin.Filter(indexed, instance1, unit);
+            EXPECT_EQ(result.status.IsOk(), expected[i][agent]) << "case " << i << " " << unit.id();
+            // the protobuf view decides the same
+            EXPECT_EQ(relaxedNonRootFilterPlugin.Filter(plain, instance1, unit).status.IsOk(), result.status.IsOk())
+                << "case " << i << " " << unit.id();
+        }
+    }
+
+    // a copy of a fragment is read from its own labels
+    auto copied = snapshot->fragment().at("agent4");
+    (*copied.mutable_nodelabels())["key1"] = GetCounter("value1", 1);
+    ::google::protobuf::Map<std::string, messages::PluginContext> map;
+    auto indexed = newContext(labelIndex, instance1, map);
+    EXPECT_EQ(schedule_framework::LabelFittedRow(*indexed, instance1, copied), -1);
+    EXPECT_EQ(relaxedNonRootFilterPlugin.Filter(indexed, instance1, copied).status.IsOk(), false);
+}
+}
@@ -183,4 +183,78 @@ TEST_F(DefaultPrefilterTest, PrecisePreFilter)
     }
 }
 
-}  // namespace functionsystem::test::schedule_plugin::prefilter
\ No newline at end of file
+/**
+ * Description: Test PrecisePreFilter of BestFitPreFilter
+ * Steps:
+ * 1. no pod of the shape of the instance -> return OK and the pods of the smallest larger shape
+ * 2. instance larger than every pod -> return RESOURCE_NOT_ENOUGH
+ * 3. pod of a shape whose proportion key does not give back its cpu exactly -> return OK and the pods of the shape,
+ *    a smaller instance is placed in it through the bucket shape index
+ */
+TEST_F(DefaultPrefilterTest, BestFitPreFilter)
+{
+    functionsystem::schedule_plugin::prefilter::DefaultPreFilter filter(true);
+    EXPECT_EQ(filter.GetPluginName(), functionsystem::schedule_plugin::BEST_FIT_PREFILTER_NAME);
+    auto correctPreAllocated = std::make_shared<PreAllocatedContext>();
+    resource_view::ResourceUnit unit;
+    resource_view::InstanceInfo ins;
+
+    // input instance with no proportion bucketIndex in ResourceView-> return the smallest larger pod (500, 1024)
+    {
+        ins = GetInstance("instance1", "monopoly", 512, 500);
+        unit = GetNewLocalResourceUnit(true, false, false, 1);
+        auto filterRet = filter.PreFilter(correctPreAllocated, ins, unit);
+        EXPECT_EQ(filterRet->status().StatusCode(), StatusCode::SUCCESS);
+        EXPECT_EQ(correctPreAllocated->bestFitRequestID, ins.requestid());
+        EXPECT_TRUE(correctPreAllocated->bestFitKeys == resource_view::BucketKeys::Of(500, 1024));
+        auto allocatable = unit.bucketindexs().at("2.048000").buckets().at("1024.000000").allocatable();
+        int cnt = 0;
+        for (; !filterRet->end(); filterRet->next()) {
+            EXPECT_TRUE(allocatable.find(filterRet->current()) != allocatable.end());
+            cnt++;
+        }
+        EXPECT_EQ(cnt, static_cast<int>(allocatable.size()));
+    }
+    // input instance with no mem bucketInfo in ResourceView-> return the smallest larger pod (1000, 2048)
+    {
+        ins = GetInstance("instance1", "monopoly", 512, 500);
+        unit = GetNewLocalResourceUnit(true, true, false, 1);
+        auto filterRet = filter.PreFilter(correctPreAllocated, ins, unit);
+        EXPECT_EQ(filterRet->status().StatusCode(), StatusCode::SUCCESS);
+        EXPECT_TRUE(correctPreAllocated->bestFitKeys == resource_view::BucketKeys::Of(1000, 2048));
+    }
+    // input instance larger than every pod in ResourceView-> return RESOURCE_NOT_ENOUGH
+    {
+        ins = GetInstance("instance1", "monopoly", 8192, 500);
+        unit = GetNewLocalResourceUnit(true, true, true, 1);
+        auto filterRet = filter.PreFilter(correctPreAllocated, ins, unit);
+        std::string errMsg = "[(500, 8192) Not Found]";
+        EXPECT_EQ(filterRet->status().StatusCode(), StatusCode::RESOURCE_NOT_ENOUGH);
+        EXPECT_EQ(filterRet->status().GetMessage(), errMsg);
+    }
+    // input instance of pod (3000, 4096), keyed by proportion 1.365333 -> return SUCCESS and the pod, also when no pod
+    // of the shape of a smaller instance is left
+    {
+        unit = GetAgentResourceUnit(3000, 4096, 1);
+        auto index = std::make_shared<resource_view::BucketShapeIndex>();
+        EXPECT_EQ(index->Update(unit), 1u);
+        correctPreAllocated->bucketShapeIndex = index;
+        correctPreAllocated->bestFitRequestID.clear();
+        ins = GetInstance("instance1", "monopoly", 4096, 3000);
+        auto filterRet = filter.PreFilter(correctPreAllocated, ins, unit);
+        EXPECT_EQ(filterRet->status().StatusCode(), StatusCode::SUCCESS);
+        EXPECT_TRUE(correctPreAllocated->bestFitRequestID.empty());
+        ASSERT_FALSE(filterRet->end());
+        EXPECT_EQ(filterRet->current(), unit.id());
+
+        ins = GetInstance("instance2", "monopoly", 4096, 2000);
+        filterRet = filter.PreFilter(correctPreAllocated, ins, unit);
+        EXPECT_EQ(filterRet->status().StatusCode(), StatusCode::SUCCESS);
+        EXPECT_EQ(correctPreAllocated->bestFitRequestID, ins.requestid());
+        EXPECT_TRUE(correctPreAllocated->bestFitKeys == resource_view::BucketKeys::Of(3000, 4096));
+        ASSERT_FALSE(filterRet->end());
+        EXPECT_EQ(filterRet->current(), unit.id());
+    }
+}
+
+}  // namespace functionsystem::test::schedule_plugin::prefilter
@@ -75,4 +75,30 @@ TEST_F(DefaultScorerTest, DefaultScorer)
     }
 }
 
+/**
+ * Description: Test DefaultScorer reading the resource matrix of the snapshot
+ * 1. return the same score as reading the protobuf view
+ */
+TEST_F(DefaultScorerTest, DefaultScorerWithMatrix)
+{
+    auto view = std::make_shared<resource_view::ResourceUnit>();
+    std::vector<resource_view::ResourceUnit> units = { GetAgentResourceUnit(1000, 1024, 1),
+                                                       GetAgentResourceUnit(3000, 2048, 1),
+                                                       GetAgentResourceUnit(700, 9000, 1) };
+    for (const auto &unit : units) {
+        (*view->mutable_fragment())[unit.id()] = unit;
+    }
+    auto ins = GetInstance("instance1", "shared", 512, 500);
+    functionsystem::schedule_plugin::scorer::DefaultScorer scorer;
+    auto withMatrix = std::make_shared<PreAllocatedContext>();
+    withMatrix->resourceMatrix = std::make_shared<resource_view::ResourceMatrix>(view);
+    withMatrix->resourceFit = withMatrix->resourceMatrix->Fit(ins);
+    auto withoutMatrix = std::make_shared<PreAllocatedContext>();
+
+    for (const auto &unit : units) {
+        EXPECT_EQ(scorer.Score(withMatrix, ins, unit).score, scorer.Score(withoutMatrix, ins, unit).score);
+    }
+    EXPECT_EQ(scorer.Score(withMatrix, ins, units[0]).score, 50);
+}
+
 }  // namespace functionsystem::test::schedule_plugin::scorer
\ No newline at end of file
@@ -465,4 +465,46 @@ TEST_F(LabelAffinityScorerTest, GroupScheduleAffinityTest)
     }
 }
 
-}
\ No newline at end of file
+TEST_F(LabelAffinityScorerTest, ResourceAffinityWithLabelIndexTest)
+{
+    LabelAffinityScorer relaxedScorerPlugin(true);
+
+    auto local1 = NewResourceUnit("local1", {});
+    for (const auto &agent : { NewResourceUnit("agent1", { { "key1", "value1" } }),
+                               NewResourceUnit("agent2", { { "key2", "value2" } }),
+                               NewResourceUnit("agent3", { { "key3", "value3" } }) }) {
+        AddFragmentToUnit(local1, agent);
+        (*local1.mutable_fragment())[agent.id()].set_ownerid(local1.id());
+    }
+    auto snapshot = std::make_shared<const resource_view::ResourceUnit>(local1);
+    auto labelIndex = std::make_shared<resource_view::LabelIndex>(snapshot);
+
+    auto instance1 = view_utils::Get1DInstance();
+    auto resourceAffinity = instance1.mutable_scheduleoption()->mutable_affinity()->mutable_resource();
+    (*resourceAffinity->mutable_preferredaffinity()) = Selector(true, { { Exist("key1") }, { Exist("key2") } });
+    (*resourceAffinity->mutable_preferredantiaffinity()) = Selector(true, { { Exist("key3") } });
+    (*resourceAffinity->mutable_requiredaffinity()) = Selector(true, { { Exist("key1") }, { Exist("key2") } });
+
+    auto newContext = [](::google::protobuf::Map<std::string, messages::PluginContext> &map) {
+        auto preAllocated = std::make_shared<schedule_framework::PreAllocatedContext>();
+        map[LABEL_AFFINITY_PLUGIN].mutable_affinityctx()->set_maxscore(300);
+        preAllocated->pluginCtx = &map;
+        return preAllocated;
+    };
+    ::google::protobuf::Map<std::string, messages::PluginContext> indexedMap;
+    ::google::protobuf::Map<std::string, messages::PluginContext> plainMap;
+    auto indexed = newContext(indexedMap);
+    indexed->labelIndex = labelIndex;
+    indexed->labelFit = labelIndex->Fit(instance1);
+    auto plain = newContext(plainMap);
+
+    std::vector<int64_t> expected = { 300, 280, 0 };
+    for (size_t agent = 0; agent < expected.size(); ++agent) {
+        const auto &unit = snapshot->fragment().at("agent" + std::to_string(agent + 1));
+        EXPECT_GE(schedule_framework::LabelFittedRow(*indexed, instance1, unit), 0);
+        EXPECT_EQ(relaxedScorerPlugin.Score(indexed, instance1, unit).score, expected[agent]) << unit.id();
+        EXPECT_EQ(relaxedScorerPlugin.Score(plain, instance1, unit).score, expected[agent]) << unit.id();
+    }
+}
+
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <gtest/gtest.h>
+
+#include "async/async.hpp"
+#include "async/collect.hpp"
+#include "kv_service_actor.h"
+#include "kv_shard_router.h"
+#include "logs/logging.h"
+#include "meta_store_client/utils/string_util.h"
+#include "mock_store_client.h"
+#include "watch_service_actor.h"
+
+namespace functionsystem::meta_store::test {
+
+// drops the responses of the kv service
+class BenchmarkSinkActor : public litebus::ActorBase {
+public:
+    explicit BenchmarkSinkActor(const std::string &name) : litebus::ActorBase(name)
+    {
+    }
+
+protected:
+    void Init() override
+    {
+        Receive("OnPut", &BenchmarkSinkActor::OnResponse);
+        Receive("OnGet", &BenchmarkSinkActor::OnResponse);
+    }
+
+private:
+    void OnResponse(const litebus::AID &, std::string &&, std::string &&)
+    {
+    }
+};
+
+class MetaStoreBenchmarkTest : public ::testing::Test {
+public:
+    void SetUp() override
+    {
+        kvActor_ = std::make_shared<meta_store::KvServiceActor>();
+    }
+
+    void TearDown() override
+    {
+        kvActor_ = nullptr;
+    }
+
+    void PutKeys()
+    {
+        etcdserverpb::PutRequest putRequest;
+        etcdserverpb::PutResponse putResponse;
+        // KEY_COUNT keys spread over PREFIX_COUNT prefixes, like the instance keys of many functions
+        for (int32_t i = 0; i < KEY_COUNT; ++i) {
+            putRequest.set_key(Prefix(i % PREFIX_COUNT) + std::to_string(i));
+            putRequest.set_value("value" + std::to_string(i));
+            kvActor_->Put(&putRequest, &putResponse);
+        }
+    }
+
+    static std::string Prefix(int32_t index)
+    {
+        return "/sn/instance/business/yrk/tenant/0/function/" + std::to_string(index) + "/";
+    }
+
+    // runs the request ROUNDS times over the prefixes and prints the average latency
+    void Run(const std::string &name, etcdserverpb::RangeRequest request, int64_t expectKvs)
+    {
+        int64_t kvs = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int32_t i = 0; i < ROUNDS; ++i) {
+            auto prefix = Prefix(i % PREFIX_COUNT);
+            request.set_key(prefix);
+            request.set_range_end(prefix.substr(0, prefix.size() - 1) + "0");
+            etcdserverpb::RangeResponse response;
+            (void)kvActor_->Range(&request, &response);
+            kvs += response.kvs_size();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout << std::fixed << std::setprecision(2) << name << " | keys: " << KEY_COUNT
+                  << " | rounds: " << ROUNDS << " | avg latency(us): " << us / ROUNDS << std::endl;
+        EXPECT_EQ(kvs, expectKvs * ROUNDS);
+    }
+
+protected:
+    static constexpr int32_t KEY_COUNT = 1000000;
+    static constexpr int32_t PREFIX_COUNT = 1000;
+    static constexpr int32_t ROUNDS = 1000;
+    std::shared_ptr<meta_store::KvServiceActor> kvActor_;
+};
+
+/**
+ * Range latency over 1M keys, a prefix holds 1000 of them.
+ * Output: the average latency of a prefix get, a limited get, a descending limited get, a limited get sorted by mod
+ * revision and a count only get.
+ */
+TEST_F(MetaStoreBenchmarkTest, BenchmarkRangeOneMillionKeys)
+{
+    PutKeys();
+    const int64_t prefixKeys = KEY_COUNT / PREFIX_COUNT;
+    etcdserverpb::RangeRequest request;
+    Run("prefix", request, prefixKeys);
+
+    request.set_limit(10);
+    Run("prefix limit 10", request, 10);
+
+    request.set_sort_order(etcdserverpb::RangeRequest_SortOrder_DESCEND);
+    Run("prefix limit 10 descend", request, 10);
+
+    request.set_sort_target(etcdserverpb::RangeRequest_SortTarget_MOD);
+    Run("prefix limit 10 by mod", request, 10);
+
+    request.set_count_only(true);
+    Run("prefix count only", request, 0);
+}
+
+/**
+ * Put fan-out cost over a growing number of range watchers, each watches the prefix of one instance.
+ * Output: the average cost of matching a put to the range watchers with the prefix index and with a scan of all the
+ * watchers as before it.
+ */
+TEST_F(MetaStoreBenchmarkTest, BenchmarkWatchFanOut)
+{
+    const std::vector<int32_t> watcherCounts = { 100, 1000, 10000 };
+    const int32_t puts = 10000;
+    for (int32_t watcherCount : watcherCounts) {
+        auto watchActor = std::make_shared<WatchServiceActor>("BenchmarkWatchServiceActor");
+        auto client = std::make_shared<MockMetaStoreClientActor>("BenchmarkClient");
+        litebus::Spawn(watchActor);
+        litebus::Spawn(client);
+        for (int32_t i = 0; i < watcherCount; ++i) {
+            auto request = std::make_shared<::etcdserverpb::WatchCreateRequest>();
+            request->set_key(Prefix(i));
+            request->set_range_end(StringPlusOne(Prefix(i)));
+            (void)litebus::Async(watchActor->GetAID(), &WatchServiceActor::CreateWatch, client->GetAID(), request)
+                .Get();
+        }
+
+        // the actor is idle, drive the matching directly
+        ::mvccpb::KeyValue kv;
+        int64_t indexHits = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int32_t i = 0; i < puts; ++i) {
+            kv.set_key(Prefix(i % watcherCount) + "instance");
+            auto response = std::make_shared<UnsyncedEvents>();
+            watchActor->CheckIfValidRangeCacheAndUpdateResponse(kv, response);
+            indexHits += static_cast<int64_t>(response->to.size());
+        }
+        auto indexUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start);
+
+        int64_t scanHits = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int32_t i = 0; i < puts; ++i) {
+            kv.set_key(Prefix(i % watcherCount) + "instance");
+            auto response = std::make_shared<UnsyncedEvents>();
+            for (const auto &cache : watchActor->rangeObserverCaches_) {
+                if (kv.key() >= cache.second.keyPrefix && kv.key() < cache.second.keyPrefixEnd) {
+                    cache.second.UpdateResponseWithCache(response);
+                }
+            }
+            scanHits += static_cast<int64_t>(response->to.size());
+        }
+        auto scanUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start);
+
+        std::cout << std::fixed << std::setprecision(3) << "watchers: " << watcherCount << " | puts: " << puts
+                  << " | prefix index per put(us): " << indexUs.count() / puts
+                  << " | scan per put(us): " << scanUs.count() / puts << std::endl;
+        EXPECT_EQ(indexHits, puts);
+        EXPECT_EQ(scanHits, puts);
+
+        litebus::Terminate(watchActor->GetAID());
+        litebus::Await(watchActor->GetAID());
+        litebus::Terminate(client->GetAID());
+        litebus::Await(client->GetAID());
+    }
+}
+
+/**
+ * Mixed put and get throughput of the kv service on one actor and sharded by key prefix over several actors.
+ * Output: the ops per second of half puts and half gets over the keys of 4 prefixes and the rest, with 1 shard and
+ * with a shard per prefix and one for the rest.
+ */
+TEST_F(MetaStoreBenchmarkTest, BenchmarkShardedThroughput)
+{
+    const std::vector<std::string> prefixes = { "/sn/instance/", "/yr/route/", "/yr/functions/", "/yr/busproxy/" };
+    const std::string otherPrefix = "/yr/other/";
+    const int32_t ops = 200000;
+    const int32_t keysPerPrefix = 1000;
+    auto sink = std::make_shared<BenchmarkSinkActor>("BenchmarkSinkActor");
+    litebus::Spawn(sink);
+
+    double singleOpsPerSecond = 0;
+    for (bool sharded : { false, true }) {
+        auto router = std::make_shared<KvShardRouter>(sharded ? prefixes : std::vector<std::string>{});
+        std::vector<std::shared_ptr<KvServiceActor>> shards;
+        for (size_t i = 0; i < router->ShardCount(); ++i) {
+            auto actor = std::make_shared<KvServiceActor>("BenchmarkShard" + std::to_string(i));
+            actor->SetShard(router, i);
+            litebus::Spawn(actor);
+            shards.emplace_back(actor);
+        }
+
+        std::list<litebus::Future<Status>> futures;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int32_t i = 0; i < ops; ++i) {
+            // a round puts a key under every prefix, the next one gets them
+            auto index = static_cast<size_t>(i) % (prefixes.size() + 1);
+            auto round = i / static_cast<int32_t>(prefixes.size() + 1);
+            auto key = (index < prefixes.size() ? prefixes[index] : otherPrefix)
+                       + std::to_string((round / 2) % keysPerPrefix);
+            const auto &shard = shards[router->Route(key)];
+            if (round % 2 == 0) {
+                auto request = std::make_shared<messages::MetaStore::PutRequest>();
+                request->set_requestid(std::to_string(i));
+                request->set_key(key);
+                request->set_value("value" + std::to_string(i));
+                futures.emplace_back(
+                    litebus::Async(shard->GetAID(), &KvServiceActor::AsyncPut, sink->GetAID(), request));
+            } else {
+                etcdserverpb::RangeRequest range;
+                range.set_key(key);
+                auto request = std::make_shared<messages::MetaStoreRequest>();
+                request->set_requestid(std::to_string(i));
+                request->set_requestmsg(range.SerializeAsString());
+                futures.emplace_back(
+                    litebus::Async(shard->GetAID(), &KvServiceActor::AsyncGet, sink->GetAID(), request));
+            }
+        }
+        (void)litebus::Collect(futures).Get();
+        auto seconds =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        double opsPerSecond = ops / seconds;
+        if (!sharded) {
+            singleOpsPerSecond = opsPerSecond;
+        }
+        std::cout << std::fixed << std::setprecision(2) << "shards: " << shards.size() << " | ops: " << ops
+                  << " | ops/s: " << opsPerSecond << " | speedup: " << opsPerSecond / singleOpsPerSecond
+                  << std::endl;
+
+        size_t keys = 0;
+        for (const auto &shard : shards) {
+            keys += shard->cache_.size();
+            litebus::Terminate(shard->GetAID());
+            litebus::Await(shard->GetAID());
+        }
+        EXPECT_EQ(keys, (prefixes.size() + 1) * static_cast<size_t>(keysPerPrefix));
+    }
+    litebus::Terminate(sink->GetAID());
+    litebus::Await(sink->GetAID());
+}
+}  // namespace functionsystem::meta_store::test
@@ -21,8 +21,14 @@
 #include "proto/pb/message_pb.h"
 #include "kv_service_accessor_actor.h"
 #include "kv_service_actor.h"
+#include "kv_shard_router.h"
 #include "lease_service_actor.h"
+#include "local_persist_actor.h"
+#include "meta_store_common.h"
 #include "meta_store_driver.h"
+#include "prefix_trie.h"
+#include "revision_history.h"
+#include "wal_store.h"
 #include "watch_service_actor.h"
 #include "mock_store_client.h"
 #include "mocks/mock_etcd_kv_service.h"
@@ -486,6 +492,91 @@ TEST_F(MetaStoreTest, KvServiceActorTest)  // NOLINT
     EXPECT_FALSE(txnResponse.succeeded());
 }
 
+TEST_F(MetaStoreTest, KvServiceActorRangeTest)  // NOLINT
+{
+    auto kvActor = std::make_shared<meta_store::KvServiceActor>();
+    etcdserverpb::PutResponse putResponse;
+    for (const auto &key : { "/a", "/key/3", "/key/1", "/key/5", "/key/2", "/key/4", "/z" }) {
+        etcdserverpb::PutRequest putRequest;
+        putRequest.set_key(key);
+        putRequest.set_value(std::string("v") + key);
+        kvActor->Put(&putRequest, &putResponse);
+    }
+
+    etcdserverpb::RangeRequest request;
+    request.set_key("/key/");
+    request.set_range_end("/key0");
+    etcdserverpb::RangeResponse response;
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    EXPECT_EQ(response.count(), 5);
+    EXPECT_FALSE(response.more());
+    ASSERT_EQ(response.kvs_size(), 5);
+    EXPECT_EQ(response.kvs(0).key(), "/key/1");
+    EXPECT_EQ(response.kvs(4).key(), "/key/5");
+    EXPECT_EQ(response.kvs(4).value(), "v/key/5");
+
+    // limit keeps the total count and reports more
+    request.set_limit(2);
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    EXPECT_EQ(response.count(), 5);
+    EXPECT_TRUE(response.more());
+    ASSERT_EQ(response.kvs_size(), 2);
+    EXPECT_EQ(response.kvs(0).key(), "/key/1");
+    EXPECT_EQ(response.kvs(1).key(), "/key/2");
+
+    request.set_sort_order(etcdserverpb::RangeRequest_SortOrder_DESCEND);
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    ASSERT_EQ(response.kvs_size(), 2);
+    EXPECT_EQ(response.kvs(0).key(), "/key/5");
+    EXPECT_EQ(response.kvs(1).key(), "/key/4");
+
+    // "/key/4" is the latest put in the range
+    request.set_sort_target(etcdserverpb::RangeRequest_SortTarget_MOD);
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    ASSERT_EQ(response.kvs_size(), 2);
+    EXPECT_EQ(response.kvs(0).key(), "/key/4");
+    EXPECT_EQ(response.kvs(1).key(), "/key/2");
+
+    request.set_sort_order(etcdserverpb::RangeRequest_SortOrder_ASCEND);
+    request.set_keys_only(true);
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    ASSERT_EQ(response.kvs_size(), 2);
+    EXPECT_EQ(response.kvs(0).key(), "/key/3");
+    EXPECT_EQ(response.kvs(1).key(), "/key/1");
+    EXPECT_TRUE(response.kvs(0).value().empty());
+
+    request.set_count_only(true);
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&request, &response).ok());
+    EXPECT_EQ(response.count(), 5);
+    EXPECT_EQ(response.kvs_size(), 0);
+
+    // "\0" as range end means all the keys from the key on
+    etcdserverpb::RangeRequest fromRequest;
+    fromRequest.set_key("/key/4");
+    fromRequest.set_range_end(std::string(1, '\0'));
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&fromRequest, &response).ok());
+    EXPECT_EQ(response.count(), 3);
+    ASSERT_EQ(response.kvs_size(), 3);
+    EXPECT_EQ(response.kvs(2).key(), "/z");
+
+    etcdserverpb::DeleteRangeRequest deleteRequest;
+    deleteRequest.set_key("/key/");
+    deleteRequest.set_range_end("/key0");
+    etcdserverpb::DeleteRangeResponse deleteResponse;
+    kvActor->DeleteRange(&deleteRequest, &deleteResponse);
+    EXPECT_EQ(deleteResponse.deleted(), 5);
+    fromRequest.set_key("/");
+    response.Clear();
+    EXPECT_TRUE(kvActor->Range(&fromRequest, &response).ok());
+    EXPECT_EQ(response.count(), 2);
+}
+
 TEST_F(MetaStoreTest, WatchServiceActorTest)  // NOLINT
 {
     auto wsActor = std::make_shared<meta_store::WatchServiceActor>("wsActor");
@@ -540,11 +631,12 @@ TEST_F(MetaStoreTest, WatchServiceActorTest)  // NOLINT
     auto vector = std::make_shared<std::vector<::mvccpb::KeyValue>>();
     vector->emplace_back(kv);
     vector->emplace_back(kv2);
-    litebus::Async(wsActor->GetAID(), &WatchServiceActor::OnDeleteList, vector);
+    int64_t revision = 2;
+    litebus::Async(wsActor->GetAID(), &WatchServiceActor::OnDeleteList, vector, revision);
 
     // OnDelete test
     prevKv.set_key("5");
-    litebus::Async(wsActor->GetAID(), &WatchServiceActor::OnDelete, prevKv);
+    litebus::Async(wsActor->GetAID(), &WatchServiceActor::OnDelete, prevKv, revision + 1);
 
     litebus::Terminate(wsActor->GetAID());
     litebus::Await(wsActor);
@@ -991,6 +1083,189 @@ void AddEvent(std::shared_ptr<meta_store::WatchServiceAsyncPushActor> asyncPushA
     asyncPushActor->AddToUnsyncedEvents(response);
 }
 
+TEST_F(MetaStoreTest, RevisionHistoryTest)  // NOLINT
+{
+    RevisionHistory history(4);
+    ::mvccpb::KeyValue kv;
+    ::mvccpb::KeyValue prevKv;
+    for (int64_t revision = 1; revision <= 3; ++revision) {
+        kv.set_key("/key/" + std::to_string(revision));
+        kv.set_mod_revision(revision);
+        history.AddPut(kv, prevKv);
+    }
+    etcdserverpb::WatchCreateRequest request;
+    request.set_key("/key/");
+    request.set_range_end("/key0");
+    std::vector<::mvccpb::Event> events;
+    EXPECT_TRUE(history.Replay(2, request, events));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].kv().mod_revision(), 2);
+    EXPECT_EQ(events[1].kv().key(), "/key/3");
+
+    // a delete range of two keys at revision 4 fills the history, revision 1 is compacted
+    history.AddDelete(4, kv);
+    prevKv.set_key("/key/2");
+    history.AddDelete(4, prevKv);
+    EXPECT_EQ(history.CompactRevision(), 2);
+    events.clear();
+    EXPECT_FALSE(history.Replay(1, request, events));
+    request.set_prev_kv(true);
+    EXPECT_TRUE(history.Replay(4, request, events));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type(), ::mvccpb::Event_EventType::Event_EventType_DELETE);
+    EXPECT_EQ(events[1].prev_kv().key(), "/key/2");
+
+    // the next put compacts revision 2
+    kv.set_mod_revision(5);
+    history.AddPut(kv, prevKv);
+    EXPECT_EQ(history.CompactRevision(), 3);
+    events.clear();
+    request.set_key("/key/3");
+    request.clear_range_end();
+    EXPECT_TRUE(history.Replay(3, request, events));
+    EXPECT_EQ(events.size(), 3u);
+
+    history.Reset(6);
+    EXPECT_EQ(history.Size(), 0u);
+    EXPECT_FALSE(history.Replay(5, request, events));
+}
+
+TEST_F(MetaStoreTest, RevisionHistoryByteBudgetTest)  // NOLINT
+{
+    // the count allows every event, the bytes hold about two of the large values
+    RevisionHistory history(100, 2500);
+    ::mvccpb::KeyValue kv;
+    ::mvccpb::KeyValue prevKv;
+    for (int64_t revision = 1; revision <= 3; ++revision) {
+        kv.set_key("/key/" + std::to_string(revision));
+        kv.set_value(std::string(1000, 'a'));
+        kv.set_mod_revision(revision);
+        history.AddPut(kv, prevKv);
+    }
+    EXPECT_EQ(history.Size(), 2u);
+    EXPECT_LE(history.Bytes(), 2500u);
+    EXPECT_EQ(history.CompactRevision(), 2);
+
+    // a small event fits next to the large ones
+    kv.set_key("/key/4");
+    kv.set_value("1");
+    kv.set_mod_revision(4);
+    history.AddPut(kv, prevKv);
+    EXPECT_EQ(history.Size(), 3u);
+    EXPECT_EQ(history.CompactRevision(), 2);
+
+    etcdserverpb::WatchCreateRequest request;
+    request.set_key("/key/");
+    request.set_range_end("/key0");
+    std::vector<::mvccpb::Event> events;
+    EXPECT_FALSE(history.Replay(1, request, events));
+    EXPECT_TRUE(history.Replay(2, request, events));
+    EXPECT_EQ(events.size(), 3u);
+
+    history.Reset(5);
+    EXPECT_EQ(history.Bytes(), 0u);
+}
+
+TEST_F(MetaStoreTest, WatchResumeFromRevisionTest)  // NOLINT
+{
+    auto kvActor = std::make_shared<meta_store::KvServiceActor>();
+    auto client = std::make_shared<MockMetaStoreClientActor>("client");
+    // revision 1 to 3 are puts, revision 4 deletes "/key/1"
+    etcdserverpb::PutResponse putResponse;
+    for (const auto &key : { "/key/1", "/other", "/key/2" }) {
+        etcdserverpb::PutRequest putRequest;
+        putRequest.set_key(key);
+        putRequest.set_value("1");
+        kvActor->Put(&putRequest, &putResponse);
+    }
+    etcdserverpb::DeleteRangeRequest deleteRequest;
+    deleteRequest.set_key("/key/1");
+    etcdserverpb::DeleteRangeResponse deleteResponse;
+    kvActor->DeleteRange(&deleteRequest, &deleteResponse);
+    EXPECT_EQ(deleteResponse.header().revision(), 4);
+
+    litebus::Spawn(kvActor);
+    litebus::Spawn(client);
+    auto kvAccessorActor = std::make_shared<meta_store::KvServiceAccessorActor>(kvActor->GetAID());
+    litebus::Spawn(kvAccessorActor);
+
+    auto watch = [&](const std::string &uuid, int64_t startRevision) {
+        messages::MetaStoreRequest req;
+        etcdserverpb::WatchRequest request;
+        auto *args = request.mutable_create_request();
+        args->set_key("/key/");
+        args->set_range_end("/key0");
+        args->set_start_revision(startRevision);
+        req.set_requestid(uuid);
+        req.set_requestmsg(request.SerializeAsString());
+        kvAccessorActor->AsyncWatch(client->GetAID(), "Watch", req.SerializeAsString());
+    };
+
+    litebus::Promise<bool> resumed;
+    EXPECT_CALL(*client, MockOnWatch)
+        .WillOnce(Invoke([](const litebus::AID &from, std::string name, std::string msg) {  // OnCreate
+            etcdserverpb::WatchResponse response;
+            EXPECT_TRUE(ParseWatchResponse(response, msg));
+            EXPECT_TRUE(response.created());
+            EXPECT_FALSE(response.canceled());
+        }))
+        .WillOnce(Invoke([&resumed](const litebus::AID &from, std::string name, std::string msg) {  // missed events
+            etcdserverpb::WatchResponse response;
+            EXPECT_TRUE(ParseWatchResponse(response, msg));
+            EXPECT_EQ(response.header().revision(), 4);
+            ASSERT_EQ(response.events_size(), 2);
+            EXPECT_EQ(response.events(0).kv().key(), "/key/2");
+            EXPECT_EQ(response.events(1).type(), ::mvccpb::Event_EventType::Event_EventType_DELETE);
+            EXPECT_EQ(response.events(1).kv().mod_revision(), 4);
+            resumed.SetValue(true);
+        }));
+    watch("resume", 2);
+    ASSERT_AWAIT_READY(resumed.GetFuture());
+
+    // the store has not reached revision 10, the watcher resyncs as compacted
+    litebus::Promise<bool> compacted;
+    EXPECT_CALL(*client, MockOnWatch)
+        .WillOnce(Invoke([&compacted](const litebus::AID &from, std::string name, std::string msg) {
+            etcdserverpb::WatchResponse response;
+            EXPECT_TRUE(ParseWatchResponse(response, msg));
+            EXPECT_TRUE(response.created());
+            EXPECT_TRUE(response.canceled());
+            EXPECT_EQ(response.compact_revision(), 1);
+            compacted.SetValue(true);
+        }));
+    watch("compacted", 10);
+    ASSERT_AWAIT_READY(compacted.GetFuture());
+
+    litebus::Terminate(kvAccessorActor->GetAID());
+    litebus::Await(kvAccessorActor);
+    litebus::Terminate(kvActor->GetAID());
+    litebus::Await(kvActor);
+    litebus::Terminate(client->GetAID());
+    litebus::Await(client);
+}
+
+TEST_F(MetaStoreTest, PrefixTrieTest)  // NOLINT
+{
+    std::vector<std::string> prefixes = { "/a/", "/a/b/", "/a/bc/", "/ab", "/b/" };
+    PrefixTrie<std::string> trie;
+    for (auto &prefix : prefixes) {
+        trie.Insert(prefix, &prefix);
+    }
+    EXPECT_EQ(trie.Size(), prefixes.size());
+    EXPECT_EQ(trie.Find("/a/b/"), &prefixes[1]);
+    EXPECT_EQ(trie.Find("/a/b"), nullptr);
+
+    std::vector<std::string> matched;
+    trie.ForEachPrefixOf("/a/bc/1", [&matched](const std::string &prefix) { matched.emplace_back(prefix); });
+    EXPECT_EQ(matched, std::vector<std::string>({ "/a/", "/a/bc/" }));
+    matched.clear();
+    trie.ForEachPrefixOf("/abc", [&matched](const std::string &prefix) { matched.emplace_back(prefix); });
+    EXPECT_EQ(matched, std::vector<std::string>({ "/ab" }));
+    matched.clear();
+    trie.ForEachPrefixOf("/c/", [&matched](const std::string &prefix) { matched.emplace_back(prefix); });
+    EXPECT_TRUE(matched.empty());
+}
+
 TEST_F(MetaStoreTest, WatchServiceAsyncPushActorTest)
 {
     auto asyncPushActor = std::make_shared<meta_store::WatchServiceAsyncPushActor>("pushActor");
@@ -1108,6 +1383,90 @@ TEST_F(MetaStoreTest, GetAndWatchTest)
     litebus::Await(client);
 }
 
+TEST_F(MetaStoreTest, GetAndWatchPagedTest)
+{
+    const int total = static_cast<int>(DEFAULT_GET_AND_WATCH_PAGE_SIZE) * 2 + 1;
+    auto kvActor = std::make_shared<meta_store::KvServiceActor>();
+    etcdserverpb::PutRequest putRequest;
+    etcdserverpb::PutResponse putResponse;
+    for (int i = 0; i < total; ++i) {
+        putRequest.set_key("/paged/" + std::to_string(i));
+        putRequest.set_value(std::to_string(i));
+        kvActor->Put(&putRequest, &putResponse);
+    }
+    auto client = std::make_shared<MockMetaStoreClientActor>("client");
+    litebus::Spawn(kvActor);
+    litebus::Spawn(client);
+    auto kvAccessorActor = std::make_shared<meta_store::KvServiceAccessorActor>(kvActor->GetAID());
+    litebus::Spawn(kvAccessorActor);
+
+    std::atomic<int> pages = 0;
+    std::atomic<int> kvs = 0;
+    std::atomic<bool> more = true;
+    std::atomic<bool> watched = false;
+    std::atomic<int64_t> revision = 0;
+    EXPECT_CALL(*client, MockOnGetAndWatch)
+        .Times(3)
+        .WillRepeatedly(Invoke([&](const litebus::AID &, std::string, std::string msg) {
+            messages::MetaStoreResponse message;
+            messages::GetAndWatchResponse rsp;
+            etcdserverpb::RangeResponse rangeResp;
+            EXPECT_TRUE(message.ParseFromString(msg));
+            EXPECT_TRUE(rsp.ParseFromString(message.responsemsg()));
+            EXPECT_TRUE(rangeResp.ParseFromString(rsp.getresponsemsg()));
+            // every page is at the revision of the snapshot, the last one is not marked with more
+            if (pages == 0) {
+                revision = rangeResp.header().revision();
+            }
+            EXPECT_EQ(rangeResp.header().revision(), revision.load());
+            for (const auto &kv : rangeResp.kvs()) {
+                EXPECT_LE(kv.mod_revision(), revision.load());
+            }
+            EXPECT_EQ(rangeResp.count(), total);
+            EXPECT_LE(rangeResp.kvs_size(), DEFAULT_GET_AND_WATCH_PAGE_SIZE);
+            more = rangeResp.more();
+            kvs += rangeResp.kvs_size();
+            ++pages;
+        }));
+    EXPECT_CALL(*client, MockOnWatch).WillOnce(Invoke([&](const litebus::AID &, std::string, std::string msg) {
+        etcdserverpb::WatchResponse response;
+        EXPECT_TRUE(ParseWatchResponse(response, msg));
+        ASSERT_EQ(response.events_size(), 1);
+        // a kv changed after the snapshot comes with its event, the pages sent after it leave it out
+        EXPECT_EQ(response.events(0).kv().value(), "new");
+        watched = true;
+    }));
+
+    messages::MetaStoreRequest req;
+    etcdserverpb::WatchRequest request;
+    auto *args = request.mutable_create_request();
+    args->set_key("/paged/");
+    args->set_range_end(StringPlusOne("/paged/"));
+    req.set_requestid(litebus::uuid_generator::UUID::GetRandomUUID().ToString());
+    req.set_requestmsg(request.SerializeAsString());
+    kvAccessorActor->AsyncGetAndWatch(client->GetAID(), "GetAndWatch", req.SerializeAsString());
+    {
+        EXPECT_CALL(*client, MockOnPut).WillOnce(Return());
+        messages::MetaStore::PutRequest request;
+        request.set_requestid(litebus::uuid_generator::UUID::GetRandomUUID().ToString());
+        request.set_key("/paged/999");
+        request.set_value("new");
+        kvAccessorActor->AsyncPut(client->GetAID(), "Put", request.SerializeAsString());
+    }
+
+    ASSERT_AWAIT_TRUE([&]() -> bool { return watched && !more; });
+    // the last key is left out of the last page if changed before it is sent
+    EXPECT_GE(kvs.load(), total - 1);
+    EXPECT_LE(kvs.load(), total);
+
+    litebus::Terminate(kvActor->GetAID());
+    litebus::Await(kvActor);
+    litebus::Terminate(kvAccessorActor->GetAID());
+    litebus::Await(kvAccessorActor);
+    litebus::Terminate(client->GetAID());
+    litebus::Await(client);
+}
+
 TEST_F(MetaStoreTest, LinkTest)
 {
     std::atomic<bool> put = false;
@@ -1770,6 +2129,369 @@ TEST_F(MetaStoreTest, LeaseRecoverTest)
     litebus::Await(persistActor);
 }
 
+TEST_F(MetaStoreTest, WalStoreRecoverTest)
+{
+    const std::string dir = "/tmp/meta_store_wal_store_test";
+    (void)litebus::os::Rmdir(dir);
+    auto putOps = [](const std::string &key) {
+        ::etcdserverpb::TxnRequest ops;
+        ops.add_success()->mutable_request_put()->set_key(key);
+        return ops;
+    };
+    auto replayed = [&dir](int64_t snapshotRevision) {
+        std::vector<int64_t> revisions;
+        WalStore store(dir);
+        EXPECT_TRUE(store.Replay(snapshotRevision, [&revisions](int64_t revision, const ::etcdserverpb::TxnRequest &) {
+                             revisions.emplace_back(revision);
+                         }).IsOk());
+        return revisions;
+    };
+    {
+        WalStore store(dir);
+        ::etcdserverpb::RangeResponse snapshot;
+        ASSERT_TRUE(store.LoadSnapshot(snapshot).IsOk());
+        EXPECT_EQ(snapshot.header().revision(), 0);
+        ASSERT_TRUE(store.Replay(0, [](int64_t, const ::etcdserverpb::TxnRequest &) { FAIL(); }).IsOk());
+        store.Append(1, putOps("a"));
+        store.Append(2, putOps("b"));
+        EXPECT_TRUE(store.Sync().IsOk());
+        store.Append(3, putOps("c"));
+        EXPECT_TRUE(store.Sync().IsOk());
+        // not synced, lost
+        store.Append(4, putOps("d"));
+    }
+    EXPECT_EQ(replayed(0), std::vector<int64_t>({ 1, 2, 3 }));
+
+    // a torn tail is cut off
+    auto logPath = litebus::os::Join(dir, META_STORE_WAL_FILE);
+    auto logSize = [&logPath]() {
+        return static_cast<int64_t>(std::ifstream(logPath, std::ios::ate | std::ios::binary).tellg());
+    };
+    auto synced = logSize();
+    {
+        std::ofstream log(logPath, std::ios::app | std::ios::binary);
+        log << "torn";
+    }
+    EXPECT_EQ(logSize(), synced + 4);
+    EXPECT_EQ(replayed(0), std::vector<int64_t>({ 1, 2, 3 }));
+    EXPECT_EQ(logSize(), synced);
+    {
+        WalStore store(dir);
+        ASSERT_TRUE(store.Replay(0, [](int64_t, const ::etcdserverpb::TxnRequest &) {}).IsOk());
+        EXPECT_EQ(static_cast<int64_t>(store.LogSize()), synced);
+
+        ::etcdserverpb::RangeResponse snapshot;
+        snapshot.mutable_header()->set_revision(3);
+        snapshot.add_kvs()->set_key("a");
+        ASSERT_TRUE(store.Snapshot(snapshot).IsOk());
+        EXPECT_EQ(store.LogSize(), 0u);
+        store.Append(4, putOps("d"));
+        EXPECT_TRUE(store.Sync().IsOk());
+    }
+    WalStore store(dir);
+    ::etcdserverpb::RangeResponse snapshot;
+    ASSERT_TRUE(store.LoadSnapshot(snapshot).IsOk());
+    EXPECT_EQ(snapshot.header().revision(), 3);
+    EXPECT_EQ(snapshot.kvs_size(), 1);
+    // the records before the snapshot are skipped
+    EXPECT_EQ(replayed(1), std::vector<int64_t>({ 4 }));
+    EXPECT_EQ(replayed(4), std::vector<int64_t>({}));
+    (void)litebus::os::Rmdir(dir);
+}
+
+TEST_F(MetaStoreTest, LocalPersistRecoverTest)
+{
+    const std::string dir = "/tmp/meta_store_local_persist_test";
+    (void)litebus::os::Rmdir(dir);
+    {
+        // small threshold to snapshot on the way
+        auto persistActor = std::make_shared<LocalPersistActor>("LocalPersist", dir, 1024);
+        litebus::Spawn(persistActor);
+        auto backupActor = std::make_shared<BackupActor>("BackupActor", persistActor->GetAID());
+        litebus::Spawn(backupActor);
+        std::vector<litebus::Future<Status>> futures;
+        for (int i = 0; i < 100; ++i) {
+            ::mvccpb::KeyValue kv;
+            kv.set_key("key" + std::to_string(i));
+            kv.set_value("value" + std::to_string(i));
+            kv.set_mod_revision(i + 1);
+            futures.emplace_back(litebus::Async(backupActor->GetAID(), &BackupActor::WritePut, kv, false));
+        }
+        for (auto &future : futures) {
+            ASSERT_AWAIT_READY(future);
+            EXPECT_TRUE(future.Get().IsOk());
+        }
+        auto deletes = std::make_shared<std::vector<::mvccpb::KeyValue>>(1);
+        deletes->at(0).set_key("key0");
+        auto deleted = litebus::Async(backupActor->GetAID(), &BackupActor::WriteDeletes, deletes, false);
+        ASSERT_AWAIT_READY(deleted);
+        EXPECT_TRUE(deleted.Get().IsOk());
+        std::string leaseKey = "/metastore/lease/1";
+        std::string leaseValue = "lease";
+        auto put = litebus::Async(backupActor->GetAID(), &BackupActor::Put, leaseKey, leaseValue, PutOption{});
+        ASSERT_AWAIT_READY(put);
+        EXPECT_TRUE(put.Get()->status.IsOk());
+        EXPECT_TRUE(litebus::os::ExistPath(litebus::os::Join(dir, META_STORE_SNAPSHOT_FILE)));
+
+        litebus::Terminate(backupActor->GetAID());
+        litebus::Await(backupActor);
+        litebus::Terminate(persistActor->GetAID());
+        litebus::Await(persistActor);
+    }
+
+    // restart without etcd, the kvs come back from the snapshot and the wal tail
+    auto persistActor = std::make_shared<LocalPersistActor>("LocalPersist", dir);
+    litebus::Spawn(persistActor);
+    auto backupActor = std::make_shared<BackupActor>("BackupActor", persistActor->GetAID());
+    litebus::Spawn(backupActor);
+    auto kvServiceActor = std::make_shared<KvServiceActor>(backupActor->GetAID());
+    litebus::Spawn(kvServiceActor);
+    auto ok = litebus::Async(kvServiceActor->GetAID(), &KvServiceActor::Recover);
+    ASSERT_AWAIT_READY(ok);
+    EXPECT_EQ(kvServiceActor->cache_.size(), 99u);
+    EXPECT_EQ(kvServiceActor->cache_.count("key0"), 0u);
+    EXPECT_EQ(kvServiceActor->cache_.at("key99").value(), "value99");
+    EXPECT_EQ(kvServiceActor->modRevision_, 100);
+
+    GetOption option;
+    option.prefix = true;
+    std::string leasePrefix = "/metastore/lease/";
+    auto leases = litebus::Async(backupActor->GetAID(), &BackupActor::Get, leasePrefix, option);
+    ASSERT_AWAIT_READY(leases);
+    ASSERT_EQ(leases.Get()->kvs.size(), 1u);
+    EXPECT_EQ(leases.Get()->kvs[0].value(), "lease");
+
+    litebus::Terminate(kvServiceActor->GetAID());
+    litebus::Await(kvServiceActor);
+    litebus::Terminate(backupActor->GetAID());
+    litebus::Await(backupActor);
+    litebus::Terminate(persistActor->GetAID());
+    litebus::Await(persistActor);
+    (void)litebus::os::Rmdir(dir);
+}
+
+TEST_F(MetaStoreTest, LocalPersistSyncFailTest)
+{
+    // the wal is not opened without the recovery, its sync fails
+    auto persistActor =
+        std::make_shared<LocalPersistActor>("LocalPersistFail", "/tmp/meta_store_local_persist_fail_test");
+    ::etcdserverpb::TxnRequest request;
+    auto *put = request.add_success()->mutable_request_put();
+    put->set_key("key");
+    put->set_value("value");
+    auto response = std::make_shared<::etcdserverpb::TxnResponse>();
+    auto written = persistActor->Write(request, response);
+    // nothing is applied before the sync
+    EXPECT_TRUE(persistActor->kvs_.empty());
+    EXPECT_EQ(persistActor->revision_, 0);
+
+    persistActor->Flush();
+    ASSERT_AWAIT_READY(written);
+    EXPECT_TRUE(written.Get().IsError());
+    EXPECT_TRUE(persistActor->kvs_.empty());
+    EXPECT_EQ(persistActor->revision_, 0);
+    EXPECT_FALSE(response->has_header());
+}
+
+TEST_F(MetaStoreTest, LeaseExpiryQueueTest)
+{
+    auto kvActor = std::make_shared<meta_store::KvServiceActor>();
+    litebus::Spawn(kvActor);
+    etcdserverpb::PutRequest putRequest;
+    etcdserverpb::PutResponse putResponse;
+    for (const auto &key : { "k1", "k2", "k3", "k4" }) {
+        putRequest.set_key(key);
+        putRequest.set_value("value");
+        kvActor->Put(&putRequest, &putResponse);
+    }
+
+    auto leaseActor = std::make_shared<LeaseServiceActor>(kvActor->GetAID());
+    auto now =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    auto addLease = [&](int64_t id, int64_t expiry) {
+        ::messages::Lease lease;
+        lease.set_id(id);
+        lease.set_expiry(expiry);
+        lease.add_items("k" + std::to_string(id));
+        lease.add_items("k" + std::to_string(id));  // attached twice
+        leaseActor->leases_[id] = lease;
+        leaseActor->ScheduleExpiry(id, expiry);
+    };
+    addLease(1, now - 1);
+    addLease(2, now - 1);
+    addLease(3, now - 1);
+    addLease(4, now + 100000);
+    // kept alive after queued, re-keyed when popped
+    leaseActor->leases_[2].set_expiry(now + 100000);
+    // revoked, its queued entry turns stale
+    leaseActor->leases_.erase(3);
+    leaseActor->expiryQueued_.erase(3);
+    EXPECT_EQ(leaseActor->expiryQueue_.size(), 4u);
+
+    leaseActor->running_ = true;
+    litebus::Spawn(leaseActor);
+    litebus::Async(leaseActor->GetAID(), &LeaseServiceActor::CheckpointScheduledLeases);
+    ASSERT_AWAIT_TRUE([&]() { return kvActor->cache_.find("k1") == kvActor->cache_.end(); });
+    EXPECT_EQ(kvActor->cache_.size(), 3u);
+    EXPECT_NE(kvActor->cache_.find("k2"), kvActor->cache_.end());
+    EXPECT_NE(kvActor->cache_.find("k3"), kvActor->cache_.end());
+
+    EXPECT_EQ(leaseActor->leases_.size(), 2u);
+    EXPECT_EQ(leaseActor->leases_.count(1), 0u);
+    EXPECT_EQ(leaseActor->expiryQueued_.at(2), now + 100000);
+    EXPECT_EQ(leaseActor->expiryQueue_.size(), 2u);
+    EXPECT_EQ(leaseActor->expiryQueue_.top().first, now + 100000);
+
+    litebus::Terminate(leaseActor->GetAID());
+    litebus::Await(leaseActor);
+    litebus::Terminate(kvActor->GetAID());
+    litebus::Await(kvActor);
+}
+
+TEST_F(MetaStoreTest, KvShardRouterTest)
+{
+    // the nested and the empty ones are dropped
+    KvShardRouter router({ "/sn/instance/", "/yr/route/", "/sn/instance/business/", "" });
+    ASSERT_EQ(router.ShardCount(), 3u);
+    EXPECT_EQ(router.DefaultShard(), 2u);
+
+    EXPECT_EQ(router.Route("/sn/instance/business/1"), 0u);
+    EXPECT_EQ(router.Route("/yr/route/1"), 1u);
+    EXPECT_EQ(router.Route("/yr/functions/1"), 2u);
+    EXPECT_EQ(router.Route("/sn/instance"), 2u);
+
+    EXPECT_EQ(router.RouteRange("/yr/route/1", ""), std::vector<size_t>{ 1 });
+    EXPECT_EQ(router.RouteRange("/sn/instance/", StringPlusOne("/sn/instance/")), std::vector<size_t>{ 0 });
+    EXPECT_EQ(router.RouteRange("/sn/instance/a", "/sn/instance/b"), std::vector<size_t>{ 0 });
+    EXPECT_EQ(router.RouteRange("/yr/", StringPlusOne("/yr/")), (std::vector<size_t>{ 1, 2 }));
+    EXPECT_EQ(router.RouteRange("/", std::string(1, '\0')), (std::vector<size_t>{ 0, 1, 2 }));
+    EXPECT_EQ(router.RouteRange("/yr/functions/", StringPlusOne("/yr/functions/")), (std::vector<size_t>{ 2 }));
+
+    etcdserverpb::TxnRequest txn;
+    EXPECT_EQ(router.RouteTxn(txn).Get(), 2u);
+    auto compare = txn.add_compare();
+    compare->set_key("/yr/route/1");
+    txn.add_success()->mutable_request_put()->set_key("/yr/route/1");
+    txn.add_failure()->mutable_request_range()->set_key("/yr/route/2");
+    EXPECT_EQ(router.RouteTxn(txn).Get(), 1u);
+    txn.add_failure()->mutable_request_txn()->add_success()->mutable_request_delete_range()->set_key("/sn/instance/1");
+    EXPECT_TRUE(router.RouteTxn(txn).IsNone());
+}
+
+TEST_F(MetaStoreTest, KvShardMergeRangeTest)
+{
+    auto router = std::make_shared<KvShardRouter>(std::vector<std::string>{ "/b/" });
+    std::vector<std::shared_ptr<KvServiceActor>> actors;
+    etcdserverpb::PutRequest putRequest;
+    etcdserverpb::PutResponse putResponse;
+    for (size_t i = 0; i < router->ShardCount(); ++i) {
+        actors.emplace_back(std::make_shared<KvServiceActor>("MergeShard" + std::to_string(i)));
+        actors.back()->SetShard(router, i);
+    }
+    for (const auto &key : { "/a/1", "/b/1", "/b/2", "/c/1" }) {
+        putRequest.set_key(key);
+        putRequest.set_value(key);
+        actors[router->Route(key)]->Put(&putRequest, &putResponse);
+    }
+
+    etcdserverpb::RangeRequest request;
+    request.set_key("/");
+    request.set_range_end(StringPlusOne("/"));
+    request.set_limit(3);
+    KvServiceAccessorActor::RangeResponses responses;
+    for (const auto &actor : actors) {
+        responses.emplace_back(actor->ShardRange(std::make_shared<etcdserverpb::RangeRequest>(request)));
+    }
+    auto merged = KvServiceAccessorActor::MergeRange(request, responses);
+    EXPECT_EQ(merged.count(), 4);
+    EXPECT_TRUE(merged.more());
+    ASSERT_EQ(merged.kvs_size(), 3);
+    EXPECT_EQ(merged.kvs(0).key(), "/a/1");
+    EXPECT_EQ(merged.kvs(1).key(), "/b/1");
+    EXPECT_EQ(merged.kvs(2).key(), "/b/2");
+    EXPECT_EQ(merged.header().revision(), 2);
+
+    request.set_sort_order(etcdserverpb::RangeRequest_SortOrder_DESCEND);
+    responses.clear();
+    for (const auto &actor : actors) {
+        responses.emplace_back(actor->ShardRange(std::make_shared<etcdserverpb::RangeRequest>(request)));
+    }
+    merged = KvServiceAccessorActor::MergeRange(request, responses);
+    ASSERT_EQ(merged.kvs_size(), 3);
+    EXPECT_EQ(merged.kvs(0).key(), "/c/1");
+    EXPECT_EQ(merged.kvs(1).key(), "/b/2");
+}
+
+TEST_F(MetaStoreTest, WatchAcrossShardsFromRevisionTest)  // NOLINT
+{
+    auto shards = std::make_shared<KvShards>();
+    shards->router = std::make_shared<KvShardRouter>(std::vector<std::string>{ "/b/" });
+    auto watchActor = std::make_shared<WatchServiceActor>("CrossShardWatchServiceActor");
+    shards->watchServiceActor = litebus::Spawn(watchActor);
+    std::vector<std::shared_ptr<KvServiceActor>> actors;
+    etcdserverpb::PutRequest putRequest;
+    etcdserverpb::PutResponse putResponse;
+    for (size_t i = 0; i < shards->router->ShardCount(); ++i) {
+        actors.emplace_back(std::make_shared<KvServiceActor>("CrossShard" + std::to_string(i)));
+        putRequest.set_key(i == 0 ? "/a/1" : "/b/1");
+        putRequest.set_value(std::to_string(i));
+        actors.back()->Put(&putRequest, &putResponse);
+        actors.back()->AddWatchServiceActor(shards->watchServiceActor);
+        actors.back()->SetShard(shards->router, i);
+        shards->kvServiceActors.emplace_back(litebus::Spawn(actors.back()));
+    }
+    auto client = std::make_shared<MockMetaStoreClientActor>("crossShardClient");
+    litebus::Spawn(client);
+    auto kvAccessorActor = std::make_shared<KvServiceAccessorActor>(shards, "CrossShard");
+    litebus::Spawn(kvAccessorActor);
+
+    // the shards have no common history, the watch is opened at the present with a snapshot of every shard to resync
+    // on, instead of being canceled as compacted again and again
+    litebus::Promise<bool> opened;
+    EXPECT_CALL(*client, MockOnWatch).Times(0);
+    EXPECT_CALL(*client, MockOnGetAndWatch)
+        .WillOnce(Invoke([&opened](const litebus::AID &, std::string, std::string msg) {
+            messages::MetaStoreResponse message;
+            messages::GetAndWatchResponse rsp;
+            etcdserverpb::RangeResponse rangeResp;
+            etcdserverpb::WatchResponse watchResp;
+            EXPECT_TRUE(message.ParseFromString(msg));
+            EXPECT_TRUE(rsp.ParseFromString(message.responsemsg()));
+            EXPECT_TRUE(rangeResp.ParseFromString(rsp.getresponsemsg()));
+            EXPECT_TRUE(watchResp.ParseFromString(rsp.watchresponsemsg()));
+            EXPECT_EQ(message.responseid(), "acrossShards");
+            EXPECT_TRUE(watchResp.created());
+            EXPECT_FALSE(watchResp.canceled());
+            EXPECT_FALSE(rangeResp.more());
+            ASSERT_EQ(rangeResp.kvs_size(), 2);
+            EXPECT_EQ(rangeResp.kvs(0).key(), "/a/1");
+            EXPECT_EQ(rangeResp.kvs(1).key(), "/b/1");
+            opened.SetValue(true);
+        }));
+    messages::MetaStoreRequest req;
+    etcdserverpb::WatchRequest request;
+    auto *args = request.mutable_create_request();
+    args->set_key("/");
+    args->set_range_end(StringPlusOne("/"));
+    args->set_start_revision(5);
+    req.set_requestid("acrossShards");
+    req.set_requestmsg(request.SerializeAsString());
+    kvAccessorActor->AsyncWatch(client->GetAID(), "Watch", req.SerializeAsString());
+    ASSERT_AWAIT_READY(opened.GetFuture());
+
+    litebus::Terminate(kvAccessorActor->GetAID());
+    litebus::Await(kvAccessorActor);
+    for (const auto &actor : actors) {
+        litebus::Terminate(actor->GetAID());
+        litebus::Await(actor);
+    }
+    litebus::Terminate(watchActor->GetAID());
+    litebus::Await(watchActor);
+    litebus::Terminate(client->GetAID());
+    litebus::Await(client);
+}
+
 TEST_F(MetaStoreTest, WatchServiceActorCancelTest)  // NOLINT
 {
     auto wsActor = std::make_shared<meta_store::WatchServiceActor>("wsActor");